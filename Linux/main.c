@@ -42,6 +42,7 @@
 /*  ----------------------------------- OS Specific Headers           */
 #include <stdio.h>
 #include <stdlib.h>
+#include <string.h>
 
 /*  ----------------------------------- DSP/BIOS Link                 */
 #include <dsplink.h>
@@ -49,6 +50,7 @@
 /*  ----------------------------------- Application Header            */
 #include <ring_io_os.h>
 #include <ring_io.h>
+#include <ring_io_daemon.h>
 
 #if defined (__cplusplus)
 extern "C" {
@@ -68,32 +70,169 @@ int main(int argc, char ** argv) {
 	Char8 * strTotalBytes = NULL;
 	Char8 * strProcessorId = NULL;
 	Uint8 processorId = 0;
+	RING_IO_Options options;
+	int argi = 1;
 
-	if ((argc != 3) && (argc != 2)) {
-		printf("Usage : %s <absolute path of DSP executable> "
+	options.mode = RING_IO_MODE_INTERACTIVE;
+	options.inFile = NULL;
+	options.outFile = NULL;
+	options.socketPath = NULL;
+	options.benchBytes = 0;
+	options.benchSizes = NULL;
+	options.tune = RING_IO_TUNE_OFF;
+	if (getenv("RING_IO_TUNE") != NULL) {
+		options.tune = (strcmp(getenv("RING_IO_TUNE"), "apply") == 0) ?
+				RING_IO_TUNE_APPLY : RING_IO_TUNE_RECOMMEND;
+	}
+	memset(&options.config, 0, sizeof(options.config));
+	if (getenv("RING_IO_RING_SIZE") != NULL) {
+		options.config.ringSize = strtoul(getenv("RING_IO_RING_SIZE"), NULL,
+				10);
+	}
+	if (getenv("RING_IO_ACQ_SIZE") != NULL) {
+		options.config.acqSize = strtoul(getenv("RING_IO_ACQ_SIZE"), NULL, 10);
+	}
+	if (getenv("RING_IO_WATERMARK") != NULL) {
+		options.config.watermark = strtoul(getenv("RING_IO_WATERMARK"), NULL,
+				10);
+	}
+	if (getenv("RING_IO_NOTIFY") != NULL) {
+		options.config.notifyAlways =
+				(strcmp(getenv("RING_IO_NOTIFY"), "always") == 0) ? 1 : 0;
+	}
+	if (getenv("RING_IO_PREFETCH") != NULL) {
+		options.config.prefetch = strtoul(getenv("RING_IO_PREFETCH"), NULL,
+				10);
+	}
+	if (getenv("RING_IO_STAGE") != NULL) {
+		options.config.stage =
+				(strcmp(getenv("RING_IO_STAGE"), "1") == 0) ? 1 : 0;
+	}
+	if (getenv("RING_IO_FILL_AHEAD") != NULL) {
+		options.config.fillAhead =
+				(strcmp(getenv("RING_IO_FILL_AHEAD"), "1") == 0) ? 1 : 0;
+	}
+	options.configFile = NULL;
+
+	if ((argc == 3) && (strcmp(argv[1], "--layout") == 0)) {
+		/* Only the memory layout is measured, the DSP is not needed */
+		RING_IO_CtrlLayoutBench(strtoul(argv[2], NULL, 10));
+		return (0);
+	}
+
+	if ((argc == 5) && (strcmp(argv[1], "--client") == 0)) {
+		/* Clients only talk to the daemon, they never attach to the DSP */
+		RING_IO_DaemonClientRun(argv[2], argv[3], argv[4]);
+		return (0);
+	}
+
+	if (   (argc >= 4)
+		&& (   (strcmp(argv[1], "--stream") == 0)
+			|| (strcmp(argv[1], "--bulk") == 0))) {
+		options.mode = (strcmp(argv[1], "--bulk") == 0) ?
+				RING_IO_MODE_BULK : RING_IO_MODE_STREAM;
+		options.inFile = argv[2];
+		options.outFile = argv[3];
+		argi = 4;
+	}
+	else if ((argc >= 4) && (strcmp(argv[1], "--bench") == 0)) {
+		options.mode = RING_IO_MODE_BENCH;
+		options.benchBytes = strtoull(argv[2], NULL, 10);
+		options.benchSizes = argv[3];
+		argi = 4;
+	}
+	else if ((argc >= 4) && (strcmp(argv[1], "--sweep") == 0)) {
+		options.mode = RING_IO_MODE_SWEEP;
+		options.benchBytes = strtoull(argv[2], NULL, 10);
+		options.configFile = argv[3];
+		argi = 4;
+	}
+	else if ((argc >= 3) && (strcmp(argv[1], "--prefetch") == 0)) {
+		options.mode = RING_IO_MODE_PREFETCH;
+		options.benchBytes = strtoull(argv[2], NULL, 10);
+		argi = 3;
+	}
+	else if ((argc >= 3) && (strcmp(argv[1], "--daemon") == 0)) {
+		options.mode = RING_IO_MODE_DAEMON;
+		options.socketPath = argv[2];
+		argi = 3;
+	}
+	else if ((argc >= 2) && (strcmp(argv[1], "--filter") == 0)) {
+		/* Standard output carries the data, print messages to stderr */
+		options.mode = RING_IO_MODE_FILTER;
+		RING_IO_PrintToStderr();
+		argi = 2;
+	}
+
+	if (((argc - argi) != 2) && ((argc - argi) != 1)) {
+		printf("Usage : %s [--stream <input file> <output file> "
+			"| --bulk <input file> <output file> | --filter "
+			"| --daemon <socket> | --bench <bytes> <sizes> "
+			"| --sweep <bytes> <config file> | --prefetch <bytes>] "
+			"<absolute path of DSP executable> "
 			"<DSP Processor Id>\n"
-			"For DSP Processor Id,"
+			"        %s --client <socket> <input file> <output file>\n"
+			"        %s --layout <iterations>\n"
+			"For --stream,"
+			"\n\t the input file is sent through the DSP and the result is "
+			"written to the output file"
+			"\nFor --bulk,"
+			"\n\t as --stream, passing POOL buffer descriptors instead of "
+			"the data through the RingIO"
+			"\nFor --filter,"
+			"\n\t the standard input is sent through the DSP and the result "
+			"is written to the standard output"
+			"\nFor --bench,"
+			"\n\t <bytes> are sent for each of the comma separated record "
+			"<sizes>, reporting throughput, latency, startup time, RSS "
+			"and context switches"
+			"\nFor --sweep,"
+			"\n\t <bytes> are sent for each channel configuration of a grid, "
+			"the configurations are ranked by throughput and the best one "
+			"is written to <config file>, to be loaded in the environment"
+			"\nFor --prefetch,"
+			"\n\t <bytes> are sent through the largest RingIOs for each "
+			"prefetch distance, with and without staging of the reads"
+			"\nFor --daemon,"
+			"\n\t local clients are served over the socket until "
+			"interrupted"
+			"\nFor --client,"
+			"\n\t the input file is sent through a running daemon"
+			"\nFor --layout,"
+			"\n\t the false sharing of the channel state is measured, "
+			"packed and split over cache lines"
+			"\nFor DSP Processor Id,"
 			"\n\t use value of 0  if sample needs to be run on DSP 0 "
 			"\n\t use value of 1  if sample needs to be run on DSP 1"
-			"\n\t For single DSP configuration this is optional argument\n",
-				argv[0]);
+			"\n\t For single DSP configuration this is optional argument"
+			"\nSet RING_IO_TUNE to recommend or apply to have the ring "
+			"sizes tuned during the run"
+			"\nSet RING_IO_RING_SIZE, RING_IO_ACQ_SIZE, RING_IO_WATERMARK "
+			"and RING_IO_NOTIFY (once or always) to configure the first "
+			"channel"
+			"\nSet RING_IO_PREFETCH to a number of bytes to prefetch the "
+			"reads ahead, and RING_IO_STAGE to 1 to copy them to a cached "
+			"buffer"
+			"\nSet RING_IO_FILL_AHEAD to 1 to fill the next record in a "
+			"thread of its own while the writer copies the previous one\n",
+				argv[0], argv[0], argv[0]);
 	} else {
-		dspExecutable = argv[1];
+		dspExecutable = argv[argi];
 		strBufferSize = "2048";
 		strTotalBytes = "128";
 
-		if (argc == 2) {
+		if ((argc - argi) == 1) {
 			strProcessorId = "0";
 			processorId = 0;
-		} else if (argc == 3) {
-			strProcessorId = argv[2];
-			processorId = atoi(argv[2]);
+		} else {
+			strProcessorId = argv[argi + 1];
+			processorId = atoi(argv[argi + 1]);
 		}
 
 		if (processorId < MAX_PROCESSORS) {
 
 			RING_IO_Main(dspExecutable, strBufferSize, strTotalBytes,
-					strProcessorId);
+					strProcessorId, &options);
 		}
 
 	}
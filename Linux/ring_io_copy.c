@@ -0,0 +1,783 @@
+/** ============================================================================
+ *  @file   ring_io_copy.c
+ *
+ *  @path   $(DSPLINK)/gpp/src/samples/ring_io/Linux/
+ *
+ *  @desc   Kernels copying and filling the data buffers of the RingIOs. The
+ *          buffers live in memory shared with the DSP, often mapped uncached
+ *          or write-combined, where the plain libc routines may be slow:
+ *          they read the destination lines they partially write, or store a
+ *          byte at a time. Next to them are kernels storing aligned words
+ *          and, when built for a CPU supporting them, vector kernels using
+ *          non-temporal stores. The fastest are selected at start up by
+ *          timing each on the buffer of a RingIO. Reads out of the buffers
+ *          may prefetch ahead and use streaming loads.
+ *
+ *  @ver    1.65.00.02
+ *  ============================================================================
+ *  Copyright (C) 2002-2009, Texas Instruments Incorporated -
+ *  http://www.ti.com/
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions
+ *  are met:
+ *  
+ *  *  Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *  
+ *  *  Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer in the
+ *     documentation and/or other materials provided with the distribution.
+ *  
+ *  *  Neither the name of Texas Instruments Incorporated nor the names of
+ *     its contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *  
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ *  THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ *  PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+ *  CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ *  EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ *  PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ *  OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ *  WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ *  OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ *  EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *  ============================================================================
+ */
+
+/*  ----------------------------------- OS Specific Headers           */
+#if !defined (_GNU_SOURCE)
+#define _GNU_SOURCE
+#endif /* !defined (_GNU_SOURCE) */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#if defined (__SSE2__)
+#include <emmintrin.h>
+#endif /* defined (__SSE2__) */
+#if defined (__SSE4_1__)
+#include <smmintrin.h>
+#endif /* defined (__SSE4_1__) */
+#if defined (__AVX__)
+#include <immintrin.h>
+#endif /* defined (__AVX__) */
+#if defined (__ARM_NEON) || defined (__ARM_NEON__)
+#include <arm_neon.h>
+#endif /* defined (__ARM_NEON) || defined (__ARM_NEON__) */
+
+/*  ----------------------------------- DSP/BIOS Link                 */
+#include <dsplink.h>
+
+/*  ----------------------------------- Application Header            */
+#include <ring_io.h>
+#include <ring_io_os.h>
+
+#if defined (__cplusplus)
+extern "C" {
+#endif /* defined (__cplusplus) */
+
+
+/** ============================================================================
+ *  @const  RING_IO_COPY_CALIBRATE
+ *
+ *  @desc   Number of bytes each kernel copies, and fills, while timed.
+ *  ============================================================================
+ */
+#define RING_IO_COPY_CALIBRATE      (4u * 1024u * 1024u)
+
+/** ============================================================================
+ *  @const  RING_IO_COPY_ALIGN
+ *
+ *  @desc   Alignment of the source buffer the kernels are timed with.
+ *  ============================================================================
+ */
+#define RING_IO_COPY_ALIGN          64u
+
+
+/** ============================================================================
+ *  @name   RING_IO_CopyFxn, RING_IO_FillFxn
+ *
+ *  @desc   Signatures of the copy and fill kernels.
+ *  ============================================================================
+ */
+typedef Void (*RING_IO_CopyFxn) (OUT Pvoid dst,
+                                 IN  Pvoid src,
+                                 IN  Uint32 size) ;
+typedef Void (*RING_IO_FillFxn) (OUT Pvoid dst,
+                                 IN  Uint8 value,
+                                 IN  Uint32 size) ;
+
+/** ============================================================================
+ *  @name   RING_IO_CopyKernel
+ *
+ *  @desc   A copy kernel and the matching fill kernel.
+ *
+ *  @field  name
+ *              Name printed and matched against RING_IO_COPY.
+ *  @field  copy
+ *              Copy kernel.
+ *  @field  fill
+ *              Fill kernel.
+ *  ============================================================================
+ */
+typedef struct RING_IO_CopyKernel_tag {
+	Char8 *         name;
+	RING_IO_CopyFxn copy;
+	RING_IO_FillFxn fill;
+} RING_IO_CopyKernel;
+
+
+/** ----------------------------------------------------------------------------
+ *  @func   RING_IO_CopyLibc
+ *
+ *  @desc   Copies with memcpy ().
+ *
+ *  @modif  dst
+ *  ----------------------------------------------------------------------------
+ */
+STATIC
+NORMAL_API
+Void
+RING_IO_CopyLibc (OUT Pvoid dst, IN Pvoid src, IN Uint32 size)
+{
+	memcpy (dst, src, size);
+}
+
+/** ----------------------------------------------------------------------------
+ *  @func   RING_IO_FillLibc
+ *
+ *  @desc   Fills with memset ().
+ *
+ *  @modif  dst
+ *  ----------------------------------------------------------------------------
+ */
+STATIC
+NORMAL_API
+Void
+RING_IO_FillLibc (OUT Pvoid dst, IN Uint8 value, IN Uint32 size)
+{
+	memset (dst, value, size);
+}
+
+/** ----------------------------------------------------------------------------
+ *  @func   RING_IO_CopyWide
+ *
+ *  @desc   Copies with aligned 64-bit stores, four per iteration, so that
+ *          whole lines reach a write-combining buffer together.
+ *
+ *  @modif  dst
+ *  ----------------------------------------------------------------------------
+ */
+STATIC
+NORMAL_API
+Void
+RING_IO_CopyWide (OUT Pvoid dst, IN Pvoid src, IN Uint32 size)
+{
+	Uint8 *          d = (Uint8 *) dst;
+	const Uint8 *    s = (const Uint8 *) src;
+	RING_IO_Uint64 * w;
+	RING_IO_Uint64   word [4];
+
+	while ((size > 0) && (((uintptr_t) d & 7u) != 0)) {
+		*d++ = *s++;
+		size--;
+	}
+
+	w = (RING_IO_Uint64 *) d;
+	while (size >= sizeof (word)) {
+		/* The source may be unaligned, memcpy () loads it safely */
+		memcpy (word, s, sizeof (word));
+		w [0] = word [0];
+		w [1] = word [1];
+		w [2] = word [2];
+		w [3] = word [3];
+		w += 4;
+		s += sizeof (word);
+		size -= sizeof (word);
+	}
+
+	d = (Uint8 *) w;
+	while (size > 0) {
+		*d++ = *s++;
+		size--;
+	}
+}
+
+/** ----------------------------------------------------------------------------
+ *  @func   RING_IO_FillWide
+ *
+ *  @desc   Fills with aligned 64-bit stores, four per iteration.
+ *
+ *  @modif  dst
+ *  ----------------------------------------------------------------------------
+ */
+STATIC
+NORMAL_API
+Void
+RING_IO_FillWide (OUT Pvoid dst, IN Uint8 value, IN Uint32 size)
+{
+	Uint8 *          d = (Uint8 *) dst;
+	RING_IO_Uint64 * w;
+	RING_IO_Uint64   word = value * 0x0101010101010101ull;
+
+	while ((size > 0) && (((uintptr_t) d & 7u) != 0)) {
+		*d++ = value;
+		size--;
+	}
+
+	w = (RING_IO_Uint64 *) d;
+	while (size >= (4u * sizeof (word))) {
+		w [0] = word;
+		w [1] = word;
+		w [2] = word;
+		w [3] = word;
+		w += 4;
+		size -= 4u * sizeof (word);
+	}
+
+	d = (Uint8 *) w;
+	while (size > 0) {
+		*d++ = value;
+		size--;
+	}
+}
+
+#if defined (__SSE2__)
+/** ----------------------------------------------------------------------------
+ *  @func   RING_IO_CopySse2
+ *
+ *  @desc   Copies with 128-bit non-temporal stores, bypassing the cache and
+ *          never reading the destination.
+ *
+ *  @modif  dst
+ *  ----------------------------------------------------------------------------
+ */
+STATIC
+NORMAL_API
+Void
+RING_IO_CopySse2 (OUT Pvoid dst, IN Pvoid src, IN Uint32 size)
+{
+	Uint8 *       d = (Uint8 *) dst;
+	const Uint8 * s = (const Uint8 *) src;
+	__m128i       v0;
+	__m128i       v1;
+	__m128i       v2;
+	__m128i       v3;
+
+	while ((size > 0) && (((uintptr_t) d & 15u) != 0)) {
+		*d++ = *s++;
+		size--;
+	}
+
+	while (size >= 64u) {
+		v0 = _mm_loadu_si128 ((const __m128i *) (s));
+		v1 = _mm_loadu_si128 ((const __m128i *) (s + 16));
+		v2 = _mm_loadu_si128 ((const __m128i *) (s + 32));
+		v3 = _mm_loadu_si128 ((const __m128i *) (s + 48));
+		_mm_stream_si128 ((__m128i *) (d), v0);
+		_mm_stream_si128 ((__m128i *) (d + 16), v1);
+		_mm_stream_si128 ((__m128i *) (d + 32), v2);
+		_mm_stream_si128 ((__m128i *) (d + 48), v3);
+		d += 64;
+		s += 64;
+		size -= 64u;
+	}
+
+	while (size >= 16u) {
+		v0 = _mm_loadu_si128 ((const __m128i *) s);
+		_mm_stream_si128 ((__m128i *) d, v0);
+		d += 16;
+		s += 16;
+		size -= 16u;
+	}
+
+	while (size > 0) {
+		*d++ = *s++;
+		size--;
+	}
+
+	/* Non-temporal stores are weakly ordered, drain them before returning */
+	_mm_sfence ();
+}
+
+/** ----------------------------------------------------------------------------
+ *  @func   RING_IO_FillSse2
+ *
+ *  @desc   Fills with 128-bit non-temporal stores.
+ *
+ *  @modif  dst
+ *  ----------------------------------------------------------------------------
+ */
+STATIC
+NORMAL_API
+Void
+RING_IO_FillSse2 (OUT Pvoid dst, IN Uint8 value, IN Uint32 size)
+{
+	Uint8 * d = (Uint8 *) dst;
+	__m128i v = _mm_set1_epi8 ((char) value);
+
+	while ((size > 0) && (((uintptr_t) d & 15u) != 0)) {
+		*d++ = value;
+		size--;
+	}
+
+	while (size >= 64u) {
+		_mm_stream_si128 ((__m128i *) (d), v);
+		_mm_stream_si128 ((__m128i *) (d + 16), v);
+		_mm_stream_si128 ((__m128i *) (d + 32), v);
+		_mm_stream_si128 ((__m128i *) (d + 48), v);
+		d += 64;
+		size -= 64u;
+	}
+
+	while (size >= 16u) {
+		_mm_stream_si128 ((__m128i *) d, v);
+		d += 16;
+		size -= 16u;
+	}
+
+	while (size > 0) {
+		*d++ = value;
+		size--;
+	}
+
+	_mm_sfence ();
+}
+#endif /* defined (__SSE2__) */
+
+#if defined (__AVX__)
+/** ----------------------------------------------------------------------------
+ *  @func   RING_IO_CopyAvx
+ *
+ *  @desc   Copies with 256-bit non-temporal stores.
+ *
+ *  @modif  dst
+ *  ----------------------------------------------------------------------------
+ */
+STATIC
+NORMAL_API
+Void
+RING_IO_CopyAvx (OUT Pvoid dst, IN Pvoid src, IN Uint32 size)
+{
+	Uint8 *       d = (Uint8 *) dst;
+	const Uint8 * s = (const Uint8 *) src;
+	__m256i       v0;
+	__m256i       v1;
+
+	while ((size > 0) && (((uintptr_t) d & 31u) != 0)) {
+		*d++ = *s++;
+		size--;
+	}
+
+	while (size >= 64u) {
+		v0 = _mm256_loadu_si256 ((const __m256i *) (s));
+		v1 = _mm256_loadu_si256 ((const __m256i *) (s + 32));
+		_mm256_stream_si256 ((__m256i *) (d), v0);
+		_mm256_stream_si256 ((__m256i *) (d + 32), v1);
+		d += 64;
+		s += 64;
+		size -= 64u;
+	}
+
+	while (size > 0) {
+		*d++ = *s++;
+		size--;
+	}
+
+	_mm_sfence ();
+}
+
+/** ----------------------------------------------------------------------------
+ *  @func   RING_IO_FillAvx
+ *
+ *  @desc   Fills with 256-bit non-temporal stores.
+ *
+ *  @modif  dst
+ *  ----------------------------------------------------------------------------
+ */
+STATIC
+NORMAL_API
+Void
+RING_IO_FillAvx (OUT Pvoid dst, IN Uint8 value, IN Uint32 size)
+{
+	Uint8 * d = (Uint8 *) dst;
+	__m256i v = _mm256_set1_epi8 ((char) value);
+
+	while ((size > 0) && (((uintptr_t) d & 31u) != 0)) {
+		*d++ = value;
+		size--;
+	}
+
+	while (size >= 64u) {
+		_mm256_stream_si256 ((__m256i *) (d), v);
+		_mm256_stream_si256 ((__m256i *) (d + 32), v);
+		d += 64;
+		size -= 64u;
+	}
+
+	while (size > 0) {
+		*d++ = value;
+		size--;
+	}
+
+	_mm_sfence ();
+}
+#endif /* defined (__AVX__) */
+
+#if defined (__ARM_NEON) || defined (__ARM_NEON__)
+/** ----------------------------------------------------------------------------
+ *  @func   RING_IO_CopyNeon
+ *
+ *  @desc   Copies with 128-bit NEON stores, four per iteration, filling a
+ *          line of the write buffer at a time.
+ *
+ *  @modif  dst
+ *  ----------------------------------------------------------------------------
+ */
+STATIC
+NORMAL_API
+Void
+RING_IO_CopyNeon (OUT Pvoid dst, IN Pvoid src, IN Uint32 size)
+{
+	Uint8 *       d = (Uint8 *) dst;
+	const Uint8 * s = (const Uint8 *) src;
+	uint8x16_t    v0;
+	uint8x16_t    v1;
+	uint8x16_t    v2;
+	uint8x16_t    v3;
+
+	while ((size > 0) && (((uintptr_t) d & 15u) != 0)) {
+		*d++ = *s++;
+		size--;
+	}
+
+	while (size >= 64u) {
+		v0 = vld1q_u8 (s);
+		v1 = vld1q_u8 (s + 16);
+		v2 = vld1q_u8 (s + 32);
+		v3 = vld1q_u8 (s + 48);
+		vst1q_u8 (d, v0);
+		vst1q_u8 (d + 16, v1);
+		vst1q_u8 (d + 32, v2);
+		vst1q_u8 (d + 48, v3);
+		d += 64;
+		s += 64;
+		size -= 64u;
+	}
+
+	while (size > 0) {
+		*d++ = *s++;
+		size--;
+	}
+}
+
+/** ----------------------------------------------------------------------------
+ *  @func   RING_IO_FillNeon
+ *
+ *  @desc   Fills with 128-bit NEON stores, four per iteration.
+ *
+ *  @modif  dst
+ *  ----------------------------------------------------------------------------
+ */
+STATIC
+NORMAL_API
+Void
+RING_IO_FillNeon (OUT Pvoid dst, IN Uint8 value, IN Uint32 size)
+{
+	Uint8 *    d = (Uint8 *) dst;
+	uint8x16_t v = vdupq_n_u8 (value);
+
+	while ((size > 0) && (((uintptr_t) d & 15u) != 0)) {
+		*d++ = value;
+		size--;
+	}
+
+	while (size >= 64u) {
+		vst1q_u8 (d, v);
+		vst1q_u8 (d + 16, v);
+		vst1q_u8 (d + 32, v);
+		vst1q_u8 (d + 48, v);
+		d += 64;
+		size -= 64u;
+	}
+
+	while (size > 0) {
+		*d++ = value;
+		size--;
+	}
+}
+#endif /* defined (__ARM_NEON) || defined (__ARM_NEON__) */
+
+
+/** ============================================================================
+ *  @name   RING_IO_CopyKernels
+ *
+ *  @desc   Kernels built for the CPU, libc first.
+ *  ============================================================================
+ */
+STATIC RING_IO_CopyKernel RING_IO_CopyKernels [] = {
+	{ "libc", RING_IO_CopyLibc, RING_IO_FillLibc },
+	{ "wide", RING_IO_CopyWide, RING_IO_FillWide },
+#if defined (__SSE2__)
+	{ "sse2", RING_IO_CopySse2, RING_IO_FillSse2 },
+#endif /* defined (__SSE2__) */
+#if defined (__AVX__)
+	{ "avx",  RING_IO_CopyAvx,  RING_IO_FillAvx  },
+#endif /* defined (__AVX__) */
+#if defined (__ARM_NEON) || defined (__ARM_NEON__)
+	{ "neon", RING_IO_CopyNeon, RING_IO_FillNeon },
+#endif /* defined (__ARM_NEON) || defined (__ARM_NEON__) */
+};
+
+#define RING_IO_COPY_NUM_KERNELS    \
+		(sizeof (RING_IO_CopyKernels) / sizeof (RING_IO_CopyKernels [0]))
+
+/** ============================================================================
+ *  @name   RING_IO_CopyCur, RING_IO_FillCur
+ *
+ *  @desc   Selected kernels. Selected before the clients are started, so
+ *          client processes inherit them.
+ *  ============================================================================
+ */
+STATIC RING_IO_CopyKernel * RING_IO_CopyCur = &RING_IO_CopyKernels [0];
+STATIC RING_IO_CopyKernel * RING_IO_FillCur = &RING_IO_CopyKernels [0];
+
+
+/** ----------------------------------------------------------------------------
+ *  @func   RING_IO_CopyTime
+ *
+ *  @desc   Times a copy, or a fill when src is NULL, of the region repeated
+ *          until RING_IO_COPY_CALIBRATE bytes are written.
+ *
+ *  @modif  region
+ *  ----------------------------------------------------------------------------
+ */
+STATIC
+NORMAL_API
+RING_IO_Uint64
+RING_IO_CopyTime (IN RING_IO_CopyKernel * kernel,
+		IN Pvoid region,
+		IN Pvoid src,
+		IN Uint32 size)
+{
+	RING_IO_Uint64 start;
+	Uint32         reps;
+	Uint32         i;
+
+	reps = RING_IO_COPY_CALIBRATE / size;
+	if (reps == 0) {
+		reps = 1;
+	}
+
+	/* A first untimed pass faults in the pages and warms the TLB */
+	if (src != NULL) {
+		kernel->copy (region, src, size);
+	}
+	else {
+		kernel->fill (region, 0, size);
+	}
+
+	start = RING_IO_GetTimeUsec ();
+	for (i = 0; i < reps; i++) {
+		if (src != NULL) {
+			kernel->copy (region, src, size);
+		}
+		else {
+			kernel->fill (region, (Uint8) i, size);
+		}
+	}
+
+	return (RING_IO_GetTimeUsec () - start);
+}
+
+
+/** ============================================================================
+ *  @func   RING_IO_CopySelect
+ *
+ *  @desc   Selects the fastest copy and fill kernels on the region.
+ *
+ *  @modif  RING_IO_CopyCur, RING_IO_FillCur
+ *  ============================================================================
+ */
+NORMAL_API
+DSP_STATUS
+RING_IO_CopySelect (IN Pvoid region, IN Uint32 size)
+{
+	DSP_STATUS     status = DSP_SOK;
+	Char8 *        name;
+	Pvoid          src = NULL;
+	RING_IO_Uint64 copyBest = 0;
+	RING_IO_Uint64 fillBest = 0;
+	RING_IO_Uint64 usec;
+	Uint32         i;
+
+	name = getenv ("RING_IO_COPY");
+	if ((name != NULL) && (name [0] == '\0')) {
+		name = NULL;
+	}
+	if (name != NULL) {
+		i = 0;
+		while (   (i < RING_IO_COPY_NUM_KERNELS)
+			   && (strcmp (name, RING_IO_CopyKernels [i].name) != 0)) {
+			i++;
+		}
+		if (i < RING_IO_COPY_NUM_KERNELS) {
+			RING_IO_CopyCur = &RING_IO_CopyKernels [i];
+			RING_IO_FillCur = &RING_IO_CopyKernels [i];
+		}
+		else {
+			RING_IO_0Print ("Unknown RING_IO_COPY kernel, timing them\n");
+			name = NULL;
+		}
+	}
+
+	if ((name == NULL) && (region != NULL) && (size != 0)) {
+		if (posix_memalign (&src, RING_IO_COPY_ALIGN, size) != 0) {
+			src = NULL;
+			status = DSP_EMEMORY;
+		}
+		else {
+			memset (src, 0x5a, size);
+			for (i = 0; i < RING_IO_COPY_NUM_KERNELS; i++) {
+				usec = RING_IO_CopyTime (&RING_IO_CopyKernels [i],
+						region, src, size);
+				if ((i == 0) || (usec < copyBest)) {
+					copyBest = usec;
+					RING_IO_CopyCur = &RING_IO_CopyKernels [i];
+				}
+
+				usec = RING_IO_CopyTime (&RING_IO_CopyKernels [i],
+						region, NULL, size);
+				if ((i == 0) || (usec < fillBest)) {
+					fillBest = usec;
+					RING_IO_FillCur = &RING_IO_CopyKernels [i];
+				}
+			}
+			free (src);
+		}
+	}
+
+	RING_IO_0Print ("Copy kernel : ");
+	RING_IO_0Print (RING_IO_CopyCur->name);
+	RING_IO_0Print (", fill kernel : ");
+	RING_IO_0Print (RING_IO_FillCur->name);
+	RING_IO_0Print ("\n");
+
+	return (status);
+}
+
+/** ============================================================================
+ *  @func   RING_IO_Copy
+ *
+ *  @desc   Copies with the selected kernel.
+ *
+ *  @modif  dst
+ *  ============================================================================
+ */
+NORMAL_API
+Void
+RING_IO_Copy (OUT Pvoid dst, IN Pvoid src, IN Uint32 size)
+{
+	RING_IO_CopyCur->copy (dst, src, size);
+}
+
+/** ============================================================================
+ *  @func   RING_IO_Fill
+ *
+ *  @desc   Fills with the selected kernel.
+ *
+ *  @modif  dst
+ *  ============================================================================
+ */
+NORMAL_API
+Void
+RING_IO_Fill (OUT Pvoid dst, IN Uint8 value, IN Uint32 size)
+{
+	RING_IO_FillCur->fill (dst, value, size);
+}
+
+/** ============================================================================
+ *  @func   RING_IO_CopyOut
+ *
+ *  @desc   Copies out of shared memory, with streaming loads if available.
+ *
+ *  @modif  dst
+ *  ============================================================================
+ */
+NORMAL_API
+Void
+RING_IO_CopyOut (OUT Pvoid dst, IN Pvoid src, IN Uint32 size)
+{
+#if defined (__SSE4_1__)
+	Uint8 *       d = (Uint8 *) dst;
+	const Uint8 * s = (const Uint8 *) src;
+	__m128i       v0;
+	__m128i       v1;
+	__m128i       v2;
+	__m128i       v3;
+
+	/* Streaming loads need an aligned source, the stores take any */
+	while ((size > 0) && (((uintptr_t) s & 15u) != 0)) {
+		*d++ = *s++;
+		size--;
+	}
+
+	while (size >= 64u) {
+		v0 = _mm_stream_load_si128 ((__m128i *) (s));
+		v1 = _mm_stream_load_si128 ((__m128i *) (s + 16));
+		v2 = _mm_stream_load_si128 ((__m128i *) (s + 32));
+		v3 = _mm_stream_load_si128 ((__m128i *) (s + 48));
+		_mm_storeu_si128 ((__m128i *) (d), v0);
+		_mm_storeu_si128 ((__m128i *) (d + 16), v1);
+		_mm_storeu_si128 ((__m128i *) (d + 32), v2);
+		_mm_storeu_si128 ((__m128i *) (d + 48), v3);
+		d += 64;
+		s += 64;
+		size -= 64u;
+	}
+
+	while (size > 0) {
+		*d++ = *s++;
+		size--;
+	}
+#else /* if defined (__SSE4_1__) */
+	memcpy (dst, src, size);
+#endif /* if defined (__SSE4_1__) */
+}
+
+/** ============================================================================
+ *  @func   RING_IO_Prefetch
+ *
+ *  @desc   Prefetches a region for reading.
+ *
+ *  @modif  None
+ *  ============================================================================
+ */
+NORMAL_API
+Void
+RING_IO_Prefetch (IN Pvoid addr, IN Uint32 size)
+{
+#if defined (__GNUC__)
+	const Uint8 * p = (const Uint8 *) addr;
+	const Uint8 * end = p + size;
+
+	/* The data is read once, do not keep it in the outer caches */
+	p = (const Uint8 *) ((uintptr_t) p
+			& ~((uintptr_t) RING_IO_CACHE_LINE - 1u));
+	while (p < end) {
+		__builtin_prefetch (p, 0, 0);
+		p += RING_IO_CACHE_LINE;
+	}
+#else /* if defined (__GNUC__) */
+	(Void) addr;
+	(Void) size;
+#endif /* if defined (__GNUC__) */
+}
+
+
+#if defined (__cplusplus)
+}
+#endif /* defined (__cplusplus) */
@@ -0,0 +1,1103 @@
+/** ============================================================================
+ *  @file   ring_io_daemon.c
+ *
+ *  @path   $(DSPLINK)/gpp/src/samples/ring_io/Linux/
+ *
+ *  @desc   Implementation of the daemon mode of the ring_io application and
+ *          of its example client.
+ *          The calling thread accepts clients and feeds their requests into
+ *          the writer RingIO. A second thread drains the reader RingIO and
+ *          completes the requests in order. Both share the request queue
+ *          under a mutex.
+ *
+ *  @ver    1.65.00.02
+ *  ============================================================================
+ *  Copyright (C) 2002-2009, Texas Instruments Incorporated -
+ *  http://www.ti.com/
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions
+ *  are met:
+ *  
+ *  *  Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *  
+ *  *  Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer in the
+ *     documentation and/or other materials provided with the distribution.
+ *  
+ *  *  Neither the name of Texas Instruments Incorporated nor the names of
+ *     its contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *  
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ *  THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ *  PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+ *  CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ *  EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ *  PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ *  OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ *  WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ *  OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ *  EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *  ============================================================================
+ */
+
+/*  ----------------------------------- OS Specific Headers           */
+#if !defined (_GNU_SOURCE)
+#define _GNU_SOURCE
+#endif /* !defined (_GNU_SOURCE) */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <fcntl.h>
+#include <errno.h>
+#include <signal.h>
+#include <poll.h>
+#include <pthread.h>
+#include <sys/types.h>
+#include <sys/mman.h>
+#include <sys/socket.h>
+#include <sys/syscall.h>
+#include <sys/un.h>
+
+/*  ----------------------------------- DSP/BIOS Link                 */
+#include <dsplink.h>
+
+/*  ----------------------------------- DSP/BIOS LINK API             */
+#include <ringio.h>
+
+/*  ----------------------------------- Application Header            */
+#include <ring_io.h>
+#include <ring_io_os.h>
+#include <ring_io_chnl.h>
+#include <ring_io_coalesce.h>
+#include <ring_io_notify.h>
+#include <ring_io_daemon.h>
+
+#if defined (__cplusplus)
+extern "C" {
+#endif /* defined (__cplusplus) */
+
+
+/** ============================================================================
+ *  @name   RING_IO_DaemonConn
+ *
+ *  @desc   State of a connected client.
+ *
+ *  @field  fd
+ *              Socket of the client, -1 once disconnected.
+ *  @field  memFd
+ *              File descriptor of the staging area, -1 when unused.
+ *  @field  staging
+ *              Mapping of the staging area.
+ *  @field  pending
+ *              Number of requests of the client not yet completed. The
+ *              staging area is kept mapped until it drops to zero.
+ *  ============================================================================
+ */
+typedef struct RING_IO_DaemonConn_tag {
+	int      fd;
+	int      memFd;
+	Uint8 *  staging;
+	Uint32   pending;
+} RING_IO_DaemonConn;
+
+/** ============================================================================
+ *  @name   RING_IO_DaemonReq
+ *
+ *  @desc   A request in flight.
+ *
+ *  @field  conn
+ *              Client of the request.
+ *  @field  id
+ *              Identifier chosen by the client.
+ *  @field  inOffset
+ *              Offset of the input data in the staging area.
+ *  @field  outOffset
+ *              Offset of the output data in the staging area.
+ *  @field  size
+ *              Size of the request.
+ *  @field  received
+ *              Number of bytes received from the DSP.
+ *  ============================================================================
+ */
+typedef struct RING_IO_DaemonReq_tag {
+	RING_IO_DaemonConn *  conn;
+	Uint32                id;
+	Uint32                inOffset;
+	Uint32                outOffset;
+	Uint32                size;
+	Uint32                received;
+} RING_IO_DaemonReq;
+
+/** ============================================================================
+ *  @name   RING_IO_DaemonObj
+ *
+ *  @desc   State of the daemon.
+ *          The requests form a ring: [reqHead, reqWrite) have been written
+ *          (partially for the last one) and wait for the DSP,
+ *          [reqWrite, reqTail) wait to be written.
+ *
+ *  @field  chnl
+ *              Channel used for the requests.
+ *  @field  listenFd
+ *              Listening socket.
+ *  @field  lock
+ *              Protects the requests and the connections.
+ *  @field  conns
+ *              Connections.
+ *  @field  reqs
+ *              Ring of requests.
+ *  @field  reqHead
+ *              Oldest request, the next to complete.
+ *  @field  reqWrite
+ *              Next request to be written to the DSP.
+ *  @field  reqTail
+ *              Next free entry.
+ *  @field  numReqs
+ *              Number of requests in the ring.
+ *  @field  numDone
+ *              Number of completed requests.
+ *  @field  numDropped
+ *              Number of bytes received from the DSP with no request.
+ *  @field  rcvBytes
+ *              Number of bytes received from the DSP.
+ *  @field  coalesce
+ *              Coalescer gathering the requests into batches.
+ *  @field  sigMask
+ *              Signal mask to be used while waiting for clients.
+ *  ============================================================================
+ */
+typedef struct RING_IO_DaemonObj_tag {
+	RING_IO_ChnlObj *    chnl;
+	int                  listenFd;
+	pthread_mutex_t      lock;
+	RING_IO_DaemonConn   conns [RING_IO_DAEMON_MAX_CONNS];
+	RING_IO_DaemonReq    reqs [RING_IO_DAEMON_MAX_REQS];
+	Uint32               reqHead;
+	Uint32               reqWrite;
+	Uint32               reqTail;
+	Uint32               numReqs;
+	RING_IO_Uint64       numDone;
+	RING_IO_Uint64       numDropped;
+	RING_IO_Uint64       rcvBytes;
+	RING_IO_CoalesceObj  coalesce;
+	sigset_t             sigMask;
+} RING_IO_DaemonObj;
+
+/** ============================================================================
+ *  @name   RING_IO_Daemon
+ *
+ *  @desc   The daemon.
+ *  ============================================================================
+ */
+STATIC RING_IO_DaemonObj RING_IO_Daemon;
+
+/** ============================================================================
+ *  @name   RING_IO_DaemonStop
+ *
+ *  @desc   Set by the signal handler to stop the daemon.
+ *  ============================================================================
+ */
+STATIC volatile sig_atomic_t RING_IO_DaemonStop = 0;
+
+
+/** ----------------------------------------------------------------------------
+ *  @func   RING_IO_DaemonSignal
+ *
+ *  @desc   Handler of SIGINT and SIGTERM.
+ *
+ *  @modif  RING_IO_DaemonStop
+ *  ----------------------------------------------------------------------------
+ */
+STATIC
+Void
+RING_IO_DaemonSignal (int sig)
+{
+	(Void) sig;
+	RING_IO_DaemonStop = 1;
+}
+
+/** ----------------------------------------------------------------------------
+ *  @func   RING_IO_DaemonSend
+ *
+ *  @desc   Sends a message, optionally with a file descriptor.
+ *
+ *  @modif  None
+ *  ----------------------------------------------------------------------------
+ */
+STATIC
+NORMAL_API
+DSP_STATUS
+RING_IO_DaemonSend (IN int fd, IN RING_IO_DaemonMsg * msg, IN int passFd)
+{
+	DSP_STATUS status = DSP_SOK;
+	struct msghdr hdr;
+	struct iovec iov;
+	struct cmsghdr * cmsg;
+	union {
+		struct cmsghdr align;
+		char buf [CMSG_SPACE (sizeof (int))];
+	} control;
+
+	memset (&hdr, 0, sizeof (hdr));
+	iov.iov_base = msg;
+	iov.iov_len = sizeof (RING_IO_DaemonMsg);
+	hdr.msg_iov = &iov;
+	hdr.msg_iovlen = 1;
+
+	if (passFd >= 0) {
+		memset (&control, 0, sizeof (control));
+		hdr.msg_control = control.buf;
+		hdr.msg_controllen = sizeof (control.buf);
+		cmsg = CMSG_FIRSTHDR (&hdr);
+		cmsg->cmsg_level = SOL_SOCKET;
+		cmsg->cmsg_type = SCM_RIGHTS;
+		cmsg->cmsg_len = CMSG_LEN (sizeof (int));
+		memcpy (CMSG_DATA (cmsg), &passFd, sizeof (int));
+	}
+
+	while (sendmsg (fd, &hdr, MSG_NOSIGNAL) < 0) {
+		if (errno != EINTR) {
+			status = DSP_EFAIL;
+			break;
+		}
+	}
+
+	return (status);
+}
+
+/** ----------------------------------------------------------------------------
+ *  @func   RING_IO_DaemonRecv
+ *
+ *  @desc   Receives a message, optionally with a file descriptor.
+ *
+ *  @modif  None
+ *  ----------------------------------------------------------------------------
+ */
+STATIC
+NORMAL_API
+DSP_STATUS
+RING_IO_DaemonRecv (IN int fd, OUT RING_IO_DaemonMsg * msg, OUT int * passFd)
+{
+	DSP_STATUS status = DSP_SOK;
+	struct msghdr hdr;
+	struct iovec iov;
+	struct cmsghdr * cmsg;
+	ssize_t size;
+	union {
+		struct cmsghdr align;
+		char buf [CMSG_SPACE (sizeof (int))];
+	} control;
+
+	memset (&hdr, 0, sizeof (hdr));
+	iov.iov_base = msg;
+	iov.iov_len = sizeof (RING_IO_DaemonMsg);
+	hdr.msg_iov = &iov;
+	hdr.msg_iovlen = 1;
+	hdr.msg_control = control.buf;
+	hdr.msg_controllen = sizeof (control.buf);
+
+	do {
+		size = recvmsg (fd, &hdr, MSG_CMSG_CLOEXEC);
+	} while ((size < 0) && (errno == EINTR));
+
+	if (size != (ssize_t) sizeof (RING_IO_DaemonMsg)) {
+		/* Disconnected, failed or malformed */
+		status = DSP_EFAIL;
+	}
+
+	if (passFd != NULL) {
+		*passFd = -1;
+		cmsg = CMSG_FIRSTHDR (&hdr);
+		if (   DSP_SUCCEEDED (status)
+			&& (cmsg != NULL)
+			&& (cmsg->cmsg_level == SOL_SOCKET)
+			&& (cmsg->cmsg_type == SCM_RIGHTS)) {
+			memcpy (passFd, CMSG_DATA (cmsg), sizeof (int));
+		}
+	}
+
+	return (status);
+}
+
+/** ----------------------------------------------------------------------------
+ *  @func   RING_IO_DaemonRelease
+ *
+ *  @desc   Frees the staging area of a disconnected client once it has no
+ *          request in flight. Called with the lock held.
+ *
+ *  @modif  conn
+ *  ----------------------------------------------------------------------------
+ */
+STATIC
+NORMAL_API
+Void
+RING_IO_DaemonRelease (IN RING_IO_DaemonConn * conn)
+{
+	if ((conn->fd < 0) && (conn->pending == 0) && (conn->memFd >= 0)) {
+		munmap (conn->staging, RING_IO_DAEMON_STAGING_SIZE);
+		close (conn->memFd);
+		conn->staging = NULL;
+		conn->memFd = -1;
+	}
+}
+
+/** ----------------------------------------------------------------------------
+ *  @func   RING_IO_DaemonAccept
+ *
+ *  @desc   Accepts a client and hands it a new staging area.
+ *
+ *  @modif  conns of the daemon.
+ *  ----------------------------------------------------------------------------
+ */
+STATIC
+NORMAL_API
+Void
+RING_IO_DaemonAccept (IN RING_IO_DaemonObj * daemon)
+{
+	RING_IO_DaemonConn * conn = NULL;
+	RING_IO_DaemonMsg msg;
+	void * staging = MAP_FAILED;
+	int memFd = -1;
+	int fd;
+	Uint32 i;
+
+	fd = accept4 (daemon->listenFd, NULL, NULL, SOCK_CLOEXEC);
+	if (fd < 0) {
+		return;
+	}
+
+	pthread_mutex_lock (&daemon->lock);
+	for (i = 0; (i < RING_IO_DAEMON_MAX_CONNS) && (conn == NULL); i++) {
+		if (   (daemon->conns [i].fd < 0)
+			&& (daemon->conns [i].memFd < 0)) {
+			conn = &daemon->conns [i];
+		}
+	}
+	pthread_mutex_unlock (&daemon->lock);
+
+#if defined (__NR_memfd_create)
+	if (conn != NULL) {
+		memFd = (int) syscall (__NR_memfd_create, "ring_io", 1 /* CLOEXEC */);
+	}
+#endif /* defined (__NR_memfd_create) */
+	if (   (memFd >= 0)
+		&& (ftruncate (memFd, RING_IO_DAEMON_STAGING_SIZE) == 0)) {
+		staging = mmap (NULL,
+				RING_IO_DAEMON_STAGING_SIZE,
+				PROT_READ | PROT_WRITE,
+				MAP_SHARED,
+				memFd,
+				0);
+	}
+
+	memset (&msg, 0, sizeof (msg));
+	msg.cmd = RING_IO_DAEMON_CMD_HELLO;
+	msg.size = RING_IO_DAEMON_STAGING_SIZE;
+	msg.status = (staging != MAP_FAILED) ? DSP_SOK : DSP_EMEMORY;
+	if (   DSP_SUCCEEDED (RING_IO_DaemonSend (fd, &msg, memFd))
+		&& (staging != MAP_FAILED)) {
+		pthread_mutex_lock (&daemon->lock);
+		conn->memFd = memFd;
+		conn->staging = (Uint8 *) staging;
+		conn->pending = 0;
+		conn->fd = fd;
+		pthread_mutex_unlock (&daemon->lock);
+	}
+	else {
+		RING_IO_0Print ("RING_IO_Daemon: client rejected\n");
+		if (staging != MAP_FAILED) {
+			munmap (staging, RING_IO_DAEMON_STAGING_SIZE);
+		}
+		if (memFd >= 0) {
+			close (memFd);
+		}
+		close (fd);
+	}
+}
+
+/** ----------------------------------------------------------------------------
+ *  @func   RING_IO_DaemonHandle
+ *
+ *  @desc   Handles a message from a client.
+ *
+ *  @modif  reqs of the daemon.
+ *  ----------------------------------------------------------------------------
+ */
+STATIC
+NORMAL_API
+Void
+RING_IO_DaemonHandle (IN RING_IO_DaemonObj * daemon,
+		IN RING_IO_DaemonConn * conn)
+{
+	RING_IO_DaemonMsg msg;
+	RING_IO_DaemonReq * req;
+	Bool valid;
+
+	if (DSP_FAILED (RING_IO_DaemonRecv (conn->fd, &msg, NULL))) {
+		pthread_mutex_lock (&daemon->lock);
+		close (conn->fd);
+		conn->fd = -1;
+		RING_IO_DaemonRelease (conn);
+		pthread_mutex_unlock (&daemon->lock);
+		return;
+	}
+
+	valid = (   (msg.cmd == RING_IO_DAEMON_CMD_SUBMIT)
+			 && (msg.size > 0)
+			 && (msg.size <= RING_IO_DAEMON_STAGING_SIZE)
+			 && (msg.inOffset <= RING_IO_DAEMON_STAGING_SIZE - msg.size)
+			 && (msg.outOffset <= RING_IO_DAEMON_STAGING_SIZE - msg.size));
+
+	if (valid == FALSE) {
+		msg.cmd = RING_IO_DAEMON_CMD_DONE;
+		msg.status = DSP_EINVALIDARG;
+		RING_IO_DaemonSend (conn->fd, &msg, -1);
+	}
+	else {
+		pthread_mutex_lock (&daemon->lock);
+		req = &daemon->reqs [daemon->reqTail];
+		req->conn = conn;
+		req->id = msg.id;
+		req->inOffset = msg.inOffset;
+		req->outOffset = msg.outOffset;
+		req->size = msg.size;
+		req->received = 0;
+		conn->pending++;
+		daemon->reqTail = (daemon->reqTail + 1) % RING_IO_DAEMON_MAX_REQS;
+		daemon->numReqs++;
+		pthread_mutex_unlock (&daemon->lock);
+	}
+}
+
+/** ----------------------------------------------------------------------------
+ *  @func   RING_IO_DaemonPoll
+ *
+ *  @desc   Waits for new clients and requests, at most timeout microseconds
+ *          unless timeout is negative. While the request ring is full only
+ *          a short delay is taken instead.
+ *
+ *  @modif  None
+ *  ----------------------------------------------------------------------------
+ */
+STATIC
+NORMAL_API
+Void
+RING_IO_DaemonPoll (IN RING_IO_DaemonObj * daemon, IN Int32 timeout)
+{
+	struct timespec ts;
+	struct pollfd fds [RING_IO_DAEMON_MAX_CONNS + 1];
+	RING_IO_DaemonConn * conns [RING_IO_DAEMON_MAX_CONNS + 1];
+	Uint32 numFds = 0;
+	Bool full;
+	Uint32 i;
+
+	pthread_mutex_lock (&daemon->lock);
+	full = (daemon->numReqs == RING_IO_DAEMON_MAX_REQS) ? TRUE : FALSE;
+	fds [numFds].fd = daemon->listenFd;
+	fds [numFds].events = POLLIN;
+	conns [numFds++] = NULL;
+	for (i = 0; (i < RING_IO_DAEMON_MAX_CONNS) && (full == FALSE); i++) {
+		if (daemon->conns [i].fd >= 0) {
+			fds [numFds].fd = daemon->conns [i].fd;
+			fds [numFds].events = POLLIN;
+			conns [numFds++] = &daemon->conns [i];
+		}
+	}
+	pthread_mutex_unlock (&daemon->lock);
+
+	ts.tv_sec = timeout / 1000000;
+	ts.tv_nsec = (timeout % 1000000) * 1000;
+
+	if (full == TRUE) {
+		/* Let the DSP complete requests before reading clients again */
+		RING_IO_Sleep (1000);
+	}
+	/* SIGINT and SIGTERM are only delivered while waiting here */
+	else if (ppoll (fds,
+				numFds,
+				(timeout < 0) ? NULL : &ts,
+				&daemon->sigMask) > 0) {
+		for (i = 0; i < numFds; i++) {
+			if (fds [i].revents == 0) {
+				continue;
+			}
+			if (conns [i] == NULL) {
+				RING_IO_DaemonAccept (daemon);
+			}
+			else if (daemon->numReqs < RING_IO_DAEMON_MAX_REQS) {
+				RING_IO_DaemonHandle (daemon, conns [i]);
+			}
+		}
+	}
+}
+
+/** ----------------------------------------------------------------------------
+ *  @func   RING_IO_DaemonWrite
+ *
+ *  @desc   Writer loop of the daemon: hands the queued requests to the
+ *          coalescer until the daemon is stopped and the queue is written.
+ *          Like Nagle's algorithm, the pending batch is flushed at once when
+ *          the DSP has returned everything sent before, and waits for more
+ *          requests until its threshold or deadline otherwise.
+ *
+ *  @modif  reqs of the daemon.
+ *  ----------------------------------------------------------------------------
+ */
+STATIC
+NORMAL_API
+DSP_STATUS
+RING_IO_DaemonWrite (IN RING_IO_DaemonObj * daemon)
+{
+	DSP_STATUS status = DSP_SOK;
+	RING_IO_CoalesceObj * coalesce = &daemon->coalesce;
+	RING_IO_DaemonReq * req;
+	Bool idle;
+	Bool done = FALSE;
+	Int32 timeout;
+
+	while (DSP_SUCCEEDED (status) && (done == FALSE)) {
+		req = NULL;
+		pthread_mutex_lock (&daemon->lock);
+		if (daemon->reqWrite != daemon->reqTail) {
+			req = &daemon->reqs [daemon->reqWrite];
+			daemon->reqWrite = (daemon->reqWrite + 1)
+					% RING_IO_DAEMON_MAX_REQS;
+		}
+		idle = (daemon->rcvBytes == coalesce->stats.bytes) ? TRUE : FALSE;
+		pthread_mutex_unlock (&daemon->lock);
+
+		if (req != NULL) {
+			/* The staging area stays mapped until the request completes */
+			status = RING_IO_CoalesceWrite (coalesce,
+					req->conn->staging + req->inOffset,
+					req->size);
+		}
+		else if (RING_IO_DaemonStop != 0) {
+			status = RING_IO_CoalesceFlush (coalesce);
+			done = TRUE;
+		}
+		else if ((idle == TRUE) && (coalesce->numRecords > 0)) {
+			status = RING_IO_CoalesceFlush (coalesce);
+		}
+		else {
+			/* Wait for requests, no longer than the pending batch may */
+			status = RING_IO_CoalescePoll (coalesce, &timeout);
+			if (DSP_SUCCEEDED (status)) {
+				RING_IO_DaemonPoll (daemon, timeout);
+			}
+		}
+	}
+
+	return (status);
+}
+
+/** ----------------------------------------------------------------------------
+ *  @func   RING_IO_DaemonComplete
+ *
+ *  @desc   Copies the received data into the staging areas of the oldest
+ *          requests and completes them. Called with the lock taken.
+ *
+ *  @modif  reqs of the daemon.
+ *  ----------------------------------------------------------------------------
+ */
+STATIC
+NORMAL_API
+Void
+RING_IO_DaemonComplete (IN RING_IO_DaemonObj * daemon,
+		IN Uint8 * data,
+		IN Uint32 size)
+{
+	RING_IO_DaemonReq * req;
+	RING_IO_DaemonMsg msg;
+	Uint32 copySize;
+
+	daemon->rcvBytes += size;
+	while ((size > 0) && (daemon->numReqs > 0)) {
+		req = &daemon->reqs [daemon->reqHead];
+		copySize = req->size - req->received;
+		if (copySize > size) {
+			copySize = size;
+		}
+		memcpy (req->conn->staging + req->outOffset + req->received,
+				data,
+				copySize);
+		req->received += copySize;
+		data += copySize;
+		size -= copySize;
+
+		if (req->received == req->size) {
+			if (req->conn->fd >= 0) {
+				memset (&msg, 0, sizeof (msg));
+				msg.cmd = RING_IO_DAEMON_CMD_DONE;
+				msg.id = req->id;
+				msg.inOffset = req->inOffset;
+				msg.outOffset = req->outOffset;
+				msg.size = req->size;
+				msg.status = DSP_SOK;
+				RING_IO_DaemonSend (req->conn->fd, &msg, -1);
+			}
+			req->conn->pending--;
+			RING_IO_DaemonRelease (req->conn);
+			daemon->reqHead = (daemon->reqHead + 1) % RING_IO_DAEMON_MAX_REQS;
+			daemon->numReqs--;
+			daemon->numDone++;
+		}
+	}
+	daemon->numDropped += size;
+}
+
+/** ----------------------------------------------------------------------------
+ *  @func   RING_IO_DaemonDrain
+ *
+ *  @desc   Drain function of the daemon: completes the requests with the
+ *          received data.
+ *
+ *  @modif  None
+ *  ----------------------------------------------------------------------------
+ */
+STATIC
+NORMAL_API
+DSP_STATUS
+RING_IO_DaemonDrain (IN Pvoid arg,
+		IN RingIO_BufPtr buffer,
+		IN Uint32 size)
+{
+	RING_IO_DaemonObj * daemon = (RING_IO_DaemonObj *) arg;
+
+	pthread_mutex_lock (&daemon->lock);
+	RING_IO_DaemonComplete (daemon, (Uint8 *) buffer, size);
+	pthread_mutex_unlock (&daemon->lock);
+
+	return (DSP_SOK);
+}
+
+/** ----------------------------------------------------------------------------
+ *  @func   RING_IO_DaemonDrainInline
+ *
+ *  @desc   Inline handler of the daemon, run in the reader notification:
+ *          completes the requests with the received data unless the lock is
+ *          held by the writer, in which case the data is queued to the
+ *          reader thread.
+ *
+ *  @modif  None
+ *  ----------------------------------------------------------------------------
+ */
+STATIC
+NORMAL_API
+DSP_STATUS
+RING_IO_DaemonDrainInline (IN Pvoid arg,
+		IN RingIO_BufPtr buffer,
+		IN Uint32 size)
+{
+	DSP_STATUS status = DSP_SOK;
+	RING_IO_DaemonObj * daemon = (RING_IO_DaemonObj *) arg;
+
+	if (pthread_mutex_trylock (&daemon->lock) == 0) {
+		RING_IO_DaemonComplete (daemon, (Uint8 *) buffer, size);
+		pthread_mutex_unlock (&daemon->lock);
+	}
+	else {
+		status = DSP_ETIMEOUT;
+	}
+
+	return (status);
+}
+
+/** ----------------------------------------------------------------------------
+ *  @func   RING_IO_DaemonReader
+ *
+ *  @desc   Reader thread of the daemon.
+ *
+ *  @modif  None
+ *  ----------------------------------------------------------------------------
+ */
+STATIC
+Void *
+RING_IO_DaemonReader (IN Void * ptr)
+{
+	RING_IO_DaemonObj * daemon = (RING_IO_DaemonObj *) ptr;
+	DSP_STATUS status;
+
+	status = RING_IO_ChnlRead (daemon->chnl,
+			&RING_IO_DaemonDrain,
+			daemon,
+			NULL);
+	if (DSP_FAILED (status)) {
+		RING_IO_1Print ("RING_IO_ChnlRead () failed. Status = [0x%x]\n",
+				status);
+	}
+	RING_IO_ChnlSeqReport (daemon->chnl);
+	RING_IO_ChnlInlineReport (daemon->chnl);
+
+	return (NULL);
+}
+
+/** ----------------------------------------------------------------------------
+ *  @func   RING_IO_DaemonListen
+ *
+ *  @desc   Creates the listening socket.
+ *
+ *  @modif  listenFd of the daemon.
+ *  ----------------------------------------------------------------------------
+ */
+STATIC
+NORMAL_API
+DSP_STATUS
+RING_IO_DaemonListen (IN RING_IO_DaemonObj * daemon, IN Char8 * socketPath)
+{
+	DSP_STATUS status = DSP_SOK;
+	struct sockaddr_un addr;
+
+	if (strlen (socketPath) >= sizeof (addr.sun_path)) {
+		return (DSP_EINVALIDARG);
+	}
+
+	memset (&addr, 0, sizeof (addr));
+	addr.sun_family = AF_UNIX;
+	strcpy (addr.sun_path, socketPath);
+
+	daemon->listenFd = socket (AF_UNIX, SOCK_SEQPACKET | SOCK_CLOEXEC, 0);
+	if (daemon->listenFd < 0) {
+		status = DSP_EFAIL;
+	}
+	else {
+		unlink (socketPath);
+		if (   (bind (daemon->listenFd,
+					  (struct sockaddr *) &addr,
+					  sizeof (addr)) < 0)
+			|| (listen (daemon->listenFd, RING_IO_DAEMON_MAX_CONNS) < 0)) {
+			close (daemon->listenFd);
+			daemon->listenFd = -1;
+			status = DSP_EFAIL;
+		}
+	}
+
+	return (status);
+}
+
+/** ============================================================================
+ *  @func   RING_IO_DaemonRun
+ *
+ *  @desc   Serves local clients until SIGINT or SIGTERM is received.
+ *
+ *  @modif  None
+ *  ============================================================================
+ */
+NORMAL_API
+DSP_STATUS
+RING_IO_DaemonRun (IN RING_IO_ChnlObj * chnls,
+		IN Uint32 chnlId,
+		IN Char8 * socketPath)
+{
+	DSP_STATUS status = DSP_SOK;
+	DSP_STATUS tmpStatus = DSP_SOK;
+	RING_IO_DaemonObj * daemon = &RING_IO_Daemon;
+	struct sigaction action;
+	sigset_t blocked;
+	pthread_t reader;
+	Bool readerStarted = FALSE;
+	Uint32 i;
+
+	memset (daemon, 0, sizeof (RING_IO_DaemonObj));
+	daemon->chnl = &chnls [chnlId];
+	daemon->listenFd = -1;
+	for (i = 0; i < RING_IO_DAEMON_MAX_CONNS; i++) {
+		daemon->conns [i].fd = -1;
+		daemon->conns [i].memFd = -1;
+	}
+	pthread_mutex_init (&daemon->lock, NULL);
+	RING_IO_DaemonStop = 0;
+
+	/*
+	 * Block the stop signals everywhere but in ppoll (), so that the reader
+	 * thread never takes them and no wakeup is lost.
+	 */
+	memset (&action, 0, sizeof (action));
+	action.sa_handler = RING_IO_DaemonSignal;
+	sigemptyset (&action.sa_mask);
+	sigaction (SIGINT, &action, NULL);
+	sigaction (SIGTERM, &action, NULL);
+	sigemptyset (&blocked);
+	sigaddset (&blocked, SIGINT);
+	sigaddset (&blocked, SIGTERM);
+	pthread_sigmask (SIG_BLOCK, &blocked, &daemon->sigMask);
+	sigdelset (&daemon->sigMask, SIGINT);
+	sigdelset (&daemon->sigMask, SIGTERM);
+
+	status = RING_IO_DaemonListen (daemon, socketPath);
+	if (DSP_FAILED (status)) {
+		RING_IO_1Print ("RING_IO_DaemonListen () failed. Status = [0x%x]\n",
+				status);
+	}
+
+	if (DSP_SUCCEEDED (status)) {
+		daemon->chnl->writerAcqSize = DSPLINK_ALIGN (
+				daemon->chnl->writerBufSize / 2u,
+				DSPLINK_BUF_ALIGN);
+		status = RING_IO_ChnlOpenReader (daemon->chnl);
+		if (DSP_SUCCEEDED (status)) {
+			status = RING_IO_ChnlOpenWriter (daemon->chnl);
+		}
+		/* Requests are small, complete them without waking the reader */
+		RING_IO_ChnlSetInline (daemon->chnl,
+				&RING_IO_DaemonDrainInline,
+				daemon);
+	}
+
+	if (DSP_SUCCEEDED (status)) {
+		if (pthread_create (&reader,
+					NULL,
+					RING_IO_DaemonReader,
+					daemon) == 0) {
+			readerStarted = TRUE;
+		}
+		else {
+			status = DSP_EFAIL;
+		}
+	}
+
+	if (DSP_SUCCEEDED (status)) {
+		RING_IO_0Print ("RING_IO_Daemon: waiting for clients\n");
+		daemon->chnl->xferMode = RING_IO_XFER_BATCH;
+		RING_IO_CoalesceInit (&daemon->coalesce,
+				daemon->chnl,
+				daemon->chnl->writerAcqSize,
+				RING_IO_COALESCE_DEADLINE);
+		status = RING_IO_ChnlWriteStart (daemon->chnl);
+		if (DSP_SUCCEEDED (status)) {
+			status = RING_IO_DaemonWrite (daemon);
+			tmpStatus = RING_IO_ChnlWriteEnd (daemon->chnl);
+			if (DSP_SUCCEEDED (status)) {
+				status = tmpStatus;
+			}
+		}
+	}
+
+	if (readerStarted == TRUE) {
+		pthread_join (reader, NULL);
+	}
+
+	RING_IO_1Print64 ("RING_IO_Daemon: requests completed %llu\n",
+			daemon->numDone);
+	if (daemon->numDropped > 0) {
+		RING_IO_1Print64 ("RING_IO_Daemon: bytes without request %llu\n",
+				daemon->numDropped);
+	}
+	RING_IO_CoalesceReport (&daemon->coalesce);
+	RING_IO_NotifyReport (daemon->coalesce.stats.bytes);
+	daemon->chnl->xferMode = RING_IO_XFER_DATA;
+	RING_IO_ChnlSetInline (daemon->chnl, NULL, NULL);
+
+	RING_IO_ChnlCloseWriter (daemon->chnl);
+	RING_IO_ChnlCloseReader (daemon->chnl);
+
+	for (i = 0; i < RING_IO_DAEMON_MAX_CONNS; i++) {
+		if (daemon->conns [i].fd >= 0) {
+			close (daemon->conns [i].fd);
+			daemon->conns [i].fd = -1;
+		}
+		daemon->conns [i].pending = 0;
+		RING_IO_DaemonRelease (&daemon->conns [i]);
+	}
+	if (daemon->listenFd >= 0) {
+		close (daemon->listenFd);
+		unlink (socketPath);
+	}
+	pthread_mutex_destroy (&daemon->lock);
+	pthread_sigmask (SIG_UNBLOCK, &blocked, NULL);
+
+	/* End the DSP side of every channel, used or not */
+	tmpStatus = RING_IO_ChnlShutdownAll (chnls, RING_IO_NUM_CHNLS);
+	if (DSP_SUCCEEDED (status) && DSP_FAILED (tmpStatus)) {
+		status = tmpStatus;
+	}
+
+	return (status);
+}
+
+/** ============================================================================
+ *  @func   RING_IO_DaemonClientRun
+ *
+ *  @desc   Sends a file through a running daemon.
+ *
+ *  @modif  None
+ *  ============================================================================
+ */
+NORMAL_API
+DSP_STATUS
+RING_IO_DaemonClientRun (IN Char8 * socketPath,
+		IN Char8 * inFile,
+		IN Char8 * outFile)
+{
+	DSP_STATUS status = DSP_SOK;
+	struct sockaddr_un addr;
+	RING_IO_DaemonMsg msg;
+	Uint8 * staging = MAP_FAILED;
+	Uint32 stagingSize = 0;
+	Uint32 slotSize;
+	Uint32 slotUsed;
+	Uint32 nextSubmit = 0;
+	Uint32 nextDone = 0;
+	Uint32 inFlight = 0;
+	RING_IO_Uint64 totalBytes = 0;
+	RING_IO_Uint64 startTime;
+	RING_IO_Uint64 elapsed;
+	Bool endOfInput = FALSE;
+	ssize_t size;
+	int memFd = -1;
+	int sockFd = -1;
+	int inFd = -1;
+	int outFd = -1;
+
+	memset (&addr, 0, sizeof (addr));
+	addr.sun_family = AF_UNIX;
+	strncpy (addr.sun_path, socketPath, sizeof (addr.sun_path) - 1);
+
+	sockFd = socket (AF_UNIX, SOCK_SEQPACKET | SOCK_CLOEXEC, 0);
+	if (   (sockFd < 0)
+		|| (connect (sockFd, (struct sockaddr *) &addr, sizeof (addr)) < 0)) {
+		RING_IO_0Print ("RING_IO_DaemonClient: cannot connect to daemon\n");
+		status = DSP_EFAIL;
+	}
+
+	if (DSP_SUCCEEDED (status)) {
+		status = RING_IO_DaemonRecv (sockFd, &msg, &memFd);
+		if (   DSP_SUCCEEDED (status)
+			&& (   (msg.cmd != RING_IO_DAEMON_CMD_HELLO)
+				|| DSP_FAILED (msg.status)
+				|| (memFd < 0))) {
+			status = DSP_EFAIL;
+		}
+	}
+
+	if (DSP_SUCCEEDED (status)) {
+		stagingSize = msg.size;
+		staging = mmap (NULL,
+				stagingSize,
+				PROT_READ | PROT_WRITE,
+				MAP_SHARED,
+				memFd,
+				0);
+		if (staging == MAP_FAILED) {
+			status = DSP_EMEMORY;
+		}
+	}
+
+	if (DSP_SUCCEEDED (status)) {
+		inFd = open (inFile, O_RDONLY | O_CLOEXEC);
+		outFd = open (outFile,
+				O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC,
+				0644);
+		if ((inFd < 0) || (outFd < 0)) {
+			RING_IO_0Print ("RING_IO_DaemonClient: cannot open files\n");
+			status = DSP_EFAIL;
+		}
+	}
+
+	/*
+	 * The first half of the staging area holds the input slots, the second
+	 * half the matching output slots.
+	 */
+	slotSize = stagingSize / (2u * RING_IO_DAEMON_CLIENT_SLOTS);
+	startTime = RING_IO_GetTimeMsec ();
+	while (DSP_SUCCEEDED (status)) {
+		while (   (endOfInput == FALSE)
+			   && (inFlight < RING_IO_DAEMON_CLIENT_SLOTS)
+			   && DSP_SUCCEEDED (status)) {
+			/* Read the input straight into the shared staging area */
+			slotUsed = 0;
+			while (slotUsed < slotSize) {
+				size = read (inFd,
+						staging + (nextSubmit * slotSize) + slotUsed,
+						slotSize - slotUsed);
+				if (size > 0) {
+					slotUsed += (Uint32) size;
+				}
+				else if ((size < 0) && (errno == EINTR)) {
+					continue;
+				}
+				else {
+					if (size < 0) {
+						status = DSP_EFAIL;
+					}
+					endOfInput = TRUE;
+					break;
+				}
+			}
+
+			if (slotUsed > 0) {
+				memset (&msg, 0, sizeof (msg));
+				msg.cmd = RING_IO_DAEMON_CMD_SUBMIT;
+				msg.id = nextSubmit;
+				msg.inOffset = nextSubmit * slotSize;
+				msg.outOffset = (RING_IO_DAEMON_CLIENT_SLOTS + nextSubmit)
+						* slotSize;
+				msg.size = slotUsed;
+				status = RING_IO_DaemonSend (sockFd, &msg, -1);
+				inFlight++;
+				nextSubmit = (nextSubmit + 1) % RING_IO_DAEMON_CLIENT_SLOTS;
+			}
+		}
+
+		if ((inFlight == 0) || DSP_FAILED (status)) {
+			break;
+		}
+
+		/* Requests complete in submission order */
+		status = RING_IO_DaemonRecv (sockFd, &msg, NULL);
+		if (   DSP_SUCCEEDED (status)
+			&& (   (msg.cmd != RING_IO_DAEMON_CMD_DONE)
+				|| (msg.id != nextDone))) {
+			status = DSP_EFAIL;
+		}
+		if (DSP_SUCCEEDED (status)) {
+			status = msg.status;
+		}
+		if (DSP_SUCCEEDED (status)) {
+			if (write (outFd, staging + msg.outOffset, msg.size)
+					!= (ssize_t) msg.size) {
+				status = DSP_EFAIL;
+			}
+			totalBytes += msg.size;
+			inFlight--;
+			nextDone = (nextDone + 1) % RING_IO_DAEMON_CLIENT_SLOTS;
+		}
+	}
+	elapsed = RING_IO_GetTimeMsec () - startTime;
+
+	RING_IO_1Print64 ("RING_IO_DaemonClient: bytes processed %llu\n",
+			totalBytes);
+	RING_IO_1Print64 ("RING_IO_DaemonClient: elapsed time %llu ms\n",
+			elapsed);
+	if (DSP_FAILED (status)) {
+		RING_IO_1Print ("RING_IO_DaemonClient: failed. Status = [0x%x]\n",
+				status);
+	}
+
+	if (outFd >= 0) {
+		close (outFd);
+	}
+	if (inFd >= 0) {
+		close (inFd);
+	}
+	if (staging != MAP_FAILED) {
+		munmap (staging, stagingSize);
+	}
+	if (memFd >= 0) {
+		close (memFd);
+	}
+	if (sockFd >= 0) {
+		close (sockFd);
+	}
+
+	return (status);
+}
+
+#if defined (__cplusplus)
+}
+#endif /* defined (__cplusplus) */
@@ -0,0 +1,232 @@
+/** ============================================================================
+ *  @file   ring_io_daemon.h
+ *
+ *  @path   $(DSPLINK)/gpp/src/samples/ring_io/Linux/
+ *
+ *  @desc   Defines the daemon mode of the ring_io application and the
+ *          protocol spoken with its local clients.
+ *          The daemon owns the DSP and the RingIOs and listens on a Unix
+ *          domain socket (SOCK_SEQPACKET). Every accepted client receives a
+ *          memfd backed staging area with a RING_IO_DAEMON_CMD_HELLO message.
+ *          The client places its data in the staging area and posts
+ *          RING_IO_DAEMON_CMD_SUBMIT descriptors naming the input and output
+ *          ranges. The daemon coalesces the inputs into RING_IO_XFER_BATCH
+ *          records, copies the data received from the DSP into the output
+ *          range and posts a RING_IO_DAEMON_CMD_DONE descriptor back.
+ *          Requests of all clients share one channel and complete in
+ *          submission order.
+ *          The DSP is expected to return as many bytes as it receives.
+ *
+ *  @ver    1.65.00.02
+ *  ============================================================================
+ *  Copyright (C) 2002-2009, Texas Instruments Incorporated -
+ *  http://www.ti.com/
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions
+ *  are met:
+ *  
+ *  *  Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *  
+ *  *  Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer in the
+ *     documentation and/or other materials provided with the distribution.
+ *  
+ *  *  Neither the name of Texas Instruments Incorporated nor the names of
+ *     its contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *  
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ *  THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ *  PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+ *  CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ *  EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ *  PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ *  OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ *  WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ *  OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ *  EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *  ============================================================================
+ */
+
+
+#if !defined (RING_IO_DAEMON_H)
+#define RING_IO_DAEMON_H
+
+
+/*  ----------------------------------- DSP/BIOS Link                 */
+#include <dsplink.h>
+
+/*  ----------------------------------- Application Header            */
+#include <ring_io_chnl.h>
+
+
+#if defined (__cplusplus)
+extern "C" {
+#endif /* defined (__cplusplus) */
+
+
+/** ============================================================================
+ *  @const  RING_IO_DAEMON_STAGING_SIZE
+ *
+ *  @desc   Size of the staging area shared with each client.
+ *  ============================================================================
+ */
+#define RING_IO_DAEMON_STAGING_SIZE     262144u
+
+/** ============================================================================
+ *  @const  RING_IO_DAEMON_MAX_CONNS
+ *
+ *  @desc   Maximum number of clients connected at the same time.
+ *  ============================================================================
+ */
+#define RING_IO_DAEMON_MAX_CONNS        16u
+
+/** ============================================================================
+ *  @const  RING_IO_DAEMON_MAX_REQS
+ *
+ *  @desc   Maximum number of requests in flight, over all clients.
+ *  ============================================================================
+ */
+#define RING_IO_DAEMON_MAX_REQS         64u
+
+/** ============================================================================
+ *  @const  RING_IO_DAEMON_CLIENT_SLOTS
+ *
+ *  @desc   Number of requests kept in flight by RING_IO_DaemonClientRun ().
+ *  ============================================================================
+ */
+#define RING_IO_DAEMON_CLIENT_SLOTS     4u
+
+/** ============================================================================
+ *  @const  RING_IO_DAEMON_CMD_HELLO
+ *
+ *  @desc   Daemon to client. Carries the staging area file descriptor as
+ *          SCM_RIGHTS ancillary data, its size is in the size field.
+ *  ============================================================================
+ */
+#define RING_IO_DAEMON_CMD_HELLO        1u
+
+/** ============================================================================
+ *  @const  RING_IO_DAEMON_CMD_SUBMIT
+ *
+ *  @desc   Client to daemon. Requests the processing of size bytes at
+ *          inOffset into outOffset of the staging area.
+ *  ============================================================================
+ */
+#define RING_IO_DAEMON_CMD_SUBMIT       2u
+
+/** ============================================================================
+ *  @const  RING_IO_DAEMON_CMD_DONE
+ *
+ *  @desc   Daemon to client. The request with the given id has completed
+ *          with the given status.
+ *  ============================================================================
+ */
+#define RING_IO_DAEMON_CMD_DONE         3u
+
+
+/** ============================================================================
+ *  @name   RING_IO_DaemonMsg
+ *
+ *  @desc   Message exchanged between the daemon and its clients.
+ *
+ *  @field  cmd
+ *              One of the RING_IO_DAEMON_CMD_* values.
+ *  @field  id
+ *              Identifier chosen by the client, echoed in the reply.
+ *  @field  inOffset
+ *              Offset of the input data in the staging area.
+ *  @field  outOffset
+ *              Offset of the output data in the staging area.
+ *  @field  size
+ *              Number of bytes of the request.
+ *  @field  status
+ *              Completion status of the request.
+ *  ============================================================================
+ */
+typedef struct RING_IO_DaemonMsg_tag {
+    Uint32      cmd ;
+    Uint32      id ;
+    Uint32      inOffset ;
+    Uint32      outOffset ;
+    Uint32      size ;
+    DSP_STATUS  status ;
+} RING_IO_DaemonMsg ;
+
+
+/** ============================================================================
+ *  @func   RING_IO_DaemonRun
+ *
+ *  @desc   Serves local clients over a Unix domain socket using one channel
+ *          of the DSP, until SIGINT or SIGTERM is received. The other
+ *          channels are shut down on exit.
+ *          The daemon runs in the calling process, which is the only one
+ *          attached to the DSP, also with RING_IO_MULTIPROCESS.
+ *
+ *  @arg    chnls
+ *              Array of RING_IO_NUM_CHNLS initialized channel objects.
+ *  @arg    chnlId
+ *              Index of the channel used for the requests.
+ *  @arg    socketPath
+ *              Path of the socket. An existing file is replaced.
+ *
+ *  @ret    DSP_SOK
+ *              Operation successfully completed.
+ *          DSP_EFAIL
+ *              General failure.
+ *
+ *  @enter  The DSP executable has been started by RING_IO_Create ().
+ *
+ *  @leave  None
+ *
+ *  @see    RING_IO_DaemonClientRun
+ *  ============================================================================
+ */
+NORMAL_API
+DSP_STATUS
+RING_IO_DaemonRun (IN RING_IO_ChnlObj * chnls,
+                   IN Uint32            chnlId,
+                   IN Char8 *           socketPath) ;
+
+/** ============================================================================
+ *  @func   RING_IO_DaemonClientRun
+ *
+ *  @desc   Sends a file through a running daemon and writes the result to
+ *          another file. RING_IO_DAEMON_CLIENT_SLOTS requests are kept in
+ *          flight. The client does not attach to the DSP.
+ *
+ *  @arg    socketPath
+ *              Path of the socket of the daemon.
+ *  @arg    inFile
+ *              Path of the input file.
+ *  @arg    outFile
+ *              Path of the output file.
+ *
+ *  @ret    DSP_SOK
+ *              Operation successfully completed.
+ *          DSP_EFAIL
+ *              General failure.
+ *
+ *  @enter  None
+ *
+ *  @leave  None
+ *
+ *  @see    RING_IO_DaemonRun
+ *  ============================================================================
+ */
+NORMAL_API
+DSP_STATUS
+RING_IO_DaemonClientRun (IN Char8 * socketPath,
+                         IN Char8 * inFile,
+                         IN Char8 * outFile) ;
+
+
+#if defined (__cplusplus)
+}
+#endif /* defined (__cplusplus) */
+
+
+#endif /* !defined (RING_IO_DAEMON_H) */
@@ -0,0 +1,1020 @@
+/** ============================================================================
+ *  @file   ring_io_file.c
+ *
+ *  @path   $(DSPLINK)/gpp/src/samples/ring_io/Linux/
+ *
+ *  @desc   OS specific file input/output used by the streaming modes of the
+ *          ring_io sample application.
+ *          Input files are mapped into memory. Output files are written from
+ *          a set of aligned staging buffers through io_uring, so that several
+ *          writes are in flight while the RingIO is being drained. On kernels
+ *          without io_uring the staging buffers are written synchronously.
+ *          The standard input is read in large blocks and the standard
+ *          output is fed with vmsplice () when it is a pipe.
+ *
+ *  @ver    1.65.00.02
+ *  ============================================================================
+ *  Copyright (C) 2002-2009, Texas Instruments Incorporated -
+ *  http://www.ti.com/
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions
+ *  are met:
+ *  
+ *  *  Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *  
+ *  *  Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer in the
+ *     documentation and/or other materials provided with the distribution.
+ *  
+ *  *  Neither the name of Texas Instruments Incorporated nor the names of
+ *     its contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *  
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ *  THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ *  PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+ *  CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ *  EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ *  PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ *  OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ *  WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ *  OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ *  EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *  ============================================================================
+ */
+
+/*  ----------------------------------- OS Specific Headers           */
+#if !defined (_GNU_SOURCE)
+#define _GNU_SOURCE
+#endif /* !defined (_GNU_SOURCE) */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <fcntl.h>
+#include <errno.h>
+#include <stdint.h>
+#include <sys/types.h>
+#include <sys/stat.h>
+#include <sys/mman.h>
+#include <sys/uio.h>
+#include <sys/syscall.h>
+#if defined (__NR_io_uring_setup)
+#include <linux/io_uring.h>
+#endif
+
+/*  ----------------------------------- DSP/BIOS Link                 */
+#include <dsplink.h>
+
+/*  ----------------------------------- Application Header            */
+#include <ring_io.h>
+#include <ring_io_os.h>
+
+#if defined (__cplusplus)
+extern "C" {
+#endif /* defined (__cplusplus) */
+
+
+#if defined (__NR_io_uring_setup)
+/** ============================================================================
+ *  @name   RING_IO_UringObj
+ *
+ *  @desc   Submission and completion queues of an io_uring instance, as
+ *          mapped from the kernel.
+ *
+ *  @field  ringFd
+ *              File descriptor of the io_uring instance.
+ *  @field  sqHead, sqTail, sqMask, sqArray
+ *              Submission queue ring.
+ *  @field  sqes
+ *              Submission queue entries.
+ *  @field  cqHead, cqTail, cqMask, cqes
+ *              Completion queue ring.
+ *  @field  sqRing, sqRingSize, cqRing, cqRingSize, sqesSize
+ *              Mappings to be released.
+ *  ============================================================================
+ */
+typedef struct RING_IO_UringObj_tag {
+	int                   ringFd;
+	unsigned *            sqHead;
+	unsigned *            sqTail;
+	unsigned *            sqMask;
+	unsigned *            sqArray;
+	struct io_uring_sqe * sqes;
+	unsigned *            cqHead;
+	unsigned *            cqTail;
+	unsigned *            cqMask;
+	struct io_uring_cqe * cqes;
+	Pvoid                 sqRing;
+	size_t                sqRingSize;
+	Pvoid                 cqRing;
+	size_t                cqRingSize;
+	size_t                sqesSize;
+} RING_IO_UringObj;
+#endif /* defined (__NR_io_uring_setup) */
+
+/** ============================================================================
+ *  @name   RING_IO_FileObj
+ *
+ *  @desc   State of a file opened by RING_IO_AsyncFileOpen ().
+ *
+ *  @field  fd
+ *              File descriptor of the output file.
+ *  @field  slotSize
+ *              Size of each staging buffer.
+ *  @field  numSlots
+ *              Number of staging buffers.
+ *  @field  slots
+ *              Staging buffers, numSlots * slotSize bytes.
+ *  @field  iov
+ *              I/O vector of each staging buffer.
+ *  @field  offsets
+ *              File offset written by each staging buffer.
+ *  @field  busy
+ *              TRUE for each staging buffer with a write in flight.
+ *  @field  curSlot
+ *              Staging buffer being filled.
+ *  @field  curFill
+ *              Number of bytes in the staging buffer being filled.
+ *  @field  offset
+ *              File offset of the next write.
+ *  @field  inFlight
+ *              Number of writes in flight.
+ *  @field  status
+ *              First failure encountered, reported by the next call.
+ *  @field  useUring
+ *              TRUE if writes are submitted through io_uring.
+ *  @field  uring
+ *              io_uring instance.
+ *  ============================================================================
+ */
+typedef struct RING_IO_FileObj_tag {
+	int                fd;
+	Uint32             slotSize;
+	Uint32             numSlots;
+	Uint8 *            slots;
+	struct iovec *     iov;
+	off_t *            offsets;
+	Uint8 *            busy;
+	Uint32             curSlot;
+	Uint32             curFill;
+	off_t              offset;
+	Uint32             inFlight;
+	DSP_STATUS         status;
+	Bool               useUring;
+#if defined (__NR_io_uring_setup)
+	RING_IO_UringObj   uring;
+#endif /* defined (__NR_io_uring_setup) */
+} RING_IO_FileObj;
+
+/** ============================================================================
+ *  @name   RING_IO_StdoutObj
+ *
+ *  @desc   State of the standard output.
+ *
+ *  @field  fd
+ *              File descriptor of the standard output.
+ *  @field  isPipe
+ *              Indicates that the data is spliced into a pipe.
+ *  @field  maxSplice
+ *              Largest amount of data spliced at once, half the pipe size.
+ *  @field  staging
+ *              Staging ring the data is spliced from.
+ *  @field  stagingSize
+ *              Size of the staging ring, twice the pipe size.
+ *  @field  stagingPos
+ *              Position of the next write in the staging ring.
+ *  ============================================================================
+ */
+typedef struct RING_IO_StdoutObj_tag {
+	int      fd;
+	Bool     isPipe;
+	Uint32   maxSplice;
+	Uint8 *  staging;
+	Uint32   stagingSize;
+	Uint32   stagingPos;
+} RING_IO_StdoutObj;
+
+
+#if defined (__NR_io_uring_setup)
+/** ----------------------------------------------------------------------------
+ *  @func   RING_IO_UringSetup
+ *
+ *  @desc   Creates an io_uring instance and maps its queues.
+ *
+ *  @modif  uring
+ *  ----------------------------------------------------------------------------
+ */
+STATIC
+NORMAL_API
+DSP_STATUS
+RING_IO_UringSetup (IN RING_IO_UringObj * uring, IN Uint32 entries)
+{
+	DSP_STATUS status = DSP_SOK;
+	struct io_uring_params params;
+	Uint8 * sqRing;
+	Uint8 * cqRing;
+
+	memset (&params, 0, sizeof (params));
+	memset (uring, 0, sizeof (RING_IO_UringObj));
+	uring->sqRing = MAP_FAILED;
+	uring->cqRing = MAP_FAILED;
+	uring->sqes = MAP_FAILED;
+
+	uring->ringFd = (int) syscall (__NR_io_uring_setup, entries, &params);
+	if (uring->ringFd < 0) {
+		status = DSP_EFAIL;
+	}
+
+	if (DSP_SUCCEEDED (status)) {
+		uring->sqRingSize = params.sq_off.array
+				+ (params.sq_entries * sizeof (unsigned));
+		uring->cqRingSize = params.cq_off.cqes
+				+ (params.cq_entries * sizeof (struct io_uring_cqe));
+#if defined (IORING_FEAT_SINGLE_MMAP)
+		if ((params.features & IORING_FEAT_SINGLE_MMAP) != 0) {
+			if (uring->cqRingSize > uring->sqRingSize) {
+				uring->sqRingSize = uring->cqRingSize;
+			}
+			uring->cqRingSize = 0;
+		}
+#endif /* defined (IORING_FEAT_SINGLE_MMAP) */
+
+		uring->sqRing = mmap (NULL, uring->sqRingSize,
+				PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE,
+				uring->ringFd, IORING_OFF_SQ_RING);
+		if (uring->sqRing == MAP_FAILED) {
+			status = DSP_EFAIL;
+		}
+		else if (uring->cqRingSize == 0) {
+			uring->cqRing = uring->sqRing;
+		}
+		else {
+			uring->cqRing = mmap (NULL, uring->cqRingSize,
+					PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE,
+					uring->ringFd, IORING_OFF_CQ_RING);
+			if (uring->cqRing == MAP_FAILED) {
+				status = DSP_EFAIL;
+			}
+		}
+	}
+
+	if (DSP_SUCCEEDED (status)) {
+		uring->sqesSize = params.sq_entries * sizeof (struct io_uring_sqe);
+		uring->sqes = mmap (NULL, uring->sqesSize,
+				PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE,
+				uring->ringFd, IORING_OFF_SQES);
+		if (uring->sqes == MAP_FAILED) {
+			status = DSP_EFAIL;
+		}
+	}
+
+	if (DSP_SUCCEEDED (status)) {
+		sqRing = (Uint8 *) uring->sqRing;
+		cqRing = (Uint8 *) uring->cqRing;
+		uring->sqHead  = (unsigned *) (sqRing + params.sq_off.head);
+		uring->sqTail  = (unsigned *) (sqRing + params.sq_off.tail);
+		uring->sqMask  = (unsigned *) (sqRing + params.sq_off.ring_mask);
+		uring->sqArray = (unsigned *) (sqRing + params.sq_off.array);
+		uring->cqHead  = (unsigned *) (cqRing + params.cq_off.head);
+		uring->cqTail  = (unsigned *) (cqRing + params.cq_off.tail);
+		uring->cqMask  = (unsigned *) (cqRing + params.cq_off.ring_mask);
+		uring->cqes    = (struct io_uring_cqe *) (cqRing + params.cq_off.cqes);
+	}
+	else if (uring->ringFd >= 0) {
+		if (uring->sqes != MAP_FAILED) {
+			munmap (uring->sqes, uring->sqesSize);
+		}
+		if ((uring->cqRing != MAP_FAILED) && (uring->cqRing != uring->sqRing)) {
+			munmap (uring->cqRing, uring->cqRingSize);
+		}
+		if (uring->sqRing != MAP_FAILED) {
+			munmap (uring->sqRing, uring->sqRingSize);
+		}
+		close (uring->ringFd);
+		uring->ringFd = -1;
+	}
+
+	return (status);
+}
+
+/** ----------------------------------------------------------------------------
+ *  @func   RING_IO_UringTeardown
+ *
+ *  @desc   Releases an io_uring instance created by RING_IO_UringSetup ().
+ *
+ *  @modif  uring
+ *  ----------------------------------------------------------------------------
+ */
+STATIC
+NORMAL_API
+Void
+RING_IO_UringTeardown (IN RING_IO_UringObj * uring)
+{
+	munmap (uring->sqes, uring->sqesSize);
+	if (uring->cqRing != uring->sqRing) {
+		munmap (uring->cqRing, uring->cqRingSize);
+	}
+	munmap (uring->sqRing, uring->sqRingSize);
+	close (uring->ringFd);
+	uring->ringFd = -1;
+}
+#endif /* defined (__NR_io_uring_setup) */
+
+/** ----------------------------------------------------------------------------
+ *  @func   RING_IO_FileComplete
+ *
+ *  @desc   Accounts for the completion of the write of a staging buffer.
+ *          Short writes are finished synchronously.
+ *
+ *  @modif  file
+ *  ----------------------------------------------------------------------------
+ */
+STATIC
+NORMAL_API
+Void
+RING_IO_FileComplete (IN RING_IO_FileObj * file,
+		IN Uint32 slot,
+		IN int result,
+		IN off_t offset)
+{
+	Uint8 * data = (Uint8 *) file->iov [slot].iov_base;
+	size_t remain = file->iov [slot].iov_len;
+	ssize_t written = result;
+
+	while ((written >= 0) && ((size_t) written < remain)) {
+		data += written;
+		remain -= written;
+		offset += written;
+		written = pwrite (file->fd, data, remain, offset);
+		if ((written < 0) && (errno == EINTR)) {
+			written = 0;
+		}
+	}
+
+	if ((written < 0) && DSP_SUCCEEDED (file->status)) {
+		file->status = DSP_EFAIL;
+		RING_IO_1Print ("Write to output file failed. errno = [%d]\n",
+				(Uint32) ((result < 0) ? -result : errno));
+	}
+
+	file->busy [slot] = FALSE;
+	file->inFlight--;
+}
+
+/** ----------------------------------------------------------------------------
+ *  @func   RING_IO_FileAbort
+ *
+ *  @desc   Fails the file after an error of io_uring. The writes in flight
+ *          are accounted as complete, since their completions may never be
+ *          reaped, and nothing more is submitted.
+ *
+ *  @modif  file
+ *  ----------------------------------------------------------------------------
+ */
+STATIC
+NORMAL_API
+Void
+RING_IO_FileAbort (IN RING_IO_FileObj * file, IN int error)
+{
+	Uint32 slot;
+
+	if (DSP_SUCCEEDED (file->status)) {
+		file->status = DSP_EFAIL;
+		RING_IO_1Print ("io_uring_enter () failed. errno = [%d]\n",
+				(Uint32) error);
+	}
+
+	for (slot = 0; slot < file->numSlots; slot++) {
+		file->busy [slot] = FALSE;
+	}
+	file->inFlight = 0;
+}
+
+/** ----------------------------------------------------------------------------
+ *  @func   RING_IO_FileReap
+ *
+ *  @desc   Waits for at least one write in flight to complete.
+ *
+ *  @modif  file
+ *  ----------------------------------------------------------------------------
+ */
+STATIC
+NORMAL_API
+Void
+RING_IO_FileReap (IN RING_IO_FileObj * file)
+{
+#if defined (__NR_io_uring_setup)
+	RING_IO_UringObj * uring = &file->uring;
+	struct io_uring_cqe * cqe;
+	unsigned head;
+	Uint32 slot;
+	int result;
+	Bool reaped = FALSE;
+
+	while ((reaped == FALSE) && (file->inFlight > 0)) {
+		head = *uring->cqHead;
+		while (head != __atomic_load_n (uring->cqTail, __ATOMIC_ACQUIRE)) {
+			cqe = &uring->cqes [head & *uring->cqMask];
+			slot = (Uint32) cqe->user_data;
+			result = cqe->res;
+			head++;
+			__atomic_store_n (uring->cqHead, head, __ATOMIC_RELEASE);
+			RING_IO_FileComplete (file, slot, result, file->offsets [slot]);
+			reaped = TRUE;
+		}
+
+		if (reaped == FALSE) {
+			if (   (syscall (__NR_io_uring_enter, uring->ringFd, 0, 1,
+					IORING_ENTER_GETEVENTS, NULL, 0) < 0)
+				&& (errno != EINTR)) {
+				RING_IO_FileAbort (file, errno);
+			}
+		}
+	}
+#endif /* defined (__NR_io_uring_setup) */
+}
+
+/** ----------------------------------------------------------------------------
+ *  @func   RING_IO_FileSubmit
+ *
+ *  @desc   Starts the write of the staging buffer being filled and moves to
+ *          the next one, waiting for it to be free.
+ *
+ *  @modif  file
+ *  ----------------------------------------------------------------------------
+ */
+STATIC
+NORMAL_API
+Void
+RING_IO_FileSubmit (IN RING_IO_FileObj * file)
+{
+	Uint32 slot = file->curSlot;
+	off_t offset = file->offset;
+	ssize_t written;
+#if defined (__NR_io_uring_setup)
+	RING_IO_UringObj * uring = &file->uring;
+	struct io_uring_sqe * sqe;
+	unsigned tail;
+	unsigned index;
+	long result;
+#endif /* defined (__NR_io_uring_setup) */
+
+	file->iov [slot].iov_base = file->slots + (slot * file->slotSize);
+	file->iov [slot].iov_len = file->curFill;
+	file->offsets [slot] = offset;
+	file->offset += file->curFill;
+	file->busy [slot] = TRUE;
+	file->inFlight++;
+
+#if defined (__NR_io_uring_setup)
+	if (file->useUring == TRUE) {
+		tail = *uring->sqTail;
+		index = tail & *uring->sqMask;
+		sqe = &uring->sqes [index];
+		memset (sqe, 0, sizeof (struct io_uring_sqe));
+		sqe->opcode = IORING_OP_WRITEV;
+		sqe->fd = file->fd;
+		sqe->off = (__u64) offset;
+		sqe->addr = (unsigned long) &file->iov [slot];
+		sqe->len = 1;
+		sqe->user_data = slot;
+		uring->sqArray [index] = index;
+		__atomic_store_n (uring->sqTail, tail + 1, __ATOMIC_RELEASE);
+
+		do {
+			result = syscall (__NR_io_uring_enter, uring->ringFd, 1, 0, 0,
+					NULL, 0);
+		}while ((result < 0) && (errno == EINTR));
+		if (result < 0) {
+			/* The write is not in flight, its completion never comes */
+			RING_IO_FileAbort (file, errno);
+		}
+	}
+	else
+#endif /* defined (__NR_io_uring_setup) */
+	{
+		do {
+			written = pwrite (file->fd, file->iov [slot].iov_base,
+					file->iov [slot].iov_len, offset);
+		}while ((written < 0) && (errno == EINTR));
+		RING_IO_FileComplete (file, slot, (int) written, offset);
+	}
+
+	file->curSlot = (slot + 1) % file->numSlots;
+	file->curFill = 0;
+
+	while (   (file->busy [file->curSlot] == TRUE)
+		   && DSP_SUCCEEDED (file->status)) {
+		RING_IO_FileReap (file);
+	}
+}
+
+/** ============================================================================
+ *  @func   RING_IO_MapFile
+ *
+ *  @desc   Maps a file read-only into the address space of the caller.
+ *
+ *  @modif  None
+ *  ============================================================================
+ */
+NORMAL_API
+DSP_STATUS
+RING_IO_MapFile (IN  Char8 * path,
+		OUT Pvoid * addr,
+		OUT RING_IO_Uint64 * size)
+{
+	DSP_STATUS status = DSP_SOK;
+	struct stat st;
+	Pvoid map = NULL;
+	int fd;
+
+	fd = open (path, O_RDONLY);
+	if (fd < 0) {
+		status = DSP_EFAIL;
+		RING_IO_1Print ("open () of input file failed. errno = [%d]\n",
+				(Uint32) errno);
+	}
+	else if (fstat (fd, &st) < 0) {
+		status = DSP_EFAIL;
+	}
+	else if ((RING_IO_Uint64) st.st_size > SIZE_MAX) {
+		status = DSP_ESIZE;
+		RING_IO_0Print ("Input file does not fit in the address space\n");
+	}
+	else if (st.st_size > 0) {
+		map = mmap (NULL, (size_t) st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+		if (map == MAP_FAILED) {
+			map = NULL;
+			status = DSP_EFAIL;
+			RING_IO_1Print ("mmap () of input file failed. errno = [%d]\n",
+					(Uint32) errno);
+		}
+		else {
+			/* The file is consumed once, front to back */
+			madvise (map, (size_t) st.st_size, MADV_SEQUENTIAL);
+			madvise (map, (size_t) st.st_size, MADV_WILLNEED);
+		}
+	}
+
+	if (fd >= 0) {
+		close (fd);
+	}
+
+	*addr = map;
+	*size = DSP_SUCCEEDED (status) ? (RING_IO_Uint64) st.st_size : 0;
+
+	return (status);
+}
+
+/** ============================================================================
+ *  @func   RING_IO_UnmapFile
+ *
+ *  @desc   Removes a mapping created by RING_IO_MapFile ().
+ *
+ *  @modif  None
+ *  ============================================================================
+ */
+NORMAL_API
+DSP_STATUS
+RING_IO_UnmapFile (IN Pvoid addr, IN RING_IO_Uint64 size)
+{
+	DSP_STATUS status = DSP_SOK;
+
+	if ((addr != NULL) && (munmap (addr, (size_t) size) < 0)) {
+		status = DSP_EFAIL;
+	}
+
+	return (status);
+}
+
+/** ============================================================================
+ *  @func   RING_IO_AsyncFileOpen
+ *
+ *  @desc   Creates a file written asynchronously from aligned staging
+ *          buffers.
+ *
+ *  @modif  None
+ *  ============================================================================
+ */
+NORMAL_API
+DSP_STATUS
+RING_IO_AsyncFileOpen (IN  Char8 * path,
+		IN  Uint32 slotSize,
+		IN  Uint32 numSlots,
+		OUT Pvoid * fileHandle)
+{
+	DSP_STATUS status = DSP_SOK;
+	RING_IO_FileObj * file;
+	Pvoid slots = NULL;
+
+	*fileHandle = NULL;
+	slotSize = DSPLINK_ALIGN (slotSize, DSPLINK_BUF_ALIGN);
+
+	file = calloc (1, sizeof (RING_IO_FileObj));
+	if (file == NULL) {
+		status = DSP_EMEMORY;
+	}
+	else {
+		file->fd = -1;
+		file->slotSize = slotSize;
+		file->numSlots = numSlots;
+		file->status = DSP_SOK;
+		file->iov = calloc (numSlots, sizeof (struct iovec));
+		file->offsets = calloc (numSlots, sizeof (off_t));
+		file->busy = calloc (numSlots, sizeof (Uint8));
+		if (   (file->iov == NULL) || (file->offsets == NULL)
+			|| (file->busy == NULL)
+			|| (posix_memalign (&slots,
+					(DSPLINK_BUF_ALIGN > sizeof (Pvoid)) ?
+						DSPLINK_BUF_ALIGN : sizeof (Pvoid),
+					slotSize * numSlots) != 0)) {
+			status = DSP_EMEMORY;
+		}
+		file->slots = (Uint8 *) slots;
+	}
+
+	if (DSP_SUCCEEDED (status)) {
+		file->fd = open (path, O_WRONLY | O_CREAT | O_TRUNC, 0644);
+		if (file->fd < 0) {
+			status = DSP_EFAIL;
+			RING_IO_1Print ("open () of output file failed. errno = [%d]\n",
+					(Uint32) errno);
+		}
+	}
+
+	if (DSP_SUCCEEDED (status)) {
+		file->useUring = FALSE;
+#if defined (__NR_io_uring_setup)
+		if (DSP_SUCCEEDED (RING_IO_UringSetup (&file->uring, numSlots))) {
+			file->useUring = TRUE;
+		}
+		else {
+			RING_IO_0Print ("io_uring not available, writing the output "
+					"file synchronously\n");
+		}
+#endif /* defined (__NR_io_uring_setup) */
+		*fileHandle = file;
+	}
+	else if (file != NULL) {
+		if (file->fd >= 0) {
+			close (file->fd);
+		}
+		free (file->slots);
+		free (file->busy);
+		free (file->offsets);
+		free (file->iov);
+		free (file);
+	}
+
+	return (status);
+}
+
+/** ============================================================================
+ *  @func   RING_IO_AsyncFileWrite
+ *
+ *  @desc   Appends data to a file opened by RING_IO_AsyncFileOpen ().
+ *
+ *  @modif  None
+ *  ============================================================================
+ */
+NORMAL_API
+DSP_STATUS
+RING_IO_AsyncFileWrite (IN Pvoid fileHandle, IN Pvoid buffer, IN Uint32 size)
+{
+	RING_IO_FileObj * file = (RING_IO_FileObj *) fileHandle;
+	Uint8 * data = (Uint8 *) buffer;
+	Uint32 copySize;
+
+	while ((size > 0) && DSP_SUCCEEDED (file->status)) {
+		copySize = file->slotSize - file->curFill;
+		if (copySize > size) {
+			copySize = size;
+		}
+		memcpy (file->slots + (file->curSlot * file->slotSize) + file->curFill,
+				data,
+				copySize);
+		file->curFill += copySize;
+		data += copySize;
+		size -= copySize;
+
+		/* Only full staging buffers are written, keeping writes aligned */
+		if (file->curFill == file->slotSize) {
+			RING_IO_FileSubmit (file);
+		}
+	}
+
+	return (file->status);
+}
+
+/** ============================================================================
+ *  @func   RING_IO_AsyncFileClose
+ *
+ *  @desc   Writes the pending data, waits for all writes in flight and closes
+ *          the file.
+ *
+ *  @modif  None
+ *  ============================================================================
+ */
+NORMAL_API
+DSP_STATUS
+RING_IO_AsyncFileClose (IN Pvoid fileHandle)
+{
+	DSP_STATUS status = DSP_SOK;
+	RING_IO_FileObj * file = (RING_IO_FileObj *) fileHandle;
+
+	if (file != NULL) {
+		if ((file->curFill > 0) && DSP_SUCCEEDED (file->status)) {
+			RING_IO_FileSubmit (file);
+		}
+		/*
+		 * Writes still in flight read the staging buffers, so they are
+		 * waited for even after an error. An error of io_uring itself
+		 * accounts for all of them.
+		 */
+		while (file->inFlight > 0) {
+			RING_IO_FileReap (file);
+		}
+		status = file->status;
+
+#if defined (__NR_io_uring_setup)
+		if (file->useUring == TRUE) {
+			RING_IO_UringTeardown (&file->uring);
+		}
+#endif /* defined (__NR_io_uring_setup) */
+		if (close (file->fd) < 0) {
+			status = DSP_EFAIL;
+		}
+		free (file->slots);
+		free (file->busy);
+		free (file->offsets);
+		free (file->iov);
+		free (file);
+	}
+
+	return (status);
+}
+
+/** ----------------------------------------------------------------------------
+ *  @func   RING_IO_WriteAll
+ *
+ *  @desc   Writes a buffer completely to a file descriptor.
+ *
+ *  @modif  None
+ *  ----------------------------------------------------------------------------
+ */
+STATIC
+NORMAL_API
+DSP_STATUS
+RING_IO_WriteAll (IN int fd, IN Uint8 * data, IN Uint32 size)
+{
+	DSP_STATUS status = DSP_SOK;
+	ssize_t written;
+
+	while ((size > 0) && DSP_SUCCEEDED (status)) {
+		written = write (fd, data, size);
+		if (written > 0) {
+			data += written;
+			size -= (Uint32) written;
+		}
+		else if ((written < 0) && (errno == EINTR)) {
+			continue;
+		}
+		else {
+			status = DSP_EFAIL;
+		}
+	}
+
+	return (status);
+}
+
+/** ----------------------------------------------------------------------------
+ *  @func   RING_IO_SpliceAll
+ *
+ *  @desc   Splices a set of buffers completely into a pipe.
+ *
+ *  @modif  iov
+ *  ----------------------------------------------------------------------------
+ */
+STATIC
+NORMAL_API
+DSP_STATUS
+RING_IO_SpliceAll (IN int fd, IN struct iovec * iov, IN Uint32 numIov)
+{
+	DSP_STATUS status = DSP_SOK;
+	ssize_t spliced;
+
+	while ((numIov > 0) && DSP_SUCCEEDED (status)) {
+		spliced = vmsplice (fd, iov, numIov, 0);
+		if (spliced > 0) {
+			while ((numIov > 0) && ((size_t) spliced >= iov->iov_len)) {
+				spliced -= iov->iov_len;
+				iov++;
+				numIov--;
+			}
+			if (numIov > 0) {
+				iov->iov_base = (Uint8 *) iov->iov_base + spliced;
+				iov->iov_len -= spliced;
+			}
+		}
+		else if ((spliced < 0) && (errno == EINTR)) {
+			continue;
+		}
+		else {
+			status = DSP_EFAIL;
+		}
+	}
+
+	return (status);
+}
+
+/** ============================================================================
+ *  @func   RING_IO_StdinRead
+ *
+ *  @desc   Reads a block from the standard input.
+ *
+ *  @modif  None
+ *  ============================================================================
+ */
+NORMAL_API
+DSP_STATUS
+RING_IO_StdinRead (IN Pvoid buffer, IN Uint32 size, OUT Uint32 * filled)
+{
+	DSP_STATUS status = DSP_SOK;
+	Uint8 * data = (Uint8 *) buffer;
+	Uint32 total = 0;
+	ssize_t bytesRead;
+
+	while (total < size) {
+		bytesRead = read (STDIN_FILENO, data + total, size - total);
+		if (bytesRead > 0) {
+			total += (Uint32) bytesRead;
+		}
+		else if (bytesRead == 0) {
+			/* End of input */
+			break;
+		}
+		else if (errno != EINTR) {
+			status = DSP_EFAIL;
+			break;
+		}
+	}
+	*filled = total;
+
+	return (status);
+}
+
+/** ============================================================================
+ *  @func   RING_IO_StdoutOpen
+ *
+ *  @desc   Prepares the standard output for writing.
+ *
+ *  @modif  None
+ *  ============================================================================
+ */
+NORMAL_API
+DSP_STATUS
+RING_IO_StdoutOpen (IN Uint32 maxWrite, OUT Pvoid * outHandle)
+{
+	DSP_STATUS status = DSP_SOK;
+	RING_IO_StdoutObj * out = NULL;
+	struct stat fileStat;
+	int pipeSize = -1;
+	void * staging = NULL;
+
+	*outHandle = NULL;
+
+	out = (RING_IO_StdoutObj *) calloc (1, sizeof (RING_IO_StdoutObj));
+	if (out == NULL) {
+		status = DSP_EMEMORY;
+	}
+	else {
+		out->fd = STDOUT_FILENO;
+		out->isPipe = FALSE;
+		if (fstat (out->fd, &fileStat) < 0) {
+			status = DSP_EFAIL;
+		}
+	}
+
+#if defined (F_GETPIPE_SZ)
+	if (DSP_SUCCEEDED (status) && S_ISFIFO (fileStat.st_mode)) {
+		pipeSize = fcntl (out->fd, F_GETPIPE_SZ);
+		if ((pipeSize > 0) && ((Uint32) pipeSize < (2u * maxWrite))) {
+			/* Best effort, the size is read back below */
+			fcntl (out->fd, F_SETPIPE_SZ, (int) (2u * maxWrite));
+			pipeSize = fcntl (out->fd, F_GETPIPE_SZ);
+		}
+	}
+#endif /* defined (F_GETPIPE_SZ) */
+
+	if (DSP_SUCCEEDED (status) && (pipeSize > 0)) {
+		/*
+		 * vmsplice () only references the pages, the pipe still reads them
+		 * after the call returns. A pipe never holds more than pipeSize
+		 * bytes, so a part of the staging ring can be reused once pipeSize
+		 * further bytes have been spliced. With a ring of twice the pipe
+		 * size and writes of at most half the pipe size this always holds.
+		 */
+		if (posix_memalign (&staging,
+					(size_t) sysconf (_SC_PAGESIZE),
+					2u * (Uint32) pipeSize) == 0) {
+			out->isPipe = TRUE;
+			out->staging = (Uint8 *) staging;
+			out->stagingSize = 2u * (Uint32) pipeSize;
+			out->maxSplice = (Uint32) pipeSize / 2u;
+		}
+		else {
+			status = DSP_EMEMORY;
+		}
+	}
+
+	if (DSP_SUCCEEDED (status)) {
+		*outHandle = out;
+	}
+	else {
+		free (out);
+	}
+
+	return (status);
+}
+
+/** ============================================================================
+ *  @func   RING_IO_StdoutWrite
+ *
+ *  @desc   Writes data to the standard output.
+ *
+ *  @modif  None
+ *  ============================================================================
+ */
+NORMAL_API
+DSP_STATUS
+RING_IO_StdoutWrite (IN Pvoid outHandle, IN Pvoid buffer, IN Uint32 size)
+{
+	DSP_STATUS status = DSP_SOK;
+	RING_IO_StdoutObj * out = (RING_IO_StdoutObj *) outHandle;
+	Uint8 * data = (Uint8 *) buffer;
+	struct iovec iov [2];
+	Uint32 numIov;
+	Uint32 chunk;
+	Uint32 tail;
+
+	if (out->isPipe == FALSE) {
+		status = RING_IO_WriteAll (out->fd, data, size);
+	}
+
+	while (out->isPipe && (size > 0) && DSP_SUCCEEDED (status)) {
+		chunk = (size < out->maxSplice) ? size : out->maxSplice;
+		tail = out->stagingSize - out->stagingPos;
+
+		/* Copy out of the RingIO, which is reused as soon as released */
+		if (chunk <= tail) {
+			memcpy (out->staging + out->stagingPos, data, chunk);
+			iov [0].iov_base = out->staging + out->stagingPos;
+			iov [0].iov_len = chunk;
+			numIov = 1;
+		}
+		else {
+			memcpy (out->staging + out->stagingPos, data, tail);
+			memcpy (out->staging, data + tail, chunk - tail);
+			iov [0].iov_base = out->staging + out->stagingPos;
+			iov [0].iov_len = tail;
+			iov [1].iov_base = out->staging;
+			iov [1].iov_len = chunk - tail;
+			numIov = 2;
+		}
+		out->stagingPos = (out->stagingPos + chunk) % out->stagingSize;
+
+		status = RING_IO_SpliceAll (out->fd, iov, numIov);
+		data += chunk;
+		size -= chunk;
+	}
+
+	return (status);
+}
+
+/** ============================================================================
+ *  @func   RING_IO_StdoutClose
+ *
+ *  @desc   Releases the state of the standard output.
+ *
+ *  @modif  None
+ *  ============================================================================
+ */
+NORMAL_API
+Void
+RING_IO_StdoutClose (IN Pvoid outHandle)
+{
+	RING_IO_StdoutObj * out = (RING_IO_StdoutObj *) outHandle;
+
+	if (out != NULL) {
+		free (out->staging);
+		free (out);
+	}
+}
+
+#if defined (__cplusplus)
+}
+#endif /* defined (__cplusplus) */
@@ -41,6 +41,9 @@
  */
 
 /*  ----------------------------------- OS Specific Headers           */
+#if !defined (_GNU_SOURCE)
+#define _GNU_SOURCE
+#endif /* !defined (_GNU_SOURCE) */
 #include <stdio.h>
 #include <unistd.h>
 #include <string.h>
@@ -50,6 +53,16 @@
 #include <sched.h>
 #include <sys/types.h>
 #include <sys/wait.h>
+#include <sys/mman.h>
+#include <sys/resource.h>
+#include <sys/syscall.h>
+#include <sys/eventfd.h>
+#include <sys/ioctl.h>
+#include <linux/futex.h>
+#include <linux/perf_event.h>
+#include <poll.h>
+#include <ucontext.h>
+#include <time.h>
 #include <errno.h>
 
 /*  ----------------------------------- DSP/BIOS Link                 */
@@ -63,21 +76,87 @@
 extern "C" {
 #endif /* defined (__cplusplus) */
 
+/** ============================================================================
+ *  @macro  RING_IO_CPU_RELAX
+ *
+ *  @desc   Hint to the CPU that the caller is spinning.
+ *  ============================================================================
+ */
+#if defined (__i386__) || defined (__x86_64__)
+#define RING_IO_CPU_RELAX()     __asm__ __volatile__ ("pause" ::: "memory")
+#else
+#define RING_IO_CPU_RELAX()     __asm__ __volatile__ ("" ::: "memory")
+#endif
+
 /** ============================================================================
  *  @name   RING_IO_SemObject
  *
- *  @desc   This object is used by various SEM API's.
+ *  @desc   This object is used by various SEM API's. Only the members of its
+ *          policy are used.
  *
+ *  @field  policy
+ *              Synchronization policy the semaphore was created with.
  *  @field  sem
- *              Linux semaphore.
+ *              Linux semaphore. RING_IO_SYNC_POSIX.
+ *  @field  count
+ *              Count of the semaphore. RING_IO_SYNC_FUTEX, RING_IO_SYNC_SPIN
+ *              and RING_IO_SYNC_CONDVAR.
+ *  @field  waiters
+ *              Number of threads sleeping on count, so that a post only
+ *              enters the kernel when needed. RING_IO_SYNC_FUTEX and
+ *              RING_IO_SYNC_SPIN.
+ *  @field  fd
+ *              Semaphore eventfd. RING_IO_SYNC_EVENTFD.
+ *  @field  mutex
+ *              Mutex protecting count. RING_IO_SYNC_CONDVAR.
+ *  @field  cond
+ *              Condition signalled on post. RING_IO_SYNC_CONDVAR.
  *
- *  @see    None
+ *  @see    RING_IO_SyncPolicy
  *  ============================================================================
  */
 typedef struct RING_IO_SemObject_tag {
-	sem_t sem;
+	RING_IO_SyncPolicy  policy;
+	sem_t               sem;
+	volatile Uint32     count;
+	volatile Uint32     waiters;
+	int                 fd;
+	pthread_mutex_t     mutex;
+	pthread_cond_t      cond;
 } RING_IO_SemObject;
 
+/** ============================================================================
+ *  @name   RING_IO_SyncNames
+ *
+ *  @desc   Names of the synchronization policies, as accepted in the
+ *          RING_IO_SYNC environment variable.
+ *  ============================================================================
+ */
+STATIC Char8 * RING_IO_SyncNames [RING_IO_SYNC_NUM_POLICIES] = {
+	"posix",
+	"futex",
+	"eventfd",
+	"spin",
+	"condvar"
+};
+
+/** ============================================================================
+ *  @name   RING_IO_Sync
+ *
+ *  @desc   Synchronization policy of the semaphores created from now on.
+ *  ============================================================================
+ */
+STATIC RING_IO_SyncPolicy RING_IO_Sync = RING_IO_SYNC_DEFAULT;
+
+/** ============================================================================
+ *  @name   RING_IO_PrintStderr
+ *
+ *  @desc   Indicates that messages are printed to the standard error instead
+ *          of the standard output.
+ *  ============================================================================
+ */
+STATIC Bool RING_IO_PrintStderr = FALSE;
+
 /** ============================================================================
  *  @func   RING_IO_0Print
  *
@@ -88,7 +167,7 @@ typedef struct RING_IO_SemObject_tag {
  */
 NORMAL_API
 Void RING_IO_0Print(Char8 * str) {
-	printf(str);
+	fprintf(RING_IO_PrintStderr ? stderr : stdout, str);
 }
 
 /** ============================================================================
@@ -101,423 +180,2960 @@ Void RING_IO_0Print(Char8 * str) {
  */
 NORMAL_API
 Void RING_IO_1Print(Char8 * str, Uint32 arg) {
-	printf(str, arg);
+	fprintf(RING_IO_PrintStderr ? stderr : stdout, str, arg);
 }
+
 /** ============================================================================
- *  @func   RING_IO_YieldClient
+ *  @func   RING_IO_1Print64
  *
- *  @desc   Yields tasks execution.
+ *  @desc   Print a message with one 64-bit argument.
  *
  *  @modif  None
  *  ============================================================================
  */
 NORMAL_API
-Void RING_IO_YieldClient() {
-	sched_yield();
+Void RING_IO_1Print64(Char8 * str, RING_IO_Uint64 arg) {
+	fprintf(RING_IO_PrintStderr ? stderr : stdout, str, arg);
 }
+
 /** ============================================================================
- *  @func   RING_IO_Sleep
+ *  @func   RING_IO_PrintToStderr
  *
- *  @desc   Sleeps for the specified number of microseconds.
+ *  @desc   Redirects the printed messages to the standard error.
  *
- *  @modif  None
+ *  @modif  RING_IO_PrintStderr
  *  ============================================================================
  */
 NORMAL_API
-Void RING_IO_Sleep(Uint32 uSec) {
-	usleep(uSec);
+Void RING_IO_PrintToStderr(Void) {
+	RING_IO_PrintStderr = TRUE;
 }
-
-/** ============================================================================
- *  @func   RING_IO_IntToString
+/** ----------------------------------------------------------------------------
+ *  @func   RING_IO_Futex
  *
- *  @desc   This function converts an integer value into a string.
+ *  @desc   Waits on or wakes the waiters of a process private futex. A
+ *          timeout of NULL waits forever.
  *
  *  @modif  None
- *  ============================================================================
+ *  ----------------------------------------------------------------------------
  */
+STATIC
 NORMAL_API
-Void
-RING_IO_IntToString (IN Int num, OUT Char8 * str)
+int
+RING_IO_Futex (IN volatile Uint32 * addr,
+		IN int op,
+		IN Uint32 val,
+		IN struct timespec * timeout)
 {
-	/*  ------------------------------------------------------------------------
-	 *  There can be a max of 7 char str for signed int including terminator
-	 *  so we use a temp string of 7 char. The index is to the rightmost space
-	 *  ie. 5. We divide the number by 10, and successively store the remainder
-	 *  in the rightmost space while decrementing the counter. Later we add the
-	 *  sign if required.
-	 *  ------------------------------------------------------------------------
-	 */
-	Int16 sign = 0;
-	Char8 remainder = 0;
-	char temp [11] = {' ',' ',' ',' ',' ',' ',' ',' ',' ',' ','\0'};
-	Int16 index = 9;
-
-	sign = (num < 0) ? -1 : 1;
-	num = num * sign;
+	return (syscall (SYS_futex,
+			addr,
+			op | FUTEX_PRIVATE_FLAG,
+			val,
+			timeout,
+			NULL,
+			0));
+}
 
-	do {
-		remainder = num % 10;
-		temp [index] = '0' + remainder;
-		num = num / 10;
-		index--;
-	}while ((num > 0)&& (index >= 0));
+/** ----------------------------------------------------------------------------
+ *  @func   RING_IO_SemTryDown
+ *
+ *  @desc   Decrements the count of a futex semaphore if it is not zero.
+ *
+ *  @modif  count of the semaphore.
+ *  ----------------------------------------------------------------------------
+ */
+STATIC
+NORMAL_API
+Bool
+RING_IO_SemTryDown (IN RING_IO_SemObject * semObj)
+{
+	Uint32 count = semObj->count;
 
-	if (sign == -1) {
-		temp [index] = '-';
-	}
-	else {
-		index++;
+	while (count > 0) {
+		if (RING_IO_AtomicCas (&semObj->count, count, count - 1u) == TRUE) {
+			return (TRUE);
+		}
+		count = semObj->count;
 	}
 
-	strncpy (str, &(temp [index]), 11);
+	return (FALSE);
 }
 
-/** ============================================================================
- *  @func   RING_IO_CreateSem
+#ifndef RING_IO_MULTIPROCESS
+/** ----------------------------------------------------------------------------
+ *  @func   RING_IO_SemTryWait
  *
- *  @desc   This function creates a semaphore.
+ *  @desc   Takes a semaphore if it is available, without blocking.
  *
  *  @modif  None
- *  ============================================================================
+ *  ----------------------------------------------------------------------------
  */
+STATIC
 NORMAL_API
-DSP_STATUS
-RING_IO_CreateSem (OUT Pvoid * semPtr)
+Bool
+RING_IO_SemTryWait (IN RING_IO_SemObject * semObj)
 {
-	DSP_STATUS status = DSP_SOK;
-	RING_IO_SemObject * semObj;
-	int osStatus;
+	Bool taken = FALSE;
+	eventfd_t value;
 
-	semObj = malloc (sizeof (RING_IO_SemObject));
-	if (semObj != NULL) {
-		osStatus = sem_init (&(semObj->sem), 0, 0);
-		if (osStatus < 0) {
-			status = DSP_EFAIL;
-		}
-		else {
-			*semPtr = (Pvoid) semObj;
+	switch (semObj->policy) {
+	case RING_IO_SYNC_FUTEX:
+	case RING_IO_SYNC_SPIN:
+		taken = RING_IO_SemTryDown (semObj);
+		break;
+
+	case RING_IO_SYNC_EVENTFD:
+		taken = (eventfd_read (semObj->fd, &value) == 0) ? TRUE : FALSE;
+		break;
+
+	case RING_IO_SYNC_CONDVAR:
+		pthread_mutex_lock (&semObj->mutex);
+		if (semObj->count > 0) {
+			semObj->count--;
+			taken = TRUE;
 		}
-	}
-	else {
-		*semPtr = NULL;
-		status = DSP_EFAIL;
+		pthread_mutex_unlock (&semObj->mutex);
+		break;
+
+	default:
+		taken = (sem_trywait (&(semObj->sem)) == 0) ? TRUE : FALSE;
+		break;
 	}
 
-	return (status);
+	return (taken);
 }
 
 /** ============================================================================
- *  @func   RING_IO_DeleteSem
- *
- *  @desc   This function deletes a semaphore.
+ *  @name   RING_IO_FiberObj
  *
- *  @arg    semHandle
- *              Pointer to the semaphore object to be deleted.
+ *  @desc   A client run as a fiber.
  *
- *  @modif  None
+ *  @field  ctx
+ *              Saved context of the fiber.
+ *  @field  stack
+ *              Stack of the fiber, preceded by a guard page.
+ *  @field  funcPtr
+ *              Client function.
+ *  @field  args
+ *              Argument of the client function.
+ *  @field  used
+ *              Set while the fiber is not joined.
+ *  @field  done
+ *              Set once the client function has exited.
+ *  @field  wakeTime
+ *              Time stamp in microseconds before which the fiber sleeps.
  *  ============================================================================
  */
-NORMAL_API
-DSP_STATUS
-RING_IO_DeleteSem (IN Pvoid semHandle)
-{
-	DSP_STATUS status = DSP_SOK;
-	RING_IO_SemObject * semObj = semHandle;
-	int osStatus;
+typedef struct RING_IO_FiberObj_tag {
+	ucontext_t       ctx;
+	Pvoid            stack;
+	Pvoid            funcPtr;
+	Pvoid            args;
+	Bool             used;
+	Bool             done;
+	RING_IO_Uint64   wakeTime;
+} RING_IO_FiberObj;
 
-	osStatus = sem_destroy (&(semObj->sem));
-	if (osStatus < 0) {
-		status = DSP_EFAIL;
-	}
+/** ============================================================================
+ *  @name   RING_IO_FiberRuntime
+ *
+ *  @desc   Fiber runtime. Fibers are scheduled round robin by the thread
+ *          that created them, whenever it waits for a semaphore, sleeps or
+ *          joins a client.
+ *
+ *  @field  enabled
+ *              Set when RING_IO_Create_client () creates fibers.
+ *  @field  thread
+ *              Thread running the fibers.
+ *  @field  current
+ *              Index of the fiber running, -1 in the scheduler.
+ *  @field  numLive
+ *              Number of fibers not joined.
+ *  @field  progress
+ *              Cleared by a fiber yielding because it cannot go on.
+ *  @field  sched
+ *              Saved context of the scheduler.
+ *  @field  kick
+ *              Posted on every post of a semaphore, so that the idle
+ *              scheduler checks the fibers again.
+ *  @field  switches
+ *              Number of switches to a fiber.
+ *  @field  fibers
+ *              Fibers.
+ *  ============================================================================
+ */
+typedef struct RING_IO_FiberRuntime_tag {
+	Bool              enabled;
+	pthread_t         thread;
+	Int32             current;
+	volatile Uint32   numLive;
+	Bool              progress;
+	ucontext_t        sched;
+	sem_t             kick;
+	RING_IO_Uint64    switches;
+	RING_IO_FiberObj  fibers [RING_IO_FIBER_MAX];
+} RING_IO_FiberRuntime;
 
-	free (semObj);
+/** ============================================================================
+ *  @name   RING_IO_Fibers
+ *
+ *  @desc   The fiber runtime. RING_IO_OS_init () sets the fields that do
+ *          not start at zero.
+ *  ============================================================================
+ */
+STATIC RING_IO_FiberRuntime RING_IO_Fibers = { 0 };
 
-	return (status);
+/** ----------------------------------------------------------------------------
+ *  @func   RING_IO_FiberIn
+ *
+ *  @desc   Tells whether the caller is a fiber.
+ *
+ *  @modif  None
+ *  ----------------------------------------------------------------------------
+ */
+STATIC
+NORMAL_API
+Bool
+RING_IO_FiberIn (Void)
+{
+	return (   (RING_IO_Fibers.current >= 0)
+			&& pthread_equal (pthread_self (), RING_IO_Fibers.thread)) ?
+			TRUE : FALSE;
 }
 
-/** ============================================================================
- *  @func   RING_IO_WaitSem
+/** ----------------------------------------------------------------------------
+ *  @func   RING_IO_FiberDriving
  *
- *  @desc   This function waits on a semaphore.
+ *  @desc   Tells whether the caller is the scheduler of live fibers, which
+ *          must run them instead of blocking.
  *
  *  @modif  None
- *  ============================================================================
+ *  ----------------------------------------------------------------------------
  */
+STATIC
 NORMAL_API
-DSP_STATUS
-RING_IO_WaitSem (IN Pvoid semHandle)
+Bool
+RING_IO_FiberDriving (Void)
 {
-	DSP_STATUS status = DSP_SOK;
-	RING_IO_SemObject * semObj = semHandle;
-	int osStatus;
-
-	osStatus = sem_wait (&(semObj->sem));
-	if (osStatus < 0) {
-		status = DSP_EFAIL;
-	}
-
-	return (status);
+	return (   (RING_IO_Fibers.numLive > 0)
+			&& (RING_IO_Fibers.current < 0)
+			&& pthread_equal (pthread_self (), RING_IO_Fibers.thread)) ?
+			TRUE : FALSE;
 }
 
-/** ============================================================================
- *  @func   RING_IO_PostSem
+/** ----------------------------------------------------------------------------
+ *  @func   RING_IO_FiberYield
  *
- *  @desc   This function posts a semaphore.
+ *  @desc   Switches from the running fiber back to the scheduler.
  *
- *  @modif  None
- *  ============================================================================
+ *  @modif  progress of the runtime.
+ *  ----------------------------------------------------------------------------
  */
+STATIC
 NORMAL_API
-DSP_STATUS
-RING_IO_PostSem (IN Pvoid semHandle)
+Void
+RING_IO_FiberYield (IN Bool blocked)
 {
-	DSP_STATUS status = DSP_SOK;
-	RING_IO_SemObject * semObj = semHandle;
-	int osStatus;
+	RING_IO_FiberObj * fiber = &RING_IO_Fibers.fibers [RING_IO_Fibers.current];
 
-	osStatus = sem_post (&(semObj->sem));
-	if (osStatus < 0) {
-		status = DSP_EFAIL;
+	if (blocked == FALSE) {
+		RING_IO_Fibers.progress = TRUE;
 	}
-
-	return (status);
+	swapcontext (&fiber->ctx, &RING_IO_Fibers.sched);
 }
 
-#ifdef RING_IO_MULTIPROCESS
-/** ============================================================================
- *  @func   RING_IO_getLinkAccess
+/** ----------------------------------------------------------------------------
+ *  @func   RING_IO_FiberExit
  *
- *  @desc   Function  that allows the child  process to  use the link
- *          components.
+ *  @desc   Ends the running fiber.
  *
- *  @modif  None
- *  ============================================================================
+ *  @modif  done of the fiber.
+ *  ----------------------------------------------------------------------------
  */
+STATIC
 NORMAL_API
-Int
-RING_IO_getLinkAccess(Uint8 processorId)
+Void
+RING_IO_FiberExit (Void)
 {
-	DSP_STATUS status = DSP_SOK;
-
-	/* Call the Link APIs that allows child process to be able to use the
-	 * Link components
-	 */
-
-	status = PROC_Attach (processorId, NULL);
-
-	if (DSP_FAILED (status)) {
-		RING_IO_1Print ("Attach Failed. Status = [0x%x]", status);
-	}
+	RING_IO_FiberObj * fiber = &RING_IO_Fibers.fibers [RING_IO_Fibers.current];
 
-	return (status);
+	fiber->done = TRUE;
+	RING_IO_Fibers.progress = TRUE;
+	setcontext (&RING_IO_Fibers.sched);
 }
-#endif
 
-/** ============================================================================
- *  @func   RING_IO_Create_client
+/** ----------------------------------------------------------------------------
+ *  @func   RING_IO_FiberEntry
  *
- *  @desc   Function to create a new thread or a Process.
+ *  @desc   Entry point of every fiber, calls its client function.
  *
  *  @modif  None
- *  ============================================================================
+ *  ----------------------------------------------------------------------------
  */
-EXPORT_API
-Uint32 RING_IO_Create_client(RING_IO_ClientInfo * pInfo, Pvoid funcPtr,
-		Pvoid args) {
-	DSP_STATUS status = DSP_SOK;
+STATIC
+Void
+RING_IO_FiberEntry (Void)
+{
+	RING_IO_FiberObj * fiber = &RING_IO_Fibers.fibers [RING_IO_Fibers.current];
+	Void * (*lptrToFun) (Void *) = fiber->funcPtr;
 
-#ifdef RING_IO_MULTIPROCESS
-	pid_t processId;
-	int result;
-	DSP_STATUS retStatus = DSP_SOK;
-	int (*lptrToFun)(void*) = NULL;
+	(lptrToFun) (fiber->args);
+	RING_IO_FiberExit ();
+}
 
-#endif
+/** ----------------------------------------------------------------------------
+ *  @func   RING_IO_FiberCreate
+ *
+ *  @desc   Creates a fiber running a client function.
+ *
+ *  @modif  RING_IO_Fibers
+ *  ----------------------------------------------------------------------------
+ */
+STATIC
+NORMAL_API
+Int32
+RING_IO_FiberCreate (IN Pvoid funcPtr, IN Pvoid args)
+{
+	RING_IO_FiberObj * fiber = NULL;
+	long pageSize = sysconf (_SC_PAGESIZE);
+	Int32 i;
 
-#ifdef RING_IO_MULTIPROCESS
-	/* Create a child process */
-	processId = fork();
-	if (processId == 0) {
-		/* In Child Process */
-
-		/* Get the access privileges for the child process */
-		retStatus = RING_IO_getLinkAccess(pInfo->processorId);
-		if (DSP_FAILED(retStatus)) {
-			RING_IO_0Print ("ERR: Unable to initialize DspLink in  Client \n"
-					/*,&pInfo->processName */);
-		} else {
-			lptrToFun = funcPtr;
-			/* Call the user function */
-			result =(lptrToFun) (args);
-		}
-
-		/* Exit from the child process */
-		exit (0);
-	}
-	else if (processId < 0) {
-		status = -1;
-		RING_IO_1Print ("Call to fork failed. Status [0x%x]\n",
-				status);
+	for (i = 0; i < (Int32) RING_IO_FIBER_MAX; i++) {
+		if (RING_IO_Fibers.fibers [i].used == FALSE) {
+			fiber = &RING_IO_Fibers.fibers [i];
+			break;
+		}
 	}
-	else {
-		/* In parent Process */
-		pInfo->pid = processId;
-		status = 0;
+	if (fiber == NULL) {
+		return (-1);
 	}
 
-#else
-	status = pthread_create(&pInfo->tid, NULL,/* Attributes of the thread.*/
-	(void*) funcPtr, /* Pointer to Function.*/
-	args);
-#endif
+	/* Stacks are kept for the next fibers, an overflow hits the guard */
+	if (fiber->stack == NULL) {
+		fiber->stack = mmap (NULL,
+				RING_IO_FIBER_STACK_SIZE + pageSize,
+				PROT_READ | PROT_WRITE,
+				MAP_PRIVATE | MAP_ANONYMOUS,
+				-1,
+				0);
+		if (fiber->stack == MAP_FAILED) {
+			fiber->stack = NULL;
+			return (-1);
+		}
+		mprotect (fiber->stack, pageSize, PROT_NONE);
+	}
 
-	switch (status) {
-	case 0:
-		return (DSP_SOK);
-	case -1:
-		return (DSP_EFAIL);
+	getcontext (&fiber->ctx);
+	fiber->ctx.uc_stack.ss_sp = (Uint8 *) fiber->stack + pageSize;
+	fiber->ctx.uc_stack.ss_size = RING_IO_FIBER_STACK_SIZE;
+	fiber->ctx.uc_link = &RING_IO_Fibers.sched;
+	makecontext (&fiber->ctx, (Void (*) (Void)) RING_IO_FiberEntry, 0);
+
+	fiber->funcPtr = funcPtr;
+	fiber->args = args;
+	fiber->done = FALSE;
+	fiber->wakeTime = 0;
+	fiber->used = TRUE;
+	if (RING_IO_Fibers.numLive == 0) {
+		RING_IO_Fibers.thread = pthread_self ();
 	}
+	RING_IO_Fibers.numLive++;
 
-	return (status);
+	/* The index is recomputed, i may not survive getcontext () */
+	return ((Int32) (fiber - RING_IO_Fibers.fibers));
 }
 
-/** ============================================================================
- *  @func   RING_IO_Join_client
+/** ----------------------------------------------------------------------------
+ *  @func   RING_IO_FiberDrive
  *
- *  @desc   Wait for thread/process to terminate.
+ *  @desc   Runs the fibers until a semaphore can be taken, a fiber is done
+ *          or a deadline passes. Either of the first two may be NULL or -1.
+ *          Sleeps on the kick semaphore when no fiber can go on.
  *
- *  @modif  None
- *  ============================================================================
+ *  @modif  RING_IO_Fibers
+ *  ----------------------------------------------------------------------------
  */
-EXPORT_API
-DSP_STATUS RING_IO_Join_client(RING_IO_ClientInfo *pInfo) {
-	DSP_STATUS status = DSP_EFAIL;
-#ifdef RING_IO_MULTIPROCESS
-	int statLoc;
-#endif
+STATIC
+NORMAL_API
+DSP_STATUS
+RING_IO_FiberDrive (IN RING_IO_SemObject * semObj,
+		IN Int32 join,
+		IN RING_IO_Uint64 deadline)
+{
+	RING_IO_FiberObj * fiber;
+	RING_IO_Uint64 now;
+	RING_IO_Uint64 wake;
+	struct timespec ts;
+	Int32 i;
 
-#ifdef RING_IO_MULTIPROCESS
-	do {
-		status = waitpid (pInfo->pid,
-				&statLoc,
-				( WSTOPPED
-						| WUNTRACED
-				) );
-		if (status < 0) {
-			if (EINTR == errno) {
-				RING_IO_0Print ("Signal received in Main process !!! \n");
-				RING_IO_0Print ("Terminate the child process \n");
-				status = API_RESTART;
+	for (;;) {
+		if ((semObj != NULL) && (RING_IO_SemTryWait (semObj) == TRUE)) {
+			return (DSP_SOK);
+		}
+		if ((join >= 0) && (RING_IO_Fibers.fibers [join].done == TRUE)) {
+			return (DSP_SOK);
+		}
+		now = RING_IO_GetTimeUsec ();
+		if (now >= deadline) {
+			return (DSP_ETIMEOUT);
+		}
+
+		/* One round robin pass over the fibers that are not asleep */
+		RING_IO_Fibers.progress = FALSE;
+		wake = now + RING_IO_FIBER_IDLE;
+		for (i = 0; i < (Int32) RING_IO_FIBER_MAX; i++) {
+			fiber = &RING_IO_Fibers.fibers [i];
+			if ((fiber->used == FALSE) || (fiber->done == TRUE)) {
+				continue;
 			}
-			else {
-				RING_IO_1Print ("Error exit from wait. Status [0x%x]\n",
-						status);
-				RING_IO_1Print ( "errno is %d \n", errno );
-				status = DSP_EFAIL;
+			if (fiber->wakeTime > now) {
+				if (fiber->wakeTime < wake) {
+					wake = fiber->wakeTime;
+				}
+				continue;
 			}
+			RING_IO_Fibers.current = i;
+			RING_IO_Fibers.switches++;
+			swapcontext (&RING_IO_Fibers.sched, &fiber->ctx);
+			RING_IO_Fibers.current = -1;
 		}
-		else {
-			if (WIFEXITED(statLoc) != 0) {
-				/* Child process exited normally */
-				status = DSP_SOK;
-			}
-			else if (WIFSIGNALED(statLoc)) {
-
-				/* Child exited due to uncaught signal */
-				RING_IO_1Print (" Child process exited due to signal %d \n",
-						WTERMSIG (statLoc));
-				/* Terminate the child processes and Main process also */
-				kill(0, SIGABRT);
-				status = DSP_EFAIL;
 
-			} else {
-				RING_IO_1Print (" Child process exited due to status 0%x \n",
-						status);
+		if (RING_IO_Fibers.progress == FALSE) {
+			if (deadline < wake) {
+				wake = deadline;
+			}
+			now = RING_IO_GetTimeUsec ();
+			if (wake > now) {
+				clock_gettime (CLOCK_REALTIME, &ts);
+				ts.tv_nsec += (long) (wake - now) * 1000L;
+				ts.tv_sec += ts.tv_nsec / 1000000000L;
+				ts.tv_nsec %= 1000000000L;
+				while (   (sem_timedwait (&RING_IO_Fibers.kick, &ts) < 0)
+					   && (errno == EINTR)) {
+				}
 			}
 		}
-
-	}while (status == API_RESTART);
-
-#else
-	status = pthread_join(pInfo->tid, NULL);
-#endif
-
-	if (status != 0) {
-		status = DSP_EFAIL;
-	} else {
-		status = DSP_SOK;
 	}
-	return (status);
+}
+
+/** ----------------------------------------------------------------------------
+ *  @func   RING_IO_FiberWaitSem
+ *
+ *  @desc   Waits on a semaphore from a fiber or from the scheduler of live
+ *          fibers. A timeout of RING_IO_SYNC_FOREVER waits forever.
+ *
+ *  @modif  None
+ *  ----------------------------------------------------------------------------
+ */
+STATIC
+NORMAL_API
+DSP_STATUS
+RING_IO_FiberWaitSem (IN RING_IO_SemObject * semObj, IN Uint32 timeout)
+{
+	RING_IO_Uint64 deadline = (RING_IO_Uint64) -1;
+
+	if (timeout != RING_IO_SYNC_FOREVER) {
+		deadline = RING_IO_GetTimeUsec () + timeout;
+	}
+
+	if (RING_IO_FiberIn () == FALSE) {
+		return (RING_IO_FiberDrive (semObj, -1, deadline));
+	}
+
+	while (RING_IO_SemTryWait (semObj) == FALSE) {
+		if (RING_IO_GetTimeUsec () >= deadline) {
+			return (DSP_ETIMEOUT);
+		}
+		RING_IO_FiberYield (TRUE);
+	}
+
+	return (DSP_SOK);
+}
+#endif /* ifndef RING_IO_MULTIPROCESS */
+
+/** ============================================================================
+ *  @func   RING_IO_YieldClient
+ *
+ *  @desc   Yields tasks execution.
+ *
+ *  @modif  None
+ *  ============================================================================
+ */
+NORMAL_API
+Void RING_IO_YieldClient() {
+	Uint32 i;
+
+#ifndef RING_IO_MULTIPROCESS
+	if (RING_IO_FiberIn () == TRUE) {
+		RING_IO_FiberYield (FALSE);
+		return;
+	}
+	if (RING_IO_FiberDriving () == TRUE) {
+		RING_IO_FiberDrive (NULL, -1, RING_IO_GetTimeUsec () + 1u);
+		return;
+	}
+#endif
+
+	/* Give a producer on another core a chance before leaving the CPU */
+	if (RING_IO_Sync == RING_IO_SYNC_SPIN) {
+		for (i = 0; i < RING_IO_SYNC_SPINS; i++) {
+			RING_IO_CPU_RELAX ();
+		}
+	}
+	sched_yield();
+}
+/** ============================================================================
+ *  @func   RING_IO_Sleep
+ *
+ *  @desc   Sleeps for the specified number of microseconds.
+ *
+ *  @modif  None
+ *  ============================================================================
+ */
+NORMAL_API
+Void RING_IO_Sleep(Uint32 uSec) {
+#ifndef RING_IO_MULTIPROCESS
+	RING_IO_FiberObj * fiber;
+
+	/* Fibers sleep in the scheduler, which runs the others meanwhile */
+	if (RING_IO_FiberIn () == TRUE) {
+		fiber = &RING_IO_Fibers.fibers [RING_IO_Fibers.current];
+		fiber->wakeTime = RING_IO_GetTimeUsec () + uSec;
+		RING_IO_FiberYield (TRUE);
+		fiber->wakeTime = 0;
+		return;
+	}
+	if (RING_IO_FiberDriving () == TRUE) {
+		RING_IO_FiberDrive (NULL, -1, RING_IO_GetTimeUsec () + uSec);
+		return;
+	}
+#endif
+	usleep(uSec);
+}
+
+/** ============================================================================
+ *  @func   RING_IO_IntToString
+ *
+ *  @desc   This function converts an integer value into a string.
+ *
+ *  @modif  None
+ *  ============================================================================
+ */
+NORMAL_API
+Void
+RING_IO_IntToString (IN Int num, OUT Char8 * str)
+{
+	/*  ------------------------------------------------------------------------
+	 *  There can be a max of 7 char str for signed int including terminator
+	 *  so we use a temp string of 7 char. The index is to the rightmost space
+	 *  ie. 5. We divide the number by 10, and successively store the remainder
+	 *  in the rightmost space while decrementing the counter. Later we add the
+	 *  sign if required.
+	 *  ------------------------------------------------------------------------
+	 */
+	Int16 sign = 0;
+	Char8 remainder = 0;
+	char temp [11] = {' ',' ',' ',' ',' ',' ',' ',' ',' ',' ','\0'};
+	Int16 index = 9;
+
+	sign = (num < 0) ? -1 : 1;
+	num = num * sign;
+
+	do {
+		remainder = num % 10;
+		temp [index] = '0' + remainder;
+		num = num / 10;
+		index--;
+	}while ((num > 0)&& (index >= 0));
+
+	if (sign == -1) {
+		temp [index] = '-';
+	}
+	else {
+		index++;
+	}
+
+	strncpy (str, &(temp [index]), 11);
+}
+
+/** ----------------------------------------------------------------------------
+ *  @func   RING_IO_SemRemain
+ *
+ *  @desc   Returns the time left until a deadline in microseconds, 0 once it
+ *          has passed.
+ *
+ *  @modif  None
+ *  ----------------------------------------------------------------------------
+ */
+STATIC
+NORMAL_API
+RING_IO_Uint64
+RING_IO_SemRemain (IN RING_IO_Uint64 deadline)
+{
+	RING_IO_Uint64 now = RING_IO_GetTimeUsec ();
+
+	return ((now < deadline) ? (deadline - now) : 0);
+}
+
+/** ----------------------------------------------------------------------------
+ *  @func   RING_IO_SemFutexWait
+ *
+ *  @desc   Waits on a futex semaphore, spinning first for
+ *          RING_IO_SYNC_SPINS rounds with RING_IO_SYNC_SPIN. A timeout of
+ *          RING_IO_SYNC_FOREVER waits forever.
+ *
+ *  @modif  count and waiters of the semaphore.
+ *  ----------------------------------------------------------------------------
+ */
+STATIC
+NORMAL_API
+DSP_STATUS
+RING_IO_SemFutexWait (IN RING_IO_SemObject * semObj, IN Uint32 timeout)
+{
+	RING_IO_Uint64 deadline = RING_IO_GetTimeUsec () + timeout;
+	RING_IO_Uint64 remain = timeout;
+	struct timespec ts;
+	Uint32 i;
+
+	if (semObj->policy == RING_IO_SYNC_SPIN) {
+		for (i = 0; i < RING_IO_SYNC_SPINS; i++) {
+			if (RING_IO_SemTryDown (semObj) == TRUE) {
+				return (DSP_SOK);
+			}
+			RING_IO_CPU_RELAX ();
+		}
+	}
+
+	while (RING_IO_SemTryDown (semObj) == FALSE) {
+		if (timeout != RING_IO_SYNC_FOREVER) {
+			remain = RING_IO_SemRemain (deadline);
+			if (remain == 0) {
+				return (DSP_ETIMEOUT);
+			}
+			ts.tv_sec = (time_t) (remain / 1000000u);
+			ts.tv_nsec = (long) (remain % 1000000u) * 1000L;
+		}
+
+		/* Sleeps only if no post came in since the count was read */
+		__sync_fetch_and_add (&semObj->waiters, 1u);
+		RING_IO_Futex (&semObj->count,
+				FUTEX_WAIT,
+				0,
+				(timeout != RING_IO_SYNC_FOREVER) ? &ts : NULL);
+		__sync_fetch_and_sub (&semObj->waiters, 1u);
+	}
+
+	return (DSP_SOK);
+}
+
+/** ----------------------------------------------------------------------------
+ *  @func   RING_IO_SemEventfdWait
+ *
+ *  @desc   Waits on an eventfd semaphore. A timeout of RING_IO_SYNC_FOREVER
+ *          waits forever.
+ *
+ *  @modif  None
+ *  ----------------------------------------------------------------------------
+ */
+STATIC
+NORMAL_API
+DSP_STATUS
+RING_IO_SemEventfdWait (IN RING_IO_SemObject * semObj, IN Uint32 timeout)
+{
+	RING_IO_Uint64 deadline = RING_IO_GetTimeUsec () + timeout;
+	struct pollfd pfd;
+	eventfd_t value;
+	int waitMsec = -1;
+
+	pfd.fd = semObj->fd;
+	pfd.events = POLLIN;
+
+	/* The eventfd is non blocking, each read takes one unit */
+	while (eventfd_read (semObj->fd, &value) < 0) {
+		if (errno != EAGAIN) {
+			return (DSP_EFAIL);
+		}
+		if (timeout != RING_IO_SYNC_FOREVER) {
+			waitMsec = (int) ((RING_IO_SemRemain (deadline) + 999u) / 1000u);
+			if (waitMsec == 0) {
+				return (DSP_ETIMEOUT);
+			}
+		}
+		if ((poll (&pfd, 1, waitMsec) < 0) && (errno != EINTR)) {
+			return (DSP_EFAIL);
+		}
+	}
+
+	return (DSP_SOK);
+}
+
+/** ----------------------------------------------------------------------------
+ *  @func   RING_IO_SemCondWait
+ *
+ *  @desc   Waits on a condition variable semaphore. A timeout of
+ *          RING_IO_SYNC_FOREVER waits forever.
+ *
+ *  @modif  count of the semaphore.
+ *  ----------------------------------------------------------------------------
+ */
+STATIC
+NORMAL_API
+DSP_STATUS
+RING_IO_SemCondWait (IN RING_IO_SemObject * semObj, IN Uint32 timeout)
+{
+	DSP_STATUS status = DSP_SOK;
+	struct timespec deadline;
+	int osStatus = 0;
+
+	if (timeout != RING_IO_SYNC_FOREVER) {
+		clock_gettime (CLOCK_REALTIME, &deadline);
+		deadline.tv_sec += timeout / 1000000u;
+		deadline.tv_nsec += (long) (timeout % 1000000u) * 1000L;
+		if (deadline.tv_nsec >= 1000000000L) {
+			deadline.tv_sec++;
+			deadline.tv_nsec -= 1000000000L;
+		}
+	}
+
+	pthread_mutex_lock (&semObj->mutex);
+	while ((semObj->count == 0) && (osStatus != ETIMEDOUT)) {
+		if (timeout == RING_IO_SYNC_FOREVER) {
+			osStatus = pthread_cond_wait (&semObj->cond, &semObj->mutex);
+		}
+		else {
+			osStatus = pthread_cond_timedwait (&semObj->cond,
+					&semObj->mutex,
+					&deadline);
+		}
+	}
+	if (semObj->count > 0) {
+		semObj->count--;
+	}
+	else {
+		status = DSP_ETIMEOUT;
+	}
+	pthread_mutex_unlock (&semObj->mutex);
+
+	return (status);
+}
+
+/** ----------------------------------------------------------------------------
+ *  @func   RING_IO_SemWait
+ *
+ *  @desc   Waits on a semaphore with its policy. A timeout of
+ *          RING_IO_SYNC_FOREVER waits forever.
+ *
+ *  @modif  None
+ *  ----------------------------------------------------------------------------
+ */
+STATIC
+NORMAL_API
+DSP_STATUS
+RING_IO_SemWait (IN RING_IO_SemObject * semObj, IN Uint32 timeout)
+{
+	DSP_STATUS status = DSP_SOK;
+	struct timespec deadline;
+	int osStatus;
+
+#ifndef RING_IO_MULTIPROCESS
+	if ((RING_IO_FiberIn () == TRUE) || (RING_IO_FiberDriving () == TRUE)) {
+		return (RING_IO_FiberWaitSem (semObj, timeout));
+	}
+#endif
+
+	switch (semObj->policy) {
+	case RING_IO_SYNC_FUTEX:
+	case RING_IO_SYNC_SPIN:
+		status = RING_IO_SemFutexWait (semObj, timeout);
+		break;
+
+	case RING_IO_SYNC_EVENTFD:
+		status = RING_IO_SemEventfdWait (semObj, timeout);
+		break;
+
+	case RING_IO_SYNC_CONDVAR:
+		status = RING_IO_SemCondWait (semObj, timeout);
+		break;
+
+	default:
+		if (timeout == RING_IO_SYNC_FOREVER) {
+			osStatus = sem_wait (&(semObj->sem));
+		}
+		else {
+			clock_gettime (CLOCK_REALTIME, &deadline);
+			deadline.tv_sec += timeout / 1000000u;
+			deadline.tv_nsec += (long) (timeout % 1000000u) * 1000L;
+			if (deadline.tv_nsec >= 1000000000L) {
+				deadline.tv_sec++;
+				deadline.tv_nsec -= 1000000000L;
+			}
+
+			do {
+				osStatus = sem_timedwait (&(semObj->sem), &deadline);
+			}while ((osStatus < 0) && (errno == EINTR));
+		}
+
+		if (osStatus < 0) {
+			status = (errno == ETIMEDOUT) ? DSP_ETIMEOUT : DSP_EFAIL;
+		}
+		break;
+	}
+
+	return (status);
+}
+
+/** ============================================================================
+ *  @func   RING_IO_SyncSet
+ *
+ *  @desc   Selects the synchronization policy of the semaphores created from
+ *          now on.
+ *
+ *  @modif  RING_IO_Sync
+ *  ============================================================================
+ */
+NORMAL_API
+DSP_STATUS
+RING_IO_SyncSet (IN RING_IO_SyncPolicy policy)
+{
+	DSP_STATUS status = DSP_SOK;
+
+	if ((Uint32) policy < RING_IO_SYNC_NUM_POLICIES) {
+		RING_IO_Sync = policy;
+	}
+	else {
+		status = DSP_EINVALIDARG;
+	}
+
+	return (status);
+}
+
+/** ============================================================================
+ *  @func   RING_IO_SyncGet
+ *
+ *  @desc   Returns the synchronization policy of new semaphores.
+ *
+ *  @modif  None
+ *  ============================================================================
+ */
+NORMAL_API
+RING_IO_SyncPolicy
+RING_IO_SyncGet (Void)
+{
+	return (RING_IO_Sync);
+}
+
+/** ============================================================================
+ *  @func   RING_IO_SyncName
+ *
+ *  @desc   Returns the name of a synchronization policy.
+ *
+ *  @modif  None
+ *  ============================================================================
+ */
+NORMAL_API
+Char8 *
+RING_IO_SyncName (IN RING_IO_SyncPolicy policy)
+{
+	Char8 * name = "unknown";
+
+	if ((Uint32) policy < RING_IO_SYNC_NUM_POLICIES) {
+		name = RING_IO_SyncNames [policy];
+	}
+
+	return (name);
+}
+
+/** ============================================================================
+ *  @func   RING_IO_CreateSem
+ *
+ *  @desc   This function creates a semaphore with the current
+ *          synchronization policy.
+ *
+ *  @modif  None
+ *  ============================================================================
+ */
+NORMAL_API
+DSP_STATUS
+RING_IO_CreateSem (OUT Pvoid * semPtr)
+{
+	DSP_STATUS status = DSP_SOK;
+	RING_IO_SemObject * semObj;
+	int osStatus = 0;
+
+	semObj = malloc (sizeof (RING_IO_SemObject));
+	if (semObj != NULL) {
+		semObj->policy = RING_IO_Sync;
+		semObj->count = 0;
+		semObj->waiters = 0;
+		semObj->fd = -1;
+
+		switch (semObj->policy) {
+		case RING_IO_SYNC_FUTEX:
+		case RING_IO_SYNC_SPIN:
+			break;
+
+		case RING_IO_SYNC_EVENTFD:
+			semObj->fd = eventfd (0, EFD_SEMAPHORE | EFD_NONBLOCK);
+			osStatus = semObj->fd;
+			break;
+
+		case RING_IO_SYNC_CONDVAR:
+			osStatus = pthread_mutex_init (&semObj->mutex, NULL);
+			if (osStatus == 0) {
+				osStatus = pthread_cond_init (&semObj->cond, NULL);
+				if (osStatus != 0) {
+					pthread_mutex_destroy (&semObj->mutex);
+					osStatus = -1;
+				}
+			}
+			else {
+				osStatus = -1;
+			}
+			break;
+
+		default:
+			osStatus = sem_init (&(semObj->sem), 0, 0);
+			break;
+		}
+
+		if (osStatus < 0) {
+			status = DSP_EFAIL;
+			*semPtr = NULL;
+			free (semObj);
+		}
+		else {
+			*semPtr = (Pvoid) semObj;
+		}
+	}
+	else {
+		*semPtr = NULL;
+		status = DSP_EFAIL;
+	}
+
+	return (status);
+}
+
+/** ============================================================================
+ *  @func   RING_IO_DeleteSem
+ *
+ *  @desc   This function deletes a semaphore.
+ *
+ *  @arg    semHandle
+ *              Pointer to the semaphore object to be deleted.
+ *
+ *  @modif  None
+ *  ============================================================================
+ */
+NORMAL_API
+DSP_STATUS
+RING_IO_DeleteSem (IN Pvoid semHandle)
+{
+	DSP_STATUS status = DSP_SOK;
+	RING_IO_SemObject * semObj = semHandle;
+	int osStatus = 0;
+
+	switch (semObj->policy) {
+	case RING_IO_SYNC_FUTEX:
+	case RING_IO_SYNC_SPIN:
+		break;
+
+	case RING_IO_SYNC_EVENTFD:
+		osStatus = close (semObj->fd);
+		break;
+
+	case RING_IO_SYNC_CONDVAR:
+		pthread_cond_destroy (&semObj->cond);
+		osStatus = (pthread_mutex_destroy (&semObj->mutex) == 0) ? 0 : -1;
+		break;
+
+	default:
+		osStatus = sem_destroy (&(semObj->sem));
+		break;
+	}
+	if (osStatus < 0) {
+		status = DSP_EFAIL;
+	}
+
+	free (semObj);
+
+	return (status);
+}
+
+/** ============================================================================
+ *  @func   RING_IO_CreateShmSem
+ *
+ *  @desc   Creates a process shared POSIX semaphore in shared memory.
+ *
+ *  @modif  None
+ *  ============================================================================
+ */
+NORMAL_API
+DSP_STATUS
+RING_IO_CreateShmSem (OUT Pvoid * semPtr)
+{
+	DSP_STATUS status = DSP_SOK;
+	RING_IO_SemObject * semObj;
+	Pvoid addr = NULL;
+
+	*semPtr = NULL;
+	status = RING_IO_ShmAlloc (sizeof (RING_IO_SemObject), &addr);
+	if (DSP_SUCCEEDED (status)) {
+		semObj = (RING_IO_SemObject *) addr;
+		semObj->policy = RING_IO_SYNC_POSIX;
+		semObj->fd = -1;
+		if (sem_init (&semObj->sem, 1, 0) < 0) {
+			status = DSP_EFAIL;
+			RING_IO_ShmFree (addr, sizeof (RING_IO_SemObject));
+		}
+		else {
+			*semPtr = addr;
+		}
+	}
+
+	return (status);
+}
+
+/** ============================================================================
+ *  @func   RING_IO_DeleteShmSem
+ *
+ *  @desc   Deletes a semaphore created by RING_IO_CreateShmSem ().
+ *
+ *  @modif  None
+ *  ============================================================================
+ */
+NORMAL_API
+DSP_STATUS
+RING_IO_DeleteShmSem (IN Pvoid semHandle)
+{
+	DSP_STATUS status = DSP_SOK;
+	DSP_STATUS tmpStatus = DSP_SOK;
+	RING_IO_SemObject * semObj = semHandle;
+
+	if (sem_destroy (&semObj->sem) < 0) {
+		status = DSP_EFAIL;
+	}
+	tmpStatus = RING_IO_ShmFree (semHandle, sizeof (RING_IO_SemObject));
+	if (DSP_SUCCEEDED (status) && DSP_FAILED (tmpStatus)) {
+		status = tmpStatus;
+	}
+
+	return (status);
+}
+
+/** ============================================================================
+ *  @func   RING_IO_WaitSem
+ *
+ *  @desc   This function waits on a semaphore.
+ *
+ *  @modif  None
+ *  ============================================================================
+ */
+NORMAL_API
+DSP_STATUS
+RING_IO_WaitSem (IN Pvoid semHandle)
+{
+	DSP_STATUS status = DSP_SOK;
+
+	status = RING_IO_SemWait (semHandle, RING_IO_SYNC_FOREVER);
+	if (DSP_FAILED (status)) {
+		status = DSP_EFAIL;
+	}
+
+	return (status);
+}
+
+/** ============================================================================
+ *  @func   RING_IO_TimedWaitSem
+ *
+ *  @desc   This function waits on a semaphore for a bounded time.
+ *
+ *  @modif  None
+ *  ============================================================================
+ */
+NORMAL_API
+DSP_STATUS
+RING_IO_TimedWaitSem (IN Pvoid semHandle, IN Uint32 timeout)
+{
+	if (timeout == RING_IO_SYNC_FOREVER) {
+		timeout--;
+	}
+
+	return (RING_IO_SemWait (semHandle, timeout));
+}
+
+/** ============================================================================
+ *  @func   RING_IO_PostSem
+ *
+ *  @desc   This function posts a semaphore.
+ *
+ *  @modif  None
+ *  ============================================================================
+ */
+NORMAL_API
+DSP_STATUS
+RING_IO_PostSem (IN Pvoid semHandle)
+{
+	DSP_STATUS status = DSP_SOK;
+	RING_IO_SemObject * semObj = semHandle;
+	int osStatus = 0;
+
+	switch (semObj->policy) {
+	case RING_IO_SYNC_FUTEX:
+	case RING_IO_SYNC_SPIN:
+		__sync_fetch_and_add (&semObj->count, 1u);
+		if (semObj->waiters > 0) {
+			RING_IO_Futex (&semObj->count, FUTEX_WAKE, 1, NULL);
+		}
+		break;
+
+	case RING_IO_SYNC_EVENTFD:
+		osStatus = eventfd_write (semObj->fd, 1);
+		break;
+
+	case RING_IO_SYNC_CONDVAR:
+		pthread_mutex_lock (&semObj->mutex);
+		semObj->count++;
+		pthread_cond_signal (&semObj->cond);
+		pthread_mutex_unlock (&semObj->mutex);
+		break;
+
+	default:
+		osStatus = sem_post (&(semObj->sem));
+		break;
+	}
+	if (osStatus < 0) {
+		status = DSP_EFAIL;
+	}
+
+#ifndef RING_IO_MULTIPROCESS
+	/* The waiter may be a fiber, polled by an idle scheduler */
+	if (RING_IO_Fibers.numLive > 0) {
+		sem_post (&RING_IO_Fibers.kick);
+	}
+#endif
+
+	return (status);
+}
+
+#ifdef RING_IO_MULTIPROCESS
+/** ============================================================================
+ *  @func   RING_IO_getLinkAccess
+ *
+ *  @desc   Function  that allows the child  process to  use the link
+ *          components.
+ *
+ *  @modif  None
+ *  ============================================================================
+ */
+NORMAL_API
+Int
+RING_IO_getLinkAccess(Uint8 processorId)
+{
+	DSP_STATUS status = DSP_SOK;
+
+	/* Call the Link APIs that allows child process to be able to use the
+	 * Link components
+	 */
+
+	status = PROC_Attach (processorId, NULL);
+
+	if (DSP_FAILED (status)) {
+		RING_IO_1Print ("Attach Failed. Status = [0x%x]", status);
+	}
+
+	return (status);
+}
+#endif
+
+/** ============================================================================
+ *  @name   RING_IO_CtrlObj
+ *
+ *  @desc   Control block with the semaphore the clients post on exit. It is
+ *          mapped shared before any client is created, so it is inherited
+ *          by the client processes.
+ *
+ *  @field  block
+ *              Control block.
+ *  @field  done
+ *              Semaphore posted by each client on exit.
+ *  ============================================================================
+ */
+typedef struct RING_IO_CtrlObj_tag {
+	RING_IO_CtrlBlock  block;
+	RING_IO_SemObject  done;
+} RING_IO_CtrlObj;
+
+/** ============================================================================
+ *  @name   RING_IO_Ctrl
+ *
+ *  @desc   The control block, NULL until RING_IO_OS_init ().
+ *  ============================================================================
+ */
+STATIC RING_IO_CtrlObj * RING_IO_Ctrl = NULL;
+
+/** ----------------------------------------------------------------------------
+ *  @func   RING_IO_CtrlDone
+ *
+ *  @desc   Accounts for the exit of a client.
+ *
+ *  @modif  RING_IO_Ctrl
+ *  ----------------------------------------------------------------------------
+ */
+STATIC
+NORMAL_API
+Void
+RING_IO_CtrlDone (Void)
+{
+	if (RING_IO_Ctrl != NULL) {
+		__sync_fetch_and_sub (&RING_IO_Ctrl->block.clients, 1u);
+		sem_post (&RING_IO_Ctrl->done.sem);
+	}
+}
+
+#ifdef RING_IO_MULTIPROCESS
+/** ============================================================================
+ *  @name   RING_IO_PoolJob
+ *
+ *  @desc   Message sent to a pool worker to run a client.
+ *
+ *  @field  funcPtr
+ *              Client function.
+ *  @field  args
+ *              Argument of the client function.
+ *  @field  sendTime
+ *              Time stamp in microseconds of the dispatch.
+ *  ============================================================================
+ */
+typedef struct RING_IO_PoolJob_tag {
+	Pvoid           funcPtr;
+	Pvoid           args;
+	RING_IO_Uint64  sendTime;
+} RING_IO_PoolJob;
+
+/** ============================================================================
+ *  @name   RING_IO_PoolDone
+ *
+ *  @desc   Message sent back by a pool worker, once attached and then after
+ *          each client it runs.
+ *
+ *  @field  status
+ *              Status of the attach or of the client.
+ *  @field  latency
+ *              Time in microseconds taken by the attach, or between the
+ *              dispatch of the client and its start.
+ *  ============================================================================
+ */
+typedef struct RING_IO_PoolDone_tag {
+	DSP_STATUS      status;
+	RING_IO_Uint64  latency;
+} RING_IO_PoolDone;
+
+/** ============================================================================
+ *  @name   RING_IO_PoolWorkerObj
+ *
+ *  @desc   State of a pool worker, as seen by the parent.
+ *
+ *  @field  pid
+ *              Process of the worker, -1 if the worker is not running.
+ *  @field  ctrlFd
+ *              Pipe the jobs are written to.
+ *  @field  doneFd
+ *              Pipe the replies are read from.
+ *  @field  busy
+ *              Set while the worker runs a client.
+ *  ============================================================================
+ */
+typedef struct RING_IO_PoolWorkerObj_tag {
+	pid_t           pid;
+	int             ctrlFd;
+	int             doneFd;
+	Bool            busy;
+} RING_IO_PoolWorkerObj;
+
+/** ============================================================================
+ *  @name   RING_IO_PoolObj
+ *
+ *  @desc   Pool of worker processes.
+ *
+ *  @field  started
+ *              Set once the workers have been forked.
+ *  @field  isWorker
+ *              Set in the worker processes.
+ *  @field  processorId
+ *              ID of the DSP processor the workers are attached to.
+ *  @field  workers
+ *              Workers.
+ *  @field  spawnTime
+ *              Time in microseconds to fork and attach all the workers.
+ *  @field  attachSum
+ *              Sum of the attach times of the workers in microseconds.
+ *  @field  attachMax
+ *              Largest of these times.
+ *  @field  runs
+ *              Number of clients run by the workers.
+ *  @field  startSum
+ *              Sum of the start latencies of these clients in microseconds.
+ *  @field  startMax
+ *              Largest of these latencies.
+ *  @field  forks
+ *              Number of clients run in a process of their own.
+ *  @field  forkSum
+ *              Sum of the times in microseconds taken by their fork ().
+ *  ============================================================================
+ */
+typedef struct RING_IO_PoolObj_tag {
+	Bool                   started;
+	Bool                   isWorker;
+	Uint8                  processorId;
+	RING_IO_PoolWorkerObj  workers [RING_IO_POOL_WORKERS];
+	RING_IO_Uint64         spawnTime;
+	RING_IO_Uint64         attachSum;
+	RING_IO_Uint64         attachMax;
+	RING_IO_Uint64         runs;
+	RING_IO_Uint64         startSum;
+	RING_IO_Uint64         startMax;
+	RING_IO_Uint64         forks;
+	RING_IO_Uint64         forkSum;
+} RING_IO_PoolObj;
+
+/** ============================================================================
+ *  @name   RING_IO_Pool
+ *
+ *  @desc   The pool of worker processes.
+ *  ============================================================================
+ */
+STATIC RING_IO_PoolObj RING_IO_Pool;
+
+/** ----------------------------------------------------------------------------
+ *  @func   RING_IO_PoolIo
+ *
+ *  @desc   Reads or writes one message on a pipe, retrying on signals.
+ *
+ *  @modif  None
+ *  ----------------------------------------------------------------------------
+ */
+STATIC
+NORMAL_API
+DSP_STATUS
+RING_IO_PoolIo (IN int fd, IN Pvoid msg, IN size_t size, IN Bool isWrite)
+{
+	DSP_STATUS status = DSP_SOK;
+	ssize_t done;
+
+	do {
+		if (isWrite == TRUE) {
+			done = write (fd, msg, size);
+		}
+		else {
+			done = read (fd, msg, size);
+		}
+	}while ((done < 0) && (errno == EINTR));
+
+	/* Messages are below PIPE_BUF, so they are never split */
+	if (done != (ssize_t) size) {
+		status = DSP_EFAIL;
+	}
+
+	return (status);
+}
+
+/** ----------------------------------------------------------------------------
+ *  @func   RING_IO_PoolWorker
+ *
+ *  @desc   Body of a pool worker: attaches once, then runs the clients it is
+ *          sent until the job pipe is closed.
+ *
+ *  @modif  None
+ *  ----------------------------------------------------------------------------
+ */
+STATIC
+NORMAL_API
+Void
+RING_IO_PoolWorker (IN int ctrlFd, IN int doneFd)
+{
+	DSP_STATUS status = DSP_SOK;
+	RING_IO_PoolJob job;
+	RING_IO_PoolDone done;
+	RING_IO_Uint64 start;
+	int (*lptrToFun)(void*) = NULL;
+
+	RING_IO_Pool.isWorker = TRUE;
+
+	start = RING_IO_GetTimeUsec ();
+	status = RING_IO_getLinkAccess (RING_IO_Pool.processorId);
+	done.status = status;
+	done.latency = RING_IO_GetTimeUsec () - start;
+	RING_IO_PoolIo (doneFd, &done, sizeof (done), TRUE);
+
+	while (   DSP_SUCCEEDED (status)
+		   && DSP_SUCCEEDED (RING_IO_PoolIo (ctrlFd,
+									 &job,
+									 sizeof (job),
+									 FALSE))) {
+		done.latency = RING_IO_GetTimeUsec () - job.sendTime;
+		lptrToFun = job.funcPtr;
+		(lptrToFun) (job.args);
+		RING_IO_CtrlDone ();
+		done.status = DSP_SOK;
+		RING_IO_PoolIo (doneFd, &done, sizeof (done), TRUE);
+	}
+
+	if (DSP_SUCCEEDED (status)) {
+		PROC_detach (RING_IO_Pool.processorId);
+	}
+	exit (0);
+}
+
+/** ----------------------------------------------------------------------------
+ *  @func   RING_IO_PoolStart
+ *
+ *  @desc   Forks the pool workers and waits for them to be attached.
+ *
+ *  @modif  RING_IO_Pool
+ *  ----------------------------------------------------------------------------
+ */
+STATIC
+NORMAL_API
+Void
+RING_IO_PoolStart (IN Uint8 processorId)
+{
+	RING_IO_PoolObj * pool = &RING_IO_Pool;
+	RING_IO_PoolWorkerObj * worker;
+	RING_IO_PoolDone done;
+	RING_IO_Uint64 start;
+	int ctrlPipe [2];
+	int donePipe [2];
+	Uint32 i;
+	Uint32 j;
+
+	pool->started = TRUE;
+	pool->processorId = processorId;
+	start = RING_IO_GetTimeUsec ();
+
+	for (i = 0; i < RING_IO_POOL_WORKERS; i++) {
+		worker = &pool->workers [i];
+		worker->pid = -1;
+		worker->busy = FALSE;
+		if (pipe (ctrlPipe) < 0) {
+			continue;
+		}
+		if (pipe (donePipe) < 0) {
+			close (ctrlPipe [0]);
+			close (ctrlPipe [1]);
+			continue;
+		}
+
+		/* Do not let the worker print what the parent has buffered */
+		fflush (stdout);
+		worker->pid = fork ();
+		if (worker->pid == 0) {
+			/* Keep only the pipes of this worker */
+			for (j = 0; j < i; j++) {
+				if (pool->workers [j].pid > 0) {
+					close (pool->workers [j].ctrlFd);
+					close (pool->workers [j].doneFd);
+				}
+			}
+			close (ctrlPipe [1]);
+			close (donePipe [0]);
+			RING_IO_PoolWorker (ctrlPipe [0], donePipe [1]);
+		}
+
+		close (ctrlPipe [0]);
+		close (donePipe [1]);
+		if (worker->pid < 0) {
+			close (ctrlPipe [1]);
+			close (donePipe [0]);
+		}
+		else {
+			worker->ctrlFd = ctrlPipe [1];
+			worker->doneFd = donePipe [0];
+		}
+	}
+
+	for (i = 0; i < RING_IO_POOL_WORKERS; i++) {
+		worker = &pool->workers [i];
+		if (worker->pid > 0) {
+			if (   DSP_SUCCEEDED (RING_IO_PoolIo (worker->doneFd,
+												&done,
+												sizeof (done),
+												FALSE))
+				&& DSP_SUCCEEDED (done.status)) {
+				pool->attachSum += done.latency;
+				if (done.latency > pool->attachMax) {
+					pool->attachMax = done.latency;
+				}
+			}
+			else {
+				/* The worker exits once its job pipe is closed */
+				close (worker->ctrlFd);
+				close (worker->doneFd);
+				waitpid (worker->pid, NULL, 0);
+				worker->pid = -1;
+			}
+		}
+	}
+
+	pool->spawnTime = RING_IO_GetTimeUsec () - start;
+}
+
+/** ----------------------------------------------------------------------------
+ *  @func   RING_IO_PoolDispatch
+ *
+ *  @desc   Sends a client to an idle pool worker, starting the pool first if
+ *          needed.
+ *
+ *  @ret    Index of the worker, -1 if none is available.
+ *
+ *  @modif  RING_IO_Pool
+ *  ----------------------------------------------------------------------------
+ */
+STATIC
+NORMAL_API
+Int32
+RING_IO_PoolDispatch (IN Uint8 processorId, IN Pvoid funcPtr)
+{
+	RING_IO_PoolObj * pool = &RING_IO_Pool;
+	RING_IO_PoolWorkerObj * worker;
+	RING_IO_PoolJob job;
+	Int32 index = -1;
+	Uint32 i;
+
+	if (pool->started == FALSE) {
+		RING_IO_PoolStart (processorId);
+	}
+
+	for (i = 0; (i < RING_IO_POOL_WORKERS) && (index < 0); i++) {
+		worker = &pool->workers [i];
+		if (   (worker->pid > 0)
+			&& (worker->busy == FALSE)
+			&& (processorId == pool->processorId)) {
+			job.funcPtr = funcPtr;
+			job.args = NULL;
+			job.sendTime = RING_IO_GetTimeUsec ();
+			if (DSP_SUCCEEDED (RING_IO_PoolIo (worker->ctrlFd,
+										   &job,
+										   sizeof (job),
+										   TRUE))) {
+				worker->busy = TRUE;
+				index = (Int32) i;
+			}
+		}
+	}
+
+	return (index);
+}
+
+/** ============================================================================
+ *  @func   RING_IO_PoolExit
+ *
+ *  @desc   Stops the worker processes and prints the cost of starting
+ *          clients.
+ *
+ *  @modif  RING_IO_Pool
+ *  ============================================================================
+ */
+NORMAL_API
+Void
+RING_IO_PoolExit (Void)
+{
+	RING_IO_PoolObj * pool = &RING_IO_Pool;
+	RING_IO_PoolWorkerObj * worker;
+	Uint32 numWorkers = 0;
+	Uint32 i;
+
+	if (pool->started == TRUE) {
+		for (i = 0; i < RING_IO_POOL_WORKERS; i++) {
+			worker = &pool->workers [i];
+			if (worker->pid > 0) {
+				close (worker->ctrlFd);
+				close (worker->doneFd);
+				waitpid (worker->pid, NULL, 0);
+				worker->pid = -1;
+				numWorkers++;
+			}
+		}
+
+		RING_IO_1Print ("RING_IO_Pool: workers %d\n", numWorkers);
+		RING_IO_1Print64 ("RING_IO_Pool: fork and attach of the pool %llu us\n",
+				pool->spawnTime);
+		if (numWorkers > 0) {
+			RING_IO_1Print64 ("RING_IO_Pool: attach avg %llu us\n",
+					pool->attachSum / numWorkers);
+			RING_IO_1Print64 ("RING_IO_Pool: attach max %llu us\n",
+					pool->attachMax);
+		}
+		if (pool->runs > 0) {
+			RING_IO_1Print64 ("RING_IO_Pool: clients run by workers %llu\n",
+					pool->runs);
+			RING_IO_1Print64 ("RING_IO_Pool: client start avg %llu us\n",
+					pool->startSum / pool->runs);
+			RING_IO_1Print64 ("RING_IO_Pool: client start max %llu us\n",
+					pool->startMax);
+		}
+		pool->started = FALSE;
+	}
+
+	if (pool->forks > 0) {
+		RING_IO_1Print64 ("RING_IO_Pool: clients forked %llu\n",
+				pool->forks);
+		RING_IO_1Print64 ("RING_IO_Pool: fork avg %llu us\n",
+				pool->forkSum / pool->forks);
+	}
+}
+#else
+/** ============================================================================
+ *  @name   RING_IO_PoolWorkerObj
+ *
+ *  @desc   State of a pool thread.
+ *
+ *  @field  tid
+ *              Thread of the worker.
+ *  @field  running
+ *              Set if the thread was created.
+ *  @field  busy
+ *              Set from the dispatch of a client until it is joined.
+ *  @field  done
+ *              Set once the client has returned.
+ *  @field  funcPtr
+ *              Client to be run, NULL when the worker waits for one.
+ *  @field  args
+ *              Argument of the client.
+ *  @field  sendTime
+ *              Time stamp in microseconds of the dispatch.
+ *  ============================================================================
+ */
+typedef struct RING_IO_PoolWorkerObj_tag {
+	pthread_t       tid;
+	Bool            running;
+	Bool            busy;
+	Bool            done;
+	Pvoid           funcPtr;
+	Pvoid           args;
+	RING_IO_Uint64  sendTime;
+} RING_IO_PoolWorkerObj;
+
+/** ============================================================================
+ *  @name   RING_IO_PoolObj
+ *
+ *  @desc   Pool of client threads, each pinned to a CPU.
+ *
+ *  @field  started
+ *              Set once the threads have been created.
+ *  @field  stop
+ *              Set to stop the threads.
+ *  @field  lock
+ *              Protects the pool.
+ *  @field  wake
+ *              Signalled when a client is dispatched or the pool stops.
+ *  @field  doneCond
+ *              Signalled when a client returns.
+ *  @field  workers
+ *              Workers.
+ *  @field  startTime
+ *              Time stamp in microseconds of the start of the pool.
+ *  @field  runs
+ *              Number of clients run by the workers.
+ *  @field  startSum
+ *              Sum of the start latencies of these clients in microseconds.
+ *  @field  startMax
+ *              Largest of these latencies.
+ *  @field  runSum
+ *              Sum of the run times of these clients in microseconds.
+ *  @field  runMax
+ *              Largest of these times.
+ *  @field  threads
+ *              Number of clients run in a thread of their own.
+ *  ============================================================================
+ */
+typedef struct RING_IO_PoolObj_tag {
+	Bool                   started;
+	Bool                   stop;
+	pthread_mutex_t        lock;
+	pthread_cond_t         wake;
+	pthread_cond_t         doneCond;
+	RING_IO_PoolWorkerObj  workers [RING_IO_POOL_WORKERS];
+	RING_IO_Uint64         startTime;
+	RING_IO_Uint64         runs;
+	RING_IO_Uint64         startSum;
+	RING_IO_Uint64         startMax;
+	RING_IO_Uint64         runSum;
+	RING_IO_Uint64         runMax;
+	RING_IO_Uint64         threads;
+} RING_IO_PoolObj;
+
+/** ============================================================================
+ *  @name   RING_IO_Pool
+ *
+ *  @desc   The pool of client threads.
+ *  ============================================================================
+ */
+STATIC RING_IO_PoolObj RING_IO_Pool = {
+	FALSE,
+	FALSE,
+	PTHREAD_MUTEX_INITIALIZER,
+	PTHREAD_COND_INITIALIZER,
+	PTHREAD_COND_INITIALIZER,
+	{ { 0 } },
+	0,
+	0,
+	0,
+	0,
+	0,
+	0,
+	0
+};
+
+/** ----------------------------------------------------------------------------
+ *  @func   RING_IO_PoolIsWorker
+ *
+ *  @desc   Tells whether the caller is a pool thread.
+ *
+ *  @modif  None
+ *  ----------------------------------------------------------------------------
+ */
+STATIC
+NORMAL_API
+Bool
+RING_IO_PoolIsWorker (Void)
+{
+	Uint32 i;
+
+	for (i = 0; i < RING_IO_POOL_WORKERS; i++) {
+		if (   (RING_IO_Pool.workers [i].running == TRUE)
+			&& pthread_equal (pthread_self (), RING_IO_Pool.workers [i].tid)) {
+			return (TRUE);
+		}
+	}
+
+	return (FALSE);
+}
+
+/** ----------------------------------------------------------------------------
+ *  @func   RING_IO_PoolWorker
+ *
+ *  @desc   Body of a pool thread: runs the clients it is given until the
+ *          pool stops.
+ *
+ *  @modif  None
+ *  ----------------------------------------------------------------------------
+ */
+STATIC
+Void *
+RING_IO_PoolWorker (IN Void * ptr)
+{
+	RING_IO_PoolObj * pool = &RING_IO_Pool;
+	RING_IO_PoolWorkerObj * worker = (RING_IO_PoolWorkerObj *) ptr;
+	Void * (*lptrToFun) (Void *) = NULL;
+	RING_IO_Uint64 start;
+	RING_IO_Uint64 latency;
+	RING_IO_Uint64 runTime;
+
+	pthread_mutex_lock (&pool->lock);
+	while (pool->stop == FALSE) {
+		if (worker->funcPtr == NULL) {
+			pthread_cond_wait (&pool->wake, &pool->lock);
+			continue;
+		}
+		lptrToFun = worker->funcPtr;
+		pthread_mutex_unlock (&pool->lock);
+
+		start = RING_IO_GetTimeUsec ();
+		latency = start - worker->sendTime;
+		(lptrToFun) (worker->args);
+		RING_IO_CtrlDone ();
+		runTime = RING_IO_GetTimeUsec () - start;
+
+		pthread_mutex_lock (&pool->lock);
+		pool->runs++;
+		pool->startSum += latency;
+		if (latency > pool->startMax) {
+			pool->startMax = latency;
+		}
+		pool->runSum += runTime;
+		if (runTime > pool->runMax) {
+			pool->runMax = runTime;
+		}
+		worker->funcPtr = NULL;
+		worker->done = TRUE;
+		pthread_cond_broadcast (&pool->doneCond);
+	}
+	pthread_mutex_unlock (&pool->lock);
+
+	return (NULL);
+}
+
+/** ----------------------------------------------------------------------------
+ *  @func   RING_IO_PoolStart
+ *
+ *  @desc   Creates the pool threads, pinning each to a CPU in turn. To be
+ *          called with the pool locked.
+ *
+ *  @modif  RING_IO_Pool
+ *  ----------------------------------------------------------------------------
+ */
+STATIC
+NORMAL_API
+Void
+RING_IO_PoolStart (Void)
+{
+	RING_IO_PoolObj * pool = &RING_IO_Pool;
+	RING_IO_PoolWorkerObj * worker;
+	long numCpus = sysconf (_SC_NPROCESSORS_ONLN);
+	cpu_set_t cpus;
+	Uint32 i;
+
+	pool->started = TRUE;
+	pool->stop = FALSE;
+	pool->startTime = RING_IO_GetTimeUsec ();
+	if (numCpus < 1) {
+		numCpus = 1;
+	}
+
+	for (i = 0; i < RING_IO_POOL_WORKERS; i++) {
+		worker = &pool->workers [i];
+		worker->busy = FALSE;
+		worker->funcPtr = NULL;
+		worker->running = (pthread_create (&worker->tid,
+				NULL,
+				RING_IO_PoolWorker,
+				worker) == 0) ? TRUE : FALSE;
+		if (worker->running == TRUE) {
+			/* A pinned client keeps its caches and its RingIO lines warm */
+			CPU_ZERO (&cpus);
+			CPU_SET ((int) (i % (Uint32) numCpus), &cpus);
+			pthread_setaffinity_np (worker->tid, sizeof (cpus), &cpus);
+		}
+	}
+}
+
+/** ----------------------------------------------------------------------------
+ *  @func   RING_IO_PoolDispatch
+ *
+ *  @desc   Hands a client to an idle pool thread, starting the pool first if
+ *          needed.
+ *
+ *  @ret    Index of the worker, -1 if none is available.
+ *
+ *  @modif  RING_IO_Pool
+ *  ----------------------------------------------------------------------------
+ */
+STATIC
+NORMAL_API
+Int32
+RING_IO_PoolDispatch (IN Pvoid funcPtr, IN Pvoid args)
+{
+	RING_IO_PoolObj * pool = &RING_IO_Pool;
+	RING_IO_PoolWorkerObj * worker;
+	Int32 index = -1;
+	Uint32 i;
+
+	pthread_mutex_lock (&pool->lock);
+	if (pool->started == FALSE) {
+		RING_IO_PoolStart ();
+	}
+
+	for (i = 0; (i < RING_IO_POOL_WORKERS) && (index < 0); i++) {
+		worker = &pool->workers [i];
+		if ((worker->running == TRUE) && (worker->busy == FALSE)) {
+			worker->args = args;
+			worker->sendTime = RING_IO_GetTimeUsec ();
+			worker->funcPtr = funcPtr;
+			worker->done = FALSE;
+			worker->busy = TRUE;
+			index = (Int32) i;
+			pthread_cond_broadcast (&pool->wake);
+		}
+	}
+	pthread_mutex_unlock (&pool->lock);
+
+	return (index);
+}
+
+/** ----------------------------------------------------------------------------
+ *  @func   RING_IO_PoolJoin
+ *
+ *  @desc   Waits for the client of a pool thread to return, leaving the
+ *          thread ready for the next one.
+ *
+ *  @modif  RING_IO_Pool
+ *  ----------------------------------------------------------------------------
+ */
+STATIC
+NORMAL_API
+Void
+RING_IO_PoolJoin (IN Int32 index)
+{
+	RING_IO_PoolObj * pool = &RING_IO_Pool;
+	RING_IO_PoolWorkerObj * worker = &pool->workers [index];
+
+	pthread_mutex_lock (&pool->lock);
+	while (worker->done == FALSE) {
+		pthread_cond_wait (&pool->doneCond, &pool->lock);
+	}
+	worker->busy = FALSE;
+	pthread_mutex_unlock (&pool->lock);
+}
+
+/** ============================================================================
+ *  @func   RING_IO_PoolExit
+ *
+ *  @desc   Stops the pool threads and prints the client latencies and the
+ *          utilization of the pool.
+ *
+ *  @modif  RING_IO_Pool
+ *  ============================================================================
+ */
+NORMAL_API
+Void
+RING_IO_PoolExit (Void)
+{
+	RING_IO_PoolObj * pool = &RING_IO_Pool;
+	RING_IO_Uint64 elapsed;
+	Uint32 numWorkers = 0;
+	Uint32 i;
+
+	if (pool->started == TRUE) {
+		pthread_mutex_lock (&pool->lock);
+		pool->stop = TRUE;
+		pthread_cond_broadcast (&pool->wake);
+		pthread_mutex_unlock (&pool->lock);
+
+		for (i = 0; i < RING_IO_POOL_WORKERS; i++) {
+			if (pool->workers [i].running == TRUE) {
+				pthread_join (pool->workers [i].tid, NULL);
+				pool->workers [i].running = FALSE;
+				numWorkers++;
+			}
+		}
+		elapsed = RING_IO_GetTimeUsec () - pool->startTime;
+
+		RING_IO_1Print ("RING_IO_Pool: threads %d\n", numWorkers);
+		if (pool->runs > 0) {
+			RING_IO_1Print64 ("RING_IO_Pool: clients run by threads %llu\n",
+					pool->runs);
+			RING_IO_1Print64 ("RING_IO_Pool: client start avg %llu us\n",
+					pool->startSum / pool->runs);
+			RING_IO_1Print64 ("RING_IO_Pool: client start max %llu us\n",
+					pool->startMax);
+			RING_IO_1Print64 ("RING_IO_Pool: client run avg %llu us\n",
+					pool->runSum / pool->runs);
+			RING_IO_1Print64 ("RING_IO_Pool: client run max %llu us\n",
+					pool->runMax);
+		}
+		if ((numWorkers > 0) && (elapsed > 0)) {
+			RING_IO_1Print64 ("RING_IO_Pool: utilization %llu %%\n",
+					(pool->runSum * 100u) / (elapsed * numWorkers));
+		}
+		pool->started = FALSE;
+	}
+
+	if (pool->threads > 0) {
+		RING_IO_1Print64 ("RING_IO_Pool: clients in threads of their own "
+				"%llu\n",
+				pool->threads);
+	}
+}
+#endif
+
+/** ============================================================================
+ *  @func   RING_IO_Create_client
+ *
+ *  @desc   Function to create a new thread or a Process.
+ *
+ *  @modif  None
+ *  ============================================================================
+ */
+EXPORT_API
+Uint32 RING_IO_Create_client(RING_IO_ClientInfo * pInfo, Pvoid funcPtr,
+		Pvoid args) {
+	DSP_STATUS status = DSP_SOK;
+
+#ifdef RING_IO_MULTIPROCESS
+	pid_t processId;
+	int result;
+	DSP_STATUS retStatus = DSP_SOK;
+	int (*lptrToFun)(void*) = NULL;
+	RING_IO_Uint64 start;
+
+#endif
+
+#ifdef RING_IO_MULTIPROCESS
+	/*
+	 * The argument of a client is only valid in a process forked after it
+	 * was set up, so only clients without argument can use the pool.
+	 */
+	pInfo->worker = -1;
+	if ((args == NULL) && (RING_IO_Pool.isWorker == FALSE)) {
+		pInfo->worker = RING_IO_PoolDispatch (pInfo->processorId, funcPtr);
+	}
+
+	if (pInfo->worker >= 0) {
+		pInfo->pid = RING_IO_Pool.workers [pInfo->worker].pid;
+		status = 0;
+	}
+	else {
+		/* Create a child process */
+		start = RING_IO_GetTimeUsec ();
+		processId = fork();
+		if (processId == 0) {
+			/* In Child Process */
+
+			/* Get the access privileges for the child process */
+			retStatus = RING_IO_getLinkAccess(pInfo->processorId);
+			if (DSP_FAILED(retStatus)) {
+				RING_IO_0Print ("ERR: Unable to initialize DspLink in  "
+						"Client \n"
+						/*,&pInfo->processName */);
+			} else {
+				lptrToFun = funcPtr;
+				/* Call the user function */
+				result =(lptrToFun) (args);
+			}
+
+			/* Exit from the child process */
+			RING_IO_CtrlDone ();
+			exit (0);
+		}
+		else if (processId < 0) {
+			status = -1;
+			RING_IO_1Print ("Call to fork failed. Status [0x%x]\n",
+					status);
+		}
+		else {
+			/* In parent Process */
+			pInfo->pid = processId;
+			status = 0;
+			RING_IO_Pool.forks++;
+			RING_IO_Pool.forkSum += RING_IO_GetTimeUsec () - start;
+		}
+	}
+
+#else
+	pInfo->fiber = -1;
+	pInfo->worker = -1;
+	if (RING_IO_Fibers.enabled == TRUE) {
+		pInfo->fiber = RING_IO_FiberCreate (funcPtr, args);
+		status = (pInfo->fiber >= 0) ? 0 : -1;
+	}
+	else {
+		pInfo->worker = RING_IO_PoolDispatch (funcPtr, args);
+		if (pInfo->worker >= 0) {
+			pInfo->tid = RING_IO_Pool.workers [pInfo->worker].tid;
+			status = 0;
+		}
+		else {
+			/* All the threads of the pool are busy */
+			status = pthread_create(&pInfo->tid,
+					NULL, /* Attributes of the thread.*/
+					(void*) funcPtr, /* Pointer to Function.*/
+					args);
+			if (status == 0) {
+				RING_IO_Pool.threads++;
+			}
+		}
+	}
+#endif
+
+	switch (status) {
+	case 0:
+		if (RING_IO_Ctrl != NULL) {
+			__sync_fetch_and_add (&RING_IO_Ctrl->block.clients, 1u);
+		}
+		return (DSP_SOK);
+	case -1:
+		return (DSP_EFAIL);
+	}
+
+	return (status);
+}
+
+/** ============================================================================
+ *  @func   RING_IO_Join_client
+ *
+ *  @desc   Wait for thread/process to terminate.
+ *
+ *  @modif  None
+ *  ============================================================================
+ */
+EXPORT_API
+DSP_STATUS RING_IO_Join_client(RING_IO_ClientInfo *pInfo) {
+	DSP_STATUS status = DSP_EFAIL;
+#ifdef RING_IO_MULTIPROCESS
+	int statLoc;
+	RING_IO_PoolDone done;
+#endif
+
+#ifdef RING_IO_MULTIPROCESS
+	if (pInfo->worker >= 0) {
+		/* The worker replies once the client has returned */
+		status = RING_IO_PoolIo (RING_IO_Pool.workers [pInfo->worker].doneFd,
+				&done,
+				sizeof (done),
+				FALSE);
+		if (DSP_SUCCEEDED (status)) {
+			RING_IO_Pool.runs++;
+			RING_IO_Pool.startSum += done.latency;
+			if (done.latency > RING_IO_Pool.startMax) {
+				RING_IO_Pool.startMax = done.latency;
+			}
+			status = done.status;
+		}
+		RING_IO_Pool.workers [pInfo->worker].busy = FALSE;
+		pInfo->worker = -1;
+	}
+	else {
+		do {
+			status = waitpid (pInfo->pid,
+					&statLoc,
+					( WSTOPPED
+							| WUNTRACED
+					) );
+			if (status < 0) {
+				if (EINTR == errno) {
+					RING_IO_0Print ("Signal received in Main process !!! "
+							"\n");
+					RING_IO_0Print ("Terminate the child process \n");
+					status = API_RESTART;
+				}
+				else {
+					RING_IO_1Print ("Error exit from wait. Status [0x%x]\n",
+							status);
+					RING_IO_1Print ( "errno is %d \n", errno );
+					status = DSP_EFAIL;
+				}
+			}
+			else {
+				if (WIFEXITED(statLoc) != 0) {
+					/* Child process exited normally */
+					status = DSP_SOK;
+				}
+				else if (WIFSIGNALED(statLoc)) {
+
+					/* Child exited due to uncaught signal */
+					RING_IO_1Print (" Child process exited due to signal "
+							"%d \n",
+							WTERMSIG (statLoc));
+					/* Terminate the child processes and Main process also */
+					kill(0, SIGABRT);
+					status = DSP_EFAIL;
+
+				} else {
+					RING_IO_1Print (" Child process exited due to status "
+							"0%x \n",
+							status);
+				}
+			}
+
+		}while (status == API_RESTART);
+	}
+
+#else
+	if (pInfo->fiber >= 0) {
+		/* Runs the fibers until the client is done */
+		if (RING_IO_FiberIn () == TRUE) {
+			while (RING_IO_Fibers.fibers [pInfo->fiber].done == FALSE) {
+				RING_IO_FiberYield (TRUE);
+			}
+		}
+		else {
+			RING_IO_FiberDrive (NULL, pInfo->fiber, (RING_IO_Uint64) -1);
+		}
+		RING_IO_Fibers.fibers [pInfo->fiber].used = FALSE;
+		RING_IO_Fibers.numLive--;
+		pInfo->fiber = -1;
+		status = 0;
+	}
+	else if (pInfo->worker >= 0) {
+		/* The thread stays in the pool for the next client */
+		RING_IO_PoolJoin (pInfo->worker);
+		pInfo->worker = -1;
+		status = 0;
+	}
+	else {
+		status = pthread_join(pInfo->tid, NULL);
+	}
+#endif
+
+	if (status != 0) {
+		status = DSP_EFAIL;
+	} else {
+		status = DSP_SOK;
+	}
+	return (status);
+}
+
+/** ============================================================================
+ *  @func   RING_IO_Exit_client
+ *
+ *  @desc   Function to exit from a caller task(thread/process).
+ *
+ *  @modif  None
+ *  ============================================================================
+ */
+EXPORT_API
+DSP_STATUS RING_IO_Exit_client(RING_IO_ClientInfo *pInfo) {
+	DSP_STATUS status = DSP_SOK;
+
+#ifdef RING_IO_MULTIPROCESS
+	if (RING_IO_Pool.isWorker == TRUE) {
+		/* Pool workers stay attached and return to wait for the next job */
+		return (status);
+	}
+	RING_IO_CtrlDone ();
+	if(pInfo != NULL) {
+		PROC_detach(pInfo->processorId);
+	}
+	exit (0);
+#else
+	if (RING_IO_PoolIsWorker () == TRUE) {
+		/* Pool threads return to wait for the next client */
+		return (status);
+	}
+	RING_IO_CtrlDone ();
+	if (RING_IO_FiberIn () == TRUE) {
+		RING_IO_FiberExit ();
+	}
+	pthread_exit(NULL);
+#endif
+
+	return (status);
+}
+
+/** ============================================================================
+ *  @func   RING_IO_CreateThread
+ *
+ *  @desc   Creates a helper thread in the calling client.
+ *
+ *  @modif  None
+ *  ============================================================================
+ */
+NORMAL_API
+DSP_STATUS
+RING_IO_CreateThread (OUT Pvoid * threadPtr, IN Pvoid funcPtr, IN Pvoid args)
+{
+	DSP_STATUS status = DSP_SOK;
+	pthread_t * tid;
+
+	*threadPtr = NULL;
+	tid = (pthread_t *) malloc (sizeof (pthread_t));
+	if (tid == NULL) {
+		status = DSP_EMEMORY;
+	}
+	else if (pthread_create (tid,
+			NULL,
+			(Void * (*) (Void *)) funcPtr,
+			args) != 0) {
+		free (tid);
+		status = DSP_EFAIL;
+	}
+	else {
+		*threadPtr = tid;
+	}
+
+	return (status);
+}
+
+/** ============================================================================
+ *  @func   RING_IO_JoinThread
+ *
+ *  @desc   Waits for a helper thread to return.
+ *
+ *  @modif  None
+ *  ============================================================================
+ */
+NORMAL_API
+DSP_STATUS
+RING_IO_JoinThread (IN Pvoid threadHandle)
+{
+	DSP_STATUS status = DSP_SOK;
+	pthread_t * tid = (pthread_t *) threadHandle;
+
+	if (pthread_join (*tid, NULL) != 0) {
+		status = DSP_EFAIL;
+	}
+	free (tid);
+
+	return (status);
+}
+
+/** ============================================================================
+ *  @func   RING_IO_OS_init
+ *
+ *  @desc   This function creates a mem pool.
+ *
+ *  @modif  None
+ *  ============================================================================
+ */
+NORMAL_API
+DSP_STATUS RING_IO_OS_init( Void) {
+	DSP_STATUS status = DSP_SOK;
+	Pvoid addr = NULL;
+	Char8 * sync;
+	Uint32 i;
+
+	sync = getenv ("RING_IO_SYNC");
+	if (sync != NULL) {
+		i = 0;
+		while (   (i < RING_IO_SYNC_NUM_POLICIES)
+			   && (strcmp (sync, RING_IO_SyncNames [i]) != 0)) {
+			i++;
+		}
+		if (DSP_FAILED (RING_IO_SyncSet ((RING_IO_SyncPolicy) i))) {
+			RING_IO_0Print ("Unknown RING_IO_SYNC policy, using the "
+					"default\n");
+		}
+	}
+#ifndef RING_IO_MULTIPROCESS
+	RING_IO_Fibers.current = -1;
+	sem_init (&RING_IO_Fibers.kick, 0, 0);
+	sync = getenv ("RING_IO_FIBERS");
+	if ((sync != NULL) && (strcmp (sync, "1") == 0)) {
+		RING_IO_FiberEnable (TRUE);
+	}
+#endif
+	RING_IO_0Print ("Synchronization policy : ");
+	RING_IO_0Print (RING_IO_SyncName (RING_IO_Sync));
+	RING_IO_0Print ("\n");
+
+	status = RING_IO_ShmAlloc (sizeof (RING_IO_CtrlObj), &addr);
+	if (DSP_SUCCEEDED (status)) {
+		RING_IO_Ctrl = addr;
+		/* Shared with the client processes, so always a POSIX semaphore */
+		RING_IO_Ctrl->done.policy = RING_IO_SYNC_POSIX;
+		if (sem_init (&RING_IO_Ctrl->done.sem, 1, 0) < 0) {
+			status = DSP_EFAIL;
+			RING_IO_ShmFree (addr, sizeof (RING_IO_CtrlObj));
+			RING_IO_Ctrl = NULL;
+		}
+	}
+
+	return status;
+}
+
+/** ============================================================================
+ *  @func   RING_IO_OS_exit
+ *
+ *  @desc   This function deletes a mem pool.
+ *
+ *  @modif  None
+ *  ============================================================================
+ */
+NORMAL_API
+DSP_STATUS RING_IO_OS_exit( Void) {
+	DSP_STATUS status = DSP_SOK;
+
+#ifndef RING_IO_MULTIPROCESS
+	sem_destroy (&RING_IO_Fibers.kick);
+#endif
+
+	if (RING_IO_Ctrl != NULL) {
+		sem_destroy (&RING_IO_Ctrl->done.sem);
+		status = RING_IO_ShmFree (RING_IO_Ctrl, sizeof (RING_IO_CtrlObj));
+		RING_IO_Ctrl = NULL;
+	}
+
+	return status;
+}
+
+/** ============================================================================
+ *  @func   RING_IO_Atoll
+ *
+ *  @desc   Converts ascii to long int
+ *
+ *  @modif  None
+ *  ============================================================================
+ */
+NORMAL_API
+Uint32 RING_IO_Atoll(Char8 * str) {
+	Uint32 val = 0;
+	val = strtoll(str, NULL, 16);
+	return val;
+}
+
+/** ============================================================================
+ *  @func   RING_IO_GetTimeMsec
+ *
+ *  @desc   Returns a monotonic time stamp in milliseconds.
+ *
+ *  @modif  None
+ *  ============================================================================
+ */
+NORMAL_API
+RING_IO_Uint64 RING_IO_GetTimeMsec(Void) {
+	struct timespec ts;
+
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return ((RING_IO_Uint64) ts.tv_sec * 1000u) + (ts.tv_nsec / 1000000u);
+}
+
+/** ============================================================================
+ *  @func   RING_IO_GetTimeUsec
+ *
+ *  @desc   Returns a monotonic time stamp in microseconds.
+ *
+ *  @modif  None
+ *  ============================================================================
+ */
+NORMAL_API
+RING_IO_Uint64 RING_IO_GetTimeUsec(Void) {
+	struct timespec ts;
+
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return ((RING_IO_Uint64) ts.tv_sec * 1000000u) + (ts.tv_nsec / 1000u);
 }
 
 /** ============================================================================
- *  @func   RING_IO_Exit_client
+ *  @func   RING_IO_AtomicCas
  *
- *  @desc   Function to exit from a caller task(thread/process).
+ *  @desc   Atomically replaces a word if it holds an expected value.
  *
  *  @modif  None
  *  ============================================================================
  */
-EXPORT_API
-DSP_STATUS RING_IO_Exit_client(RING_IO_ClientInfo *pInfo) {
+NORMAL_API
+Bool RING_IO_AtomicCas(IN volatile Uint32 * addr,
+		IN Uint32 oldVal,
+		IN Uint32 newVal) {
+	return (__sync_bool_compare_and_swap(addr, oldVal, newVal) ? TRUE : FALSE);
+}
+
+/** ============================================================================
+ *  @func   RING_IO_AtomicAdd64
+ *
+ *  @desc   Atomically adds to a 64-bit counter.
+ *
+ *  @modif  None
+ *  ============================================================================
+ */
+NORMAL_API
+Void RING_IO_AtomicAdd64(IN volatile RING_IO_Uint64 * addr,
+		IN RING_IO_Uint64 value) {
+	__sync_fetch_and_add(addr, value);
+}
+
+/** ============================================================================
+ *  @func   RING_IO_MemBarrier
+ *
+ *  @desc   Full memory barrier.
+ *
+ *  @modif  None
+ *  ============================================================================
+ */
+NORMAL_API
+Void RING_IO_MemBarrier(Void) {
+	__sync_synchronize();
+}
+
+/*
+ * The __atomic builtins give the exact ordering where the toolchain has
+ * them, older ones fall back on the __sync builtins, which are stronger.
+ */
+
+/** ============================================================================
+ *  @func   RING_IO_AtomicOr
+ *
+ *  @desc   Atomically sets bits of a word, with release ordering.
+ *
+ *  @modif  None
+ *  ============================================================================
+ */
+NORMAL_API
+Uint32 RING_IO_AtomicOr(IN volatile Uint32 * addr,
+		IN Uint32 bits) {
+#if defined (__ATOMIC_RELEASE)
+	return (__atomic_fetch_or(addr, bits, __ATOMIC_RELEASE));
+#else
+	return (__sync_fetch_and_or(addr, bits));
+#endif /* defined (__ATOMIC_RELEASE) */
+}
+
+/** ============================================================================
+ *  @func   RING_IO_AtomicXchg
+ *
+ *  @desc   Atomically replaces a word, with acquire ordering.
+ *
+ *  @modif  None
+ *  ============================================================================
+ */
+NORMAL_API
+Uint32 RING_IO_AtomicXchg(IN volatile Uint32 * addr,
+		IN Uint32 newVal) {
+#if defined (__ATOMIC_ACQUIRE)
+	return (__atomic_exchange_n(addr, newVal, __ATOMIC_ACQUIRE));
+#else
+	return (__sync_lock_test_and_set(addr, newVal));
+#endif /* defined (__ATOMIC_ACQUIRE) */
+}
+
+/** ============================================================================
+ *  @func   RING_IO_AtomicLoad
+ *
+ *  @desc   Reads a word with acquire ordering.
+ *
+ *  @modif  None
+ *  ============================================================================
+ */
+NORMAL_API
+Uint32 RING_IO_AtomicLoad(IN volatile Uint32 * addr) {
+#if defined (__ATOMIC_ACQUIRE)
+	return (__atomic_load_n(addr, __ATOMIC_ACQUIRE));
+#else
+	Uint32 value = *addr;
+
+	__sync_synchronize();
+	return (value);
+#endif /* defined (__ATOMIC_ACQUIRE) */
+}
+
+/** ============================================================================
+ *  @func   RING_IO_ShmAlloc
+ *
+ *  @desc   Allocates zeroed memory shared with the clients. The mapping is
+ *          inherited by the processes forked afterwards.
+ *
+ *  @modif  None
+ *  ============================================================================
+ */
+NORMAL_API
+DSP_STATUS
+RING_IO_ShmAlloc (IN Uint32 size, OUT Pvoid * addr)
+{
+	DSP_STATUS status = DSP_SOK;
+	Pvoid map;
+
+	/* Anonymous mappings are zero filled */
+	map = mmap (NULL,
+			size,
+			PROT_READ | PROT_WRITE,
+			MAP_SHARED | MAP_ANONYMOUS,
+			-1,
+			0);
+	if (map == MAP_FAILED) {
+		status = DSP_EMEMORY;
+		*addr = NULL;
+		RING_IO_1Print ("mmap () of shared memory failed. errno = %d\n",
+				errno);
+	}
+	else {
+		*addr = map;
+	}
+
+	return (status);
+}
+
+/** ============================================================================
+ *  @func   RING_IO_ShmFree
+ *
+ *  @desc   Frees memory allocated by RING_IO_ShmAlloc ().
+ *
+ *  @modif  None
+ *  ============================================================================
+ */
+NORMAL_API
+DSP_STATUS
+RING_IO_ShmFree (IN Pvoid addr, IN Uint32 size)
+{
 	DSP_STATUS status = DSP_SOK;
 
+	if (munmap (addr, size) < 0) {
+		status = DSP_EFAIL;
+	}
+
+	return (status);
+}
+
+/** ============================================================================
+ *  @func   RING_IO_GetUsage
+ *
+ *  @desc   Returns the resource usage of the calling thread or process.
+ *
+ *  @modif  None
+ *  ============================================================================
+ */
+NORMAL_API
+Void
+RING_IO_GetUsage (OUT RING_IO_Usage * usage)
+{
+	struct rusage ru;
+
 #ifdef RING_IO_MULTIPROCESS
-	if(pInfo != NULL) {
-		PROC_detach(pInfo->processorId);
+	getrusage (RUSAGE_SELF, &ru);
+#else
+	getrusage (RUSAGE_THREAD, &ru);
+#endif
+	usage->maxRss = (RING_IO_Uint64) ru.ru_maxrss;
+	usage->volCsw = (RING_IO_Uint64) ru.ru_nvcsw;
+	usage->involCsw = (RING_IO_Uint64) ru.ru_nivcsw;
+}
+
+/** ============================================================================
+ *  @func   RING_IO_ClientKind
+ *
+ *  @desc   Returns how clients are run by this build.
+ *
+ *  @modif  None
+ *  ============================================================================
+ */
+NORMAL_API
+Char8 *
+RING_IO_ClientKind (Void)
+{
+#ifdef RING_IO_MULTIPROCESS
+	return ("process");
+#else
+	return ("thread");
+#endif
+}
+
+/** ============================================================================
+ *  @func   RING_IO_FiberEnable
+ *
+ *  @desc   Selects whether the clients created from now on are fibers.
+ *
+ *  @modif  RING_IO_Fibers
+ *  ============================================================================
+ */
+NORMAL_API
+DSP_STATUS
+RING_IO_FiberEnable (IN Bool enable)
+{
+	DSP_STATUS status = DSP_SOK;
+
+#ifdef RING_IO_MULTIPROCESS
+	if (enable == TRUE) {
+		status = DSP_EFAIL;
+		RING_IO_0Print ("Fibers are not available with client processes\n");
 	}
-	exit (0);
 #else
-	pthread_exit(NULL);
+	RING_IO_Fibers.enabled = enable;
 #endif
 
 	return (status);
 }
 
 /** ============================================================================
- *  @func   RING_IO_OS_init
+ *  @func   RING_IO_CtrlGet
  *
- *  @desc   This function creates a mem pool.
+ *  @desc   Returns the control block shared with the clients.
  *
  *  @modif  None
  *  ============================================================================
  */
 NORMAL_API
-DSP_STATUS RING_IO_OS_init( Void) {
-	DSP_STATUS status = DSP_SOK;
+RING_IO_CtrlBlock *
+RING_IO_CtrlGet (Void)
+{
+	return (&RING_IO_Ctrl->block);
+}
 
-	return status;
+/** ============================================================================
+ *  @func   RING_IO_CtrlStop
+ *
+ *  @desc   Asks all the clients to stop.
+ *
+ *  @modif  RING_IO_Ctrl
+ *  ============================================================================
+ */
+NORMAL_API
+Void
+RING_IO_CtrlStop (Void)
+{
+	RING_IO_AtomicOr (&RING_IO_Ctrl->block.stop, TRUE);
 }
 
 /** ============================================================================
- *  @func   RING_IO_OS_exit
+ *  @func   RING_IO_CtrlWait
  *
- *  @desc   This function deletes a mem pool.
+ *  @desc   Waits for all the clients to exit, reporting the throughput.
  *
- *  @modif  None
+ *  @modif  RING_IO_Ctrl
  *  ============================================================================
  */
 NORMAL_API
-DSP_STATUS RING_IO_OS_exit( Void) {
+Void
+RING_IO_CtrlWait (Void)
+{
+	RING_IO_CtrlBlock * block = &RING_IO_Ctrl->block;
+	RING_IO_Uint64 lastBytes = 0;
+	RING_IO_Uint64 lastTime;
+	RING_IO_Uint64 bytes;
+	RING_IO_Uint64 now;
+	DSP_STATUS status;
+	Uint32 i;
+
+	lastTime = RING_IO_GetTimeUsec ();
+	while (block->clients != 0) {
+		status = RING_IO_TimedWaitSem (&RING_IO_Ctrl->done,
+				RING_IO_CTRL_PERIOD);
+		if (status == DSP_SOK) {
+			/* Once a client is done, the others have no one to talk to */
+			RING_IO_CtrlStop ();
+		}
+		else if (status == DSP_ETIMEOUT) {
+			bytes = 0;
+			for (i = 0; i < RING_IO_CTRL_CHNLS; i++) {
+				bytes += block->chnls [i].bytesSent
+						+ block->chnls [i].bytesRcvd;
+			}
+			now = RING_IO_GetTimeUsec ();
+			RING_IO_1Print ("Clients running : %d\n", block->clients);
+			RING_IO_1Print64 ("Bytes transferred : %llu\n", bytes);
+			RING_IO_1Print64 ("Throughput (KB/s) : %llu\n",
+					((bytes - lastBytes) * 1000u) / (now - lastTime));
+			lastBytes = bytes;
+			lastTime = now;
+		}
+		else {
+			break;
+		}
+	}
+}
+
+/** ============================================================================
+ *  @name   RING_IO_LayoutPacked
+ *
+ *  @desc   State of a channel as laid out before RING_IO_CtrlChnl split it
+ *          over cache lines, the reference of RING_IO_CtrlLayoutBench ().
+ *
+ *  @field  bytesSent, bytesRcvd, readerEvents
+ *              As in RING_IO_CtrlChnl.
+ *  ============================================================================
+ */
+typedef struct RING_IO_LayoutPacked_tag {
+	volatile RING_IO_Uint64  bytesSent;
+	volatile RING_IO_Uint64  bytesRcvd;
+	volatile Uint32          readerEvents;
+} RING_IO_LayoutPacked;
+
+/** ============================================================================
+ *  @name   RING_IO_LayoutArg
+ *
+ *  @desc   Work of a thread of RING_IO_CtrlLayoutBench ().
+ *
+ *  @field  counter
+ *              Counter added to, NULL for the notification thread.
+ *  @field  flag
+ *              Event mask set by the notification thread and polled by the
+ *              reader thread, NULL for the writer thread.
+ *  @field  iterations
+ *              Number of updates.
+ *  @field  seen
+ *              Sum of the values of the flag polled, so that the polls are
+ *              not optimized out.
+ *  ============================================================================
+ */
+typedef struct RING_IO_LayoutArg_tag {
+	volatile RING_IO_Uint64 * counter;
+	volatile Uint32 *         flag;
+	Uint32                    iterations;
+	Uint32                    seen;
+} RING_IO_LayoutArg;
+
+/** ----------------------------------------------------------------------------
+ *  @func   RING_IO_LayoutThread
+ *
+ *  @desc   Body of a thread of RING_IO_CtrlLayoutBench ().
+ *
+ *  @modif  seen of the argument.
+ *  ----------------------------------------------------------------------------
+ */
+STATIC
+NORMAL_API
+Void *
+RING_IO_LayoutThread (IN Void * ptr)
+{
+	RING_IO_LayoutArg * arg = (RING_IO_LayoutArg *) ptr;
+	Uint32 i;
+
+	for (i = 0; i < arg->iterations; i++) {
+		if (arg->counter == NULL) {
+			RING_IO_AtomicOr (arg->flag, RING_IO_EVENT_DATA);
+		}
+		else {
+			RING_IO_AtomicAdd64 (arg->counter, 1u);
+			if (arg->flag != NULL) {
+				arg->seen += RING_IO_AtomicLoad (arg->flag);
+			}
+		}
+	}
+
+	return (NULL);
+}
+
+/** ----------------------------------------------------------------------------
+ *  @func   RING_IO_LayoutMissCounter
+ *
+ *  @desc   Opens a counter of the cache misses of the calling thread and of
+ *          the threads it creates afterwards.
+ *
+ *  @ret    File descriptor of the counter, -1 if not available.
+ *
+ *  @modif  None
+ *  ----------------------------------------------------------------------------
+ */
+STATIC
+NORMAL_API
+int
+RING_IO_LayoutMissCounter (Void)
+{
+	int fd = -1;
+#if defined (__NR_perf_event_open)
+	struct perf_event_attr attr;
+
+	memset (&attr, 0, sizeof (attr));
+	attr.type = PERF_TYPE_HARDWARE;
+	attr.size = sizeof (attr);
+	attr.config = PERF_COUNT_HW_CACHE_MISSES;
+	attr.disabled = 1;
+	attr.inherit = 1;
+	attr.exclude_kernel = 1;
+	attr.exclude_hv = 1;
+	fd = (int) syscall (__NR_perf_event_open, &attr, 0, -1, -1, 0);
+#endif /* defined (__NR_perf_event_open) */
+
+	return (fd);
+}
+
+/** ----------------------------------------------------------------------------
+ *  @func   RING_IO_LayoutRun
+ *
+ *  @desc   Runs the threads of RING_IO_CtrlLayoutBench () on one layout and
+ *          prints the measurements.
+ *
+ *  @modif  The counters and flags the threads work on.
+ *  ----------------------------------------------------------------------------
+ */
+STATIC
+NORMAL_API
+DSP_STATUS
+RING_IO_LayoutRun (IN Char8 * name,
+		IN RING_IO_LayoutArg * args,
+		IN Uint32 numArgs)
+{
 	DSP_STATUS status = DSP_SOK;
+	pthread_t tids [3u * RING_IO_LAYOUT_CHNLS];
+	RING_IO_Uint64 start;
+	RING_IO_Uint64 elapsed;
+	RING_IO_Uint64 misses = 0;
+	Uint32 numThreads = 0;
+	int fd;
+	Uint32 i;
 
-	return status;
+	fd = RING_IO_LayoutMissCounter ();
+	if (fd >= 0) {
+		ioctl (fd, PERF_EVENT_IOC_RESET, 0);
+		ioctl (fd, PERF_EVENT_IOC_ENABLE, 0);
+	}
+
+	start = RING_IO_GetTimeUsec ();
+	for (i = 0; i < numArgs; i++) {
+		if (pthread_create (&tids [i],
+				NULL,
+				RING_IO_LayoutThread,
+				&args [i]) != 0) {
+			status = DSP_EFAIL;
+			break;
+		}
+		numThreads++;
+	}
+	for (i = 0; i < numThreads; i++) {
+		pthread_join (tids [i], NULL);
+	}
+	elapsed = RING_IO_GetTimeUsec () - start;
+
+	if (fd >= 0) {
+		/* The counts of the joined threads are folded into this one */
+		ioctl (fd, PERF_EVENT_IOC_DISABLE, 0);
+		if (read (fd, &misses, sizeof (misses)) != sizeof (misses)) {
+			misses = 0;
+		}
+		close (fd);
+	}
+
+	if (DSP_SUCCEEDED (status)) {
+		RING_IO_0Print ("LAYOUT ");
+		RING_IO_0Print (name);
+		RING_IO_1Print (" chnls %u", RING_IO_LAYOUT_CHNLS);
+		RING_IO_1Print (" threads %u", numThreads);
+		RING_IO_1Print64 (" ns_per_iteration %llu",
+				(elapsed * 1000u) / args [0].iterations);
+		if (fd >= 0) {
+			RING_IO_1Print64 (" cache_misses %llu", misses);
+		}
+		RING_IO_0Print ("\n");
+	}
+
+	return (status);
 }
 
 /** ============================================================================
- *  @func   RING_IO_Atoll
+ *  @func   RING_IO_CtrlLayoutBench
  *
- *  @desc   Converts ascii to long int
+ *  @desc   Measures the packed and split layouts of the channel state.
  *
  *  @modif  None
  *  ============================================================================
  */
 NORMAL_API
-Uint32 RING_IO_Atoll(Char8 * str) {
-	Uint32 val = 0;
-	val = strtoll(str, NULL, 16);
-	return val;
+DSP_STATUS
+RING_IO_CtrlLayoutBench (IN Uint32 iterations)
+{
+	DSP_STATUS status = DSP_SOK;
+	RING_IO_LayoutArg args [3u * RING_IO_LAYOUT_CHNLS];
+	RING_IO_LayoutPacked * packed = NULL;
+	RING_IO_CtrlChnl * split = NULL;
+	Pvoid addr = NULL;
+	Uint32 i;
+
+	if (iterations == 0) {
+		iterations = 1;
+	}
+
+	if (posix_memalign (&addr,
+			RING_IO_CACHE_LINE,
+			RING_IO_LAYOUT_CHNLS * sizeof (RING_IO_LayoutPacked)) == 0) {
+		packed = (RING_IO_LayoutPacked *) addr;
+		memset (packed, 0, RING_IO_LAYOUT_CHNLS * sizeof (*packed));
+	}
+	if (posix_memalign (&addr,
+			RING_IO_CACHE_LINE,
+			RING_IO_LAYOUT_CHNLS * sizeof (RING_IO_CtrlChnl)) == 0) {
+		split = (RING_IO_CtrlChnl *) addr;
+		memset (split, 0, RING_IO_LAYOUT_CHNLS * sizeof (*split));
+	}
+	if ((packed == NULL) || (split == NULL)) {
+		status = DSP_EMEMORY;
+	}
+
+	if (DSP_SUCCEEDED (status)) {
+		memset (args, 0, sizeof (args));
+		for (i = 0; i < RING_IO_LAYOUT_CHNLS; i++) {
+			args [3u * i].counter = &packed [i].bytesSent;
+			args [(3u * i) + 1u].counter = &packed [i].bytesRcvd;
+			args [(3u * i) + 1u].flag = &packed [i].readerEvents;
+			args [(3u * i) + 2u].flag = &packed [i].readerEvents;
+		}
+		for (i = 0; i < (3u * RING_IO_LAYOUT_CHNLS); i++) {
+			args [i].iterations = iterations;
+		}
+		status = RING_IO_LayoutRun ("packed", args, 3u * RING_IO_LAYOUT_CHNLS);
+	}
+
+	if (DSP_SUCCEEDED (status)) {
+		for (i = 0; i < RING_IO_LAYOUT_CHNLS; i++) {
+			args [3u * i].counter = &split [i].bytesSent;
+			args [(3u * i) + 1u].counter = &split [i].bytesRcvd;
+			args [(3u * i) + 1u].flag = &split [i].readerEvents;
+			args [(3u * i) + 2u].flag = &split [i].readerEvents;
+		}
+		status = RING_IO_LayoutRun ("split", args, 3u * RING_IO_LAYOUT_CHNLS);
+	}
+
+	free (packed);
+	free (split);
+
+	return (status);
 }
 
 #if defined (__cplusplus)
@@ -49,6 +49,9 @@
 /*  ----------------------------------- DSP/BIOS Link                 */
 #include <dsplink.h>
 
+/*  ----------------------------------- Application Header            */
+#include <ring_io.h>
+
 
 #if defined (__cplusplus)
 extern "C" {
@@ -58,8 +61,20 @@ extern "C" {
 #define     API_RESTART     DSP_ERESTART /* To restart an  function call if it is
                                          * interrupted by a signal
                                          */
+
 #endif
 
+/** ============================================================================
+ *  @const  RING_IO_POOL_WORKERS
+ *
+ *  @desc   Number of workers of the client pool: processes forked and
+ *          attached to DSP/BIOS Link ahead of time, which run the clients
+ *          created without argument, in multiprocess builds, and threads
+ *          pinned to a CPU each, which run any client, in thread builds.
+ *  ============================================================================
+ */
+#define     RING_IO_POOL_WORKERS    4u
+
 
 /** ============================================================================
  *  @name   RING_IO_ClientInfo
@@ -70,6 +85,12 @@ extern "C" {
  *              Thread Identification number.
  *  @field  processorId
  *              ID of the dsp processor.
+ *  @field  worker
+ *              Index of the pool worker running the client, -1 if the client
+ *              runs in a process or a thread of its own.
+ *  @field  fiber
+ *              Index of the fiber running the client, -1 if the client runs
+ *              in a thread of its own. Thread builds only.
  *
  *  ============================================================================
  */
@@ -78,13 +99,227 @@ typedef struct RINIG_IO_ClientInfo_tag {
 #ifdef RING_IO_MULTIPROCESS
     pid_t      pid ;
     char       processName[32];
+    Int32      worker ;
 #else
     pthread_t  tid ;
+    Int32      worker ;
+    Int32      fiber ;
 #endif
     Uint8      processorId ;
 
 } RING_IO_ClientInfo ;
 
+/** ============================================================================
+ *  @const  RING_IO_CACHE_LINE
+ *
+ *  @desc   Size of a cache line of the GPP.
+ *  ============================================================================
+ */
+#define RING_IO_CACHE_LINE      64u
+
+/** ============================================================================
+ *  @const  RING_IO_CACHE_ALIGN
+ *
+ *  @desc   Starts a field or a variable on a cache line of its own, so that
+ *          the ones written by different threads or processes do not share
+ *          a line.
+ *  ============================================================================
+ */
+#define RING_IO_CACHE_ALIGN     __attribute__ ((aligned (RING_IO_CACHE_LINE)))
+
+/** ============================================================================
+ *  @const  RING_IO_CTRL_CHNLS
+ *
+ *  @desc   Number of channels accounted for in the control block.
+ *  ============================================================================
+ */
+#define RING_IO_CTRL_CHNLS      2u
+
+/** ============================================================================
+ *  @const  RING_IO_CTRL_PERIOD
+ *
+ *  @desc   Period in microseconds of the throughput reports of
+ *          RING_IO_CtrlWait ().
+ *  ============================================================================
+ */
+#define RING_IO_CTRL_PERIOD     1000000u
+
+/** ============================================================================
+ *  @const  RING_IO_LAYOUT_CHNLS
+ *
+ *  @desc   Number of channels simulated by RING_IO_CtrlLayoutBench ().
+ *  ============================================================================
+ */
+#define RING_IO_LAYOUT_CHNLS    4u
+
+/** ============================================================================
+ *  @const  RING_IO_EVENT_START, RING_IO_EVENT_END, RING_IO_EVENT_DATA
+ *
+ *  @desc   Events passed by a reader notification to the reader thread. They
+ *          are bits of a mask set with RING_IO_AtomicOr () and consumed all
+ *          at once with RING_IO_AtomicXchg (). The semaphore of the reader
+ *          is posted only when the mask was empty, so that one wakeup
+ *          consumes all the events notified meanwhile.
+ *  ============================================================================
+ */
+#define RING_IO_EVENT_START     0x1u
+#define RING_IO_EVENT_END       0x2u
+#define RING_IO_EVENT_DATA      0x4u
+
+/** ============================================================================
+ *  @name   RING_IO_CtrlChnl
+ *
+ *  @desc   State of a channel in the control block. What the writer, the
+ *          reader and the reader notification write is on three separate
+ *          cache lines.
+ *
+ *  @field  bytesSent
+ *              Number of bytes sent to the DSP.
+ *  @field  bytesRcvd
+ *              Number of bytes received from the DSP.
+ *  @field  readerEvents
+ *              RING_IO_EVENT_* notified by the DSP and not yet consumed by
+ *              the reader.
+ *  ============================================================================
+ */
+typedef struct RING_IO_CtrlChnl_tag {
+    volatile RING_IO_Uint64  bytesSent RING_IO_CACHE_ALIGN ;
+    volatile RING_IO_Uint64  bytesRcvd RING_IO_CACHE_ALIGN ;
+    volatile Uint32          readerEvents RING_IO_CACHE_ALIGN ;
+} RING_IO_CtrlChnl ;
+
+/** ============================================================================
+ *  @name   RING_IO_CtrlBlock
+ *
+ *  @desc   Control block shared by the application and all its clients,
+ *          threads or processes. The counters are updated with atomic
+ *          operations.
+ *
+ *  @field  stop
+ *              Set to ask the clients to stop.
+ *  @field  clients
+ *              Number of clients running.
+ *  @field  dspCaps
+ *              Capability flags of the RINGIO_DATA_START parameter announced
+ *              by the DSP, zero until its first transfer started.
+ *  @field  chnls
+ *              State of the channels, after the line of the fields above.
+ *  ============================================================================
+ */
+typedef struct RING_IO_CtrlBlock_tag {
+    volatile Uint32   stop ;
+    volatile Uint32   clients ;
+    volatile Uint32   dspCaps ;
+    RING_IO_CtrlChnl  chnls [RING_IO_CTRL_CHNLS] ;
+} RING_IO_CtrlBlock ;
+
+/** ============================================================================
+ *  @name   RING_IO_SyncPolicy
+ *
+ *  @desc   Synchronization policies of the semaphores of the OS layer.
+ *
+ *  @field  RING_IO_SYNC_POSIX
+ *              POSIX semaphore.
+ *  @field  RING_IO_SYNC_FUTEX
+ *              Counter with a futex, posts without waiters stay in user
+ *              space.
+ *  @field  RING_IO_SYNC_EVENTFD
+ *              Semaphore eventfd.
+ *  @field  RING_IO_SYNC_SPIN
+ *              As RING_IO_SYNC_FUTEX, spinning RING_IO_SYNC_SPINS rounds
+ *              before sleeping. RING_IO_YieldClient () also spins first.
+ *  @field  RING_IO_SYNC_CONDVAR
+ *              Counter protected by a mutex with a condition variable.
+ *  ============================================================================
+ */
+typedef enum {
+    RING_IO_SYNC_POSIX   = 0u,
+    RING_IO_SYNC_FUTEX   = 1u,
+    RING_IO_SYNC_EVENTFD = 2u,
+    RING_IO_SYNC_SPIN    = 3u,
+    RING_IO_SYNC_CONDVAR = 4u
+} RING_IO_SyncPolicy ;
+
+/** ============================================================================
+ *  @const  RING_IO_SYNC_NUM_POLICIES
+ *
+ *  @desc   Number of synchronization policies.
+ *  ============================================================================
+ */
+#define RING_IO_SYNC_NUM_POLICIES   5u
+
+/** ============================================================================
+ *  @const  RING_IO_SYNC_DEFAULT
+ *
+ *  @desc   Synchronization policy used unless the RING_IO_SYNC environment
+ *          variable names another one. Can be overridden at build time.
+ *  ============================================================================
+ */
+#if !defined (RING_IO_SYNC_DEFAULT)
+#define RING_IO_SYNC_DEFAULT        RING_IO_SYNC_POSIX
+#endif /* !defined (RING_IO_SYNC_DEFAULT) */
+
+/** ============================================================================
+ *  @const  RING_IO_SYNC_SPINS
+ *
+ *  @desc   Number of rounds RING_IO_SYNC_SPIN spins before sleeping.
+ *  ============================================================================
+ */
+#define RING_IO_SYNC_SPINS          1000u
+
+/** ============================================================================
+ *  @const  RING_IO_SYNC_FOREVER
+ *
+ *  @desc   Timeout waiting forever.
+ *  ============================================================================
+ */
+#define RING_IO_SYNC_FOREVER        0xFFFFFFFFu
+
+/** ============================================================================
+ *  @const  RING_IO_FIBER_MAX
+ *
+ *  @desc   Maximum number of clients running as fibers.
+ *  ============================================================================
+ */
+#define RING_IO_FIBER_MAX           256u
+
+/** ============================================================================
+ *  @const  RING_IO_FIBER_STACK_SIZE
+ *
+ *  @desc   Stack size of a fiber, instead of the 8 MB of a thread.
+ *  ============================================================================
+ */
+#define RING_IO_FIBER_STACK_SIZE    65536u
+
+/** ============================================================================
+ *  @const  RING_IO_FIBER_IDLE
+ *
+ *  @desc   Longest time in microseconds the scheduler sleeps when no fiber
+ *          can go on, before checking them again.
+ *  ============================================================================
+ */
+#define RING_IO_FIBER_IDLE          10000u
+
+/** ============================================================================
+ *  @name   RING_IO_Usage
+ *
+ *  @desc   Resource usage of a client: of its thread in thread builds, of its
+ *          process in RING_IO_MULTIPROCESS builds.
+ *
+ *  @field  maxRss
+ *              Peak resident set size in KB.
+ *  @field  volCsw
+ *              Number of voluntary context switches.
+ *  @field  involCsw
+ *              Number of involuntary context switches.
+ *  ============================================================================
+ */
+typedef struct RING_IO_Usage_tag {
+    RING_IO_Uint64  maxRss ;
+    RING_IO_Uint64  volCsw ;
+    RING_IO_Uint64  involCsw ;
+} RING_IO_Usage ;
+
 /** ============================================================================
  *  @func   atoi
  *
@@ -153,10 +388,78 @@ NORMAL_API
 Void
 RING_IO_IntToString (IN Int num, OUT Char8 * str) ;
 
+/** ============================================================================
+ *  @func   RING_IO_SyncSet
+ *
+ *  @desc   Selects the synchronization policy of the semaphores created from
+ *          now on. Existing semaphores keep theirs.
+ *
+ *  @arg    policy
+ *              Synchronization policy.
+ *
+ *  @ret    DSP_SOK
+ *              Operation successfully completed.
+ *          DSP_EINVALIDARG
+ *              Unknown policy.
+ *
+ *  @enter  None
+ *
+ *  @leave  None
+ *
+ *  @see    RING_IO_SyncGet, RING_IO_CreateSem
+ *  ============================================================================
+ */
+NORMAL_API
+DSP_STATUS
+RING_IO_SyncSet (IN RING_IO_SyncPolicy policy) ;
+
+/** ============================================================================
+ *  @func   RING_IO_SyncGet
+ *
+ *  @desc   Returns the synchronization policy of new semaphores.
+ *
+ *  @arg    None
+ *
+ *  @ret    The synchronization policy.
+ *
+ *  @enter  None
+ *
+ *  @leave  None
+ *
+ *  @see    RING_IO_SyncSet
+ *  ============================================================================
+ */
+NORMAL_API
+RING_IO_SyncPolicy
+RING_IO_SyncGet (Void) ;
+
+/** ============================================================================
+ *  @func   RING_IO_SyncName
+ *
+ *  @desc   Returns the name of a synchronization policy, as accepted in the
+ *          RING_IO_SYNC environment variable.
+ *
+ *  @arg    policy
+ *              Synchronization policy.
+ *
+ *  @ret    The name of the policy.
+ *
+ *  @enter  None
+ *
+ *  @leave  None
+ *
+ *  @see    RING_IO_SyncSet
+ *  ============================================================================
+ */
+NORMAL_API
+Char8 *
+RING_IO_SyncName (IN RING_IO_SyncPolicy policy) ;
+
 /** ============================================================================
  *  @func   RING_IO_CreateSem
  *
- *  @desc   This function creates a semaphore.
+ *  @desc   This function creates a semaphore with the synchronization policy
+ *          selected by RING_IO_SyncSet ().
  *
  *  @arg    semPtr
  *              Location to receive the semaphore object.
@@ -201,6 +504,59 @@ NORMAL_API
 DSP_STATUS
 RING_IO_DeleteSem (IN Pvoid semHandle) ;
 
+/** ============================================================================
+ *  @func   RING_IO_CreateShmSem
+ *
+ *  @desc   Creates a semaphore in shared memory, which the clients created
+ *          afterwards can wait on and post whether they are threads or
+ *          processes. It is always a POSIX semaphore, whatever the
+ *          synchronization policy.
+ *
+ *  @arg    semPtr
+ *              Location to receive the semaphore object.
+ *
+ *  @ret    DSP_SOK
+ *              Operation successfully completed.
+ *          DSP_EMEMORY
+ *              Out of memory.
+ *          DSP_EFAIL
+ *              General failure.
+ *
+ *  @enter  None
+ *
+ *  @leave  None
+ *
+ *  @see    RING_IO_DeleteShmSem
+ *  ============================================================================
+ */
+NORMAL_API
+DSP_STATUS
+RING_IO_CreateShmSem (OUT Pvoid * semPtr) ;
+
+/** ============================================================================
+ *  @func   RING_IO_DeleteShmSem
+ *
+ *  @desc   Deletes a semaphore created by RING_IO_CreateShmSem ().
+ *
+ *  @arg    semHandle
+ *              Pointer to the semaphore object to be deleted.
+ *
+ *  @ret    DSP_SOK
+ *              Operation successfully completed.
+ *          DSP_EFAIL
+ *              General failure.
+ *
+ *  @enter  No client uses the semaphore any more.
+ *
+ *  @leave  None
+ *
+ *  @see    RING_IO_CreateShmSem
+ *  ============================================================================
+ */
+NORMAL_API
+DSP_STATUS
+RING_IO_DeleteShmSem (IN Pvoid semHandle) ;
+
 /** ============================================================================
  *  @func   RING_IO_WaitSem
  *
@@ -225,6 +581,34 @@ NORMAL_API
 DSP_STATUS
 RING_IO_WaitSem (IN Pvoid semHandle) ;
 
+/** ============================================================================
+ *  @func   RING_IO_TimedWaitSem
+ *
+ *  @desc   This function waits on a semaphore for a bounded time.
+ *
+ *  @arg    semHandle
+ *              Pointer to the semaphore object to wait on.
+ *  @arg    timeout
+ *              Maximum time to wait in microseconds.
+ *
+ *  @ret    DSP_SOK
+ *              Operation successfully completed.
+ *          DSP_ETIMEOUT
+ *              The semaphore was not posted in time.
+ *          DSP_EFAIL
+ *              General failure.
+ *
+ *  @enter  None
+ *
+ *  @leave  None
+ *
+ *  @see    RING_IO_WaitSem
+ *  ============================================================================
+ */
+NORMAL_API
+DSP_STATUS
+RING_IO_TimedWaitSem (IN Pvoid semHandle, IN Uint32 timeout) ;
+
 /** ============================================================================
  *  @func   RING_IO_PostSem
  *
@@ -253,6 +637,13 @@ RING_IO_PostSem (IN Pvoid semHandle) ;
  *  @func   RING_IO_Create_client
  *
  *  @desc   Function to create a new thread or a Process..
+ *          In multiprocess builds, a client created without argument is run
+ *          by an idle worker of a pool of processes already attached to
+ *          DSP/BIOS Link. In thread builds, a client is run by an idle
+ *          thread of a pool of threads pinned to a CPU each, and Join only
+ *          waits for the client to return. The pool is started by the first
+ *          client it runs. A client finding no idle worker runs in a process
+ *          or a thread of its own.
  *
  *  @modif  None
  *  ============================================================================
@@ -262,58 +653,98 @@ Uint32
 RING_IO_Create_client (RING_IO_ClientInfo * pInfo, Pvoid funcPtr, Pvoid args);
 
 /** ============================================================================
- *  @func   RING_IO_Join_client
+ *  @func   RING_IO_CreateThread
  *
- *  @desc   Wait for thread/process to terminate.
+ *  @desc   Creates a helper thread in the calling client, whatever the build.
+ *          Unlike a client, it shares the memory of its creator, is never a
+ *          fiber and is not run by the pool. It must not call
+ *          RING_IO_Exit_client ().
  *
- *  @modif  None
+ *  @arg    threadPtr
+ *              Location to receive the handle of the thread.
+ *  @arg    funcPtr
+ *              Function run by the thread, taking and returning a pointer.
+ *  @arg    args
+ *              Argument of the function.
+ *
+ *  @ret    DSP_SOK
+ *              Operation successfully completed.
+ *          DSP_EMEMORY
+ *              Out of memory.
+ *          DSP_EFAIL
+ *              The thread could not be created.
+ *
+ *  @enter  None
+ *
+ *  @leave  None
+ *
+ *  @see    RING_IO_JoinThread
  *  ============================================================================
  */
-EXPORT_API
+NORMAL_API
 DSP_STATUS
-RING_IO_Join_client (RING_IO_ClientInfo *pInfo);
+RING_IO_CreateThread (OUT Pvoid * threadPtr, IN Pvoid funcPtr, IN Pvoid args) ;
 
 /** ============================================================================
- *  @func   RING_IO_Exit_client
+ *  @func   RING_IO_JoinThread
  *
- *  @desc   Function to exit from a caller task(thread/process).
+ *  @desc   Waits for a helper thread to return and frees its handle.
  *
- *  @modif  None
+ *  @arg    threadHandle
+ *              Handle of the thread.
+ *
+ *  @ret    DSP_SOK
+ *              Operation successfully completed.
+ *          DSP_EFAIL
+ *              General failure.
+ *
+ *  @enter  None
+ *
+ *  @leave  None
+ *
+ *  @see    RING_IO_CreateThread
  *  ============================================================================
  */
-EXPORT_API
+NORMAL_API
 DSP_STATUS
-RING_IO_Exit_client (RING_IO_ClientInfo *pInfo);
+RING_IO_JoinThread (IN Pvoid threadHandle) ;
 
 /** ============================================================================
- *  @func   RING_IO_OS_init
+ *  @func   RING_IO_ShmAlloc
  *
- *  @desc   This function creates a memory pool.
+ *  @desc   Allocates zeroed memory shared with the clients created
+ *          afterwards, whether they are threads or processes.
  *
- *  @arg    none
+ *  @arg    size
+ *              Size of the memory.
+ *  @arg    addr
+ *              Location to receive the address of the memory.
  *
  *  @ret    DSP_SOK
  *              Operation successfully completed.
- *          DSP_EFAIL
- *              General failure.
+ *          DSP_EMEMORY
+ *              Out of memory.
  *
  *  @enter  None
  *
  *  @leave  None
  *
- *  @see    None
+ *  @see    RING_IO_ShmFree
  *  ============================================================================
  */
 NORMAL_API
 DSP_STATUS
-RING_IO_OS_init (Void) ;
+RING_IO_ShmAlloc (IN Uint32 size, OUT Pvoid * addr) ;
 
 /** ============================================================================
- *  @func   RING_IO_OS_enit
+ *  @func   RING_IO_ShmFree
  *
- *  @desc   This function deletes a memory pool.
+ *  @desc   Frees memory allocated by RING_IO_ShmAlloc ().
  *
- *  @arg    none
+ *  @arg    addr
+ *              Address of the memory.
+ *  @arg    size
+ *              Size of the memory.
  *
  *  @ret    DSP_SOK
  *              Operation successfully completed.
@@ -324,35 +755,909 @@ RING_IO_OS_init (Void) ;
  *
  *  @leave  None
  *
- *  @see    None
+ *  @see    RING_IO_ShmAlloc
  *  ============================================================================
  */
 NORMAL_API
 DSP_STATUS
-RING_IO_OS_exit (Void) ;
+RING_IO_ShmFree (IN Pvoid addr, IN Uint32 size) ;
 
+/** ============================================================================
+ *  @func   RING_IO_GetUsage
+ *
+ *  @desc   Returns the resource usage of the calling client.
+ *
+ *  @arg    usage
+ *              Location to receive the usage.
+ *
+ *  @ret    None
+ *
+ *  @enter  None
+ *
+ *  @leave  None
+ *
+ *  @see    RING_IO_Usage
+ *  ============================================================================
+ */
+NORMAL_API
+Void
+RING_IO_GetUsage (OUT RING_IO_Usage * usage) ;
 
 /** ============================================================================
- *  @func   RING_IO_Atoll
+ *  @func   RING_IO_ClientKind
  *
- *  @desc   Converts ascii to long int
+ *  @desc   Returns how clients are run by this build.
  *
- *  @ret    <valid integer>
- *              If the 'initial' part of the string represents a valid integer
- *          0
- *              If the string passed does not represent an integer or is NULL.
+ *  @arg    None
+ *
+ *  @ret    "thread" or "process".
  *
  *  @enter  None
  *
  *  @leave  None
  *
- *  @see    None
+ *  @see    RING_IO_Create_client
+ *  ============================================================================
+ */
+NORMAL_API
+Char8 *
+RING_IO_ClientKind (Void) ;
+
+/** ============================================================================
+ *  @func   RING_IO_FiberEnable
+ *
+ *  @desc   Selects whether the clients created from now on run as fibers of
+ *          the calling thread instead of threads of their own. Fibers are
+ *          scheduled whenever that thread waits on a semaphore, sleeps or
+ *          joins a client, and themselves switch on RING_IO_WaitSem (),
+ *          RING_IO_Sleep () and RING_IO_YieldClient (). A fiber must not
+ *          block otherwise. Also enabled by the RING_IO_FIBERS environment
+ *          variable set to 1. Thread builds only.
+ *
+ *  @arg    enable
+ *              TRUE to create fibers.
+ *
+ *  @ret    DSP_SOK
+ *              Operation successfully completed.
+ *          DSP_EFAIL
+ *              Fibers are not available in RING_IO_MULTIPROCESS builds.
+ *
+ *  @enter  None
+ *
+ *  @leave  None
+ *
+ *  @see    RING_IO_Create_client
+ *  ============================================================================
+ */
+NORMAL_API
+DSP_STATUS
+RING_IO_FiberEnable (IN Bool enable) ;
+
+/** ============================================================================
+ *  @func   RING_IO_CtrlGet
+ *
+ *  @desc   Returns the control block shared with the clients.
+ *
+ *  @arg    None
+ *
+ *  @ret    The control block.
+ *
+ *  @enter  RING_IO_OS_init () succeeded.
+ *
+ *  @leave  None
+ *
+ *  @see    RING_IO_CtrlStop, RING_IO_CtrlWait
+ *  ============================================================================
+ */
+NORMAL_API
+RING_IO_CtrlBlock *
+RING_IO_CtrlGet (Void) ;
+
+/** ============================================================================
+ *  @func   RING_IO_CtrlStop
+ *
+ *  @desc   Asks all the clients to stop, whatever thread or process they run
+ *          in.
+ *
+ *  @arg    None
+ *
+ *  @ret    None
+ *
+ *  @enter  RING_IO_OS_init () succeeded.
+ *
+ *  @leave  None
+ *
+ *  @see    RING_IO_CtrlWait
+ *  ============================================================================
+ */
+NORMAL_API
+Void
+RING_IO_CtrlStop (Void) ;
+
+/** ============================================================================
+ *  @func   RING_IO_CtrlWait
+ *
+ *  @desc   Waits for all the clients to exit, printing the aggregate
+ *          throughput of the channels every RING_IO_CTRL_PERIOD. Once a
+ *          client exits, the others are asked to stop. Clients signal their
+ *          exit through the control block, so no process is polled.
+ *
+ *  @arg    None
+ *
+ *  @ret    None
+ *
+ *  @enter  RING_IO_OS_init () succeeded.
+ *
+ *  @leave  No client is running. They still have to be joined.
+ *
+ *  @see    RING_IO_Join_client
+ *  ============================================================================
+ */
+NORMAL_API
+Void
+RING_IO_CtrlWait (Void) ;
+
+/** ============================================================================
+ *  @func   RING_IO_CtrlLayoutBench
+ *
+ *  @desc   Measures the cost of false sharing in the state of the channels.
+ *          For each of RING_IO_LAYOUT_CHNLS channels, a writer and a reader
+ *          thread add to their byte counters while a notification thread
+ *          sets the event mask the reader polls. This is run once with the
+ *          fields packed as they used to be and once with RING_IO_CtrlChnl,
+ *          printing the time per iteration and, when the kernel offers the
+ *          counter, the cache misses.
+ *
+ *  @arg    iterations
+ *              Number of updates made by each thread.
+ *
+ *  @ret    DSP_SOK
+ *              Operation successfully completed.
+ *          DSP_EMEMORY
+ *              Out of memory.
+ *          DSP_EFAIL
+ *              A thread could not be created.
+ *
+ *  @enter  None
+ *
+ *  @leave  None
+ *
+ *  @see    RING_IO_CtrlChnl
+ *  ============================================================================
+ */
+NORMAL_API
+DSP_STATUS
+RING_IO_CtrlLayoutBench (IN Uint32 iterations) ;
+
+/** ============================================================================
+ *  @func   RING_IO_PoolExit
+ *
+ *  @desc   Stops the workers of the client pool, the processes of which
+ *          detach from DSP/BIOS Link, and prints the cost of starting
+ *          clients. Thread builds also print the run time of the clients
+ *          and the utilization of the pool.
+ *
+ *  @arg    None
+ *
+ *  @ret    None
+ *
+ *  @enter  No client is running.
+ *
+ *  @leave  None
+ *
+ *  @see    RING_IO_Create_client
+ *  ============================================================================
+ */
+NORMAL_API
+Void
+RING_IO_PoolExit (Void) ;
+
+/** ============================================================================
+ *  @func   RING_IO_Join_client
+ *
+ *  @desc   Wait for thread/process to terminate.
+ *
+ *  @modif  None
+ *  ============================================================================
+ */
+EXPORT_API
+DSP_STATUS
+RING_IO_Join_client (RING_IO_ClientInfo *pInfo);
+
+/** ============================================================================
+ *  @func   RING_IO_Exit_client
+ *
+ *  @desc   Function to exit from a caller task(thread/process).
+ *
+ *  @modif  None
+ *  ============================================================================
+ */
+EXPORT_API
+DSP_STATUS
+RING_IO_Exit_client (RING_IO_ClientInfo *pInfo);
+
+/** ============================================================================
+ *  @func   RING_IO_OS_init
+ *
+ *  @desc   This function creates a memory pool.
+ *
+ *  @arg    none
+ *
+ *  @ret    DSP_SOK
+ *              Operation successfully completed.
+ *          DSP_EFAIL
+ *              General failure.
+ *
+ *  @enter  None
+ *
+ *  @leave  None
+ *
+ *  @see    None
+ *  ============================================================================
+ */
+NORMAL_API
+DSP_STATUS
+RING_IO_OS_init (Void) ;
+
+/** ============================================================================
+ *  @func   RING_IO_OS_enit
+ *
+ *  @desc   This function deletes a memory pool.
+ *
+ *  @arg    none
+ *
+ *  @ret    DSP_SOK
+ *              Operation successfully completed.
+ *          DSP_EFAIL
+ *              General failure.
+ *
+ *  @enter  None
+ *
+ *  @leave  None
+ *
+ *  @see    None
+ *  ============================================================================
+ */
+NORMAL_API
+DSP_STATUS
+RING_IO_OS_exit (Void) ;
+
+
+/** ============================================================================
+ *  @func   RING_IO_Atoll
+ *
+ *  @desc   Converts ascii to long int
+ *
+ *  @ret    <valid integer>
+ *              If the 'initial' part of the string represents a valid integer
+ *          0
+ *              If the string passed does not represent an integer or is NULL.
+ *
+ *  @enter  None
+ *
+ *  @leave  None
+ *
+ *  @see    None
  *  ============================================================================
  */
 NORMAL_API
 Uint32
 RING_IO_Atoll (Char8 * str) ;
 
+/** ============================================================================
+ *  @func   RING_IO_GetTimeMsec
+ *
+ *  @desc   Returns a monotonic time stamp in milliseconds, for measuring
+ *          elapsed time.
+ *
+ *  @arg    None
+ *
+ *  @ret    Current time stamp in milliseconds.
+ *
+ *  @enter  None
+ *
+ *  @leave  None
+ *
+ *  @see    None
+ *  ============================================================================
+ */
+NORMAL_API
+RING_IO_Uint64
+RING_IO_GetTimeMsec (Void) ;
+
+/** ============================================================================
+ *  @func   RING_IO_GetTimeUsec
+ *
+ *  @desc   Returns a monotonic time stamp in microseconds, for deadlines.
+ *
+ *  @arg    None
+ *
+ *  @ret    Current time stamp in microseconds.
+ *
+ *  @enter  None
+ *
+ *  @leave  None
+ *
+ *  @see    RING_IO_GetTimeMsec
+ *  ============================================================================
+ */
+NORMAL_API
+RING_IO_Uint64
+RING_IO_GetTimeUsec (Void) ;
+
+/** ============================================================================
+ *  @func   RING_IO_AtomicCas
+ *
+ *  @desc   Atomically replaces a word if it holds an expected value. Acts as
+ *          a full memory barrier.
+ *
+ *  @arg    addr
+ *              Word to be updated.
+ *  @arg    oldVal
+ *              Expected value of the word.
+ *  @arg    newVal
+ *              Value to be stored.
+ *
+ *  @ret    TRUE
+ *              The word held oldVal and now holds newVal.
+ *          FALSE
+ *              The word did not hold oldVal and is unchanged.
+ *
+ *  @enter  None
+ *
+ *  @leave  None
+ *
+ *  @see    RING_IO_MemBarrier
+ *  ============================================================================
+ */
+NORMAL_API
+Bool
+RING_IO_AtomicCas (IN volatile Uint32 * addr,
+                   IN Uint32            oldVal,
+                   IN Uint32            newVal) ;
+
+/** ============================================================================
+ *  @func   RING_IO_AtomicAdd64
+ *
+ *  @desc   Atomically adds to a 64-bit counter, which may be shared between
+ *          processes.
+ *
+ *  @arg    addr
+ *              Counter to be updated.
+ *  @arg    value
+ *              Value to be added.
+ *
+ *  @ret    None
+ *
+ *  @enter  None
+ *
+ *  @leave  None
+ *
+ *  @see    RING_IO_AtomicCas
+ *  ============================================================================
+ */
+NORMAL_API
+Void
+RING_IO_AtomicAdd64 (IN volatile RING_IO_Uint64 * addr,
+                     IN RING_IO_Uint64            value) ;
+
+/** ============================================================================
+ *  @func   RING_IO_MemBarrier
+ *
+ *  @desc   Full memory barrier, for data published between threads without
+ *          a lock.
+ *
+ *  @arg    None
+ *
+ *  @ret    None
+ *
+ *  @enter  None
+ *
+ *  @leave  None
+ *
+ *  @see    RING_IO_AtomicCas
+ *  ============================================================================
+ */
+NORMAL_API
+Void
+RING_IO_MemBarrier (Void) ;
+
+/** ============================================================================
+ *  @func   RING_IO_AtomicOr
+ *
+ *  @desc   Atomically sets bits of a word, with release ordering: what was
+ *          written before is visible to whoever reads the bits with acquire
+ *          ordering.
+ *
+ *  @arg    addr
+ *              Word to be updated.
+ *  @arg    bits
+ *              Bits to be set.
+ *
+ *  @ret    Value of the word before the update.
+ *
+ *  @enter  None
+ *
+ *  @leave  None
+ *
+ *  @see    RING_IO_AtomicXchg
+ *  ============================================================================
+ */
+NORMAL_API
+Uint32
+RING_IO_AtomicOr (IN volatile Uint32 * addr,
+                  IN Uint32            bits) ;
+
+/** ============================================================================
+ *  @func   RING_IO_AtomicXchg
+ *
+ *  @desc   Atomically replaces a word, with acquire ordering.
+ *
+ *  @arg    addr
+ *              Word to be updated.
+ *  @arg    newVal
+ *              Value to be stored.
+ *
+ *  @ret    Value of the word before the update.
+ *
+ *  @enter  None
+ *
+ *  @leave  None
+ *
+ *  @see    RING_IO_AtomicOr
+ *  ============================================================================
+ */
+NORMAL_API
+Uint32
+RING_IO_AtomicXchg (IN volatile Uint32 * addr,
+                    IN Uint32            newVal) ;
+
+/** ============================================================================
+ *  @func   RING_IO_AtomicLoad
+ *
+ *  @desc   Reads a word with acquire ordering.
+ *
+ *  @arg    addr
+ *              Word to be read.
+ *
+ *  @ret    Value of the word.
+ *
+ *  @enter  None
+ *
+ *  @leave  None
+ *
+ *  @see    RING_IO_AtomicOr
+ *  ============================================================================
+ */
+NORMAL_API
+Uint32
+RING_IO_AtomicLoad (IN volatile Uint32 * addr) ;
+
+/** ============================================================================
+ *  @func   RING_IO_CopySelect
+ *
+ *  @desc   Selects the kernels used by RING_IO_Copy () and RING_IO_Fill ()
+ *          by timing each available kernel on a region of the memory they
+ *          will write, such as the data buffer of a RingIO, which may be
+ *          uncached or write-combined. The RING_IO_COPY environment variable
+ *          set to the name of a kernel selects it without timing: libc,
+ *          wide, and when built for the CPU sse2, avx or neon.
+ *
+ *  @arg    region
+ *              Memory the kernels are timed on. Its content is overwritten.
+ *  @arg    size
+ *              Size of the region.
+ *
+ *  @ret    DSP_SOK
+ *              Operation successfully completed.
+ *          DSP_EMEMORY
+ *              Out of memory, the kernels are not changed.
+ *
+ *  @enter  No other client copies or fills concurrently.
+ *
+ *  @leave  None
+ *
+ *  @see    RING_IO_Copy, RING_IO_Fill
+ *  ============================================================================
+ */
+NORMAL_API
+DSP_STATUS
+RING_IO_CopySelect (IN Pvoid region, IN Uint32 size) ;
+
+/** ============================================================================
+ *  @func   RING_IO_Copy
+ *
+ *  @desc   Copies data into shared memory with the selected kernel. The
+ *          data is visible to the DSP once the function returns, even if
+ *          written with non-temporal stores.
+ *
+ *  @arg    dst
+ *              Destination, of any alignment.
+ *  @arg    src
+ *              Source, of any alignment.
+ *  @arg    size
+ *              Number of bytes to be copied.
+ *
+ *  @ret    None
+ *
+ *  @enter  None
+ *
+ *  @leave  None
+ *
+ *  @see    RING_IO_CopySelect
+ *  ============================================================================
+ */
+NORMAL_API
+Void
+RING_IO_Copy (OUT Pvoid dst, IN Pvoid src, IN Uint32 size) ;
+
+/** ============================================================================
+ *  @func   RING_IO_Fill
+ *
+ *  @desc   Fills shared memory with a byte value with the selected kernel.
+ *
+ *  @arg    dst
+ *              Destination, of any alignment.
+ *  @arg    value
+ *              Value of the bytes.
+ *  @arg    size
+ *              Number of bytes to be filled.
+ *
+ *  @ret    None
+ *
+ *  @enter  None
+ *
+ *  @leave  None
+ *
+ *  @see    RING_IO_CopySelect
+ *  ============================================================================
+ */
+NORMAL_API
+Void
+RING_IO_Fill (OUT Pvoid dst, IN Uint8 value, IN Uint32 size) ;
+
+/** ============================================================================
+ *  @func   RING_IO_CopyOut
+ *
+ *  @desc   Copies data out of shared memory into cached memory. When built
+ *          for a CPU supporting them, the loads are streaming loads, which
+ *          read write-combined memory a line at a time without polluting
+ *          the cache.
+ *
+ *  @arg    dst
+ *              Destination, of any alignment.
+ *  @arg    src
+ *              Source, of any alignment.
+ *  @arg    size
+ *              Number of bytes to be copied.
+ *
+ *  @ret    None
+ *
+ *  @enter  None
+ *
+ *  @leave  None
+ *
+ *  @see    RING_IO_Prefetch
+ *  ============================================================================
+ */
+NORMAL_API
+Void
+RING_IO_CopyOut (OUT Pvoid dst, IN Pvoid src, IN Uint32 size) ;
+
+/** ============================================================================
+ *  @func   RING_IO_Prefetch
+ *
+ *  @desc   Asks the CPU to start loading a region that is read soon, one
+ *          request per cache line. It is only a hint: nothing is done when
+ *          the compiler offers no prefetch, and the region need not be
+ *          mapped.
+ *
+ *  @arg    addr
+ *              Start of the region.
+ *  @arg    size
+ *              Size of the region.
+ *
+ *  @ret    None
+ *
+ *  @enter  None
+ *
+ *  @leave  None
+ *
+ *  @see    RING_IO_CopyOut
+ *  ============================================================================
+ */
+NORMAL_API
+Void
+RING_IO_Prefetch (IN Pvoid addr, IN Uint32 size) ;
+
+/** ============================================================================
+ *  @func   RING_IO_MapFile
+ *
+ *  @desc   Maps a file read-only into the address space of the caller, for
+ *          sequential access.
+ *
+ *  @arg    path
+ *              Path of the file.
+ *  @arg    addr
+ *              Location to receive the address of the mapping. NULL is
+ *              returned for an empty file.
+ *  @arg    size
+ *              Location to receive the size of the file.
+ *
+ *  @ret    DSP_SOK
+ *              Operation successfully completed.
+ *          DSP_ESIZE
+ *              The file does not fit in the address space.
+ *          DSP_EFAIL
+ *              General failure.
+ *
+ *  @enter  None
+ *
+ *  @leave  None
+ *
+ *  @see    RING_IO_UnmapFile
+ *  ============================================================================
+ */
+NORMAL_API
+DSP_STATUS
+RING_IO_MapFile (IN  Char8 *          path,
+                 OUT Pvoid *          addr,
+                 OUT RING_IO_Uint64 * size) ;
+
+/** ============================================================================
+ *  @func   RING_IO_UnmapFile
+ *
+ *  @desc   Removes a mapping created by RING_IO_MapFile ().
+ *
+ *  @arg    addr
+ *              Address of the mapping.
+ *  @arg    size
+ *              Size of the mapping.
+ *
+ *  @ret    DSP_SOK
+ *              Operation successfully completed.
+ *          DSP_EFAIL
+ *              General failure.
+ *
+ *  @enter  None
+ *
+ *  @leave  None
+ *
+ *  @see    RING_IO_MapFile
+ *  ============================================================================
+ */
+NORMAL_API
+DSP_STATUS
+RING_IO_UnmapFile (IN Pvoid addr, IN RING_IO_Uint64 size) ;
+
+/** ============================================================================
+ *  @func   RING_IO_AsyncFileOpen
+ *
+ *  @desc   Creates a file written asynchronously. Data is gathered into
+ *          numSlots staging buffers of slotSize bytes, aligned on
+ *          DSPLINK_BUF_ALIGN, and every full buffer is written while the
+ *          next one is filled. io_uring is used when the kernel supports it,
+ *          synchronous writes otherwise.
+ *
+ *  @arg    path
+ *              Path of the file. It is created or truncated.
+ *  @arg    slotSize
+ *              Size of each staging buffer.
+ *  @arg    numSlots
+ *              Number of staging buffers, i.e. maximum writes in flight.
+ *  @arg    fileHandle
+ *              Location to receive the handle of the file.
+ *
+ *  @ret    DSP_SOK
+ *              Operation successfully completed.
+ *          DSP_EMEMORY
+ *              Staging buffers could not be allocated.
+ *          DSP_EFAIL
+ *              General failure.
+ *
+ *  @enter  None
+ *
+ *  @leave  None
+ *
+ *  @see    RING_IO_AsyncFileWrite, RING_IO_AsyncFileClose
+ *  ============================================================================
+ */
+NORMAL_API
+DSP_STATUS
+RING_IO_AsyncFileOpen (IN  Char8 * path,
+                       IN  Uint32  slotSize,
+                       IN  Uint32  numSlots,
+                       OUT Pvoid * fileHandle) ;
+
+/** ============================================================================
+ *  @func   RING_IO_AsyncFileWrite
+ *
+ *  @desc   Appends data to a file opened by RING_IO_AsyncFileOpen (). The
+ *          data is copied, so the buffer can be reused on return.
+ *
+ *  @arg    fileHandle
+ *              Handle of the file.
+ *  @arg    buffer
+ *              Data to be written.
+ *  @arg    size
+ *              Number of bytes to be written.
+ *
+ *  @ret    DSP_SOK
+ *              Operation successfully completed.
+ *          DSP_EFAIL
+ *              A previous or the current write failed.
+ *
+ *  @enter  None
+ *
+ *  @leave  None
+ *
+ *  @see    RING_IO_AsyncFileOpen
+ *  ============================================================================
+ */
+NORMAL_API
+DSP_STATUS
+RING_IO_AsyncFileWrite (IN Pvoid fileHandle, IN Pvoid buffer, IN Uint32 size) ;
+
+/** ============================================================================
+ *  @func   RING_IO_AsyncFileClose
+ *
+ *  @desc   Writes the pending data, waits for all writes in flight and closes
+ *          a file opened by RING_IO_AsyncFileOpen ().
+ *
+ *  @arg    fileHandle
+ *              Handle of the file.
+ *
+ *  @ret    DSP_SOK
+ *              Operation successfully completed.
+ *          DSP_EFAIL
+ *              A write failed.
+ *
+ *  @enter  None
+ *
+ *  @leave  None
+ *
+ *  @see    RING_IO_AsyncFileOpen
+ *  ============================================================================
+ */
+NORMAL_API
+DSP_STATUS
+RING_IO_AsyncFileClose (IN Pvoid fileHandle) ;
+
+/** ============================================================================
+ *  @func   RING_IO_PrintToStderr
+ *
+ *  @desc   Redirects the messages printed by RING_IO_0Print () and
+ *          RING_IO_1Print () to the standard error, leaving the standard
+ *          output free for data.
+ *
+ *  @arg    None
+ *
+ *  @ret    None
+ *
+ *  @enter  None
+ *
+ *  @leave  None
+ *
+ *  @see    RING_IO_0Print, RING_IO_1Print
+ *  ============================================================================
+ */
+NORMAL_API
+Void
+RING_IO_PrintToStderr (Void) ;
+
+/** ============================================================================
+ *  @func   RING_IO_StdinRead
+ *
+ *  @desc   Reads a block from the standard input straight into the given
+ *          buffer. The read is repeated until the buffer is full or the end
+ *          of the input is reached, so that short pipe reads do not result
+ *          in small blocks.
+ *
+ *  @arg    buffer
+ *              Buffer to be filled.
+ *  @arg    size
+ *              Size of the buffer.
+ *  @arg    filled
+ *              Location to receive the number of bytes read. Smaller than
+ *              size only at the end of the input.
+ *
+ *  @ret    DSP_SOK
+ *              Operation successfully completed.
+ *          DSP_EFAIL
+ *              The read failed.
+ *
+ *  @enter  None
+ *
+ *  @leave  None
+ *
+ *  @see    None
+ *  ============================================================================
+ */
+NORMAL_API
+DSP_STATUS
+RING_IO_StdinRead (IN Pvoid buffer, IN Uint32 size, OUT Uint32 * filled) ;
+
+/** ============================================================================
+ *  @func   RING_IO_StdoutOpen
+ *
+ *  @desc   Prepares the standard output for RING_IO_StdoutWrite ().
+ *          When it is a pipe the data is spliced into it with vmsplice ()
+ *          from a staging ring of twice the pipe capacity, otherwise it is
+ *          written directly from the caller's buffer.
+ *
+ *  @arg    maxWrite
+ *              Largest size passed to RING_IO_StdoutWrite ().
+ *  @arg    outHandle
+ *              Location to receive the handle of the standard output.
+ *
+ *  @ret    DSP_SOK
+ *              Operation successfully completed.
+ *          DSP_EMEMORY
+ *              The staging ring could not be allocated.
+ *          DSP_EFAIL
+ *              General failure.
+ *
+ *  @enter  None
+ *
+ *  @leave  None
+ *
+ *  @see    RING_IO_StdoutWrite, RING_IO_StdoutClose
+ *  ============================================================================
+ */
+NORMAL_API
+DSP_STATUS
+RING_IO_StdoutOpen (IN Uint32 maxWrite, OUT Pvoid * outHandle) ;
+
+/** ============================================================================
+ *  @func   RING_IO_StdoutWrite
+ *
+ *  @desc   Writes data to the standard output. The buffer can be reused on
+ *          return.
+ *
+ *  @arg    outHandle
+ *              Handle of the standard output.
+ *  @arg    buffer
+ *              Data to be written.
+ *  @arg    size
+ *              Number of bytes to be written.
+ *
+ *  @ret    DSP_SOK
+ *              Operation successfully completed.
+ *          DSP_EFAIL
+ *              The write failed.
+ *
+ *  @enter  None
+ *
+ *  @leave  None
+ *
+ *  @see    RING_IO_StdoutOpen
+ *  ============================================================================
+ */
+NORMAL_API
+DSP_STATUS
+RING_IO_StdoutWrite (IN Pvoid outHandle, IN Pvoid buffer, IN Uint32 size) ;
+
+/** ============================================================================
+ *  @func   RING_IO_StdoutClose
+ *
+ *  @desc   Releases a handle returned by RING_IO_StdoutOpen ().
+ *
+ *  @arg    outHandle
+ *              Handle of the standard output.
+ *
+ *  @ret    None
+ *
+ *  @enter  None
+ *
+ *  @leave  None
+ *
+ *  @see    RING_IO_StdoutOpen
+ *  ============================================================================
+ */
+NORMAL_API
+Void
+RING_IO_StdoutClose (IN Pvoid outHandle) ;
+
 
 #if defined (__cplusplus)
 }
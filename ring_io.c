@@ -69,6 +69,12 @@
 /*  ------------------------ Application Header------------------------------*/
 #include <ring_io.h>
 #include <ring_io_os.h>
+#include <ring_io_chnl.h>
+#include <ring_io_notify.h>
+#include <ring_io_stream.h>
+#include <ring_io_bench.h>
+#include <ring_io_tune.h>
+#include <ring_io_daemon.h>
 
 #if defined (__cplusplus)
 extern "C" {
@@ -154,6 +160,26 @@ extern "C" {
  */
 #define NUM_BUF_POOL6           4u
 
+/** ============================================================================
+ *  @name   NUM_RESIZE_BUF_SIZES
+ *
+ *  @desc   Number of buffer pools configured for resized RingIOs.
+ *  ============================================================================
+ */
+#define NUM_RESIZE_BUF_SIZES    3u
+
+/** ============================================================================
+ *  @const  NUM_RESIZE_BUF_POOL0, NUM_RESIZE_BUF_POOL1, NUM_RESIZE_BUF_POOL2
+ *
+ *  @desc   Number of buffers of 1 KB, 4 KB and RING_IO_RESIZE_MAX_SIZE for
+ *          resized RingIOs. The small ones also hold the control structures
+ *          and locks.
+ *  ============================================================================
+ */
+#define NUM_RESIZE_BUF_POOL0    16u
+#define NUM_RESIZE_BUF_POOL1    8u
+#define NUM_RESIZE_BUF_POOL2    4u
+
 /** ============================================================================
  *  @name   RING_IO_ATTR_BUF_SIZE
  *
@@ -199,61 +225,6 @@ extern "C" {
  */
 #define OP_DIVIDE               2u
 
-/*  ============================================================================
- *  @const   RINGIO_DATA_START
- *
- *  @desc    Fixed attribute type indicates  start of the data in the RingIO
- *  ============================================================================
- */
-#define RINGIO_DATA_START       1u
-
-/*  ============================================================================
- *  @const   NOTIFY_DATA_START
- *
- *  @desc    Notification message  to  DSP.Indicates data transfer start
- *  ============================================================================
- */
-#define NOTIFY_DATA_START       2u
-
-/*  ============================================================================
- *  @const   RINGIO_DATA_END
- *
- *  @desc    Fixed attribute type indicates  start of the data in the RingIO
- *  ============================================================================
- */
-#define RINGIO_DATA_END         3u
-
-/*  ============================================================================
- *  @const   NOTIFY_DATA_START
- *
- *  @desc     Notification message  to  DSP.Indicates data transfer stop.
- *  ============================================================================
- */
-#define NOTIFY_DATA_END         4u
-
-
-
-/*  ============================================================================
- *  @const   RINGIO_DSP_END
- *
- *  @desc     Fixed attribute type indicates  end of the dsp 
- *  ============================================================================
- */
-#define RINGIO_DSP_END         5u
-
-
-/*  ============================================================================
- *  @const   NOTIFY_DSP_END
- *
- *  @desc     Notification message  to  DSP.Indicates DSP end
- *  ============================================================================
- */
-#define NOTIFY_DSP_END         6u
-
-
-
-
-
 /*  ============================================================================
  *  @const   RING_IO_WRITER_BUF_SIZE
  *
@@ -262,14 +233,6 @@ extern "C" {
  */
 #define RING_IO_WRITER_BUF_SIZE    1024u
 
-/** ============================================================================
- *  @const  RING_IO_VATTR_SIZE
- *
- *  @desc   size of the RingIO varibale attribute buffer.
- *  ============================================================================
- */
-#define RING_IO_VATTR_SIZE      1u
-
 /*  ============================================================================
  *  @name   RING_IO_BufferSize
  *
@@ -324,8 +287,8 @@ STATIC RingIO_Handle RingIOReaderHandle2 = NULL;
  *  @desc   varible that specifies the totol number of bytes to transfer.
  *  ============================================================================
  */
-STATIC Uint32 RING_IO_BytesToTransfer1;
-STATIC Uint32 RING_IO_BytesToTransfer2;
+STATIC RING_IO_Uint64 RING_IO_BytesToTransfer1;
+STATIC RING_IO_Uint64 RING_IO_BytesToTransfer2;
 
 /** ============================================================================
  *  @const  writerClientInfo
@@ -346,22 +309,24 @@ RING_IO_ClientInfo readerClientInfo1;
 RING_IO_ClientInfo readerClientInfo2;
 
 /** ============================================================================
- *  @const  fReaderStart
+ *  @name   RING_IO_Ctrl
  *
- *  @desc   boolean variable to  indicate Gpp reader can start reading.
+ *  @desc   Control block shared with the clients. Holds the flags telling
+ *          the Gpp readers to start and stop reading, the byte counters of
+ *          the channels and the flag asking the clients to stop, so that
+ *          they also work when the clients are processes.
  *  ============================================================================
  */
-STATIC Uint32 fReaderStart1 = FALSE;
-STATIC Uint32 fReaderStart2 = FALSE;
+STATIC RING_IO_CtrlBlock * RING_IO_Ctrl = NULL;
 
 /** ============================================================================
- *  @const  fReaderEnd
+ *  @name   RING_IO_Chnls
  *
- *  @desc   boolean variable to  indicate Gpp reader should stop reading.
+ *  @desc   Channels (writer and reader RingIO pairs) used by the streaming
+ *          modes of the application.
  *  ============================================================================
  */
-STATIC Uint32 fReaderEnd1 = FALSE;
-STATIC Uint32 fReaderEnd2 = FALSE;
+STATIC RING_IO_ChnlObj RING_IO_Chnls [RING_IO_NUM_CHNLS];
 
 /** ----------------------------------------------------------------------------
  *  @func   RING_IO_VerifyData
@@ -422,6 +387,31 @@ NORMAL_API
 Void
 RING_IO_InitBuffer (IN Void * buffer, Uint32 size);
 
+/** ----------------------------------------------------------------------------
+ *  @func   RING_IO_RecordSize
+ *
+ *  @desc   Returns the size of the records sent for a transfer, i.e. the
+ *          number of bytes to transfer, bounded by the size of the RingIO.
+ *
+ *  @arg    bytesToTransfer
+ *              Number of bytes to transfer.
+ *  @arg    bufSize
+ *              Size of the data buffer of the writer RingIO.
+ *
+ *  @ret    Size of the records.
+ *
+ *  @enter  None
+ *
+ *  @leave  None
+ *
+ *  @see    None
+ *  ----------------------------------------------------------------------------
+ */
+STATIC
+NORMAL_API
+Uint32
+RING_IO_RecordSize (IN RING_IO_Uint64 bytesToTransfer, IN Uint32 bufSize);
+
 /** ----------------------------------------------------------------------------
  *  @func   RING_IO_Writer_Notify
  *
@@ -478,6 +468,34 @@ Void
 RING_IO_Reader_Notify2 ( IN RingIO_Handle handle,
 		IN RingIO_NotifyParam param,
 		IN RingIO_NotifyMsg msg);
+
+/** ----------------------------------------------------------------------------
+ *  @func   RING_IO_ReaderWait
+ *
+ *  @desc   Waits for a reader notification and takes all the events notified
+ *          on the channel since the last wait.
+ *
+ *  @arg    semHandle
+ *              Semaphore posted by the reader notification.
+ *  @arg    chnlId
+ *              Index of the channel in the control block.
+ *  @arg    events
+ *              RING_IO_EVENT_* taken and not yet acted on.
+ *
+ *  @ret    DSP_SOK
+ *              Operation successfully completed.
+ *          DSP_EFAIL
+ *              General failure.
+ *
+ *  @modif  events
+ *  ----------------------------------------------------------------------------
+ */
+STATIC
+NORMAL_API
+DSP_STATUS
+RING_IO_ReaderWait (IN Pvoid semHandle,
+		IN Uint32 chnlId,
+		IN OUT Uint32 * events);
 /** ============================================================================
  *  @func   RING_IO_Create
  *
@@ -506,6 +524,16 @@ RING_IO_Create (IN Char8 * dspExecutable,
 		NUM_BUF_POOL6
 	};
 	Uint32 size [NUM_BUF_SIZES];
+	Uint32 resizeSize [NUM_RESIZE_BUF_SIZES] = {1024u,
+		4096u,
+		RING_IO_RESIZE_MAX_SIZE
+	};
+	Uint32 resizeNumBufs [NUM_RESIZE_BUF_SIZES] = {NUM_RESIZE_BUF_POOL0,
+		NUM_RESIZE_BUF_POOL1,
+		NUM_RESIZE_BUF_POOL2
+	};
+	Uint32 bulkSize = RING_IO_BULK_HDR_SIZE + RING_IO_BULK_BUF_SIZE;
+	Uint32 bulkNumBufs = RING_IO_BULK_NUM_BUFS;
 	SMAPOOL_Attrs poolAttrs;
 	Char8 * args [NUM_ARGS];
 	Char8 tempCmdString [NUM_ARGS][11];
@@ -533,6 +561,19 @@ RING_IO_Create (IN Char8 * dspExecutable,
 	RING_IO_BytesToTransfer2 = DSPLINK_ALIGN (RING_IO_BytesToTransfer2,
 			DSPLINK_BUF_ALIGN);
 
+	RING_IO_ChnlInit (&RING_IO_Chnls [0],
+			0,
+			RingIOWriterName1,
+			RingIOReaderName1,
+			RING_IO_BufferSize,
+			RING_IO_BufferSize1);
+	RING_IO_ChnlInit (&RING_IO_Chnls [1],
+			1,
+			RingIOWriterName2,
+			RingIOReaderName2,
+			RING_IO_BufferSize2,
+			RING_IO_BufferSize3);
+
 	RING_IO_0Print ("Entered RING_IO_Create ()\n");
 	/*
 	 *  OS initialization
@@ -542,6 +583,32 @@ RING_IO_Create (IN Char8 * dspExecutable,
 		RING_IO_1Print ("RING_IO_OS_init () failed. Status = [0x%x]\n",
 				status);
 	}
+	else {
+		RING_IO_Ctrl = RING_IO_CtrlGet ();
+		status = RING_IO_NotifyInit ();
+		if (DSP_FAILED (status)) {
+			RING_IO_1Print ("RING_IO_NotifyInit () failed. "
+					"Status = [0x%x]\n",
+					status);
+		}
+		else {
+			status = RING_IO_ChnlPoolInit ();
+			if (DSP_FAILED (status)) {
+				RING_IO_1Print ("RING_IO_ChnlPoolInit () failed. "
+						"Status = [0x%x]\n",
+						status);
+			}
+			else {
+				/* Mapped before the tuner starts the pool workers */
+				status = RING_IO_BenchInit ();
+				if (DSP_FAILED (status)) {
+					RING_IO_1Print ("RING_IO_BenchInit () failed. "
+							"Status = [0x%x]\n",
+							status);
+				}
+			}
+		}
+	}
 	/*
 	 *  Create and initialize the proc object.
 	 */
@@ -585,6 +652,40 @@ RING_IO_Create (IN Char8 * dspExecutable,
 		}
 	}
 
+	/*
+	 *  Open the pool of resized RingIOs. Its buffers need not match the
+	 *  size requested.
+	 */
+	if (DSP_SUCCEEDED (status)) {
+		poolAttrs.bufSizes = resizeSize;
+		poolAttrs.numBuffers = resizeNumBufs;
+		poolAttrs.numBufPools = NUM_RESIZE_BUF_SIZES;
+		poolAttrs.exactMatchReq = FALSE;
+		status = POOL_open (POOL_makePoolId(processorId, RING_IO_RESIZE_POOL_ID),
+				&poolAttrs);
+		if (DSP_FAILED (status)) {
+			RING_IO_1Print ("POOL_open () failed. Status = [0x%x]\n",
+					status);
+		}
+	}
+
+	/*
+	 *  Open the pool of the bulk buffers, so that the large buffers do not
+	 *  crowd the RingIOs.
+	 */
+	if (DSP_SUCCEEDED (status)) {
+		poolAttrs.bufSizes = &bulkSize;
+		poolAttrs.numBuffers = &bulkNumBufs;
+		poolAttrs.numBufPools = 1;
+		poolAttrs.exactMatchReq = TRUE;
+		status = POOL_open (POOL_makePoolId(processorId, RING_IO_BULK_POOL_ID),
+				&poolAttrs);
+		if (DSP_FAILED (status)) {
+			RING_IO_1Print ("POOL_open () failed. Status = [0x%x]\n",
+					status);
+		}
+	}
+
 	/*
 	 *  Load the executable on the DSP.
 	 */
@@ -666,6 +767,14 @@ RING_IO_Create (IN Char8 * dspExecutable,
 					status);
 		}
 	}
+
+	/*
+	 *  Select the copy and fill kernels on the shared memory of the RingIOs,
+	 *  before any client is started so that client processes inherit them.
+	 */
+	if (DSP_SUCCEEDED (status)) {
+		status = RING_IO_ChnlCalibrate (&RING_IO_Chnls [0]);
+	}
 	RING_IO_0Print ("Leaving RING_IO_Create ()\n");
 
 	return (status);
@@ -722,8 +831,6 @@ RING_IO_Create (IN Char8 * dspExecutable,
  *  @modif  None
  *  ============================================================================
  */
-STATIC Uint32 Task_Run = TRUE;
-
 NORMAL_API
 Void *
 RING_IO_WriterClient1 (IN Void * ptr)
@@ -736,8 +843,10 @@ RING_IO_WriterClient1 (IN Void * ptr)
 	RingIO_BufPtr bufPtr = NULL;
 	Pvoid semPtrWriter = NULL;
 	Uint8 i = 0;
-	Uint32 bytesTransfered = 0;
+	RING_IO_Uint64 bytesTransfered = 0;
+	RING_IO_Uint64 seq = 0;
 	Uint32 attrs [RING_IO_VATTR_SIZE];
+	Uint32 attrSize = RING_IO_VATTR_SIZE_BASE * sizeof (Uint32);
 	Uint16 type;
 	Uint32 acqSize;
 
@@ -745,8 +854,9 @@ RING_IO_WriterClient1 (IN Void * ptr)
 	Uint32 param;
 	Uint32 vAttrSize = 0;
 	Uint32 rcvSize = RING_IO_BufferSize1;
-	Uint32 totalRcvbytes = 0;
+	RING_IO_Uint64 totalRcvbytes = 0;
 	Uint8 exitFlag = FALSE;
+	Uint32 events = 0;
 	DSP_STATUS attrStatus = DSP_SOK;
 
 	////////////////////////////////////////////////////////////////////////////////
@@ -795,7 +905,8 @@ RING_IO_WriterClient1 (IN Void * ptr)
 			status = RingIO_setNotifier (RingIOWriterHandle1,
 					RINGIO_NOTIFICATION_ONCE,
 					//RING_IO_WRITER_BUF_SIZE,
-					RING_IO_BytesToTransfer1,
+					RING_IO_RecordSize (RING_IO_BytesToTransfer1,
+							RING_IO_BufferSize),
 					&RING_IO_Writer_Notify1,
 					(RingIO_NotifyParam) semPtrWriter);
 			if (status != RINGIO_SUCCESS) {
@@ -877,7 +988,7 @@ RING_IO_WriterClient1 (IN Void * ptr)
 		RING_IO_0Print ("Enter text. Include a dot ('.') in a sentence to exit: \n");
 		c = getchar();
 		if(c == '.') {
-			Task_Run = FALSE;
+			RING_IO_CtrlStop ();
 			break;
 		}
 
@@ -886,12 +997,19 @@ RING_IO_WriterClient1 (IN Void * ptr)
 		////////////////////////////////////////////////////////////////////////////////
 
 		if (DSP_SUCCEEDED (status)) {
+			/* Extended record attributes only if the DSP reads them */
+			param =   RING_IO_AtomicLoad (&RING_IO_Ctrl->dspCaps)
+					& RING_IO_XFER_VATTR_EXT;
+			if (param != 0) {
+				attrSize = sizeof (attrs);
+			}
+
 			/* Send data transfer attribute (Fixed attribute) to DSP*/
 			type = (Uint16) RINGIO_DATA_START;
 			status = RingIO_setAttribute(RingIOWriterHandle1,
 					0,
 					type,
-					0);
+					param);
 			if (DSP_FAILED(status)) {
 				RING_IO_1Print ("RingIO_setAttribute1 failed to set the  "
 						"RINGIO_DATA_START. Status = [0x%x]\n",
@@ -921,7 +1039,8 @@ RING_IO_WriterClient1 (IN Void * ptr)
 
 		if (DSP_SUCCEEDED (status)) {
 
-			RING_IO_1Print ("Bytes to transfer :%ld \n", RING_IO_BytesToTransfer1);
+			RING_IO_1Print64 ("Bytes to transfer :%llu \n",
+					RING_IO_BytesToTransfer1);
 			RING_IO_1Print ("Data buffer size  :%ld \n", RING_IO_BufferSize);
 
 			while ( (RING_IO_BytesToTransfer1 == 0)
@@ -929,7 +1048,14 @@ RING_IO_WriterClient1 (IN Void * ptr)
 
 				/* Update the attrs to send variable attribute to DSP*/
 				//attrs [0] = RING_IO_WRITER_BUF_SIZE;
-				attrs [0] = RING_IO_BytesToTransfer1;
+				attrs [RING_IO_VATTR_LEN] =
+						RING_IO_RecordSize (RING_IO_BytesToTransfer1,
+								RING_IO_BufferSize);
+				attrs [RING_IO_VATTR_OFFSET_LO] = (Uint32) bytesTransfered;
+				attrs [RING_IO_VATTR_OFFSET_HI] =
+						(Uint32) (bytesTransfered >> 32);
+				attrs [RING_IO_VATTR_SEQ_LO] = (Uint32) seq;
+				attrs [RING_IO_VATTR_SEQ_HI] = (Uint32) (seq >> 32);
 
 				/* ----------------------------------------------------------------
 				 * Send to DSP.
@@ -941,7 +1067,7 @@ RING_IO_WriterClient1 (IN Void * ptr)
 						0, /* No type */
 						0,
 						attrs,
-						sizeof (attrs));
+						attrSize);
 				if (DSP_FAILED(status)) {
 					/* RingIO_setvAttribute failed */
 					RING_IO_Sleep(10);
@@ -949,7 +1075,7 @@ RING_IO_WriterClient1 (IN Void * ptr)
 				else {
 					/* Acquire writer bufs and initialize and release them. */
 					//acqSize = RING_IO_WRITER_BUF_SIZE;
-					acqSize = RING_IO_BytesToTransfer1;
+					acqSize = attrs [RING_IO_VATTR_LEN];
 					status = RingIO_acquire (RingIOWriterHandle1,
 							&bufPtr ,
 							&acqSize);
@@ -981,7 +1107,7 @@ RING_IO_WriterClient1 (IN Void * ptr)
 							if (bytesTransfered != RING_IO_BytesToTransfer1) {
 
 								relStatus = RingIO_release (RingIOWriterHandle1,
-										(RING_IO_BytesToTransfer1-
+										(Uint32) (RING_IO_BytesToTransfer1-
 												bytesTransfered));
 								if (DSP_FAILED (relStatus)) {
 									RING_IO_1Print ("RingIO_release1 () in Writer "
@@ -998,7 +1124,10 @@ RING_IO_WriterClient1 (IN Void * ptr)
 										"status = [0x%x]\n",
 										status);
 							}
+							RING_IO_AtomicAdd64 (&RING_IO_Ctrl->chnls [0].bytesSent,
+									RING_IO_BytesToTransfer1 - bytesTransfered);
 							bytesTransfered = RING_IO_BytesToTransfer1;
+							seq++;
 
 						}
 						else {
@@ -1012,6 +1141,9 @@ RING_IO_WriterClient1 (IN Void * ptr)
 							}
 							else {
 								bytesTransfered += acqSize;
+								RING_IO_AtomicAdd64 (&RING_IO_Ctrl->chnls [0].bytesSent,
+										acqSize);
+								seq++;
 							}
 						}
 
@@ -1036,10 +1168,11 @@ RING_IO_WriterClient1 (IN Void * ptr)
 				}
 			}
 
-			RING_IO_1Print ("GPP-->DSP1:Total Bytes Transmitted  %ld \n",
+			RING_IO_1Print64 ("GPP-->DSP1:Total Bytes Transmitted  %llu \n",
 					bytesTransfered);
 
 			bytesTransfered = 0;
+			seq = 0;
 
 			/* Send  End of  data transfer attribute to DSP */
 			type = (Uint16) RINGIO_DATA_END;
@@ -1098,7 +1231,7 @@ RING_IO_WriterClient1 (IN Void * ptr)
 			 * Wait for notification from  DSP  about data
 			 * transfer
 			 */
-			status = RING_IO_WaitSem (semPtrReader);
+			status = RING_IO_ReaderWait (semPtrReader, 0u, &events);
 			if (DSP_FAILED (status)) {
 				RING_IO_1Print ("RING_IO_WaitSem1 () Reader SEM failed "
 						"Status = [0x%x]\n",
@@ -1106,9 +1239,9 @@ RING_IO_WriterClient1 (IN Void * ptr)
 			}
 			RING_IO_0Print (" RING_IO_WaitSem1 () Reader SEM  \n");
 
-			if (fReaderStart1 == TRUE) {
+			if ((events & RING_IO_EVENT_START) != 0) {
 
-				fReaderStart1 = FALSE;
+				events &= ~RING_IO_EVENT_START;
 
 				/* Got  data transfer start notification from DSP*/
 				do {
@@ -1121,6 +1254,9 @@ RING_IO_WriterClient1 (IN Void * ptr)
 							|| (status == RINGIO_SPENDINGATTRIBUTE)) {
 
 						if (type == (Uint16)RINGIO_DATA_START) {
+							/* Capabilities announced by the DSP */
+							RING_IO_AtomicOr (&RING_IO_Ctrl->dspCaps,
+									param & ~RING_IO_XFER_MODE_MASK);
 							RING_IO_0Print ("GPP<--DSP1:Received Data Transfer"
 									"Start Attribute\n");
 							break;
@@ -1156,14 +1292,16 @@ RING_IO_WriterClient1 (IN Void * ptr)
 					/* Got buffer from DSP.*/
 					rcvSize -= acqSize;
 					totalRcvbytes += acqSize;
+					RING_IO_AtomicAdd64 (&RING_IO_Ctrl->chnls [0].bytesRcvd,
+							acqSize);
 
 					/* Verify the received data */
 					if (DSP_SOK != RING_IO_Reader_VerifyData (bufPtr,
 									//factor,
 									//action,
 									acqSize)) {
-						RING_IO_1Print (" Data1 verification failed after"
-								"%ld bytes received from DSP \n",
+						RING_IO_1Print64 (" Data1 verification failed after"
+								"%llu bytes received from DSP \n",
 								totalRcvbytes);
 					}
 
@@ -1283,7 +1421,7 @@ RING_IO_WriterClient1 (IN Void * ptr)
 						||(status == RINGIO_EBUFEMPTY)) {
 
 					/* Failed to acquire buffer */
-					status = RING_IO_WaitSem (semPtrReader);
+					status = RING_IO_ReaderWait (semPtrReader, 0u, &events);
 					if (DSP_FAILED (status)) {
 						RING_IO_1Print ("RING_IO_WaitSem () Reader SEM failed "
 								"Status = [0x%x]\n",
@@ -1305,18 +1443,19 @@ RING_IO_WriterClient1 (IN Void * ptr)
 			}
 		}
 
-		RING_IO_1Print ("GPP<--DSP1:Bytes Received %ld \n",
+		RING_IO_1Print64 ("GPP<--DSP1:Bytes Received %llu \n",
 				totalRcvbytes);
 
-		if (fReaderEnd1 != TRUE) {
+		while ((events & RING_IO_EVENT_END) == 0) {
 			/* If data transfer end notification  not yet received
 			 * from DSP ,wait for it.
 			 */
-			status = RING_IO_WaitSem (semPtrReader);
+			status = RING_IO_ReaderWait (semPtrReader, 0u, &events);
 			if (DSP_FAILED (status)) {
 				RING_IO_1Print ("RING_IO_WaitSem1 () Reader SEM failed "
 						"Status = [0x%x]\n",
 						status);
+				break;
 			}
 		}
 		//else {
@@ -1324,7 +1463,7 @@ RING_IO_WriterClient1 (IN Void * ptr)
 		//}
 		totalRcvbytes = 0;
 		rcvSize = RING_IO_BufferSize1;
-		fReaderEnd1 = FALSE;
+		events = 0;
 		exitFlag = FALSE;
 		RING_IO_0Print ("End Reader Task1  () \n");
 
@@ -1438,8 +1577,10 @@ RING_IO_WriterClient2 (IN Void * ptr)
 	RingIO_BufPtr bufPtr = NULL;
 	Pvoid semPtrWriter = NULL;
 	Uint8 i = 0;
-	Uint32 bytesTransfered = 0;
+	RING_IO_Uint64 bytesTransfered = 0;
+	RING_IO_Uint64 seq = 0;
 	Uint32 attrs [RING_IO_VATTR_SIZE];
+	Uint32 attrSize = RING_IO_VATTR_SIZE_BASE * sizeof (Uint32);
 	Uint16 type;
 	Uint32 acqSize;
 
@@ -1447,8 +1588,9 @@ RING_IO_WriterClient2 (IN Void * ptr)
 	Uint32 param;
 	Uint32 vAttrSize = 0;
 	Uint32 rcvSize = RING_IO_BufferSize1;
-	Uint32 totalRcvbytes = 0;
+	RING_IO_Uint64 totalRcvbytes = 0;
 	Uint8 exitFlag = FALSE;
+	Uint32 events = 0;
 	DSP_STATUS attrStatus = DSP_SOK;
 
 	///////////////////////////////////////////////////////////////////////////////
@@ -1581,7 +1723,7 @@ RING_IO_WriterClient2 (IN Void * ptr)
 		
 		RING_IO_Sleep(5000000);
 		RING_IO_0Print ("2222 sleep 5s and run \n");
-		if(Task_Run == FALSE){
+		if(RING_IO_AtomicLoad (&RING_IO_Ctrl->stop) == TRUE){
 			RING_IO_0Print ("!!! WriteTask2 exit \n");
 
 			break;
@@ -1594,12 +1736,19 @@ RING_IO_WriterClient2 (IN Void * ptr)
 
 
 		if (DSP_SUCCEEDED (status)) {
+			/* Extended record attributes only if the DSP reads them */
+			param =   RING_IO_AtomicLoad (&RING_IO_Ctrl->dspCaps)
+					& RING_IO_XFER_VATTR_EXT;
+			if (param != 0) {
+				attrSize = sizeof (attrs);
+			}
+
 			/* Send data transfer attribute (Fixed attribute) to DSP*/
 			type = (Uint16) RINGIO_DATA_START;
 			status = RingIO_setAttribute(RingIOWriterHandle2,
 					0,
 					type,
-					0);
+					param);
 			if (DSP_FAILED(status)) {
 				RING_IO_1Print ("RingIO_setAttribute2 failed to set the  "
 						"RINGIO_DATA_START. Status = [0x%x]\n",
@@ -1629,7 +1778,8 @@ RING_IO_WriterClient2 (IN Void * ptr)
 
 		if (DSP_SUCCEEDED (status)) {
 
-			RING_IO_1Print ("2Bytes to transfer :%ld \n", RING_IO_BytesToTransfer2);
+			RING_IO_1Print64 ("2Bytes to transfer :%llu \n",
+					RING_IO_BytesToTransfer2);
 			RING_IO_1Print ("2Data buffer size  :%ld \n", RING_IO_BufferSize3);
 
 			while ( (RING_IO_BytesToTransfer2 == 0)
@@ -1637,7 +1787,14 @@ RING_IO_WriterClient2 (IN Void * ptr)
 
 				/* Update the attrs to send variable attribute to DSP*/
 				//attrs [0] = RING_IO_WRITER_BUF_SIZE;
-				attrs [0] = RING_IO_BytesToTransfer2;
+				attrs [RING_IO_VATTR_LEN] =
+						RING_IO_RecordSize (RING_IO_BytesToTransfer2,
+								RING_IO_BufferSize2);
+				attrs [RING_IO_VATTR_OFFSET_LO] = (Uint32) bytesTransfered;
+				attrs [RING_IO_VATTR_OFFSET_HI] =
+						(Uint32) (bytesTransfered >> 32);
+				attrs [RING_IO_VATTR_SEQ_LO] = (Uint32) seq;
+				attrs [RING_IO_VATTR_SEQ_HI] = (Uint32) (seq >> 32);
 
 				/* ----------------------------------------------------------------
 				 * Send to DSP.
@@ -1649,7 +1806,7 @@ RING_IO_WriterClient2 (IN Void * ptr)
 						0, /* No type */
 						0,
 						attrs,
-						sizeof (attrs));
+						attrSize);
 				if (DSP_FAILED(status)) {
 					/* RingIO_setvAttribute failed */
 					RING_IO_Sleep(10);
@@ -1657,7 +1814,7 @@ RING_IO_WriterClient2 (IN Void * ptr)
 				else {
 					/* Acquire writer bufs and initialize and release them. */
 					//acqSize = RING_IO_WRITER_BUF_SIZE;
-					acqSize = RING_IO_BytesToTransfer2;
+					acqSize = attrs [RING_IO_VATTR_LEN];
 					status = RingIO_acquire (RingIOWriterHandle2,
 							&bufPtr ,
 							&acqSize);
@@ -1688,7 +1845,7 @@ RING_IO_WriterClient2 (IN Void * ptr)
 							if (bytesTransfered != RING_IO_BytesToTransfer2) {
 
 								relStatus = RingIO_release (RingIOWriterHandle2,
-										(RING_IO_BytesToTransfer2-
+										(Uint32) (RING_IO_BytesToTransfer2-
 												bytesTransfered));
 								if (DSP_FAILED (relStatus)) {
 									RING_IO_1Print ("RingIO_release2 () in Writer "
@@ -1705,7 +1862,10 @@ RING_IO_WriterClient2 (IN Void * ptr)
 										"status = [0x%x]\n",
 										status);
 							}
+							RING_IO_AtomicAdd64 (&RING_IO_Ctrl->chnls [1].bytesSent,
+									RING_IO_BytesToTransfer2 - bytesTransfered);
 							bytesTransfered = RING_IO_BytesToTransfer2;
+							seq++;
 
 						}
 						else {
@@ -1719,6 +1879,9 @@ RING_IO_WriterClient2 (IN Void * ptr)
 							}
 							else {
 								bytesTransfered += acqSize;
+								RING_IO_AtomicAdd64 (&RING_IO_Ctrl->chnls [1].bytesSent,
+										acqSize);
+								seq++;
 							}
 						}
 
@@ -1743,10 +1906,11 @@ RING_IO_WriterClient2 (IN Void * ptr)
 				}
 			}
 
-			RING_IO_1Print ("GPP-->DSP2: Total Bytes Transmitted  %ld \n",
+			RING_IO_1Print64 ("GPP-->DSP2: Total Bytes Transmitted  %llu \n",
 					bytesTransfered);
 
 			bytesTransfered = 0;
+			seq = 0;
 
 			/* Send  End of  data transfer attribute to DSP */
 			type = (Uint16) RINGIO_DATA_END;
@@ -1804,7 +1968,7 @@ RING_IO_WriterClient2 (IN Void * ptr)
 			 * Wait for notification from  DSP  about data
 			 * transfer
 			 */
-			status = RING_IO_WaitSem (semPtrReader);
+			status = RING_IO_ReaderWait (semPtrReader, 1u, &events);
 			if (DSP_FAILED (status)) {
 				RING_IO_1Print ("RING_IO_WaitSem2 () Reader SEM failed "
 						"Status = [0x%x]\n",
@@ -1813,9 +1977,9 @@ RING_IO_WriterClient2 (IN Void * ptr)
 
 			RING_IO_0Print (" RING_IO_WaitSem2 () Reader SEM  \n");
 
-			if (fReaderStart2 == TRUE) {
+			if ((events & RING_IO_EVENT_START) != 0) {
 
-				fReaderStart2 = FALSE;
+				events &= ~RING_IO_EVENT_START;
 
 				/* Got  data transfer start notification from DSP*/
 				do {
@@ -1828,6 +1992,9 @@ RING_IO_WriterClient2 (IN Void * ptr)
 							|| (status == RINGIO_SPENDINGATTRIBUTE)) {
 
 						if (type == (Uint16)RINGIO_DATA_START) {
+							/* Capabilities announced by the DSP */
+							RING_IO_AtomicOr (&RING_IO_Ctrl->dspCaps,
+									param & ~RING_IO_XFER_MODE_MASK);
 							RING_IO_0Print ("GPP<--DSP2:Received Data Transfer"
 									"Start Attribute\n");
 							break;
@@ -1863,14 +2030,16 @@ RING_IO_WriterClient2 (IN Void * ptr)
 					/* Got buffer from DSP.*/
 					rcvSize -= acqSize;
 					totalRcvbytes += acqSize;
+					RING_IO_AtomicAdd64 (&RING_IO_Ctrl->chnls [1].bytesRcvd,
+							acqSize);
 
 					/* Verify the received data */
 					if (DSP_SOK != RING_IO_Reader_VerifyData (bufPtr,
 									//factor,
 									//action,
 									acqSize)) {
-						RING_IO_1Print (" Data verification2 failed after"
-								"%ld bytes received from DSP \n",
+						RING_IO_1Print64 (" Data verification2 failed after"
+								"%llu bytes received from DSP \n",
 								totalRcvbytes);
 					}
 
@@ -1991,7 +2160,7 @@ RING_IO_WriterClient2 (IN Void * ptr)
 						||(status == RINGIO_EBUFEMPTY)) {
 
 					/* Failed to acquire buffer */
-					status = RING_IO_WaitSem (semPtrReader);
+					status = RING_IO_ReaderWait (semPtrReader, 1u, &events);
 					if (DSP_FAILED (status)) {
 						RING_IO_1Print ("RING_IO_WaitSem () Reader SEM failed "
 								"Status = [0x%x]\n",
@@ -2013,18 +2182,19 @@ RING_IO_WriterClient2 (IN Void * ptr)
 			}
 		}
 
-		RING_IO_1Print ("GPP<--DSP2:Bytes Received %ld \n",
+		RING_IO_1Print64 ("GPP<--DSP2:Bytes Received %llu \n",
 				totalRcvbytes);
 
-		if (fReaderEnd2 != TRUE) {
+		while ((events & RING_IO_EVENT_END) == 0) {
 			/* If data transfer end notification  not yet received
 			 * from DSP ,wait for it.
 			 */
-			status = RING_IO_WaitSem (semPtrReader);
+			status = RING_IO_ReaderWait (semPtrReader, 1u, &events);
 			if (DSP_FAILED (status)) {
 				RING_IO_1Print ("RING_IO_WaitSem2 () Reader SEM failed "
 						"Status = [0x%x]\n",
 						status);
+				break;
 			}
 		}
 		//else {
@@ -2032,7 +2202,7 @@ RING_IO_WriterClient2 (IN Void * ptr)
 		//}
 		totalRcvbytes = 0;
 		rcvSize = RING_IO_BufferSize3;
-		fReaderEnd2 = FALSE;
+		events = 0;
 		exitFlag = FALSE;
 
 		RING_IO_0Print (" End Reader task2  \n");
@@ -2177,8 +2347,9 @@ RING_IO_ReaderClient1 (IN Void * ptr)
 	Pvoid semPtrReader = NULL;
 	Uint32 vAttrSize = 0;
 	Uint32 rcvSize = RING_IO_BufferSize1;
-	Uint32 totalRcvbytes = 0;
+	RING_IO_Uint64 totalRcvbytes = 0;
 	Uint8 exitFlag = FALSE;
+	Uint32 events = 0;
 	Uint32 factor = 0;
 	Uint32 action = 0;
 	Uint16 type;
@@ -2245,7 +2416,7 @@ RING_IO_ReaderClient1 (IN Void * ptr)
 		 * Wait for notification from  DSP  about data
 		 * transfer
 		 */
-		status = RING_IO_WaitSem (semPtrReader);
+		status = RING_IO_ReaderWait (semPtrReader, 0u, &events);
 		if (DSP_FAILED (status)) {
 			RING_IO_1Print ("RING_IO_WaitSem1 () Reader SEM failed "
 					"Status = [0x%x]\n",
@@ -2253,7 +2424,9 @@ RING_IO_ReaderClient1 (IN Void * ptr)
 		}
 		RING_IO_0Print (" RING_IO_WaitSem1 () Reader SEM  \n");
 
-		if (fReaderStart1 == TRUE) {
+		if ((events & RING_IO_EVENT_START) != 0) {
+
+			events &= ~RING_IO_EVENT_START;
 
 			/* Got  data transfer start notification from DSP*/
 			do {
@@ -2266,6 +2439,9 @@ RING_IO_ReaderClient1 (IN Void * ptr)
 						|| (status == RINGIO_SPENDINGATTRIBUTE)) {
 
 					if (type == (Uint16)RINGIO_DATA_START) {
+						/* Capabilities announced by the DSP */
+						RING_IO_AtomicOr (&RING_IO_Ctrl->dspCaps,
+								param & ~RING_IO_XFER_MODE_MASK);
 						RING_IO_0Print ("GPP<--DSP1:Received Data Transfer"
 								"Start Attribute\n");
 						break;
@@ -2301,14 +2477,16 @@ RING_IO_ReaderClient1 (IN Void * ptr)
 				/* Got buffer from DSP.*/
 				rcvSize -= acqSize;
 				totalRcvbytes += acqSize;
+				RING_IO_AtomicAdd64 (&RING_IO_Ctrl->chnls [0].bytesRcvd,
+						acqSize);
 
 				/* Verify the received data */
 				if (DSP_SOK != RING_IO_Reader_VerifyData (bufPtr,
 								//factor,
 								//action,
 								acqSize)) {
-					RING_IO_1Print (" Data1 verification failed after"
-							"%ld bytes received from DSP \n",
+					RING_IO_1Print64 (" Data1 verification failed after"
+							"%llu bytes received from DSP \n",
 							totalRcvbytes);
 				}
 
@@ -2333,7 +2511,7 @@ RING_IO_ReaderClient1 (IN Void * ptr)
 				}
 
 				if ((totalRcvbytes % (8192u)) == 0u) {
-					RING_IO_1Print ("GPP<--DSP1:Bytes Received :%lu \n",
+					RING_IO_1Print64 ("GPP<--DSP1:Bytes Received :%llu \n",
 							totalRcvbytes);
 
 				}
@@ -2423,7 +2601,7 @@ RING_IO_ReaderClient1 (IN Void * ptr)
 					||(status == RINGIO_EBUFEMPTY)) {
 
 				/* Failed to acquire buffer */
-				status = RING_IO_WaitSem (semPtrReader);
+				status = RING_IO_ReaderWait (semPtrReader, 0u, &events);
 				if (DSP_FAILED (status)) {
 					RING_IO_1Print ("RING_IO_WaitSem () Reader SEM failed "
 							"Status = [0x%x]\n",
@@ -2445,22 +2623,23 @@ RING_IO_ReaderClient1 (IN Void * ptr)
 		}
 	}
 
-	RING_IO_1Print ("GPP<--DSP1:Bytes Received %ld \n",
+	RING_IO_1Print64 ("GPP<--DSP1:Bytes Received %llu \n",
 			totalRcvbytes);
 
-	if (fReaderEnd1 != TRUE) {
+	while ((events & RING_IO_EVENT_END) == 0) {
 		/* If data transfer end notification  not yet received
 		 * from DSP ,wait for it.
 		 */
-		status = RING_IO_WaitSem (semPtrReader);
+		status = RING_IO_ReaderWait (semPtrReader, 0u, &events);
 		if (DSP_FAILED (status)) {
 			RING_IO_1Print ("RING_IO_WaitSem1 () Reader SEM failed "
 					"Status = [0x%x]\n",
 					status);
+			break;
 		}
 	}
 
-	if (fReaderEnd1 == TRUE) {
+	if ((events & RING_IO_EVENT_END) != 0) {
 		RING_IO_0Print ("GPP<--DSP1:Received Data Transfer End Notification"
 				" \n");
 		if (semPtrReader != NULL) {
@@ -2508,8 +2687,9 @@ RING_IO_ReaderClient2 (IN Void * ptr)
 	Pvoid semPtrReader = NULL;
 	Uint32 vAttrSize = 0;
 	Uint32 rcvSize = RING_IO_BufferSize3;
-	Uint32 totalRcvbytes = 0;
+	RING_IO_Uint64 totalRcvbytes = 0;
 	Uint8 exitFlag = FALSE;
+	Uint32 events = 0;
 	Uint32 factor = 0;
 	Uint32 action = 0;
 	Uint16 type;
@@ -2574,7 +2754,7 @@ RING_IO_ReaderClient2 (IN Void * ptr)
 		 * Wait for notification from  DSP  about data
 		 * transfer
 		 */
-		status = RING_IO_WaitSem (semPtrReader);
+		status = RING_IO_ReaderWait (semPtrReader, 1u, &events);
 		if (DSP_FAILED (status)) {
 			RING_IO_1Print ("RING_IO_WaitSem2 () Reader SEM failed "
 					"Status = [0x%x]\n",
@@ -2583,7 +2763,9 @@ RING_IO_ReaderClient2 (IN Void * ptr)
 
 		RING_IO_0Print (" RING_IO_WaitSem2 () Reader SEM  \n");
 
-		if (fReaderStart2 == TRUE) {
+		if ((events & RING_IO_EVENT_START) != 0) {
+
+			events &= ~RING_IO_EVENT_START;
 
 			/* Got  data transfer start notification from DSP*/
 			do {
@@ -2596,6 +2778,9 @@ RING_IO_ReaderClient2 (IN Void * ptr)
 						|| (status == RINGIO_SPENDINGATTRIBUTE)) {
 
 					if (type == (Uint16)RINGIO_DATA_START) {
+						/* Capabilities announced by the DSP */
+						RING_IO_AtomicOr (&RING_IO_Ctrl->dspCaps,
+								param & ~RING_IO_XFER_MODE_MASK);
 						RING_IO_0Print ("GPP<--DSP2:Received Data Transfer"
 								"Start Attribute\n");
 						break;
@@ -2631,14 +2816,16 @@ RING_IO_ReaderClient2 (IN Void * ptr)
 				/* Got buffer from DSP.*/
 				rcvSize -= acqSize;
 				totalRcvbytes += acqSize;
+				RING_IO_AtomicAdd64 (&RING_IO_Ctrl->chnls [1].bytesRcvd,
+						acqSize);
 
 				/* Verify the received data */
 				if (DSP_SOK != RING_IO_Reader_VerifyData (bufPtr,
 								//factor,
 								//action,
 								acqSize)) {
-					RING_IO_1Print (" Data verification2 failed after"
-							"%ld bytes received from DSP \n",
+					RING_IO_1Print64 (" Data verification2 failed after"
+							"%llu bytes received from DSP \n",
 							totalRcvbytes);
 				}
 
@@ -2663,7 +2850,7 @@ RING_IO_ReaderClient2 (IN Void * ptr)
 				}
 
 				if ((totalRcvbytes % (8192u)) == 0u) {
-					RING_IO_1Print ("GPP<--DSP2:Bytes Received :%lu \n",
+					RING_IO_1Print64 ("GPP<--DSP2:Bytes Received :%llu \n",
 							totalRcvbytes);
 
 				}
@@ -2754,7 +2941,7 @@ RING_IO_ReaderClient2 (IN Void * ptr)
 					||(status == RINGIO_EBUFEMPTY)) {
 
 				/* Failed to acquire buffer */
-				status = RING_IO_WaitSem (semPtrReader);
+				status = RING_IO_ReaderWait (semPtrReader, 1u, &events);
 				if (DSP_FAILED (status)) {
 					RING_IO_1Print ("RING_IO_WaitSem () Reader SEM failed "
 							"Status = [0x%x]\n",
@@ -2776,23 +2963,24 @@ RING_IO_ReaderClient2 (IN Void * ptr)
 		}
 	}
 
-	RING_IO_1Print ("GPP<--DSP2:Bytes Received %ld \n",
+	RING_IO_1Print64 ("GPP<--DSP2:Bytes Received %llu \n",
 			totalRcvbytes);
 
-	if (fReaderEnd2 != TRUE) {
+	while ((events & RING_IO_EVENT_END) == 0) {
 		/* If data transfer end notification  not yet received
 		 * from DSP ,wait for it.
 		 */
-		status = RING_IO_WaitSem (semPtrReader);
+		status = RING_IO_ReaderWait (semPtrReader, 1u, &events);
 		if (DSP_FAILED (status)) {
 			RING_IO_1Print ("RING_IO_WaitSem2 () Reader SEM failed "
 					"Status = [0x%x]\n",
 					status);
+			break;
 		}
 	}
 	RING_IO_0Print (" RING_IO_WaitSem2 () Reader SEM  \n");
 
-	if (fReaderEnd2 == TRUE) {
+	if ((events & RING_IO_EVENT_END) != 0) {
 		RING_IO_0Print ("GPP<--DSP2:Received Data Transfer End Notification"
 				" \n");
 		if (semPtrReader != NULL) {
@@ -2846,6 +3034,13 @@ Void RING_IO_Delete(Uint8 processorId) {
 
 	RING_IO_0Print("Entered RING_IO_Delete ()\n");
 
+	/* Pool workers must detach before the DSP is stopped */
+	RING_IO_PoolExit ();
+
+	/* The RingIOs must be closed before they are deleted */
+	RING_IO_ChnlPoolExit (RING_IO_Chnls, RING_IO_NUM_CHNLS);
+	RING_IO_BenchExit ();
+
 
 
 
@@ -2916,6 +3111,19 @@ Void RING_IO_Delete(Uint8 processorId) {
 		RING_IO_1Print("POOL_close () failed. Status = [0x%x]\n", status);
 	}
 
+	tmpStatus = POOL_close(POOL_makePoolId(processorId,
+			RING_IO_RESIZE_POOL_ID));
+	if (DSP_SUCCEEDED(status) && DSP_FAILED(tmpStatus)) {
+		status = tmpStatus;
+		RING_IO_1Print("POOL_close () failed. Status = [0x%x]\n", status);
+	}
+
+	tmpStatus = POOL_close(POOL_makePoolId(processorId, RING_IO_BULK_POOL_ID));
+	if (DSP_SUCCEEDED(status) && DSP_FAILED(tmpStatus)) {
+		status = tmpStatus;
+		RING_IO_1Print("POOL_close () failed. Status = [0x%x]\n", status);
+	}
+
 	/*
 	 *  Detach from the processor
 	 */
@@ -2934,6 +3142,8 @@ Void RING_IO_Delete(Uint8 processorId) {
 		RING_IO_1Print("PROC_destroy () failed. Status = [0x%x]\n", status);
 	}
 
+	RING_IO_NotifyExit ();
+
 	/*
 	 *  OS Finalization
 	 */
@@ -2959,10 +3169,12 @@ Void
 RING_IO_Main (IN Char8 * dspExecutable,
 		IN Char8 * strBufferSize,
 		IN Char8 * strBytesToTransfer,
-		IN Char8 * strProcessorId)
+		IN Char8 * strProcessorId,
+		IN RING_IO_Options * options)
 {
 	DSP_STATUS status = DSP_SOK;
 	Uint8 processorId = 0;
+	RING_IO_Mode mode = RING_IO_MODE_INTERACTIVE;
 
 	RING_IO_0Print ("========== Sample Application : RING_IO ==========\n");
 
@@ -3008,7 +3220,126 @@ RING_IO_Main (IN Char8 * dspExecutable,
 					// strBytesToTransfer,
 					processorId);
 
-			if (DSP_SUCCEEDED (status)) {
+			if (options != NULL) {
+				mode = options->mode;
+			}
+
+			if (   DSP_SUCCEEDED (status)
+				&& (options != NULL)
+				&& (   (options->config.ringSize != 0)
+					|| (options->config.acqSize != 0)
+					|| (options->config.watermark != 0)
+					|| (options->config.notifyAlways != 0)
+					|| (options->config.prefetch != 0)
+					|| (options->config.stage != 0)
+					|| (options->config.fillAhead != 0))) {
+				status = RING_IO_ChnlConfigure (&RING_IO_Chnls [0],
+						processorId,
+						RING_IO_ATTR_BUF_SIZE,
+						&options->config);
+				if (DSP_FAILED (status)) {
+					RING_IO_1Print ("RING_IO_ChnlConfigure () failed. "
+							"Status = [0x%x]\n",
+							status);
+				}
+			}
+
+			if (   DSP_SUCCEEDED (status)
+				&& (options != NULL)
+				&& (options->tune != RING_IO_TUNE_OFF)) {
+				status = RING_IO_TuneStart (RING_IO_Chnls,
+						RING_IO_NUM_CHNLS,
+						processorId,
+						RING_IO_ATTR_BUF_SIZE,
+						options->tune);
+				if (DSP_FAILED (status)) {
+					RING_IO_1Print ("RING_IO_TuneStart () failed. "
+							"Status = [0x%x]\n",
+							status);
+				}
+			}
+
+			if (DSP_SUCCEEDED (status) && (mode == RING_IO_MODE_STREAM)) {
+				status = RING_IO_StreamRun (RING_IO_Chnls,
+						0,
+						processorId,
+						options->inFile,
+						options->outFile);
+				if (DSP_FAILED (status)) {
+					RING_IO_1Print ("RING_IO_StreamRun () failed. "
+							"Status = [0x%x]\n",
+							status);
+				}
+			}
+			else if (DSP_SUCCEEDED (status) && (mode == RING_IO_MODE_BULK)) {
+				status = RING_IO_BulkRun (RING_IO_Chnls,
+						0,
+						processorId,
+						options->inFile,
+						options->outFile);
+				if (DSP_FAILED (status)) {
+					RING_IO_1Print ("RING_IO_BulkRun () failed. "
+							"Status = [0x%x]\n",
+							status);
+				}
+			}
+			else if (DSP_SUCCEEDED (status) && (mode == RING_IO_MODE_BENCH)) {
+				status = RING_IO_BenchRun (RING_IO_Chnls,
+						0,
+						processorId,
+						options->benchBytes,
+						options->benchSizes);
+				if (DSP_FAILED (status)) {
+					RING_IO_1Print ("RING_IO_BenchRun () failed. "
+							"Status = [0x%x]\n",
+							status);
+				}
+			}
+			else if (DSP_SUCCEEDED (status) && (mode == RING_IO_MODE_SWEEP)) {
+				status = RING_IO_BenchSweep (RING_IO_Chnls,
+						0,
+						processorId,
+						RING_IO_ATTR_BUF_SIZE,
+						options->benchBytes,
+						options->configFile);
+				if (DSP_FAILED (status)) {
+					RING_IO_1Print ("RING_IO_BenchSweep () failed. "
+							"Status = [0x%x]\n",
+							status);
+				}
+			}
+			else if (   DSP_SUCCEEDED (status)
+					 && (mode == RING_IO_MODE_PREFETCH)) {
+				status = RING_IO_BenchPrefetch (RING_IO_Chnls,
+						0,
+						processorId,
+						RING_IO_ATTR_BUF_SIZE,
+						options->benchBytes);
+				if (DSP_FAILED (status)) {
+					RING_IO_1Print ("RING_IO_BenchPrefetch () failed. "
+							"Status = [0x%x]\n",
+							status);
+				}
+			}
+			else if (DSP_SUCCEEDED (status) && (mode == RING_IO_MODE_DAEMON)) {
+				status = RING_IO_DaemonRun (RING_IO_Chnls,
+						0,
+						options->socketPath);
+				if (DSP_FAILED (status)) {
+					RING_IO_1Print ("RING_IO_DaemonRun () failed. "
+							"Status = [0x%x]\n",
+							status);
+				}
+			}
+			else if (DSP_SUCCEEDED (status) && (mode == RING_IO_MODE_FILTER)) {
+				status = RING_IO_FilterRun (RING_IO_Chnls, 0, processorId);
+				if (DSP_FAILED (status)) {
+					RING_IO_1Print ("RING_IO_FilterRun () failed. "
+							"Status = [0x%x]\n",
+							status);
+				}
+			}
+			else if (DSP_SUCCEEDED (status)) {
 				writerClientInfo1.processorId = processorId;
 				status = RING_IO_Create_client(&writerClientInfo1,
 						(Pvoid)RING_IO_WriterClient1, NULL);
@@ -3120,8 +3451,9 @@ RING_IO_Main (IN Char8 * dspExecutable,
 			 }
 			 */
 
-			if (DSP_SUCCEEDED (status)) {
+			if (DSP_SUCCEEDED (status) && (mode == RING_IO_MODE_INTERACTIVE)) {
 				/* Wait for the threads/process to  terminate*/
+				RING_IO_CtrlWait ();
 				RING_IO_Join_client (&writerClientInfo1);
 				RING_IO_Join_client (&writerClientInfo2);
 				//   RING_IO_Join_client (&readerClientInfo1) ;
@@ -3129,6 +3461,9 @@ RING_IO_Main (IN Char8 * dspExecutable,
 
 			}
 
+			/* The tuner samples the channels until the very end */
+			RING_IO_TuneStop ();
+
 			/*
 			 *  Perform cleanup operation.
 			 */
@@ -3163,7 +3498,7 @@ RING_IO_Reader_VerifyData (IN Void * buffer,
 	DSP_STATUS status = DSP_SOK;
 	Char8 * ptr8 = (Char8 *) (buffer);
 	//Uint16 *   ptr16  = (Uint16 *) (buffer) ;
-	Int16 i;
+	Uint32 i;
 	for (i = 0;
 			DSP_SUCCEEDED (status) && (i < 20 );
 			i++) {
@@ -3255,18 +3590,31 @@ NORMAL_API
 Void
 RING_IO_InitBuffer (IN Void * buffer, Uint32 size)
 {
-	Uint8 * ptr8 = (Uint8 *) (buffer);
-	Uint16 * ptr16 = (Uint16 *) (buffer);
-	Int16 i;
-
 	if (buffer != NULL) {
-		for (i = 0; i < (size ); i++) {
+		RING_IO_Fill (buffer, XFER_VALUE, size);
+	}
+}
 
-			*ptr8 = XFER_VALUE;
-			ptr8++;
+/** ----------------------------------------------------------------------------
+ *  @func   RING_IO_RecordSize
+ *
+ *  @desc   Returns the size of the records sent for a transfer.
+ *
+ *  @modif  None
+ *  ----------------------------------------------------------------------------
+ */
+STATIC
+NORMAL_API
+Uint32
+RING_IO_RecordSize (IN RING_IO_Uint64 bytesToTransfer, IN Uint32 bufSize)
+{
+	Uint32 recSize = bufSize;
 
-		}
+	if (bytesToTransfer < bufSize) {
+		recSize = (Uint32) bytesToTransfer;
 	}
+
+	return (recSize);
 }
 
 /** ----------------------------------------------------------------------------
@@ -3333,15 +3681,16 @@ RING_IO_Reader_Notify1 (IN RingIO_Handle handle,
 		IN RingIO_NotifyMsg msg)
 {
 	DSP_STATUS status = DSP_SOK;
+	Uint32 event = RING_IO_EVENT_DATA;
 
 	switch(msg) {
 		case NOTIFY_DATA_START:
-		fReaderStart1 = TRUE;
+		event = RING_IO_EVENT_START;
 		RING_IO_0Print (" RING_IO_Reader_Notify1 Start Scuccess \n");
 		break;
 
 		case NOTIFY_DATA_END:
-		fReaderEnd1 = TRUE;
+		event = RING_IO_EVENT_END;
 		RING_IO_0Print (" RING_IO_Reader_Notify1 End Scuccess \n");
 		break;
 
@@ -3349,8 +3698,10 @@ RING_IO_Reader_Notify1 (IN RingIO_Handle handle,
 		break;
 	}
 
-	/* Post the semaphore. */
-	status = RING_IO_PostSem ((Pvoid) param);
+	/* Post the semaphore, unless the reader has not taken the last events */
+	if (RING_IO_AtomicOr (&RING_IO_Ctrl->chnls [0].readerEvents, event) == 0) {
+		status = RING_IO_PostSem ((Pvoid) param);
+	}
 	if (DSP_FAILED (status)) {
 		RING_IO_1Print ("RING_IO_PostSem () failed. Status = [0x%x]\n",
 				status);
@@ -3370,17 +3721,21 @@ RING_IO_Reader_Notify2 (IN RingIO_Handle handle,
 
 	switch(msg) {
 		case NOTIFY_DATA_START:
-		fReaderStart2 = TRUE;
 		RING_IO_0Print (" RING_IO_Reader_Notify2 Start Scuccess \n");
-		/* Post the semaphore. */
-		status = RING_IO_PostSem ((Pvoid) param);
+		/* Post the semaphore, unless the reader has not taken the last */
+		if (RING_IO_AtomicOr (&RING_IO_Ctrl->chnls [1].readerEvents,
+				RING_IO_EVENT_START) == 0) {
+			status = RING_IO_PostSem ((Pvoid) param);
+		}
 		break;
 
 		case NOTIFY_DATA_END:
-		fReaderEnd2 = TRUE;
 		RING_IO_0Print (" RING_IO_Reader_Notify2 End Scuccess \n");
-		/* Post the semaphore. */
-		status = RING_IO_PostSem ((Pvoid) param);
+		/* Post the semaphore, unless the reader has not taken the last */
+		if (RING_IO_AtomicOr (&RING_IO_Ctrl->chnls [1].readerEvents,
+				RING_IO_EVENT_END) == 0) {
+			status = RING_IO_PostSem ((Pvoid) param);
+		}
 		break;
 
 		default:
@@ -3394,6 +3749,33 @@ RING_IO_Reader_Notify2 (IN RingIO_Handle handle,
 	}
 }
 
+/** ----------------------------------------------------------------------------
+ *  @func   RING_IO_ReaderWait
+ *
+ *  @desc   Waits for a reader notification and takes the pending events.
+ *
+ *  @modif  events
+ *  ----------------------------------------------------------------------------
+ */
+STATIC
+NORMAL_API
+DSP_STATUS
+RING_IO_ReaderWait (IN Pvoid semHandle,
+		IN Uint32 chnlId,
+		IN OUT Uint32 * events)
+{
+	DSP_STATUS status = DSP_SOK;
+	RING_IO_CtrlChnl * ctrlChnl = &RING_IO_Ctrl->chnls [chnlId];
+
+	status = RING_IO_WaitSem (semHandle);
+	if (DSP_SUCCEEDED (status)) {
+		/* Emptying the mask lets the next notification post again */
+		*events |= RING_IO_AtomicXchg (&ctrlChnl->readerEvents, 0u);
+	}
+
+	return (status);
+}
+
 #if defined (__cplusplus)
 }
 #endif /* defined (__cplusplus) */
@@ -57,6 +57,350 @@ extern "C" {
 #endif /* defined (__cplusplus) */
 
 
+/*  ============================================================================
+ *  @const   RINGIO_DATA_START
+ *
+ *  @desc    Fixed attribute type indicates  start of the data in the RingIO
+ *  ============================================================================
+ */
+#define RINGIO_DATA_START       1u
+
+/*  ============================================================================
+ *  @const   NOTIFY_DATA_START
+ *
+ *  @desc    Notification message  to  DSP.Indicates data transfer start
+ *  ============================================================================
+ */
+#define NOTIFY_DATA_START       2u
+
+/*  ============================================================================
+ *  @const   RINGIO_DATA_END
+ *
+ *  @desc    Fixed attribute type indicates  start of the data in the RingIO
+ *  ============================================================================
+ */
+#define RINGIO_DATA_END         3u
+
+/*  ============================================================================
+ *  @const   NOTIFY_DATA_START
+ *
+ *  @desc     Notification message  to  DSP.Indicates data transfer stop.
+ *  ============================================================================
+ */
+#define NOTIFY_DATA_END         4u
+
+/*  ============================================================================
+ *  @const   RINGIO_DSP_END
+ *
+ *  @desc     Fixed attribute type indicates  end of the dsp 
+ *  ============================================================================
+ */
+#define RINGIO_DSP_END         5u
+
+/*  ============================================================================
+ *  @const   NOTIFY_DSP_END
+ *
+ *  @desc     Notification message  to  DSP.Indicates DSP end
+ *  ============================================================================
+ */
+#define NOTIFY_DSP_END         6u
+
+/*  ============================================================================
+ *  @const   RINGIO_DATA_RESIZE
+ *
+ *  @desc    Variable attribute type carrying new sizes for the RingIOs of a
+ *           channel, RING_IO_RESIZE_SIZE words. The DSP returns it as a
+ *           fixed attribute once it has closed the RingIO it reads, then
+ *           recreates the RingIO it writes with the new sizes.
+ *  ============================================================================
+ */
+#define RINGIO_DATA_RESIZE     7u
+
+/*  ============================================================================
+ *  @const   NOTIFY_DATA_RESIZE
+ *
+ *  @desc    Notification message to DSP. Indicates new RingIO sizes.
+ *  ============================================================================
+ */
+#define NOTIFY_DATA_RESIZE     8u
+
+/** ============================================================================
+ *  @const  RING_IO_RESIZE_SIZE, RING_IO_RESIZE_WRITER, RING_IO_RESIZE_READER,
+ *          RING_IO_RESIZE_ATTR
+ *
+ *  @desc   Words of the RINGIO_DATA_RESIZE attribute: the data buffer size
+ *          of the RingIO written by the GPP, that of the RingIO written by
+ *          the DSP and the attribute buffer size of both.
+ *  ============================================================================
+ */
+#define RING_IO_RESIZE_SIZE     3u
+#define RING_IO_RESIZE_WRITER   0u
+#define RING_IO_RESIZE_READER   1u
+#define RING_IO_RESIZE_ATTR     2u
+
+/** ============================================================================
+ *  @const  RING_IO_VATTR_SIZE
+ *
+ *  @desc   size of the RingIO varibale attribute buffer, in words.
+ *  ============================================================================
+ */
+#define RING_IO_VATTR_SIZE      5u
+
+/** ============================================================================
+ *  @const  RING_IO_VATTR_SIZE_BASE
+ *
+ *  @desc   Size in words of the variable attribute sent to a DSP that did
+ *          not announce RING_IO_XFER_VATTR_EXT: RING_IO_VATTR_LEN only.
+ *  ============================================================================
+ */
+#define RING_IO_VATTR_SIZE_BASE 1u
+
+/** ============================================================================
+ *  @const  RING_IO_VATTR_LEN, RING_IO_VATTR_OFFSET_LO, RING_IO_VATTR_OFFSET_HI,
+ *          RING_IO_VATTR_SEQ_LO, RING_IO_VATTR_SEQ_HI
+ *
+ *  @desc   Words of the variable attribute preceding every record: the size
+ *          of the record, the 64-bit offset of its first byte in the
+ *          transfer and the 64-bit sequence number of the record, low word
+ *          first. Sequence numbers start at zero with every transfer and the
+ *          DSP returns them unchanged with the processed records.
+ *  ============================================================================
+ */
+#define RING_IO_VATTR_LEN       0u
+#define RING_IO_VATTR_OFFSET_LO 1u
+#define RING_IO_VATTR_OFFSET_HI 2u
+#define RING_IO_VATTR_SEQ_LO    3u
+#define RING_IO_VATTR_SEQ_HI    4u
+
+/** ============================================================================
+ *  @name   RING_IO_Uint64
+ *
+ *  @desc   64-bit unsigned integer used for byte counts and sequence
+ *          numbers, which must not wrap on long running transfers.
+ *  ============================================================================
+ */
+typedef unsigned long long RING_IO_Uint64 ;
+
+/** ============================================================================
+ *  @const  RING_IO_XFER_DATA
+ *
+ *  @desc   Parameter of RINGIO_DATA_START: the records carry the payload.
+ *  ============================================================================
+ */
+#define RING_IO_XFER_DATA       0u
+
+/** ============================================================================
+ *  @const  RING_IO_XFER_BULK
+ *
+ *  @desc   Parameter of RINGIO_DATA_START: every record is one
+ *          RING_IO_BulkDesc naming a payload buffer in a POOL. The DSP
+ *          processes the payload in place and returns the same descriptor as
+ *          acknowledgement, after which the buffer is reused.
+ *  ============================================================================
+ */
+#define RING_IO_XFER_BULK       1u
+
+/** ============================================================================
+ *  @const  RING_IO_XFER_BATCH
+ *
+ *  @desc   Parameter of RINGIO_DATA_START: every record is a batch of
+ *          smaller records, made of a word holding their number, a word per
+ *          record holding its size, then the records. The DSP returns the
+ *          processed records without the table.
+ *  ============================================================================
+ */
+#define RING_IO_XFER_BATCH      2u
+
+/** ============================================================================
+ *  @const  RING_IO_XFER_MODE_MASK
+ *
+ *  @desc   Bits of the RINGIO_DATA_START parameter holding the
+ *          RING_IO_XFER_* mode. The bits above are capability flags.
+ *  ============================================================================
+ */
+#define RING_IO_XFER_MODE_MASK  0xFFu
+
+/** ============================================================================
+ *  @const  RING_IO_XFER_VATTR_EXT
+ *
+ *  @desc   Capability flag of the RINGIO_DATA_START parameter. The DSP sets
+ *          it in the attribute starting its transfers when it reads the
+ *          RING_IO_VATTR_SIZE words variable attribute; the GPP then sets
+ *          it in the attribute starting the transfers whose records carry
+ *          it. Without it the variable attribute is RING_IO_VATTR_SIZE_BASE
+ *          words, the layout read by the existing DSP images, whose
+ *          RingIO_getvAttribute () fails on a larger attribute.
+ *  ============================================================================
+ */
+#define RING_IO_XFER_VATTR_EXT  0x100u
+
+/** ============================================================================
+ *  @const  RING_IO_XFER_DOORBELL
+ *
+ *  @desc   Capability flag of the RINGIO_DATA_START parameter. The DSP sets
+ *          it in the attribute starting its transfers when it decodes the
+ *          doorbells of ring_io_notify.h. Without it every channel gets its
+ *          own notification.
+ *  ============================================================================
+ */
+#define RING_IO_XFER_DOORBELL   0x200u
+
+/** ============================================================================
+ *  @name   RING_IO_BulkDesc
+ *
+ *  @desc   Descriptor of a payload buffer exchanged in RING_IO_XFER_BULK
+ *          transfers.
+ *
+ *  @field  poolId
+ *              Pool the buffer was allocated from.
+ *  @field  dspAddr
+ *              DSP address of the payload.
+ *  @field  size
+ *              Number of valid bytes of the payload.
+ *  ============================================================================
+ */
+typedef struct RING_IO_BulkDesc_tag {
+    Uint32  poolId ;
+    Uint32  dspAddr ;
+    Uint32  size ;
+} RING_IO_BulkDesc ;
+
+
+/** ============================================================================
+ *  @name   RING_IO_Mode
+ *
+ *  @desc   Operating modes of the ring_io application.
+ *
+ *  @field  RING_IO_MODE_INTERACTIVE
+ *              Console driven transfers of a fixed pattern on both channels.
+ *  @field  RING_IO_MODE_STREAM
+ *              Streams an input file through the DSP into an output file.
+ *  @field  RING_IO_MODE_FILTER
+ *              Streams standard input through the DSP to standard output.
+ *  @field  RING_IO_MODE_DAEMON
+ *              Serves local clients over a Unix domain socket.
+ *  @field  RING_IO_MODE_BULK
+ *              Streams an input file through the DSP into an output file,
+ *              passing POOL buffer descriptors through the RingIO.
+ *  @field  RING_IO_MODE_BENCH
+ *              Measures synthetic transfers for a list of record sizes.
+ *  @field  RING_IO_MODE_SWEEP
+ *              Measures synthetic transfers for a grid of channel
+ *              configurations and writes the best one to a file.
+ *  @field  RING_IO_MODE_PREFETCH
+ *              Measures synthetic transfers through the largest RingIOs
+ *              with and without prefetching and staging of the reads.
+ *  ============================================================================
+ */
+typedef enum {
+    RING_IO_MODE_INTERACTIVE = 0u,
+    RING_IO_MODE_STREAM      = 1u,
+    RING_IO_MODE_FILTER      = 2u,
+    RING_IO_MODE_DAEMON      = 3u,
+    RING_IO_MODE_BULK        = 4u,
+    RING_IO_MODE_BENCH       = 5u,
+    RING_IO_MODE_SWEEP       = 6u,
+    RING_IO_MODE_PREFETCH    = 7u
+} RING_IO_Mode ;
+
+/** ============================================================================
+ *  @name   RING_IO_TuneMode
+ *
+ *  @desc   Modes of the ring size tuner.
+ *
+ *  @field  RING_IO_TUNE_OFF
+ *              The tuner does not run.
+ *  @field  RING_IO_TUNE_RECOMMEND
+ *              The tuner logs the sizes it would apply.
+ *  @field  RING_IO_TUNE_APPLY
+ *              The tuner applies them between transfers.
+ *  ============================================================================
+ */
+typedef enum {
+    RING_IO_TUNE_OFF        = 0u,
+    RING_IO_TUNE_RECOMMEND  = 1u,
+    RING_IO_TUNE_APPLY      = 2u
+} RING_IO_TuneMode ;
+
+/** ============================================================================
+ *  @name   RING_IO_Config
+ *
+ *  @desc   Configuration of the first channel, applied once the DSP is
+ *          loaded. A field left to zero keeps the built-in value.
+ *
+ *  @field  ringSize
+ *              Size of the data buffers of both RingIOs.
+ *  @field  acqSize
+ *              Size of each acquire on the writer RingIO.
+ *  @field  watermark
+ *              Watermark of the writer notification, the acquire size if 0.
+ *  @field  notifyAlways
+ *              Non zero to be notified each time the writer RingIO is above
+ *              the watermark instead of once.
+ *  @field  prefetch
+ *              Number of bytes of an acquired reader buffer prefetched ahead
+ *              of the drain function, 0 not to prefetch.
+ *  @field  stage
+ *              Non zero to copy the acquired reader buffers to a cached
+ *              staging buffer with streaming loads before draining them.
+ *  @field  fillAhead
+ *              Non zero to run the fill function of the writer in a thread of
+ *              its own, which fills the next record in a staging buffer while
+ *              the writer copies the previous one to the RingIO.
+ *  ============================================================================
+ */
+typedef struct RING_IO_Config_tag {
+    Uint32  ringSize ;
+    Uint32  acqSize ;
+    Uint32  watermark ;
+    Uint32  notifyAlways ;
+    Uint32  prefetch ;
+    Uint32  stage ;
+    Uint32  fillAhead ;
+} RING_IO_Config ;
+
+/** ============================================================================
+ *  @name   RING_IO_Options
+ *
+ *  @desc   Run time options of the ring_io application, as parsed by the
+ *          OS specific driver.
+ *
+ *  @field  mode
+ *              Operating mode of the application.
+ *  @field  inFile
+ *              Input file for RING_IO_MODE_STREAM and RING_IO_MODE_BULK.
+ *  @field  outFile
+ *              Output file for RING_IO_MODE_STREAM and RING_IO_MODE_BULK.
+ *  @field  socketPath
+ *              Socket path for RING_IO_MODE_DAEMON.
+ *  @field  benchBytes
+ *              Bytes sent per record size in RING_IO_MODE_BENCH, per
+ *              configuration in RING_IO_MODE_SWEEP and
+ *              RING_IO_MODE_PREFETCH.
+ *  @field  benchSizes
+ *              Comma separated record sizes for RING_IO_MODE_BENCH.
+ *  @field  tune
+ *              Mode of the ring size tuner.
+ *  @field  config
+ *              Configuration of the first channel.
+ *  @field  configFile
+ *              File the best configuration is written to in
+ *              RING_IO_MODE_SWEEP.
+ *  ============================================================================
+ */
+typedef struct RING_IO_Options_tag {
+    RING_IO_Mode    mode ;
+    Char8 *         inFile ;
+    Char8 *         outFile ;
+    Char8 *         socketPath ;
+    RING_IO_Uint64  benchBytes ;
+    Char8 *         benchSizes ;
+    RING_IO_TuneMode tune ;
+    RING_IO_Config  config ;
+    Char8 *         configFile ;
+} RING_IO_Options ;
+
+
 /** ============================================================================
  *  @func   RING_IO_Create
  *
@@ -138,6 +482,8 @@ RING_IO_Delete (IN Uint8 processorId) ;
  *              GPP and DSP in string format.
  *  @arg    strProcessorId
  *              ID of the DSP processor  in string format.
+ *  @arg    options
+ *              Run time options. NULL selects RING_IO_MODE_INTERACTIVE.
  *
  *  @ret    None
  *
@@ -150,10 +496,11 @@ RING_IO_Delete (IN Uint8 processorId) ;
  */
 NORMAL_API
 Void
-RING_IO_Main (IN Char8 * dspExecutable,
-              IN Char8 * strBufferSize,
-              IN Char8 * strNumIterations,
-              IN Char8 * strProcessorId) ;
+RING_IO_Main (IN Char8 *           dspExecutable,
+              IN Char8 *           strBufferSize,
+              IN Char8 *           strNumIterations,
+              IN Char8 *           strProcessorId,
+              IN RING_IO_Options * options) ;
 
 
 #if defined (DA8XXGEM)
@@ -249,6 +596,33 @@ NORMAL_API
 Void
 RING_IO_1Print (Char8 * str, Uint32 arg) ;
 
+
+/** ============================================================================
+ *  @func   RING_IO_1Print64
+ *
+ *  @desc   Print a message with one 64-bit argument, to be formatted with
+ *          %llu.
+ *          This is a OS specific function and is implemented in file:
+ *              <GPPOS>\ring_io_os.c
+ *
+ *  @arg    str
+ *              String message to be printed.
+ *  @arg    arg
+ *              Argument to be printed.
+ *
+ *  @ret    None
+ *
+ *  @enter  None
+ *
+ *  @leave  None
+ *
+ *  @see    RING_IO_1Print
+ *  ============================================================================
+ */
+NORMAL_API
+Void
+RING_IO_1Print64 (Char8 * str, RING_IO_Uint64 arg) ;
+
 /** ============================================================================
  *  @func   RING_IO_YieldTsk
  *
@@ -0,0 +1,1233 @@
+/** ============================================================================
+ *  @file   ring_io_bench.c
+ *
+ *  @path   $(DSPLINK)/gpp/src/samples/ring_io/
+ *
+ *  @desc   Implementation of the benchmark mode of the ring_io application.
+ *          The writer client fills records with a fixed pattern and stamps
+ *          the time each record is sent. The reader client takes the time
+ *          each record is completely received back, so the latency of a
+ *          record includes its queueing in both RingIOs and its processing
+ *          by the DSP.
+ *          The state of the benchmark lives in shared memory, so that the
+ *          clients update it the same way whether they are threads or
+ *          processes. Clients are created without argument so that
+ *          RING_IO_MULTIPROCESS builds run them in the pool workers, as in
+ *          a deployment.
+ *          The clients lease the channel from the channel pool, so that the
+ *          runs after the first one reuse the RingIOs left open.
+ *
+ *  @ver    1.65.00.02
+ *  ============================================================================
+ *  Copyright (C) 2002-2009, Texas Instruments Incorporated -
+ *  http://www.ti.com/
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions
+ *  are met:
+ *  
+ *  *  Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *  
+ *  *  Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer in the
+ *     documentation and/or other materials provided with the distribution.
+ *  
+ *  *  Neither the name of Texas Instruments Incorporated nor the names of
+ *     its contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *  
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ *  THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ *  PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+ *  CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ *  EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ *  PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ *  OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ *  WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ *  OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ *  EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *  ============================================================================
+ */
+
+/*  ------------------------ DSP/BIOS Link ----------------------------------*/
+#include <dsplink.h>
+
+/*  ------------------------DSP/BIOS LINK API -------------------------------*/
+#include <ringio.h>
+#include <string.h>
+#include <stdlib.h>
+
+/*  ------------------------ Application Header------------------------------*/
+#include <ring_io.h>
+#include <ring_io_os.h>
+#include <ring_io_chnl.h>
+#include <ring_io_bench.h>
+#include <ring_io_tune.h>
+
+
+#if defined (__cplusplus)
+extern "C" {
+#endif /* defined (__cplusplus) */
+
+
+/** ============================================================================
+ *  @const  RING_IO_BENCH_PATTERN
+ *
+ *  @desc   Byte the records are filled with.
+ *  ============================================================================
+ */
+#define RING_IO_BENCH_PATTERN       0xA5u
+
+/** ============================================================================
+ *  @name   RING_IO_BenchObj
+ *
+ *  @desc   State of a benchmark run, shared by the clients.
+ *
+ *  @field  chnl
+ *              Channel used.
+ *  @field  recSize
+ *              Size of the records.
+ *  @field  totalBytes
+ *              Number of bytes to be sent.
+ *  @field  stride
+ *              Every stride-th record is sampled for its latency.
+ *  @field  sent
+ *              Number of bytes sent. Written by the writer only.
+ *  @field  rcvd
+ *              Number of bytes received. Written by the reader only.
+ *  @field  lost
+ *              Number of sampled records whose send time was overwritten
+ *              before they were received.
+ *  @field  numSamples
+ *              Number of latency samples.
+ *  @field  writerCreate
+ *              Time stamp in microseconds of the creation of the writer.
+ *  @field  readerCreate
+ *              Time stamp in microseconds of the creation of the reader.
+ *  @field  writerStart
+ *              Time stamp in microseconds of the start of the writer.
+ *  @field  readerStart
+ *              Time stamp in microseconds of the start of the reader.
+ *  @field  firstSend
+ *              Time stamp in microseconds of the first record sent.
+ *  @field  lastRcv
+ *              Time stamp in microseconds of the last byte received.
+ *  @field  writerUsage
+ *              Context switches of the writer during the run, and its peak
+ *              resident set size.
+ *  @field  readerUsage
+ *              Same for the reader.
+ *  @field  writerStatus
+ *              Status of the writer.
+ *  @field  readerStatus
+ *              Status of the reader.
+ *  @field  sync
+ *              Synchronization policy the clients create their semaphores
+ *              with.
+ *  @field  touch
+ *              Set if the reader reads every byte it receives.
+ *  @field  checksum
+ *              Sum of the bytes read when touch is set.
+ *  @field  stamps
+ *              Send times of the last records sent.
+ *  @field  samples
+ *              Latencies of the sampled records in microseconds.
+ *  ============================================================================
+ */
+typedef struct RING_IO_BenchObj_tag {
+	RING_IO_ChnlObj *       chnl;
+	Uint32                  recSize;
+	RING_IO_Uint64          totalBytes;
+	Uint32                  stride;
+	volatile RING_IO_Uint64 sent;
+	RING_IO_Uint64          rcvd;
+	Uint32                  lost;
+	Uint32                  numSamples;
+	RING_IO_Uint64          writerCreate;
+	RING_IO_Uint64          readerCreate;
+	RING_IO_Uint64          writerStart;
+	RING_IO_Uint64          readerStart;
+	RING_IO_Uint64          firstSend;
+	RING_IO_Uint64          lastRcv;
+	RING_IO_Usage           writerUsage;
+	RING_IO_Usage           readerUsage;
+	DSP_STATUS              writerStatus;
+	DSP_STATUS              readerStatus;
+	RING_IO_SyncPolicy      sync;
+	Bool                    touch;
+	Uint32                  checksum;
+	volatile RING_IO_Uint64 stamps [RING_IO_BENCH_NUM_STAMPS];
+	Uint32                  samples [RING_IO_BENCH_MAX_SAMPLES];
+} RING_IO_BenchObj;
+
+/** ============================================================================
+ *  @name   RING_IO_Bench
+ *
+ *  @desc   The benchmark being run, in shared memory. Mapped by
+ *          RING_IO_BenchInit () before any client is created, as the pool
+ *          workers only see the mappings made before they are forked.
+ *  ============================================================================
+ */
+STATIC RING_IO_BenchObj * RING_IO_Bench = NULL;
+
+/** ============================================================================
+ *  @name   benchWriterInfo, benchReaderInfo
+ *
+ *  @desc   Writer and reader client information structures.
+ *  ============================================================================
+ */
+STATIC RING_IO_ClientInfo benchWriterInfo;
+STATIC RING_IO_ClientInfo benchReaderInfo;
+
+/** ============================================================================
+ *  @const  RING_IO_BENCH_SWEEP_RINGS, RING_IO_BENCH_SWEEP_ACQS,
+ *          RING_IO_BENCH_SWEEP_WATERMARKS, RING_IO_BENCH_SWEEP_NOTIFIES,
+ *          RING_IO_BENCH_SWEEP_KINDS
+ *
+ *  @desc   Number of values of each dimension of the grid of a sweep. The
+ *          watermarks are the acquire size and half the ring, the
+ *          notifications once and always, the kinds of client threads and
+ *          fibers. Client processes cannot be fibers.
+ *  ============================================================================
+ */
+#define RING_IO_BENCH_SWEEP_RINGS       3u
+#define RING_IO_BENCH_SWEEP_ACQS        3u
+#define RING_IO_BENCH_SWEEP_WATERMARKS  2u
+#define RING_IO_BENCH_SWEEP_NOTIFIES    2u
+#if defined (RING_IO_MULTIPROCESS)
+#define RING_IO_BENCH_SWEEP_KINDS       1u
+#else
+#define RING_IO_BENCH_SWEEP_KINDS       2u
+#endif /* if defined (RING_IO_MULTIPROCESS) */
+
+/** ============================================================================
+ *  @const  RING_IO_BENCH_CONFIG_SIZE
+ *
+ *  @desc   Size of the text of a configuration file.
+ *  ============================================================================
+ */
+#define RING_IO_BENCH_CONFIG_SIZE       512u
+
+/** ============================================================================
+ *  @name   RING_IO_BenchPoint
+ *
+ *  @desc   Channel configuration of a sweep and its measurements.
+ *
+ *  @field  config
+ *              Configuration of the channel.
+ *  @field  sync
+ *              Synchronization policy of the OS layer.
+ *  @field  fibers
+ *              Set if the clients are fibers.
+ *  @field  throughput
+ *              Throughput in kilobytes per second.
+ *  @field  latencyP99
+ *              99th percentile of the latency in microseconds.
+ *  ============================================================================
+ */
+typedef struct RING_IO_BenchPoint_tag {
+	RING_IO_Config       config;
+	RING_IO_SyncPolicy   sync;
+	Bool                 fibers;
+	RING_IO_Uint64       throughput;
+	Uint32               latencyP99;
+} RING_IO_BenchPoint;
+
+/** ============================================================================
+ *  @name   RING_IO_BenchRings, RING_IO_BenchAcqs
+ *
+ *  @desc   Ring sizes and acquire sizes of the grid of a sweep. The ring
+ *          sizes match the buffers of the pool of resized RingIOs.
+ *  ============================================================================
+ */
+STATIC Uint32 RING_IO_BenchRings [RING_IO_BENCH_SWEEP_RINGS] = {1024u,
+	4096u,
+	RING_IO_RESIZE_MAX_SIZE
+};
+STATIC Uint32 RING_IO_BenchAcqs [RING_IO_BENCH_SWEEP_ACQS] = {256u,
+	1024u,
+	4096u
+};
+
+/** ============================================================================
+ *  @name   RING_IO_BenchPoints
+ *
+ *  @desc   Configurations measured by the sweep.
+ *  ============================================================================
+ */
+STATIC RING_IO_BenchPoint RING_IO_BenchPoints [RING_IO_BENCH_SWEEP_MAX];
+
+/** ============================================================================
+ *  @const  RING_IO_BENCH_PREFETCHES
+ *
+ *  @desc   Number of prefetch distances measured by RING_IO_BenchPrefetch ().
+ *  ============================================================================
+ */
+#define RING_IO_BENCH_PREFETCHES        4u
+
+/** ============================================================================
+ *  @name   RING_IO_BenchPrefetches
+ *
+ *  @desc   Prefetch distances measured by RING_IO_BenchPrefetch (), 0 not to
+ *          prefetch.
+ *  ============================================================================
+ */
+STATIC Uint32 RING_IO_BenchPrefetches [RING_IO_BENCH_PREFETCHES] = {0u,
+	256u,
+	1024u,
+	RING_IO_CHNL_STAGE_SIZE
+};
+
+
+/** ----------------------------------------------------------------------------
+ *  @func   RING_IO_BenchFill
+ *
+ *  @desc   Fill function of the benchmark: fills the acquired buffer with
+ *          the pattern and stamps the records starting in it.
+ *
+ *  @modif  sent and stamps of the benchmark.
+ *  ----------------------------------------------------------------------------
+ */
+STATIC
+NORMAL_API
+DSP_STATUS
+RING_IO_BenchFill (IN  Pvoid arg,
+		IN  RingIO_BufPtr buffer,
+		IN  Uint32 size,
+		OUT Uint32 * filled)
+{
+	RING_IO_BenchObj * bench = (RING_IO_BenchObj *) arg;
+	RING_IO_Uint64 remain = bench->totalBytes - bench->sent;
+	RING_IO_Uint64 rec;
+	RING_IO_Uint64 now;
+
+	if (size > remain) {
+		size = (Uint32) remain;
+	}
+
+	if (size > 0) {
+		now = RING_IO_GetTimeUsec ();
+		if (bench->sent == 0) {
+			bench->firstSend = now;
+		}
+		RING_IO_Fill (buffer, RING_IO_BENCH_PATTERN, size);
+		for (rec = (bench->sent + bench->recSize - 1u) / bench->recSize;
+				(rec * bench->recSize) < (bench->sent + size);
+				rec++) {
+			bench->stamps [rec % RING_IO_BENCH_NUM_STAMPS] = now;
+		}
+		RING_IO_MemBarrier ();
+		bench->sent += size;
+	}
+	*filled = size;
+
+	return (DSP_SOK);
+}
+
+/** ----------------------------------------------------------------------------
+ *  @func   RING_IO_BenchDrain
+ *
+ *  @desc   Drain function of the benchmark: samples the latency of the
+ *          records completed by the received data, and reads it if asked.
+ *
+ *  @modif  rcvd, lost, numSamples, samples and checksum of the benchmark.
+ *  ----------------------------------------------------------------------------
+ */
+STATIC
+NORMAL_API
+DSP_STATUS
+RING_IO_BenchDrain (IN Pvoid arg,
+		IN RingIO_BufPtr buffer,
+		IN Uint32 size)
+{
+	RING_IO_BenchObj * bench = (RING_IO_BenchObj *) arg;
+	RING_IO_Uint64 rec = bench->rcvd / bench->recSize;
+	RING_IO_Uint64 now = RING_IO_GetTimeUsec ();
+	RING_IO_Uint64 sent;
+	Uint8 * data = (Uint8 *) buffer;
+	Uint32 sum = 0;
+	Uint32 i;
+
+	if (bench->touch == TRUE) {
+		for (i = 0; i < size; i++) {
+			sum += data [i];
+		}
+		bench->checksum += sum;
+	}
+
+	bench->rcvd += size;
+	bench->lastRcv = now;
+	for (; ((rec + 1u) * bench->recSize) <= bench->rcvd; rec++) {
+		if (   ((rec % bench->stride) != 0)
+			|| (bench->numSamples >= RING_IO_BENCH_MAX_SAMPLES)) {
+			continue;
+		}
+		/* A record is sent before it is received, so stamped by now */
+		sent = bench->sent;
+		RING_IO_MemBarrier ();
+		if (sent > ((rec + RING_IO_BENCH_NUM_STAMPS) * bench->recSize)) {
+			bench->lost++;
+		}
+		else {
+			bench->samples [bench->numSamples++] = (Uint32) (now
+					- bench->stamps [rec % RING_IO_BENCH_NUM_STAMPS]);
+		}
+	}
+
+	return (DSP_SOK);
+}
+
+/** ----------------------------------------------------------------------------
+ *  @func   RING_IO_BenchUsage
+ *
+ *  @desc   Turns the usage of a client at its start into the usage during
+ *          its run.
+ *
+ *  @modif  usage
+ *  ----------------------------------------------------------------------------
+ */
+STATIC
+NORMAL_API
+Void
+RING_IO_BenchUsage (IN OUT RING_IO_Usage * usage)
+{
+	RING_IO_Usage end;
+
+	RING_IO_GetUsage (&end);
+	usage->maxRss = end.maxRss;
+	usage->volCsw = end.volCsw - usage->volCsw;
+	usage->involCsw = end.involCsw - usage->involCsw;
+}
+
+/** ============================================================================
+ *  @func   RING_IO_BenchWriterClient
+ *
+ *  @desc   Writer client of the benchmark.
+ *
+ *  @modif  None
+ *  ============================================================================
+ */
+NORMAL_API
+Void *
+RING_IO_BenchWriterClient (IN Void * ptr)
+{
+	DSP_STATUS status = DSP_SOK;
+	DSP_STATUS tmpStatus = DSP_SOK;
+	RING_IO_BenchObj * bench = RING_IO_Bench;
+	RING_IO_Uint64 bytesTransfered = 0;
+
+	(Void) ptr;
+
+	bench->writerStart = RING_IO_GetTimeUsec ();
+	RING_IO_GetUsage (&bench->writerUsage);
+
+	/* A pool worker keeps the policy in force when it was forked */
+	RING_IO_SyncSet (bench->sync);
+
+	/* The lease takes the acquire size published for the run */
+	status = RING_IO_ChnlLeaseWriter (bench->chnl);
+
+	if (DSP_SUCCEEDED (status)) {
+		status = RING_IO_ChnlWriteStart (bench->chnl);
+	}
+
+	if (DSP_SUCCEEDED (status)) {
+		status = RING_IO_ChnlWrite (bench->chnl,
+				&RING_IO_BenchFill,
+				bench,
+				&bytesTransfered);
+
+		/* Always terminate the transfer so that the reader completes */
+		tmpStatus = RING_IO_ChnlWriteEnd (bench->chnl);
+		if (DSP_SUCCEEDED (status) && DSP_FAILED (tmpStatus)) {
+			status = tmpStatus;
+		}
+	}
+
+	tmpStatus = RING_IO_ChnlReturnWriter (bench->chnl);
+	if (DSP_SUCCEEDED (status) && DSP_FAILED (tmpStatus)) {
+		status = tmpStatus;
+	}
+
+	RING_IO_BenchUsage (&bench->writerUsage);
+	bench->writerStatus = status;
+
+	/* Exit */
+	RING_IO_Exit_client (&benchWriterInfo);
+
+	return (NULL);
+}
+
+/** ============================================================================
+ *  @func   RING_IO_BenchReaderClient
+ *
+ *  @desc   Reader client of the benchmark.
+ *
+ *  @modif  None
+ *  ============================================================================
+ */
+NORMAL_API
+Void *
+RING_IO_BenchReaderClient (IN Void * ptr)
+{
+	DSP_STATUS status = DSP_SOK;
+	DSP_STATUS tmpStatus = DSP_SOK;
+	RING_IO_BenchObj * bench = RING_IO_Bench;
+	RING_IO_Uint64 totalRcvbytes = 0;
+
+	(Void) ptr;
+
+	bench->readerStart = RING_IO_GetTimeUsec ();
+	RING_IO_GetUsage (&bench->readerUsage);
+
+	RING_IO_SyncSet (bench->sync);
+
+	status = RING_IO_ChnlLeaseReader (bench->chnl);
+	if (DSP_SUCCEEDED (status)) {
+		status = RING_IO_ChnlRead (bench->chnl,
+				&RING_IO_BenchDrain,
+				bench,
+				&totalRcvbytes);
+
+		tmpStatus = RING_IO_ChnlReturnReader (bench->chnl);
+		if (DSP_SUCCEEDED (status) && DSP_FAILED (tmpStatus)) {
+			status = tmpStatus;
+		}
+	}
+
+	RING_IO_BenchUsage (&bench->readerUsage);
+	bench->readerStatus = status;
+
+	/* Exit */
+	RING_IO_Exit_client (&benchReaderInfo);
+
+	return (NULL);
+}
+
+/** ----------------------------------------------------------------------------
+ *  @func   RING_IO_BenchCompare
+ *
+ *  @desc   Orders latency samples for qsort ().
+ *
+ *  @modif  None
+ *  ----------------------------------------------------------------------------
+ */
+STATIC
+int
+RING_IO_BenchCompare (const void * a, const void * b)
+{
+	Uint32 x = *(const Uint32 *) a;
+	Uint32 y = *(const Uint32 *) b;
+
+	return ((x > y) - (x < y));
+}
+
+/** ----------------------------------------------------------------------------
+ *  @func   RING_IO_BenchPrint
+ *
+ *  @desc   Prints one measurement of a run, prefixed so that the reports of
+ *          several builds can be merged.
+ *
+ *  @modif  None
+ *  ----------------------------------------------------------------------------
+ */
+STATIC
+NORMAL_API
+Void
+RING_IO_BenchPrint (IN Uint32 recSize, IN Char8 * name, IN RING_IO_Uint64 val)
+{
+	RING_IO_0Print ("BENCH ");
+	RING_IO_0Print (RING_IO_ClientKind ());
+	RING_IO_0Print (" ");
+	RING_IO_0Print (RING_IO_SyncName (RING_IO_SyncGet ()));
+	RING_IO_1Print (" %u ", recSize);
+	RING_IO_0Print (name);
+	RING_IO_1Print64 (" %llu\n", val);
+}
+
+/** ----------------------------------------------------------------------------
+ *  @func   RING_IO_BenchReport
+ *
+ *  @desc   Prints the measurements of a run.
+ *
+ *  @modif  samples of the benchmark, which are sorted.
+ *  ----------------------------------------------------------------------------
+ */
+STATIC
+NORMAL_API
+Void
+RING_IO_BenchReport (IN RING_IO_BenchObj * bench)
+{
+	Uint32 recSize = bench->recSize;
+	Uint32 * samples = bench->samples;
+	Uint32 num = bench->numSamples;
+	RING_IO_Uint64 elapsed = bench->lastRcv - bench->firstSend;
+
+	RING_IO_BenchPrint (recSize, "bytes", bench->rcvd);
+	if ((bench->rcvd > 0) && (elapsed > 0)) {
+		RING_IO_BenchPrint (recSize,
+				"throughput_kbps",
+				(bench->rcvd * 1000u) / elapsed);
+	}
+
+	if (num > 0) {
+		qsort (samples, num, sizeof (Uint32), &RING_IO_BenchCompare);
+		RING_IO_BenchPrint (recSize, "latency_p50_us", samples [num / 2u]);
+		RING_IO_BenchPrint (recSize,
+				"latency_p90_us",
+				samples [(num * 9u) / 10u]);
+		RING_IO_BenchPrint (recSize,
+				"latency_p99_us",
+				samples [(num * 99u) / 100u]);
+		RING_IO_BenchPrint (recSize, "latency_max_us", samples [num - 1u]);
+	}
+	RING_IO_BenchPrint (recSize, "latency_samples", num);
+	RING_IO_BenchPrint (recSize, "latency_lost", bench->lost);
+
+	RING_IO_BenchPrint (recSize,
+			"writer_startup_us",
+			bench->writerStart - bench->writerCreate);
+	RING_IO_BenchPrint (recSize,
+			"reader_startup_us",
+			bench->readerStart - bench->readerCreate);
+
+	/* Thread clients share the resident set of the application */
+	RING_IO_BenchPrint (recSize, "writer_rss_kb", bench->writerUsage.maxRss);
+	RING_IO_BenchPrint (recSize, "reader_rss_kb", bench->readerUsage.maxRss);
+	RING_IO_BenchPrint (recSize,
+			"writer_vcsw",
+			bench->writerUsage.volCsw);
+	RING_IO_BenchPrint (recSize,
+			"writer_ivcsw",
+			bench->writerUsage.involCsw);
+	RING_IO_BenchPrint (recSize,
+			"reader_vcsw",
+			bench->readerUsage.volCsw);
+	RING_IO_BenchPrint (recSize,
+			"reader_ivcsw",
+			bench->readerUsage.involCsw);
+}
+
+/** ----------------------------------------------------------------------------
+ *  @func   RING_IO_BenchCheck
+ *
+ *  @desc   Checks that the state of the benchmark has been mapped.
+ *
+ *  @modif  None
+ *  ----------------------------------------------------------------------------
+ */
+STATIC
+NORMAL_API
+DSP_STATUS
+RING_IO_BenchCheck (Void)
+{
+	DSP_STATUS status = DSP_SOK;
+
+	if (RING_IO_Bench == NULL) {
+		status = DSP_EFAIL;
+		RING_IO_0Print ("ERROR! RING_IO_BenchInit () not called\n");
+	}
+
+	return (status);
+}
+
+/** ----------------------------------------------------------------------------
+ *  @func   RING_IO_BenchOne
+ *
+ *  @desc   Runs the writer and reader clients for one record size.
+ *
+ *  @modif  writerAcqSize of the channel used, which is published.
+ *  ----------------------------------------------------------------------------
+ */
+STATIC
+NORMAL_API
+DSP_STATUS
+RING_IO_BenchOne (IN RING_IO_BenchObj * bench,
+		IN Uint8 processorId,
+		IN Uint32 recSize,
+		IN RING_IO_Uint64 totalBytes)
+{
+	DSP_STATUS status = DSP_SOK;
+	RING_IO_ChnlObj * chnl = bench->chnl;
+	Bool touch = bench->touch;
+	RING_IO_Uint64 numRecs;
+
+	memset (bench, 0, sizeof (RING_IO_BenchObj));
+	bench->chnl = chnl;
+	bench->touch = touch;
+	bench->recSize = recSize;
+	bench->totalBytes = totalBytes;
+	numRecs = (bench->totalBytes + recSize - 1u) / recSize;
+	bench->stride = (Uint32) (numRecs / RING_IO_BENCH_MAX_SAMPLES) + 1u;
+	bench->writerStatus = DSP_EFAIL;
+	bench->readerStatus = DSP_EFAIL;
+	bench->sync = RING_IO_SyncGet ();
+
+	/* Every acquire is one record */
+	chnl->writerAcqSize = recSize;
+	RING_IO_ChnlPublish (chnl);
+
+	benchReaderInfo.processorId = processorId;
+	bench->readerCreate = RING_IO_GetTimeUsec ();
+	status = RING_IO_Create_client (&benchReaderInfo,
+			(Pvoid) RING_IO_BenchReaderClient,
+			NULL);
+	if (DSP_SUCCEEDED (status)) {
+		benchWriterInfo.processorId = processorId;
+		bench->writerCreate = RING_IO_GetTimeUsec ();
+		status = RING_IO_Create_client (&benchWriterInfo,
+				(Pvoid) RING_IO_BenchWriterClient,
+				NULL);
+		if (DSP_SUCCEEDED (status)) {
+			RING_IO_Join_client (&benchWriterInfo);
+		}
+		else {
+			RING_IO_0Print ("ERROR! Failed to create bench writer client\n");
+		}
+		RING_IO_Join_client (&benchReaderInfo);
+	}
+	else {
+		RING_IO_0Print ("ERROR! Failed to create bench reader client\n");
+	}
+
+	if (DSP_SUCCEEDED (status)) {
+		status = DSP_FAILED (bench->writerStatus) ? bench->writerStatus
+				: bench->readerStatus;
+	}
+	if (DSP_FAILED (status)) {
+		RING_IO_1Print ("Benchmark run failed. Status = [0x%x]\n", status);
+	}
+
+	return (status);
+}
+
+/** ============================================================================
+ *  @func   RING_IO_BenchInit
+ *
+ *  @desc   Maps the state of the benchmark.
+ *
+ *  @modif  RING_IO_Bench
+ *  ============================================================================
+ */
+NORMAL_API
+DSP_STATUS
+RING_IO_BenchInit (Void)
+{
+	DSP_STATUS status = DSP_SOK;
+	Pvoid addr = NULL;
+
+	status = RING_IO_ShmAlloc (sizeof (RING_IO_BenchObj), &addr);
+	if (DSP_SUCCEEDED (status)) {
+		RING_IO_Bench = (RING_IO_BenchObj *) addr;
+	}
+
+	return (status);
+}
+
+/** ============================================================================
+ *  @func   RING_IO_BenchExit
+ *
+ *  @desc   Unmaps the state of the benchmark.
+ *
+ *  @modif  RING_IO_Bench
+ *  ============================================================================
+ */
+NORMAL_API
+Void
+RING_IO_BenchExit (Void)
+{
+	if (RING_IO_Bench != NULL) {
+		RING_IO_ShmFree (RING_IO_Bench, sizeof (RING_IO_BenchObj));
+		RING_IO_Bench = NULL;
+	}
+}
+
+/** ============================================================================
+ *  @func   RING_IO_BenchRun
+ *
+ *  @desc   Runs the benchmark for each record size.
+ *
+ *  @modif  None
+ *  ============================================================================
+ */
+NORMAL_API
+DSP_STATUS
+RING_IO_BenchRun (IN RING_IO_ChnlObj * chnls,
+		IN Uint32 chnlId,
+		IN Uint8 processorId,
+		IN RING_IO_Uint64 totalBytes,
+		IN Char8 * sizes)
+{
+	DSP_STATUS status = DSP_SOK;
+	DSP_STATUS tmpStatus = DSP_SOK;
+	RING_IO_ChnlObj * chnl = &chnls [chnlId];
+	Uint32 recSizes [RING_IO_BENCH_MAX_SIZES];
+	Uint32 numSizes = 0;
+	Uint32 savedAcqSize = chnl->writerAcqSize;
+	Char8 * next = sizes;
+	Uint32 i;
+
+	while ((next != NULL) && (*next != '\0')
+			&& (numSizes < RING_IO_BENCH_MAX_SIZES)) {
+		recSizes [numSizes] = (Uint32) strtoul (next, &next, 10);
+		if (recSizes [numSizes] > chnl->writerBufSize) {
+			recSizes [numSizes] = chnl->writerBufSize;
+		}
+		if (recSizes [numSizes] > 0) {
+			numSizes++;
+		}
+		if (*next == ',') {
+			next++;
+		}
+		else if (*next != '\0') {
+			next = NULL;
+		}
+	}
+	if ((numSizes == 0) || (totalBytes == 0)) {
+		status = DSP_EINVALIDARG;
+		RING_IO_0Print ("ERROR! Invalid benchmark arguments\n");
+	}
+
+	if (DSP_SUCCEEDED (status)) {
+		status = RING_IO_BenchCheck ();
+	}
+
+	if (DSP_SUCCEEDED (status)) {
+		RING_IO_Bench->chnl = chnl;
+		RING_IO_Bench->touch = FALSE;
+		for (i = 0; (i < numSizes) && DSP_SUCCEEDED (status); i++) {
+			status = RING_IO_BenchOne (RING_IO_Bench,
+					processorId,
+					recSizes [i],
+					totalBytes);
+			if (DSP_SUCCEEDED (status)) {
+				RING_IO_BenchReport (RING_IO_Bench);
+			}
+			/* Runs are the transfers the tuner may resize between */
+			if (DSP_SUCCEEDED (status)) {
+				status = RING_IO_TuneApply ();
+			}
+		}
+		chnl->writerAcqSize = savedAcqSize;
+		RING_IO_ChnlPublish (chnl);
+		RING_IO_ChnlPoolReport (chnl);
+	}
+
+	/* End the DSP side of every channel, used or not */
+	tmpStatus = RING_IO_ChnlShutdownAll (chnls, RING_IO_NUM_CHNLS);
+	if (DSP_SUCCEEDED (status) && DSP_FAILED (tmpStatus)) {
+		status = tmpStatus;
+	}
+
+	return (status);
+}
+
+/** ----------------------------------------------------------------------------
+ *  @func   RING_IO_BenchGridPoint
+ *
+ *  @desc   Gets a configuration of the grid of a sweep from its index. The
+ *          ring size varies slowest, so that the RingIOs are resized as
+ *          seldom as possible.
+ *
+ *  @ret    FALSE if the configuration is skipped: acquire larger than the
+ *          ring, or half the ring not above the acquire size.
+ *
+ *  @modif  None
+ *  ----------------------------------------------------------------------------
+ */
+STATIC
+NORMAL_API
+Bool
+RING_IO_BenchGridPoint (IN Uint32 index, OUT RING_IO_BenchPoint * point)
+{
+	Uint32 watermark;
+	Uint32 notify;
+	Uint32 kind;
+	Uint32 sync;
+	Uint32 acqSize;
+	Uint32 ringSize;
+
+	watermark = index % RING_IO_BENCH_SWEEP_WATERMARKS;
+	index /= RING_IO_BENCH_SWEEP_WATERMARKS;
+	acqSize = RING_IO_BenchAcqs [index % RING_IO_BENCH_SWEEP_ACQS];
+	index /= RING_IO_BENCH_SWEEP_ACQS;
+	notify = index % RING_IO_BENCH_SWEEP_NOTIFIES;
+	index /= RING_IO_BENCH_SWEEP_NOTIFIES;
+	kind = index % RING_IO_BENCH_SWEEP_KINDS;
+	index /= RING_IO_BENCH_SWEEP_KINDS;
+	sync = index % RING_IO_SYNC_NUM_POLICIES;
+	index /= RING_IO_SYNC_NUM_POLICIES;
+	ringSize = RING_IO_BenchRings [index];
+
+	if (   (acqSize > ringSize)
+		|| ((watermark != 0) && ((ringSize / 2u) <= acqSize))) {
+		return (FALSE);
+	}
+
+	memset (point, 0, sizeof (RING_IO_BenchPoint));
+	point->config.ringSize = ringSize;
+	point->config.acqSize = acqSize;
+	point->config.watermark = (watermark == 0) ? acqSize : (ringSize / 2u);
+	point->config.notifyAlways = notify;
+	point->sync = (RING_IO_SyncPolicy) sync;
+	point->fibers = (kind != 0) ? TRUE : FALSE;
+
+	return (TRUE);
+}
+
+/** ----------------------------------------------------------------------------
+ *  @func   RING_IO_BenchRank
+ *
+ *  @desc   Orders configurations for qsort (): highest throughput first,
+ *          then lowest latency.
+ *
+ *  @modif  None
+ *  ----------------------------------------------------------------------------
+ */
+STATIC
+int
+RING_IO_BenchRank (const void * a, const void * b)
+{
+	const RING_IO_BenchPoint * x = (const RING_IO_BenchPoint *) a;
+	const RING_IO_BenchPoint * y = (const RING_IO_BenchPoint *) b;
+
+	if (x->throughput != y->throughput) {
+		return ((x->throughput < y->throughput) ? 1 : -1);
+	}
+
+	return ((x->latencyP99 > y->latencyP99) - (x->latencyP99 < y->latencyP99));
+}
+
+/** ----------------------------------------------------------------------------
+ *  @func   RING_IO_BenchSweepPrint
+ *
+ *  @desc   Prints a ranked configuration.
+ *
+ *  @modif  None
+ *  ----------------------------------------------------------------------------
+ */
+STATIC
+NORMAL_API
+Void
+RING_IO_BenchSweepPrint (IN Uint32 rank, IN RING_IO_BenchPoint * point)
+{
+	RING_IO_1Print ("SWEEP %u", rank);
+	RING_IO_1Print (" ring %u", point->config.ringSize);
+	RING_IO_1Print (" acq %u", point->config.acqSize);
+	RING_IO_1Print (" watermark %u", point->config.watermark);
+	RING_IO_0Print ((point->config.notifyAlways != 0) ? " notify always"
+			: " notify once");
+	RING_IO_0Print (" sync ");
+	RING_IO_0Print (RING_IO_SyncName (point->sync));
+	RING_IO_0Print (" clients ");
+	RING_IO_0Print ((point->fibers == TRUE) ? "fiber" : RING_IO_ClientKind ());
+	RING_IO_1Print64 (" throughput_kbps %llu", point->throughput);
+	RING_IO_1Print (" latency_p99_us %u\n", point->latencyP99);
+}
+
+/** ----------------------------------------------------------------------------
+ *  @func   RING_IO_BenchConfigLine
+ *
+ *  @desc   Appends an assignment to the text of a configuration file.
+ *
+ *  @modif  None
+ *  ----------------------------------------------------------------------------
+ */
+STATIC
+NORMAL_API
+Void
+RING_IO_BenchConfigLine (IN OUT Char8 * text,
+		IN Char8 * name,
+		IN Char8 * value)
+{
+	strcat (text, name);
+	strcat (text, "=");
+	strcat (text, value);
+	strcat (text, "\n");
+}
+
+/** ----------------------------------------------------------------------------
+ *  @func   RING_IO_BenchWriteConfig
+ *
+ *  @desc   Writes a configuration as the environment variables the
+ *          application reads at start up.
+ *
+ *  @modif  None
+ *  ----------------------------------------------------------------------------
+ */
+STATIC
+NORMAL_API
+DSP_STATUS
+RING_IO_BenchWriteConfig (IN Char8 * path, IN RING_IO_BenchPoint * point)
+{
+	DSP_STATUS status = DSP_SOK;
+	DSP_STATUS tmpStatus = DSP_SOK;
+	Char8 text [RING_IO_BENCH_CONFIG_SIZE];
+	Char8 num [11];
+	Pvoid file = NULL;
+
+	strcpy (text, "# ring_io configuration chosen by --sweep, load it with\n"
+			"# env $(grep -v '^#' <file>) ring_io <arguments>\n");
+	RING_IO_BenchConfigLine (text, "RING_IO_SYNC",
+			RING_IO_SyncName (point->sync));
+	RING_IO_BenchConfigLine (text, "RING_IO_FIBERS",
+			(point->fibers == TRUE) ? "1" : "0");
+	RING_IO_IntToString ((Int) point->config.ringSize, num);
+	RING_IO_BenchConfigLine (text, "RING_IO_RING_SIZE", num);
+	RING_IO_IntToString ((Int) point->config.acqSize, num);
+	RING_IO_BenchConfigLine (text, "RING_IO_ACQ_SIZE", num);
+	RING_IO_IntToString ((Int) point->config.watermark, num);
+	RING_IO_BenchConfigLine (text, "RING_IO_WATERMARK", num);
+	RING_IO_BenchConfigLine (text, "RING_IO_NOTIFY",
+			(point->config.notifyAlways != 0) ? "always" : "once");
+
+	status = RING_IO_AsyncFileOpen (path, RING_IO_BENCH_CONFIG_SIZE, 1u, &file);
+	if (DSP_SUCCEEDED (status)) {
+		status = RING_IO_AsyncFileWrite (file, text, strlen (text));
+		tmpStatus = RING_IO_AsyncFileClose (file);
+		if (DSP_SUCCEEDED (status) && DSP_FAILED (tmpStatus)) {
+			status = tmpStatus;
+		}
+	}
+	if (DSP_FAILED (status)) {
+		RING_IO_1Print ("Failed to write the configuration file. "
+				"Status = [0x%x]\n",
+				status);
+	}
+
+	return (status);
+}
+
+/** ============================================================================
+ *  @func   RING_IO_BenchSweep
+ *
+ *  @desc   Runs the benchmark for each configuration of the grid and keeps
+ *          the best one.
+ *
+ *  @modif  Configuration of the channel used. The synchronization policy
+ *          and the kind of clients are restored.
+ *  ============================================================================
+ */
+NORMAL_API
+DSP_STATUS
+RING_IO_BenchSweep (IN RING_IO_ChnlObj * chnls,
+		IN Uint32 chnlId,
+		IN Uint8 processorId,
+		IN Uint32 attrBufSize,
+		IN RING_IO_Uint64 totalBytes,
+		IN Char8 * configFile)
+{
+	DSP_STATUS status = DSP_SOK;
+	DSP_STATUS tmpStatus = DSP_SOK;
+	RING_IO_ChnlObj * chnl = &chnls [chnlId];
+	RING_IO_SyncPolicy savedSync = RING_IO_SyncGet ();
+	Uint32 savedAcqSize = chnl->writerAcqSize;
+	Uint32 savedWatermark = chnl->writerWatermark;
+	RingIO_NotifyType savedNotifyType = chnl->writerNotifyType;
+	RING_IO_BenchPoint * point;
+	RING_IO_Uint64 elapsed;
+	Uint32 numGrid;
+	Uint32 numPoints = 0;
+	Uint32 num;
+	Uint32 i;
+
+	numGrid = RING_IO_BENCH_SWEEP_RINGS * RING_IO_SYNC_NUM_POLICIES
+			* RING_IO_BENCH_SWEEP_KINDS * RING_IO_BENCH_SWEEP_NOTIFIES
+			* RING_IO_BENCH_SWEEP_ACQS * RING_IO_BENCH_SWEEP_WATERMARKS;
+	if ((totalBytes == 0) || (configFile == NULL)) {
+		status = DSP_EINVALIDARG;
+		RING_IO_0Print ("ERROR! Invalid sweep arguments\n");
+	}
+
+	if (DSP_SUCCEEDED (status)) {
+		status = RING_IO_BenchCheck ();
+	}
+
+	if (DSP_SUCCEEDED (status)) {
+		RING_IO_Bench->chnl = chnl;
+		RING_IO_Bench->touch = FALSE;
+		for (i = 0;
+			(i < numGrid)
+			&& (numPoints < RING_IO_BENCH_SWEEP_MAX)
+			&& DSP_SUCCEEDED (status);
+			i++) {
+			point = &RING_IO_BenchPoints [numPoints];
+			if (RING_IO_BenchGridPoint (i, point) == FALSE) {
+				continue;
+			}
+
+			/*
+			 * Semaphores take the policy in force when they are created.
+			 * The clients set it from the benchmark and take the
+			 * configuration published by RING_IO_ChnlConfigure (), as pool
+			 * workers have their own copy of both.
+			 */
+			RING_IO_SyncSet (point->sync);
+			RING_IO_FiberEnable (point->fibers);
+			status = RING_IO_ChnlPoolFlush (chnl);
+			if (DSP_SUCCEEDED (status)) {
+				status = RING_IO_ChnlConfigure (chnl,
+						processorId,
+						attrBufSize,
+						&point->config);
+			}
+			if (DSP_SUCCEEDED (status)) {
+				status = RING_IO_BenchOne (RING_IO_Bench,
+						processorId,
+						point->config.acqSize,
+						totalBytes);
+			}
+
+			if (DSP_SUCCEEDED (status)) {
+				elapsed = RING_IO_Bench->lastRcv - RING_IO_Bench->firstSend;
+				if (elapsed > 0) {
+					point->throughput = (RING_IO_Bench->rcvd * 1000u)
+							/ elapsed;
+				}
+				num = RING_IO_Bench->numSamples;
+				if (num > 0) {
+					qsort (RING_IO_Bench->samples,
+							num,
+							sizeof (Uint32),
+							&RING_IO_BenchCompare);
+					point->latencyP99 = RING_IO_Bench->samples [
+							(num * 99u) / 100u];
+				}
+				numPoints++;
+			}
+		}
+
+		RING_IO_FiberEnable (FALSE);
+		RING_IO_SyncSet (savedSync);
+		tmpStatus = RING_IO_ChnlPoolFlush (chnl);
+		if (DSP_SUCCEEDED (status) && DSP_FAILED (tmpStatus)) {
+			status = tmpStatus;
+		}
+		chnl->writerAcqSize = savedAcqSize;
+		chnl->writerWatermark = savedWatermark;
+		chnl->writerNotifyType = savedNotifyType;
+		RING_IO_ChnlPublish (chnl);
+	}
+
+	/* Whatever was measured before a failure is still ranked */
+	if (numPoints > 0) {
+		qsort (RING_IO_BenchPoints,
+				numPoints,
+				sizeof (RING_IO_BenchPoint),
+				&RING_IO_BenchRank);
+		for (i = 0; i < numPoints; i++) {
+			RING_IO_BenchSweepPrint (i + 1u, &RING_IO_BenchPoints [i]);
+		}
+		tmpStatus = RING_IO_BenchWriteConfig (configFile,
+				&RING_IO_BenchPoints [0]);
+		if (DSP_SUCCEEDED (status) && DSP_FAILED (tmpStatus)) {
+			status = tmpStatus;
+		}
+	}
+
+	/* End the DSP side of every channel, used or not */
+	tmpStatus = RING_IO_ChnlShutdownAll (chnls, RING_IO_NUM_CHNLS);
+	if (DSP_SUCCEEDED (status) && DSP_FAILED (tmpStatus)) {
+		status = tmpStatus;
+	}
+
+	return (status);
+}
+/** ============================================================================
+ *  @func   RING_IO_BenchPrefetch
+ *
+ *  @desc   Runs the benchmark for each prefetch distance, with and without
+ *          staging of the reads.
+ *
+ *  @modif  Configuration of the channel used. The acquire size, watermark,
+ *          notification type, prefetch distance and staging are restored.
+ *  ============================================================================
+ */
+NORMAL_API
+DSP_STATUS
+RING_IO_BenchPrefetch (IN RING_IO_ChnlObj * chnls,
+		IN Uint32 chnlId,
+		IN Uint8 processorId,
+		IN Uint32 attrBufSize,
+		IN RING_IO_Uint64 totalBytes)
+{
+	DSP_STATUS status = DSP_SOK;
+	DSP_STATUS tmpStatus = DSP_SOK;
+	RING_IO_ChnlObj * chnl = &chnls [chnlId];
+	Uint32 savedAcqSize = chnl->writerAcqSize;
+	Uint32 savedWatermark = chnl->writerWatermark;
+	RingIO_NotifyType savedNotifyType = chnl->writerNotifyType;
+	Uint32 savedPrefetch = chnl->readerPrefetch;
+	Uint32 savedStage = chnl->readerStage;
+	RING_IO_Config config;
+	RING_IO_Uint64 elapsed;
+	Uint32 i;
+
+	if (totalBytes == 0) {
+		status = DSP_EINVALIDARG;
+		RING_IO_0Print ("ERROR! Invalid prefetch benchmark arguments\n");
+	}
+
+	if (DSP_SUCCEEDED (status)) {
+		status = RING_IO_BenchCheck ();
+	}
+
+	if (DSP_SUCCEEDED (status)) {
+		RING_IO_Bench->chnl = chnl;
+		RING_IO_Bench->touch = TRUE;
+		memset (&config, 0, sizeof (RING_IO_Config));
+		config.ringSize = RING_IO_RESIZE_MAX_SIZE;
+		config.acqSize = RING_IO_RESIZE_MAX_SIZE;
+
+		/* Even runs read in place, odd runs through the staging buffer */
+		for (i = 0;
+			(i < (2u * RING_IO_BENCH_PREFETCHES)) && DSP_SUCCEEDED (status);
+			i++) {
+			config.prefetch = RING_IO_BenchPrefetches [i / 2u];
+			config.stage = i % 2u;
+			status = RING_IO_ChnlConfigure (chnl,
+					processorId,
+					attrBufSize,
+					&config);
+			if (DSP_SUCCEEDED (status)) {
+				status = RING_IO_BenchOne (RING_IO_Bench,
+						processorId,
+						config.acqSize,
+						totalBytes);
+			}
+
+			if (DSP_SUCCEEDED (status)) {
+				elapsed = RING_IO_Bench->lastRcv - RING_IO_Bench->firstSend;
+				RING_IO_1Print ("PREFETCH %u", chnl->readerPrefetch);
+				RING_IO_1Print (" stage %u", chnl->readerStage);
+				RING_IO_1Print (" ring %u", chnl->readerBufSize);
+				RING_IO_1Print64 (" bytes %llu", RING_IO_Bench->rcvd);
+				RING_IO_1Print64 (" throughput_kbps %llu\n",
+						(elapsed > 0) ?
+						((RING_IO_Bench->rcvd * 1000u) / elapsed) : 0);
+			}
+		}
+
+		chnl->writerAcqSize = savedAcqSize;
+		chnl->writerWatermark = savedWatermark;
+		chnl->writerNotifyType = savedNotifyType;
+		chnl->readerPrefetch = savedPrefetch;
+		chnl->readerStage = savedStage;
+		RING_IO_ChnlPublish (chnl);
+	}
+
+	/* End the DSP side of every channel, used or not */
+	tmpStatus = RING_IO_ChnlShutdownAll (chnls, RING_IO_NUM_CHNLS);
+	if (DSP_SUCCEEDED (status) && DSP_FAILED (tmpStatus)) {
+		status = tmpStatus;
+	}
+
+	return (status);
+}
+
+
+#if defined (__cplusplus)
+}
+#endif /* defined (__cplusplus) */
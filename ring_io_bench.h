@@ -0,0 +1,296 @@
+/** ============================================================================
+ *  @file   ring_io_bench.h
+ *
+ *  @path   $(DSPLINK)/gpp/src/samples/ring_io/
+ *
+ *  @desc   Defines the benchmark mode of the ring_io application, which runs
+ *          the same synthetic workload through one channel for a list of
+ *          record sizes and reports throughput, latency percentiles, client
+ *          startup time, resident set size and context switches, and the
+ *          sweep mode, which runs it for a grid of channel configurations.
+ *          Every line of the report starts with "BENCH" followed by the way
+ *          the clients are run, "thread" or "process", and by the
+ *          synchronization policy of the OS layer, so that the reports of a
+ *          thread build and of a RING_IO_MULTIPROCESS build of the
+ *          application, run with each policy, can be merged into a single
+ *          matrix.
+ *
+ *  @ver    1.65.00.02
+ *  ============================================================================
+ *  Copyright (C) 2002-2009, Texas Instruments Incorporated -
+ *  http://www.ti.com/
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions
+ *  are met:
+ *  
+ *  *  Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *  
+ *  *  Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer in the
+ *     documentation and/or other materials provided with the distribution.
+ *  
+ *  *  Neither the name of Texas Instruments Incorporated nor the names of
+ *     its contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *  
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ *  THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ *  PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+ *  CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ *  EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ *  PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ *  OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ *  WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ *  OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ *  EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *  ============================================================================
+ */
+
+
+#if !defined (RING_IO_BENCH_H)
+#define RING_IO_BENCH_H
+
+
+/*  ----------------------------------- DSP/BIOS Link                 */
+#include <dsplink.h>
+
+/*  ----------------------------------- Application Header            */
+#include <ring_io.h>
+#include <ring_io_chnl.h>
+
+
+#if defined (__cplusplus)
+extern "C" {
+#endif /* defined (__cplusplus) */
+
+
+/** ============================================================================
+ *  @const  RING_IO_BENCH_MAX_SIZES
+ *
+ *  @desc   Maximum number of record sizes in a benchmark.
+ *  ============================================================================
+ */
+#define RING_IO_BENCH_MAX_SIZES     16u
+
+/** ============================================================================
+ *  @const  RING_IO_BENCH_NUM_STAMPS
+ *
+ *  @desc   Number of records whose send time is remembered, i.e. the maximum
+ *          number of records in flight whose latency can be measured.
+ *  ============================================================================
+ */
+#define RING_IO_BENCH_NUM_STAMPS    4096u
+
+/** ============================================================================
+ *  @const  RING_IO_BENCH_MAX_SAMPLES
+ *
+ *  @desc   Maximum number of latency samples of a run. Longer runs sample
+ *          the records at a regular stride.
+ *  ============================================================================
+ */
+#define RING_IO_BENCH_MAX_SAMPLES   65536u
+
+/** ============================================================================
+ *  @const  RING_IO_BENCH_SWEEP_MAX
+ *
+ *  @desc   Maximum number of channel configurations measured by a sweep.
+ *  ============================================================================
+ */
+#define RING_IO_BENCH_SWEEP_MAX     512u
+
+
+/** ============================================================================
+ *  @func   RING_IO_BenchInit
+ *
+ *  @desc   Maps the state of the benchmark in memory shared with the clients
+ *          created afterwards. Called before any client is created, as the
+ *          workers of the pool of RING_IO_MULTIPROCESS builds are forked by
+ *          the first client run in the pool and only see the mappings made
+ *          before.
+ *
+ *  @arg    None
+ *
+ *  @ret    DSP_SOK
+ *              Operation successfully completed.
+ *          DSP_EMEMORY
+ *              Out of memory.
+ *
+ *  @enter  No client has been created.
+ *
+ *  @leave  None
+ *
+ *  @see    RING_IO_BenchExit
+ *  ============================================================================
+ */
+NORMAL_API
+DSP_STATUS
+RING_IO_BenchInit (Void) ;
+
+/** ============================================================================
+ *  @func   RING_IO_BenchExit
+ *
+ *  @desc   Unmaps the state of the benchmark.
+ *
+ *  @arg    None
+ *
+ *  @ret    None
+ *
+ *  @enter  None
+ *
+ *  @leave  None
+ *
+ *  @see    RING_IO_BenchInit
+ *  ============================================================================
+ */
+NORMAL_API
+Void
+RING_IO_BenchExit (Void) ;
+
+/** ============================================================================
+ *  @func   RING_IO_BenchRun
+ *
+ *  @desc   Sends the same number of bytes through a channel of the DSP once
+ *          for each record size, and prints the measurements of each run.
+ *
+ *  @arg    chnls
+ *              Channels of the application, all ended by the function.
+ *  @arg    chnlId
+ *              Index of the channel used.
+ *  @arg    processorId
+ *              ID of the DSP processor.
+ *  @arg    totalBytes
+ *              Number of bytes sent in each run.
+ *  @arg    sizes
+ *              Comma separated list of record sizes in bytes. Sizes larger
+ *              than the writer RingIO are reduced to it.
+ *
+ *  @ret    DSP_SOK
+ *              Operation successfully completed.
+ *          DSP_EINVALIDARG
+ *              No valid record size.
+ *          DSP_EMEMORY
+ *              Out of memory.
+ *          DSP_EFAIL
+ *              General failure.
+ *
+ *  @enter  RING_IO_Create () succeeded.
+ *
+ *  @leave  None
+ *
+ *  @see    RING_IO_StreamRun
+ *  ============================================================================
+ */
+NORMAL_API
+DSP_STATUS
+RING_IO_BenchRun (IN RING_IO_ChnlObj * chnls,
+                  IN Uint32            chnlId,
+                  IN Uint8             processorId,
+                  IN RING_IO_Uint64    totalBytes,
+                  IN Char8 *           sizes) ;
+
+/** ============================================================================
+ *  @func   RING_IO_BenchSweep
+ *
+ *  @desc   Sends the same number of bytes through a channel of the DSP once
+ *          for each channel configuration of a grid: ring size, acquire
+ *          size, watermark, notification type, synchronization policy of
+ *          the OS layer and, in thread builds, threads or fibers. The
+ *          acquire size is also the record size. The configurations are
+ *          then printed ranked by throughput, then by 99th percentile
+ *          latency, and the best one is written to a file of environment
+ *          variable assignments read by the application at start up.
+ *
+ *  @arg    chnls
+ *              Channels of the application, all ended by the function.
+ *  @arg    chnlId
+ *              Index of the channel used.
+ *  @arg    processorId
+ *              ID of the DSP processor.
+ *  @arg    attrBufSize
+ *              Attribute buffer size of the RingIOs, kept as they are
+ *              resized.
+ *  @arg    totalBytes
+ *              Number of bytes sent for each configuration.
+ *  @arg    configFile
+ *              Path of the file the best configuration is written to.
+ *
+ *  @ret    DSP_SOK
+ *              Operation successfully completed.
+ *          DSP_EINVALIDARG
+ *              Invalid arguments.
+ *          DSP_EMEMORY
+ *              Out of memory.
+ *          DSP_EFAIL
+ *              General failure.
+ *
+ *  @enter  RING_IO_Create () succeeded.
+ *
+ *  @leave  None
+ *
+ *  @see    RING_IO_BenchRun, RING_IO_ChnlConfigure
+ *  ============================================================================
+ */
+NORMAL_API
+DSP_STATUS
+RING_IO_BenchSweep (IN RING_IO_ChnlObj * chnls,
+                    IN Uint32            chnlId,
+                    IN Uint8             processorId,
+                    IN Uint32            attrBufSize,
+                    IN RING_IO_Uint64    totalBytes,
+                    IN Char8 *           configFile) ;
+
+/** ============================================================================
+ *  @func   RING_IO_BenchPrefetch
+ *
+ *  @desc   Sends the same number of bytes through a channel of the DSP,
+ *          resized to RING_IO_RESIZE_MAX_SIZE and acquired whole, once for
+ *          each prefetch distance of the reads, with and without staging.
+ *          The reader reads every byte it receives, and the throughput of
+ *          each run is printed.
+ *
+ *  @arg    chnls
+ *              Channels of the application, all ended by the function.
+ *  @arg    chnlId
+ *              Index of the channel used.
+ *  @arg    processorId
+ *              ID of the DSP processor.
+ *  @arg    attrBufSize
+ *              Attribute buffer size of the RingIOs, kept as they are
+ *              resized.
+ *  @arg    totalBytes
+ *              Number of bytes sent for each run.
+ *
+ *  @ret    DSP_SOK
+ *              Operation successfully completed.
+ *          DSP_EINVALIDARG
+ *              Invalid arguments.
+ *          DSP_EMEMORY
+ *              Out of memory.
+ *          DSP_EFAIL
+ *              General failure.
+ *
+ *  @enter  RING_IO_Create () succeeded.
+ *
+ *  @leave  None
+ *
+ *  @see    RING_IO_BenchRun, RING_IO_ChnlConfigure
+ *  ============================================================================
+ */
+NORMAL_API
+DSP_STATUS
+RING_IO_BenchPrefetch (IN RING_IO_ChnlObj * chnls,
+                       IN Uint32            chnlId,
+                       IN Uint8             processorId,
+                       IN Uint32            attrBufSize,
+                       IN RING_IO_Uint64    totalBytes) ;
+
+
+#if defined (__cplusplus)
+}
+#endif /* defined (__cplusplus) */
+
+
+#endif /* !defined (RING_IO_BENCH_H) */
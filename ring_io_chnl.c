@@ -0,0 +1,2977 @@
+/** ============================================================================
+ *  @file   ring_io_chnl.c
+ *
+ *  @path   $(DSPLINK)/gpp/src/samples/ring_io/
+ *
+ *  @desc   Implementation of the channel abstraction of the ring_io
+ *          application. It carries the RINGIO_DATA_START / variable size
+ *          attribute / RINGIO_DATA_END protocol understood by the DSP
+ *          executable, and leaves production and consumption of the data to
+ *          the caller.
+ *
+ *  @ver    1.65.00.02
+ *  ============================================================================
+ *  Copyright (C) 2002-2009, Texas Instruments Incorporated -
+ *  http://www.ti.com/
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions
+ *  are met:
+ *  
+ *  *  Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *  
+ *  *  Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer in the
+ *     documentation and/or other materials provided with the distribution.
+ *  
+ *  *  Neither the name of Texas Instruments Incorporated nor the names of
+ *     its contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *  
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ *  THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ *  PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+ *  CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ *  EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ *  PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ *  OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ *  WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ *  OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ *  EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *  ============================================================================
+ */
+
+/*  ------------------------ DSP/BIOS Link ----------------------------------*/
+#include <dsplink.h>
+
+/*  ------------------------DSP/BIOS LINK API -------------------------------*/
+#include <pool.h>
+#include <ringio.h>
+#include <string.h>
+
+/*  ------------------------ Application Header------------------------------*/
+#include <ring_io.h>
+#include <ring_io_os.h>
+#include <ring_io_chnl.h>
+#include <ring_io_notify.h>
+
+#if defined (__cplusplus)
+extern "C" {
+#endif /* defined (__cplusplus) */
+
+
+/** ============================================================================
+ *  @name   RING_IO_ChnlPoolEntry
+ *
+ *  @desc   RingIOs of a channel kept open by the channel pool.
+ *
+ *  @field  writerHandle
+ *              Writer RingIO, NULL if none is kept.
+ *  @field  semWriter
+ *              Semaphore of its notification.
+ *  @field  writerChnl
+ *              Channel object its notification was registered with.
+ *  @field  writerWatermark
+ *              Watermark of its notification.
+ *  @field  writerNotifyType
+ *              Type of its notification.
+ *  @field  readerHandle
+ *              Reader RingIO, NULL if none is kept.
+ *  @field  semReader
+ *              Semaphore of its notification.
+ *  @field  readerChnl
+ *              Channel object its notification was registered with.
+ *  ============================================================================
+ */
+typedef struct RING_IO_ChnlPoolEntry_tag {
+	RingIO_Handle      writerHandle;
+	Pvoid              semWriter;
+	RING_IO_ChnlObj *  writerChnl;
+	Uint32             writerWatermark;
+	RingIO_NotifyType  writerNotifyType;
+	RingIO_Handle      readerHandle;
+	Pvoid              semReader;
+	RING_IO_ChnlObj *  readerChnl;
+} RING_IO_ChnlPoolEntry;
+
+/** ============================================================================
+ *  @name   RING_IO_ChnlSettings
+ *
+ *  @desc   Settings of a channel published by RING_IO_ChnlPublish (), as a
+ *          client process has its own copy of the channel object. The
+ *          fields are those of RING_IO_ChnlObj.
+ *
+ *  @field  published
+ *              Set once the settings have been published.
+ *  ============================================================================
+ */
+typedef struct RING_IO_ChnlSettings_tag {
+	volatile Uint32    published;
+	Uint32             writerBufSize;
+	Uint32             readerBufSize;
+	Uint32             readerNewSize;
+	Uint32             writerAcqSize;
+	Uint32             writerWatermark;
+	RingIO_NotifyType  writerNotifyType;
+	Uint32             readerPrefetch;
+	Uint32             readerStage;
+	Uint32             writerFillAhead;
+} RING_IO_ChnlSettings;
+
+/** ============================================================================
+ *  @name   RING_IO_ChnlPoolObj
+ *
+ *  @desc   Statistics and settings of the channel pool and of the channels,
+ *          shared between the clients.
+ *
+ *  @field  writerStats
+ *              Leases of the writer RingIO of each channel.
+ *  @field  readerStats
+ *              Leases of the reader RingIO of each channel.
+ *  @field  tuneStats
+ *              Counters of each channel sampled by the ring size tuner.
+ *  @field  settings
+ *              Settings of each channel the leases take.
+ *  ============================================================================
+ */
+typedef struct RING_IO_ChnlPoolObj_tag {
+	RING_IO_ChnlPoolStats  writerStats [RING_IO_NUM_CHNLS];
+	RING_IO_ChnlPoolStats  readerStats [RING_IO_NUM_CHNLS];
+	RING_IO_ChnlTuneStats  tuneStats [RING_IO_NUM_CHNLS];
+	RING_IO_ChnlSettings   settings [RING_IO_NUM_CHNLS];
+} RING_IO_ChnlPoolObj;
+
+/** ============================================================================
+ *  @name   RING_IO_ChnlFillObj
+ *
+ *  @desc   Staging buffers of the writer in fill-ahead mode, shared between
+ *          RING_IO_ChnlWriteAhead () and the thread running the fill
+ *          function. The n-th record is filled in buffer
+ *          n % RING_IO_CHNL_FILL_BUFS.
+ *
+ *  @field  fillFxn
+ *              Function producing the data.
+ *  @field  arg
+ *              Argument for the fill function.
+ *  @field  size
+ *              Size of each staging buffer.
+ *  @field  semFree
+ *              Posted when a staging buffer may be filled.
+ *  @field  semFilled
+ *              Posted when a staging buffer has been filled.
+ *  @field  stop
+ *              Set by the writer to stop the thread.
+ *  @field  bufs
+ *              Staging buffers.
+ *  @field  filled
+ *              Number of bytes filled in each buffer, 0 at the end of data.
+ *  @field  status
+ *              Status of the fill function for each buffer.
+ *  ============================================================================
+ */
+typedef struct RING_IO_ChnlFillObj_tag {
+	RING_IO_ChnlFillFxn  fillFxn;
+	Pvoid                arg;
+	Uint32               size;
+	Pvoid                semFree;
+	Pvoid                semFilled;
+	volatile Uint32      stop;
+	RingIO_BufPtr        bufs [RING_IO_CHNL_FILL_BUFS];
+	Uint32               filled [RING_IO_CHNL_FILL_BUFS];
+	DSP_STATUS           status [RING_IO_CHNL_FILL_BUFS];
+} RING_IO_ChnlFillObj;
+
+/** ============================================================================
+ *  @name   RING_IO_ChnlPool
+ *
+ *  @desc   Statistics of the channel pool, NULL until it is initialized.
+ *  ============================================================================
+ */
+STATIC RING_IO_ChnlPoolObj * RING_IO_ChnlPool = NULL;
+
+/** ============================================================================
+ *  @name   RING_IO_ChnlEntries
+ *
+ *  @desc   RingIOs kept open by the channel pool, per channel. A RingIO
+ *          handle is only valid in the process that opened it.
+ *  ============================================================================
+ */
+STATIC RING_IO_ChnlPoolEntry RING_IO_ChnlEntries [RING_IO_NUM_CHNLS];
+
+
+/** ----------------------------------------------------------------------------
+ *  @func   RING_IO_ChnlWriterNotifier
+ *
+ *  @desc   Registers the notification of the writer RingIO of the channel,
+ *          retrying until it succeeds.
+ *
+ *  @arg    chnl
+ *              Channel object.
+ *
+ *  @modif  None
+ *  ----------------------------------------------------------------------------
+ */
+STATIC
+NORMAL_API
+DSP_STATUS
+RING_IO_ChnlWriterNotifier (IN RING_IO_ChnlObj * chnl);
+
+/** ----------------------------------------------------------------------------
+ *  @func   RING_IO_ChnlReaderNotifier
+ *
+ *  @desc   Registers the notification of the reader RingIO of the channel,
+ *          retrying until it succeeds.
+ *
+ *  @arg    chnl
+ *              Channel object.
+ *
+ *  @modif  None
+ *  ----------------------------------------------------------------------------
+ */
+STATIC
+NORMAL_API
+DSP_STATUS
+RING_IO_ChnlReaderNotifier (IN RING_IO_ChnlObj * chnl);
+
+/** ----------------------------------------------------------------------------
+ *  @func   RING_IO_ChnlWatermark
+ *
+ *  @desc   Gets the watermark of the writer notification of the channel.
+ *
+ *  @arg    chnl
+ *              Channel object.
+ *
+ *  @ret    The watermark.
+ *
+ *  @enter  None
+ *
+ *  @leave  None
+ *
+ *  @see    None
+ *  ----------------------------------------------------------------------------
+ */
+STATIC
+NORMAL_API
+Uint32
+RING_IO_ChnlWatermark (IN RING_IO_ChnlObj * chnl);
+
+/** ----------------------------------------------------------------------------
+ *  @func   RING_IO_ChnlPoolCount
+ *
+ *  @desc   Accounts for a lease from the channel pool.
+ *
+ *  @arg    stats
+ *              Statistics of the side of the channel leased.
+ *  @arg    hit
+ *              Set if the RingIO was already open.
+ *  @arg    start
+ *              Time stamp in microseconds of the start of the lease.
+ *
+ *  @modif  stats
+ *  ----------------------------------------------------------------------------
+ */
+STATIC
+NORMAL_API
+Void
+RING_IO_ChnlPoolCount (IN RING_IO_ChnlPoolStats * stats,
+		IN Bool hit,
+		IN RING_IO_Uint64 start);
+
+/** ----------------------------------------------------------------------------
+ *  @func   RING_IO_ChnlAdopt
+ *
+ *  @desc   Takes the settings of one side of the channel last published in
+ *          the channel pool, if any.
+ *
+ *  @arg    chnl
+ *              Channel object.
+ *  @arg    writer
+ *              TRUE for the settings of the writer, FALSE for the reader.
+ *
+ *  @modif  Settings of that side of the channel.
+ *  ----------------------------------------------------------------------------
+ */
+STATIC
+NORMAL_API
+Void
+RING_IO_ChnlAdopt (IN RING_IO_ChnlObj * chnl, IN Bool writer);
+
+/** ----------------------------------------------------------------------------
+ *  @func   RING_IO_ChnlPoolDrain
+ *
+ *  @desc   Closes the RingIOs of the channel kept open by the channel pool.
+ *
+ *  @arg    chnl
+ *              Channel object.
+ *
+ *  @modif  RING_IO_ChnlEntries
+ *  ----------------------------------------------------------------------------
+ */
+STATIC
+NORMAL_API
+DSP_STATUS
+RING_IO_ChnlPoolDrain (IN RING_IO_ChnlObj * chnl);
+
+/** ----------------------------------------------------------------------------
+ *  @func   RING_IO_ChnlResizeAck
+ *
+ *  @desc   Waits for the DSP to return the RINGIO_DATA_RESIZE attribute on
+ *          the reader RingIO, discarding what precedes it.
+ *
+ *  @arg    chnl
+ *              Channel object.
+ *
+ *  @ret    DSP_SOK
+ *              The attribute was received.
+ *          DSP_ETIMEOUT
+ *              It was not received within RING_IO_RESIZE_TIMEOUT.
+ *
+ *  @modif  None
+ *  ----------------------------------------------------------------------------
+ */
+STATIC
+NORMAL_API
+DSP_STATUS
+RING_IO_ChnlResizeAck (IN RING_IO_ChnlObj * chnl);
+
+/** ----------------------------------------------------------------------------
+ *  @func   RING_IO_ChnlWriterNotify
+ *
+ *  @desc   Notification callback for the RingIO opened by the GPP in writer
+ *          mode. The parameter is the channel object.
+ *
+ *  @arg    handle
+ *              Handle to the RingIO.
+ *  @arg    param
+ *              Parameter used while registering the notification.
+ *  @arg    msg
+ *               Message passed along with notification.
+ *
+ *  @modif  None
+ *  ----------------------------------------------------------------------------
+ */
+STATIC
+NORMAL_API
+Void
+RING_IO_ChnlWriterNotify (IN RingIO_Handle handle,
+		IN RingIO_NotifyParam param,
+		IN RingIO_NotifyMsg msg);
+
+/** ----------------------------------------------------------------------------
+ *  @func   RING_IO_ChnlReaderNotify
+ *
+ *  @desc   Notification callback for the RingIO opened by the GPP in reader
+ *          mode. The parameter is the channel object.
+ *
+ *  @arg    handle
+ *              Handle to the RingIO.
+ *  @arg    param
+ *              Parameter used while registering the notification.
+ *  @arg    msg
+ *               Message passed along with notification.
+ *
+ *  @modif  readerEvents of the channel.
+ *  ----------------------------------------------------------------------------
+ */
+STATIC
+NORMAL_API
+Void
+RING_IO_ChnlReaderNotify (IN RingIO_Handle handle,
+		IN RingIO_NotifyParam param,
+		IN RingIO_NotifyMsg msg);
+
+/** ----------------------------------------------------------------------------
+ *  @func   RING_IO_ChnlReaderWait
+ *
+ *  @desc   Waits for a reader notification and takes all the events notified
+ *          since the last wait.
+ *
+ *  @arg    chnl
+ *              Channel object.
+ *  @arg    timeout
+ *              Timeout in microseconds, 0 to wait until notified.
+ *
+ *  @ret    DSP_SOK
+ *              Operation successfully completed.
+ *          DSP_ETIMEOUT
+ *              No notification within the timeout.
+ *          DSP_EFAIL
+ *              General failure.
+ *
+ *  @modif  readerEvents, readerPending of the channel.
+ *  ----------------------------------------------------------------------------
+ */
+STATIC
+NORMAL_API
+DSP_STATUS
+RING_IO_ChnlReaderWait (IN RING_IO_ChnlObj * chnl, IN Uint32 timeout);
+
+/** ----------------------------------------------------------------------------
+ *  @func   RING_IO_ChnlWriteRecord
+ *
+ *  @desc   Places the variable attribute describing a record at the start of
+ *          the acquired writer buffer.
+ *
+ *  @arg    chnl
+ *              Channel object.
+ *  @arg    size
+ *              Size of the record.
+ *  @arg    offset
+ *              Offset of the record in the transfer.
+ *
+ *  @ret    DSP_SOK
+ *              Operation successfully completed.
+ *
+ *  @modif  None
+ *  ----------------------------------------------------------------------------
+ */
+STATIC
+NORMAL_API
+DSP_STATUS
+RING_IO_ChnlWriteRecord (IN RING_IO_ChnlObj * chnl,
+		IN Uint32 size,
+		IN RING_IO_Uint64 offset);
+
+/** ----------------------------------------------------------------------------
+ *  @func   RING_IO_ChnlWriteDone
+ *
+ *  @desc   Accounts for a record written and released to the writer RingIO.
+ *
+ *  @arg    chnl
+ *              Channel object.
+ *  @arg    size
+ *              Size of the record.
+ *
+ *  @modif  writerSeq of the channel.
+ *  ----------------------------------------------------------------------------
+ */
+STATIC
+NORMAL_API
+Void
+RING_IO_ChnlWriteDone (IN RING_IO_ChnlObj * chnl, IN Uint32 size);
+
+/** ----------------------------------------------------------------------------
+ *  @func   RING_IO_ChnlCommit
+ *
+ *  @desc   Copies a record from a staging buffer to the writer RingIO, over
+ *          as many acquires as the RingIO needs.
+ *
+ *  @arg    chnl
+ *              Channel object.
+ *  @arg    data
+ *              Staging buffer holding the record.
+ *  @arg    size
+ *              Size of the record.
+ *  @arg    offset
+ *              Offset of the record in the transfer.
+ *
+ *  @ret    DSP_SOK
+ *              Operation successfully completed.
+ *          DSP_EFAIL
+ *              General failure.
+ *
+ *  @modif  writerSeq of the channel.
+ *  ----------------------------------------------------------------------------
+ */
+STATIC
+NORMAL_API
+DSP_STATUS
+RING_IO_ChnlCommit (IN RING_IO_ChnlObj * chnl,
+		IN RingIO_BufPtr data,
+		IN Uint32 size,
+		IN RING_IO_Uint64 offset);
+
+/** ----------------------------------------------------------------------------
+ *  @func   RING_IO_ChnlFillThread
+ *
+ *  @desc   Body of the thread running the fill function in fill-ahead mode.
+ *          Fills the staging buffers in turn until the end of data.
+ *
+ *  @arg    ptr
+ *              Staging buffers, RING_IO_ChnlFillObj.
+ *
+ *  @ret    NULL
+ *
+ *  @modif  filled, status of the staging buffers.
+ *  ----------------------------------------------------------------------------
+ */
+STATIC
+NORMAL_API
+Void *
+RING_IO_ChnlFillThread (IN Void * ptr);
+
+/** ----------------------------------------------------------------------------
+ *  @func   RING_IO_ChnlWriteAhead
+ *
+ *  @desc   Writes data to the DSP in fill-ahead mode, the fill function
+ *          producing the next record while the writer copies the previous
+ *          one to the RingIO.
+ *
+ *  @arg    chnl
+ *              Channel object with the writer opened.
+ *  @arg    fillFxn
+ *              Function producing the data.
+ *  @arg    arg
+ *              Argument for the fill function.
+ *  @arg    bytesWritten
+ *              Location to receive the number of bytes written.
+ *
+ *  @ret    DSP_SOK
+ *              Operation successfully completed.
+ *          DSP_EMEMORY
+ *              Out of memory for the staging buffers.
+ *          DSP_EFAIL
+ *              General failure.
+ *
+ *  @modif  writerSeq of the channel.
+ *  ----------------------------------------------------------------------------
+ */
+STATIC
+NORMAL_API
+DSP_STATUS
+RING_IO_ChnlWriteAhead (IN  RING_IO_ChnlObj * chnl,
+		IN  RING_IO_ChnlFillFxn fillFxn,
+		IN  Pvoid arg,
+		OUT RING_IO_Uint64 * bytesWritten);
+
+/** ----------------------------------------------------------------------------
+ *  @func   RING_IO_ChnlSeqCheck
+ *
+ *  @desc   Accounts for the sequence number of a received record.
+ *
+ *  @arg    chnl
+ *              Channel object.
+ *  @arg    seq
+ *              Sequence number of the record.
+ *
+ *  @modif  readerSeq, readerSeqMask, seqStats of the channel.
+ *  ----------------------------------------------------------------------------
+ */
+STATIC
+NORMAL_API
+Void
+RING_IO_ChnlSeqCheck (IN RING_IO_ChnlObj * chnl, IN RING_IO_Uint64 seq);
+
+/** ----------------------------------------------------------------------------
+ *  @func   RING_IO_ChnlReadDone
+ *
+ *  @desc   Accounts for data read and released from the reader RingIO.
+ *
+ *  @arg    chnl
+ *              Channel object.
+ *  @arg    size
+ *              Number of bytes read.
+ *
+ *  @modif  readerRemain, readerBytes of the channel.
+ *  ----------------------------------------------------------------------------
+ */
+STATIC
+NORMAL_API
+Void
+RING_IO_ChnlReadDone (IN RING_IO_ChnlObj * chnl, IN Uint32 size);
+
+/** ----------------------------------------------------------------------------
+ *  @func   RING_IO_ChnlDrain
+ *
+ *  @desc   Hands an acquired reader buffer to the drain function. When the
+ *          channel prefetches or stages its reads, the buffer is handed in
+ *          pieces: each piece is prefetched while the previous one is
+ *          drained, and copied to the staging buffer if staged.
+ *
+ *  @arg    chnl
+ *              Channel object.
+ *  @arg    drainFxn
+ *              Function consuming the data.
+ *  @arg    arg
+ *              Argument for the drain function.
+ *  @arg    buffer
+ *              Acquired buffer.
+ *  @arg    size
+ *              Number of valid bytes in the buffer.
+ *
+ *  @ret    Status of the last call to the drain function.
+ *
+ *  @modif  readerStageBuf of the channel.
+ *  ----------------------------------------------------------------------------
+ */
+STATIC
+NORMAL_API
+DSP_STATUS
+RING_IO_ChnlDrain (IN RING_IO_ChnlObj * chnl,
+		IN RING_IO_ChnlDrainFxn drainFxn,
+		IN Pvoid arg,
+		IN RingIO_BufPtr buffer,
+		IN Uint32 size);
+
+/** ----------------------------------------------------------------------------
+ *  @func   RING_IO_ChnlReadAttr
+ *
+ *  @desc   Reads the attribute pending on the reader RingIO.
+ *
+ *  @arg    chnl
+ *              Channel object.
+ *
+ *  @modif  readerRemain, readerDone of the channel.
+ *  ----------------------------------------------------------------------------
+ */
+STATIC
+NORMAL_API
+Void
+RING_IO_ChnlReadAttr (IN RING_IO_ChnlObj * chnl);
+
+/** ----------------------------------------------------------------------------
+ *  @func   RING_IO_ChnlReadInline
+ *
+ *  @desc   Reads the reader RingIO in the reader notification, in inline
+ *          mode. Called with readerOwner taken.
+ *
+ *  @arg    chnl
+ *              Channel object.
+ *
+ *  @ret    TRUE
+ *              The reader thread has work to do and must be woken up.
+ *          FALSE
+ *              All the data available was consumed.
+ *
+ *  @modif  inlineHead, inlineStats of the channel.
+ *  ----------------------------------------------------------------------------
+ */
+STATIC
+NORMAL_API
+Bool
+RING_IO_ChnlReadInline (IN RING_IO_ChnlObj * chnl);
+
+
+/** ============================================================================
+ *  @func   RING_IO_ChnlInit
+ *
+ *  @desc   Initializes a channel object. No RingIO is opened.
+ *
+ *  @modif  None
+ *  ============================================================================
+ */
+NORMAL_API
+Void
+RING_IO_ChnlInit (IN RING_IO_ChnlObj * chnl,
+		IN Uint32 id,
+		IN Char8 * writerName,
+		IN Char8 * readerName,
+		IN Uint32 writerBufSize,
+		IN Uint32 readerBufSize)
+{
+	chnl->id = id;
+	chnl->writerName = writerName;
+	chnl->readerName = readerName;
+	chnl->writerBufSize = writerBufSize;
+	chnl->readerBufSize = readerBufSize;
+	chnl->readerNewSize = 0;
+	chnl->writerAcqSize = writerBufSize;
+	chnl->writerWatermark = 0;
+	chnl->writerNotifyType = RINGIO_NOTIFICATION_ONCE;
+	chnl->xferMode = RING_IO_XFER_DATA;
+	chnl->writerHandle = NULL;
+	chnl->readerHandle = NULL;
+	chnl->semWriter = NULL;
+	chnl->semReader = NULL;
+	chnl->readerEvents = 0;
+	chnl->readerPending = 0;
+	chnl->writerSeq = 0;
+	chnl->writerAttrSize = RING_IO_VATTR_SIZE_BASE * sizeof (Uint32);
+	chnl->readerSeq = 0;
+	chnl->readerSeqMask = 0;
+	memset (&chnl->seqStats, 0, sizeof (RING_IO_ChnlSeqStats));
+	chnl->readerRemain = readerBufSize;
+	chnl->readerBytes = 0;
+	chnl->readerDone = FALSE;
+	chnl->readerOwner = 1u;
+	chnl->inlineFxn = NULL;
+	chnl->inlineArg = NULL;
+	chnl->inlineHead = 0;
+	chnl->inlineTail = 0;
+	memset (&chnl->inlineStats, 0, sizeof (RING_IO_ChnlInlineStats));
+	chnl->readerPrefetch = 0;
+	chnl->readerStage = FALSE;
+	chnl->writerFillAhead = FALSE;
+}
+
+/** ============================================================================
+ *  @func   RING_IO_ChnlOpenWriter
+ *
+ *  @desc   Opens the writer RingIO of the channel and registers its
+ *          notification.
+ *
+ *  @modif  writerHandle, semWriter of the channel.
+ *  ============================================================================
+ */
+NORMAL_API
+DSP_STATUS
+RING_IO_ChnlOpenWriter (IN RING_IO_ChnlObj * chnl)
+{
+	DSP_STATUS status = DSP_SOK;
+
+	/*
+	 *  Open the RingIO to be used with GPP as the writer.
+	 *
+	 *  Value of the flags indicates:
+	 *     No cache coherence for: Control structure
+	 *                             Data buffer
+	 *                             Attribute buffer
+	 *     Exact size requirement.
+	 */
+	chnl->writerHandle = RingIO_open (chnl->writerName,
+			RINGIO_MODE_WRITE,
+			(Uint32) (RINGIO_NEED_EXACT_SIZE));
+	if (chnl->writerHandle == NULL) {
+		status = RINGIO_EFAILURE;
+		RING_IO_1Print ("RingIO_open () Writer failed. Status = [0x%x]\n",
+				status);
+	}
+
+	if (DSP_SUCCEEDED (status)) {
+		/* Create the semaphore to be used for notification */
+		status = RING_IO_CreateSem (&chnl->semWriter);
+		if (DSP_FAILED (status)) {
+			RING_IO_1Print ("RING_IO_CreateSem () Writer SEM failed "
+					"Status = [0x%x]\n",
+					status);
+		}
+	}
+
+	if (DSP_SUCCEEDED (status)) {
+		status = RING_IO_ChnlWriterNotifier (chnl);
+	}
+
+	return (status);
+}
+
+/** ============================================================================
+ *  @func   RING_IO_ChnlCloseWriter
+ *
+ *  @desc   Waits for the DSP to consume the writer RingIO and closes it.
+ *
+ *  @modif  writerHandle, semWriter of the channel.
+ *  ============================================================================
+ */
+NORMAL_API
+DSP_STATUS
+RING_IO_ChnlCloseWriter (IN RING_IO_ChnlObj * chnl)
+{
+	DSP_STATUS status = DSP_SOK;
+	DSP_STATUS tmpStatus = DSP_SOK;
+
+	/*
+	 *  Close the RingIO to be used with GPP as the writer once the DSP has
+	 *  read everything, including the attributes.
+	 */
+	if (chnl->writerHandle != NULL) {
+		while ( (RingIO_getValidSize(chnl->writerHandle) != 0)
+				|| (RingIO_getValidAttrSize(chnl->writerHandle) != 0)) {
+			RING_IO_Sleep(10);
+		}
+		tmpStatus = RingIO_close (chnl->writerHandle);
+		if (DSP_FAILED (tmpStatus)) {
+			status = tmpStatus;
+			RING_IO_1Print ("RingIO_close () Writer failed. Status = [0x%x]\n",
+					status);
+		}
+		chnl->writerHandle = NULL;
+	}
+
+	/* Delete the semaphore used for notification */
+	if (chnl->semWriter != NULL) {
+		tmpStatus = RING_IO_DeleteSem (chnl->semWriter);
+		if (DSP_SUCCEEDED (status) && DSP_FAILED (tmpStatus)) {
+			status = tmpStatus;
+			RING_IO_1Print ("RING_IO_DeleteSem () Writer SEM failed "
+					"Status = [0x%x]\n",
+					status);
+		}
+		chnl->semWriter = NULL;
+	}
+
+	return (status);
+}
+
+/** ============================================================================
+ *  @func   RING_IO_ChnlOpenReader
+ *
+ *  @desc   Opens the reader RingIO of the channel, once created by the DSP,
+ *          and registers its notification.
+ *
+ *  @modif  readerHandle, semReader of the channel.
+ *  ============================================================================
+ */
+NORMAL_API
+DSP_STATUS
+RING_IO_ChnlOpenReader (IN RING_IO_ChnlObj * chnl)
+{
+	DSP_STATUS status = DSP_SOK;
+
+	/*
+	 *  Open the RingIO to be used with GPP as the reader.
+	 *  Value of the flags indicates:
+	 *     No cache coherence for: Control structure
+	 *                             Data buffer
+	 *                             Attribute buffer
+	 *     Exact size requirement false.
+	 *  The RingIO is created by the DSP, so retry until it exists. After
+	 *  a resize, the old RingIO is released until the DSP has replaced it.
+	 */
+	do {
+		chnl->readerHandle = RingIO_open (chnl->readerName,
+				RINGIO_MODE_READ,
+				0);
+		if (   (chnl->readerHandle != NULL)
+			&& (chnl->readerNewSize != 0)
+			&& (  RingIO_getValidSize (chnl->readerHandle)
+				+ RingIO_getEmptySize (chnl->readerHandle)
+				!= chnl->readerNewSize)) {
+			RingIO_close (chnl->readerHandle);
+			chnl->readerHandle = NULL;
+		}
+		if (chnl->readerHandle == NULL) {
+			RING_IO_Sleep(10);
+		}
+	}while (chnl->readerHandle == NULL);
+	chnl->readerNewSize = 0;
+
+	chnl->readerEvents = 0;
+	chnl->readerPending = 0;
+	/* The notification does not read until RING_IO_ChnlRead () lets it */
+	chnl->readerOwner = 1u;
+
+	/* Create the semaphore to be used for notification */
+	status = RING_IO_CreateSem (&chnl->semReader);
+	if (DSP_FAILED (status)) {
+		RING_IO_1Print ("RING_IO_CreateSem () Reader SEM failed "
+				"Status = [0x%x]\n",
+				status);
+	}
+
+	if (DSP_SUCCEEDED(status)) {
+		status = RING_IO_ChnlReaderNotifier (chnl);
+	}
+
+	return (status);
+}
+
+/** ============================================================================
+ *  @func   RING_IO_ChnlCloseReader
+ *
+ *  @desc   Closes the reader RingIO of the channel.
+ *
+ *  @modif  readerHandle, semReader of the channel.
+ *  ============================================================================
+ */
+NORMAL_API
+DSP_STATUS
+RING_IO_ChnlCloseReader (IN RING_IO_ChnlObj * chnl)
+{
+	DSP_STATUS status = DSP_SOK;
+	DSP_STATUS tmpStatus = DSP_SOK;
+
+	if (chnl->readerHandle != NULL) {
+		tmpStatus = RingIO_close (chnl->readerHandle);
+		if (DSP_FAILED (tmpStatus)) {
+			status = tmpStatus;
+			RING_IO_1Print ("RingIO_close () Reader failed. Status = [0x%x]\n",
+					status);
+		}
+		chnl->readerHandle = NULL;
+	}
+
+	if (chnl->semReader != NULL) {
+		tmpStatus = RING_IO_DeleteSem (chnl->semReader);
+		if (DSP_SUCCEEDED (status) && DSP_FAILED (tmpStatus)) {
+			status = tmpStatus;
+			RING_IO_1Print ("RING_IO_DeleteSem () Reader SEM failed "
+					"Status = [0x%x]\n",
+					status);
+		}
+		chnl->semReader = NULL;
+	}
+
+	return (status);
+}
+
+/** ============================================================================
+ *  @func   RING_IO_ChnlWriteStart
+ *
+ *  @desc   Inserts the RINGIO_DATA_START attribute and notifies the DSP.
+ *
+ *  @modif  None
+ *  ============================================================================
+ */
+NORMAL_API
+DSP_STATUS
+RING_IO_ChnlWriteStart (IN RING_IO_ChnlObj * chnl)
+{
+	DSP_STATUS status = DSP_SOK;
+	Uint32 caps;
+
+	chnl->writerSeq = 0;
+
+	/* Extended record attributes only if the DSP reads them */
+	caps =   RING_IO_AtomicLoad (&RING_IO_CtrlGet ()->dspCaps)
+		   & RING_IO_XFER_VATTR_EXT;
+	chnl->writerAttrSize = RING_IO_VATTR_SIZE_BASE * sizeof (Uint32);
+	if (caps != 0) {
+		chnl->writerAttrSize = RING_IO_VATTR_SIZE * sizeof (Uint32);
+	}
+
+	/* Send data transfer attribute (Fixed attribute) to DSP*/
+	status = RingIO_setAttribute (chnl->writerHandle,
+			0,
+			(Uint16) RINGIO_DATA_START,
+			chnl->xferMode | caps);
+	if (DSP_FAILED(status)) {
+		RING_IO_1Print ("RingIO_setAttribute failed to set the  "
+				"RINGIO_DATA_START. Status = [0x%x]\n",
+				status);
+	}
+
+	if (DSP_SUCCEEDED (status)) {
+		/* Send Notification  to  the reader (DSP)*/
+		status = RING_IO_NotifyPost (chnl, (Uint16) NOTIFY_DATA_START);
+	}
+
+	return (status);
+}
+
+/** ============================================================================
+ *  @func   RING_IO_ChnlWrite
+ *
+ *  @desc   Writes data to the DSP until the fill function signals end of data.
+ *
+ *  @modif  None
+ *  ============================================================================
+ */
+NORMAL_API
+DSP_STATUS
+RING_IO_ChnlWrite (IN  RING_IO_ChnlObj * chnl,
+		IN  RING_IO_ChnlFillFxn fillFxn,
+		IN  Pvoid arg,
+		OUT RING_IO_Uint64 * bytesWritten)
+{
+	DSP_STATUS status = DSP_SOK;
+	DSP_STATUS relStatus = DSP_SOK;
+	RingIO_BufPtr bufPtr = NULL;
+	RING_IO_Uint64 bytesTransfered = 0;
+	Uint32 acqSize;
+	Uint32 filled;
+	Bool endOfData = FALSE;
+
+	if (chnl->writerFillAhead == TRUE) {
+		status = RING_IO_ChnlWriteAhead (chnl,
+				fillFxn,
+				arg,
+				&bytesTransfered);
+		endOfData = TRUE;
+	}
+
+	while (DSP_SUCCEEDED (status) && (endOfData == FALSE)) {
+		acqSize = chnl->writerAcqSize;
+		status = RingIO_acquire (chnl->writerHandle,
+				&bufPtr,
+				&acqSize);
+
+		if ((DSP_SUCCEEDED (status)) && (acqSize > 0)) {
+			/* Produce the data directly in the acquired buffer */
+			filled = 0;
+			status = (*fillFxn) (arg, bufPtr, acqSize, &filled);
+			if (DSP_FAILED (status) || (filled == 0)) {
+				endOfData = TRUE;
+			}
+			else {
+				status = RING_IO_ChnlWriteRecord (chnl,
+						filled,
+						bytesTransfered);
+
+				relStatus = RingIO_release (chnl->writerHandle, filled);
+				if (DSP_FAILED (relStatus)) {
+					status = relStatus;
+					RING_IO_1Print ("RingIO_release () in Writer task "
+							"failed. relStatus = [0x%x]\n",
+							relStatus);
+				}
+				else {
+					bytesTransfered += filled;
+					RING_IO_ChnlWriteDone (chnl, filled);
+				}
+			}
+
+			if (filled < acqSize) {
+				/* Give back the part of the buffer that was not filled */
+				relStatus = RingIO_cancel (chnl->writerHandle);
+				if (DSP_FAILED (relStatus)) {
+					RING_IO_1Print ("RingIO_cancel () in Writer task "
+							"failed. relStatus = [0x%x]\n",
+							relStatus);
+				}
+			}
+		}
+		else {
+			/*
+			 * Acquired failed, Wait for empty buffer to become
+			 * available.
+			 */
+			status = RING_IO_ChnlWriterWait (chnl);
+		}
+	}
+
+	if (bytesWritten != NULL) {
+		*bytesWritten = bytesTransfered;
+	}
+
+	return (status);
+}
+
+/** ============================================================================
+ *  @func   RING_IO_ChnlWriteEnd
+ *
+ *  @desc   Inserts the RINGIO_DATA_END attribute and notifies the DSP.
+ *
+ *  @modif  None
+ *  ============================================================================
+ */
+NORMAL_API
+DSP_STATUS
+RING_IO_ChnlWriteEnd (IN RING_IO_ChnlObj * chnl)
+{
+	DSP_STATUS status = DSP_SOK;
+
+	/* Send  End of  data transfer attribute to DSP */
+	do {
+		status = RingIO_setAttribute (chnl->writerHandle,
+				0,
+				(Uint16) RINGIO_DATA_END,
+				0);
+		if (DSP_FAILED (status)) {
+			RING_IO_Sleep(10);
+		}
+	}while (status != RINGIO_SUCCESS);
+
+	/*
+	 * Send Notification  to  the reader (DSP)
+	 * This allows DSP  application to come out from blocked state  if
+	 * it is waiting for Data buffer and  GPP sent only data end
+	 * attribute.
+	 */
+	status = RING_IO_NotifyPost (chnl, (Uint16) NOTIFY_DATA_END);
+
+	return (status);
+}
+
+/** ============================================================================
+ *  @func   RING_IO_ChnlWriterWait
+ *
+ *  @desc   Waits for the writer RingIO to have room.
+ *
+ *  @modif  None
+ *  ============================================================================
+ */
+NORMAL_API
+DSP_STATUS
+RING_IO_ChnlWriterWait (IN RING_IO_ChnlObj * chnl)
+{
+	DSP_STATUS status = DSP_SOK;
+	RING_IO_ChnlTuneStats * tune = RING_IO_ChnlGetTuneStats (chnl);
+	RING_IO_Uint64 start;
+
+	start = (tune != NULL) ? RING_IO_GetTimeUsec () : 0;
+	status = RING_IO_WaitSem (chnl->semWriter);
+	if (DSP_FAILED (status)) {
+		RING_IO_1Print ("RING_IO_WaitSem () Writer SEM failed "
+				"Status = [0x%x]\n",
+				status);
+	}
+	if (tune != NULL) {
+		tune->writerWaits++;
+		tune->writerWaitTime += RING_IO_GetTimeUsec () - start;
+	}
+
+	return (status);
+}
+
+/** ============================================================================
+ *  @func   RING_IO_ChnlRead
+ *
+ *  @desc   Reads one data transfer from the DSP.
+ *
+ *  @modif  readerEvents, readerPending of the channel.
+ *  ============================================================================
+ */
+NORMAL_API
+DSP_STATUS
+RING_IO_ChnlRead (IN  RING_IO_ChnlObj * chnl,
+		IN  RING_IO_ChnlDrainFxn drainFxn,
+		IN  Pvoid arg,
+		OUT RING_IO_Uint64 * bytesRead)
+{
+	DSP_STATUS status = DSP_SOK;
+	DSP_STATUS relStatus = DSP_SOK;
+	DSP_STATUS drainStatus = DSP_SOK;
+	RingIO_BufPtr bufPtr = NULL;
+	Uint32 acqSize;
+	Uint32 param;
+	Uint32 slot;
+	Uint16 type;
+	Uint8 exitFlag = FALSE;
+	RING_IO_ChnlTuneStats * tune = RING_IO_ChnlGetTuneStats (chnl);
+	RING_IO_Uint64 start;
+
+	/*
+	 * Wait for notification from  DSP  about data
+	 * transfer
+	 */
+	status = RING_IO_ChnlReaderWait (chnl, 0);
+	if (DSP_FAILED (status)) {
+		RING_IO_1Print ("RING_IO_WaitSem () Reader SEM failed "
+				"Status = [0x%x]\n",
+				status);
+	}
+
+	chnl->readerSeq = 0;
+	chnl->readerSeqMask = 0;
+	memset (&chnl->seqStats, 0, sizeof (RING_IO_ChnlSeqStats));
+	chnl->readerRemain = chnl->readerBufSize;
+	chnl->readerBytes = 0;
+	chnl->readerDone = FALSE;
+	chnl->inlineHead = 0;
+	chnl->inlineTail = 0;
+
+	if ((chnl->readerPending & RING_IO_EVENT_START) != 0) {
+		chnl->readerPending &= ~RING_IO_EVENT_START;
+
+		/* Got  data transfer start notification from DSP*/
+		do {
+			status = RingIO_getAttribute (chnl->readerHandle,
+					&type,
+					&param);
+			if ( (status == RINGIO_SUCCESS)
+					|| (status == RINGIO_SPENDINGATTRIBUTE)) {
+				if (type != (Uint16)RINGIO_DATA_START) {
+					RING_IO_1Print ("RingIO_getAttribute () Reader failed "
+							"Unknown attribute received instead of "
+							"RINGIO_DATA_START. Status = [0x%x]\n",
+							status);
+				}
+				else {
+					/* Capabilities announced by the DSP */
+					RING_IO_AtomicOr (&RING_IO_CtrlGet ()->dspCaps,
+							param & ~RING_IO_XFER_MODE_MASK);
+				}
+			}
+			else {
+				RING_IO_Sleep(10);
+			}
+		}while ( (status != RINGIO_SUCCESS)
+				&& (status != RINGIO_SPENDINGATTRIBUTE));
+	}
+
+	/* Now reader  can start reading data from the ringio created
+	 * by Dsp as the writer
+	 */
+	while (exitFlag == FALSE) {
+
+		/* Data queued by the notification comes before the RingIO data */
+		while (chnl->inlineTail != chnl->inlineHead) {
+			RING_IO_MemBarrier ();
+			slot = chnl->inlineTail % RING_IO_CHNL_INLINE_SLOTS;
+			if ((drainFxn != NULL) && DSP_SUCCEEDED (drainStatus)) {
+				drainStatus = (*drainFxn) (arg,
+						chnl->inlineData [slot],
+						chnl->inlineLens [slot]);
+			}
+			RING_IO_MemBarrier ();
+			chnl->inlineTail++;
+		}
+
+		if (chnl->readerDone == TRUE) {
+			/* End of data transfer read by the notification */
+			break;
+		}
+
+		acqSize = chnl->readerRemain;
+		status = RingIO_acquire (chnl->readerHandle,
+				&bufPtr,
+				&acqSize);
+
+		if ((status == RINGIO_SUCCESS)
+				||(acqSize > 0)) {
+			/*
+			 * Keep draining after a consumer failure so that the
+			 * protocol with the DSP stays in step.
+			 */
+			if ((drainFxn != NULL) && DSP_SUCCEEDED (drainStatus)) {
+				drainStatus = RING_IO_ChnlDrain (chnl,
+						drainFxn,
+						arg,
+						bufPtr,
+						acqSize);
+			}
+
+			/* Release the acquired buffer */
+			relStatus = RingIO_release (chnl->readerHandle, acqSize);
+			if (DSP_FAILED (relStatus)) {
+				RING_IO_1Print ("RingIO_release () in Reader task "
+						"failed relStatus = [0x%x]\n",
+						relStatus);
+			}
+
+			RING_IO_ChnlReadDone (chnl, acqSize);
+		}
+		else if ( (status == RINGIO_SPENDINGATTRIBUTE)
+				&& (acqSize == 0u)) {
+			/* Attribute is pending,Read it */
+			RING_IO_ChnlReadAttr (chnl);
+			exitFlag = chnl->readerDone;
+		}
+		else if ( (status == RINGIO_EFAILURE)
+				||(status == RINGIO_EBUFEMPTY)) {
+
+			/* Let the notification read inline while this thread waits */
+			if (chnl->inlineFxn != NULL) {
+				RING_IO_AtomicCas (&chnl->readerOwner, 1u, 0u);
+			}
+
+			/* Failed to acquire buffer */
+			start = (tune != NULL) ? RING_IO_GetTimeUsec () : 0;
+			status = RING_IO_ChnlReaderWait (chnl, 0);
+			if (DSP_FAILED (status)) {
+				RING_IO_1Print ("RING_IO_WaitSem () Reader SEM failed "
+						"Status = [0x%x]\n",
+						status);
+				exitFlag = TRUE;
+			}
+			if (tune != NULL) {
+				tune->readerWaits++;
+				tune->readerWaitTime += RING_IO_GetTimeUsec () - start;
+			}
+
+			if (chnl->inlineFxn != NULL) {
+				while (RING_IO_AtomicCas (&chnl->readerOwner, 0u, 1u)
+						== FALSE) {
+					RING_IO_YieldClient ();
+				}
+			}
+		}
+	}
+
+	while ((chnl->readerPending & RING_IO_EVENT_END) == 0) {
+		/* If data transfer end notification  not yet received
+		 * from DSP ,wait for it. Data notified late is skipped.
+		 */
+		status = RING_IO_ChnlReaderWait (chnl, 0);
+		if (DSP_FAILED (status)) {
+			RING_IO_1Print ("RING_IO_WaitSem () Reader SEM failed "
+					"Status = [0x%x]\n",
+					status);
+			break;
+		}
+	}
+	chnl->readerPending = 0;
+
+	if (bytesRead != NULL) {
+		*bytesRead = chnl->readerBytes;
+	}
+
+	if (DSP_SUCCEEDED (status)) {
+		status = drainStatus;
+	}
+
+	return (status);
+}
+
+/** ============================================================================
+ *  @func   RING_IO_ChnlSetInline
+ *
+ *  @desc   Turns the inline mode of the reader on or off.
+ *
+ *  @modif  inlineFxn, inlineArg, inlineStats of the channel.
+ *  ============================================================================
+ */
+NORMAL_API
+Void
+RING_IO_ChnlSetInline (IN RING_IO_ChnlObj * chnl,
+		IN RING_IO_ChnlInlineFxn inlineFxn,
+		IN Pvoid arg)
+{
+	chnl->inlineArg = arg;
+	chnl->inlineFxn = inlineFxn;
+	memset (&chnl->inlineStats, 0, sizeof (RING_IO_ChnlInlineStats));
+}
+
+/** ============================================================================
+ *  @func   RING_IO_ChnlInlineReport
+ *
+ *  @desc   Prints the work done by the reader notification in inline mode.
+ *
+ *  @modif  None
+ *  ============================================================================
+ */
+NORMAL_API
+Void
+RING_IO_ChnlInlineReport (IN RING_IO_ChnlObj * chnl)
+{
+	RING_IO_ChnlInlineStats * stats = &chnl->inlineStats;
+
+	RING_IO_1Print64 ("GPP<--DSP:Records handled inline %llu \n",
+			stats->records);
+	RING_IO_1Print64 ("GPP<--DSP:Bytes handled inline %llu \n",
+			stats->bytes);
+	RING_IO_1Print64 ("GPP<--DSP:Records queued to the reader %llu \n",
+			stats->queued);
+	RING_IO_1Print64 ("GPP<--DSP:Handoffs to the reader %llu \n",
+			stats->handoffs);
+}
+
+/** ============================================================================
+ *  @func   RING_IO_ChnlSeqReport
+ *
+ *  @desc   Prints the sequence number checks of the last transfer read.
+ *
+ *  @modif  None
+ *  ============================================================================
+ */
+NORMAL_API
+DSP_STATUS
+RING_IO_ChnlSeqReport (IN RING_IO_ChnlObj * chnl)
+{
+	DSP_STATUS status = DSP_SOK;
+	RING_IO_ChnlSeqStats * stats = &chnl->seqStats;
+
+	RING_IO_1Print64 ("GPP<--DSP:Records in sequence %llu \n",
+			stats->records - stats->duplicates - stats->reordered);
+	if (   (stats->missing > 0)
+		|| (stats->duplicates > 0)
+		|| (stats->reordered > 0)) {
+		RING_IO_1Print64 ("GPP<--DSP:Records missing %llu \n",
+				stats->missing);
+		RING_IO_1Print64 ("GPP<--DSP:Records duplicated %llu \n",
+				stats->duplicates);
+		RING_IO_1Print64 ("GPP<--DSP:Records reordered %llu \n",
+				stats->reordered);
+		status = DSP_EFAIL;
+	}
+
+	return (status);
+}
+
+/** ============================================================================
+ *  @func   RING_IO_ChnlPoolInit
+ *
+ *  @desc   Initializes the channel pool.
+ *
+ *  @modif  RING_IO_ChnlPool, RING_IO_ChnlEntries
+ *  ============================================================================
+ */
+NORMAL_API
+DSP_STATUS
+RING_IO_ChnlPoolInit (Void)
+{
+	DSP_STATUS status = DSP_SOK;
+	Pvoid addr = NULL;
+
+	memset (RING_IO_ChnlEntries, 0, sizeof (RING_IO_ChnlEntries));
+	status = RING_IO_ShmAlloc (sizeof (RING_IO_ChnlPoolObj), &addr);
+	if (DSP_SUCCEEDED (status)) {
+		RING_IO_ChnlPool = (RING_IO_ChnlPoolObj *) addr;
+	}
+
+	return (status);
+}
+
+/** ============================================================================
+ *  @func   RING_IO_ChnlPoolExit
+ *
+ *  @desc   Closes the RingIOs still held by the channel pool and frees it.
+ *
+ *  @modif  RING_IO_ChnlPool, RING_IO_ChnlEntries
+ *  ============================================================================
+ */
+NORMAL_API
+Void
+RING_IO_ChnlPoolExit (IN RING_IO_ChnlObj * chnls, IN Uint32 numChnls)
+{
+	Uint32 i;
+
+	for (i = 0; i < numChnls; i++) {
+		RING_IO_ChnlPoolDrain (&chnls [i]);
+	}
+
+	if (RING_IO_ChnlPool != NULL) {
+		RING_IO_ShmFree (RING_IO_ChnlPool, sizeof (RING_IO_ChnlPoolObj));
+		RING_IO_ChnlPool = NULL;
+	}
+}
+
+/** ============================================================================
+ *  @func   RING_IO_ChnlLeaseWriter
+ *
+ *  @desc   Leases the writer RingIO of the channel from the channel pool.
+ *
+ *  @modif  writerHandle, semWriter, writer settings of the channel,
+ *          RING_IO_ChnlEntries.
+ *  ============================================================================
+ */
+NORMAL_API
+DSP_STATUS
+RING_IO_ChnlLeaseWriter (IN RING_IO_ChnlObj * chnl)
+{
+	DSP_STATUS status = DSP_SOK;
+	RING_IO_ChnlPoolEntry * entry = &RING_IO_ChnlEntries [chnl->id];
+	RING_IO_Uint64 start = RING_IO_GetTimeUsec ();
+	Bool hit = FALSE;
+
+	RING_IO_ChnlAdopt (chnl, TRUE);
+	if (entry->writerHandle != NULL) {
+		hit = TRUE;
+		chnl->writerHandle = entry->writerHandle;
+		chnl->semWriter = entry->semWriter;
+		entry->writerHandle = NULL;
+		entry->semWriter = NULL;
+		/* The notification carries the channel and its settings */
+		if (   (entry->writerChnl != chnl)
+			|| (entry->writerWatermark != RING_IO_ChnlWatermark (chnl))
+			|| (entry->writerNotifyType != chnl->writerNotifyType)) {
+			status = RING_IO_ChnlWriterNotifier (chnl);
+		}
+	}
+	else {
+		status = RING_IO_ChnlOpenWriter (chnl);
+	}
+
+	if (RING_IO_ChnlPool != NULL) {
+		RING_IO_ChnlPoolCount (&RING_IO_ChnlPool->writerStats [chnl->id],
+				hit,
+				start);
+	}
+
+	return (status);
+}
+
+/** ============================================================================
+ *  @func   RING_IO_ChnlReturnWriter
+ *
+ *  @desc   Returns the writer RingIO of the channel to the channel pool.
+ *
+ *  @modif  writerHandle, semWriter of the channel, RING_IO_ChnlEntries.
+ *  ============================================================================
+ */
+NORMAL_API
+DSP_STATUS
+RING_IO_ChnlReturnWriter (IN RING_IO_ChnlObj * chnl)
+{
+	DSP_STATUS status = DSP_SOK;
+#if !defined (RING_IO_MULTIPROCESS)
+	RING_IO_ChnlPoolEntry * entry = &RING_IO_ChnlEntries [chnl->id];
+#endif /* !defined (RING_IO_MULTIPROCESS) */
+
+#if defined (RING_IO_MULTIPROCESS)
+	/* The next session may run in another process */
+	status = RING_IO_ChnlCloseWriter (chnl);
+#else
+	if ((chnl->writerHandle != NULL) && (entry->writerHandle == NULL)) {
+		entry->writerHandle = chnl->writerHandle;
+		entry->semWriter = chnl->semWriter;
+		entry->writerChnl = chnl;
+		entry->writerWatermark = RING_IO_ChnlWatermark (chnl);
+		entry->writerNotifyType = chnl->writerNotifyType;
+		chnl->writerHandle = NULL;
+		chnl->semWriter = NULL;
+	}
+	else {
+		status = RING_IO_ChnlCloseWriter (chnl);
+	}
+#endif /* if defined (RING_IO_MULTIPROCESS) */
+
+	return (status);
+}
+
+/** ============================================================================
+ *  @func   RING_IO_ChnlLeaseReader
+ *
+ *  @desc   Leases the reader RingIO of the channel from the channel pool.
+ *
+ *  @modif  readerHandle, semReader, reader settings of the channel,
+ *          RING_IO_ChnlEntries.
+ *  ============================================================================
+ */
+NORMAL_API
+DSP_STATUS
+RING_IO_ChnlLeaseReader (IN RING_IO_ChnlObj * chnl)
+{
+	DSP_STATUS status = DSP_SOK;
+	RING_IO_ChnlPoolEntry * entry = &RING_IO_ChnlEntries [chnl->id];
+	RING_IO_Uint64 start = RING_IO_GetTimeUsec ();
+	Bool hit = FALSE;
+
+	RING_IO_ChnlAdopt (chnl, FALSE);
+	if (entry->readerHandle != NULL) {
+		/*
+		 * The flags are not reset, as the DSP may already have notified
+		 * the start of this session.
+		 */
+		hit = TRUE;
+		chnl->readerHandle = entry->readerHandle;
+		chnl->semReader = entry->semReader;
+		entry->readerHandle = NULL;
+		entry->semReader = NULL;
+		if (entry->readerChnl != chnl) {
+			chnl->readerOwner = 1u;
+			status = RING_IO_ChnlReaderNotifier (chnl);
+		}
+	}
+	else {
+		status = RING_IO_ChnlOpenReader (chnl);
+	}
+
+	if (RING_IO_ChnlPool != NULL) {
+		RING_IO_ChnlPoolCount (&RING_IO_ChnlPool->readerStats [chnl->id],
+				hit,
+				start);
+	}
+
+	return (status);
+}
+
+/** ============================================================================
+ *  @func   RING_IO_ChnlReturnReader
+ *
+ *  @desc   Returns the reader RingIO of the channel to the channel pool,
+ *          flushing what the session left unread.
+ *
+ *  @modif  readerHandle, semReader of the channel, RING_IO_ChnlEntries.
+ *  ============================================================================
+ */
+NORMAL_API
+DSP_STATUS
+RING_IO_ChnlReturnReader (IN RING_IO_ChnlObj * chnl)
+{
+	DSP_STATUS status = DSP_SOK;
+#if !defined (RING_IO_MULTIPROCESS)
+	RING_IO_ChnlPoolEntry * entry = &RING_IO_ChnlEntries [chnl->id];
+	Uint16 type;
+	Uint32 param;
+	Uint32 bytesFlushed;
+#endif /* !defined (RING_IO_MULTIPROCESS) */
+
+#if defined (RING_IO_MULTIPROCESS)
+	/* The next session may run in another process */
+	status = RING_IO_ChnlCloseReader (chnl);
+#else
+	if ((chnl->readerHandle != NULL) && (entry->readerHandle == NULL)) {
+		/* A session ended early leaves data for the next one */
+		chnl->readerOwner = 1u;
+		chnl->readerEvents = 0;
+		chnl->readerPending = 0;
+		if (   (RingIO_getValidSize (chnl->readerHandle) != 0)
+			|| (RingIO_getValidAttrSize (chnl->readerHandle) != 0)) {
+			status = RingIO_flush (chnl->readerHandle,
+					TRUE,
+					&type,
+					&param,
+					&bytesFlushed);
+		}
+
+		if (DSP_SUCCEEDED (status)) {
+			entry->readerHandle = chnl->readerHandle;
+			entry->semReader = chnl->semReader;
+			entry->readerChnl = chnl;
+			chnl->readerHandle = NULL;
+			chnl->semReader = NULL;
+		}
+		else {
+			RING_IO_1Print ("RingIO_flush () Reader failed. "
+					"Status = [0x%x]\n",
+					status);
+			status = RING_IO_ChnlCloseReader (chnl);
+		}
+	}
+	else {
+		status = RING_IO_ChnlCloseReader (chnl);
+	}
+#endif /* if defined (RING_IO_MULTIPROCESS) */
+
+	return (status);
+}
+
+/** ============================================================================
+ *  @func   RING_IO_ChnlPoolReport
+ *
+ *  @desc   Prints the setup time and the hit rate of the leases of the
+ *          channel.
+ *
+ *  @modif  None
+ *  ============================================================================
+ */
+NORMAL_API
+Void
+RING_IO_ChnlPoolReport (IN RING_IO_ChnlObj * chnl)
+{
+	RING_IO_ChnlPoolStats * stats;
+
+	if (RING_IO_ChnlPool != NULL) {
+		stats = &RING_IO_ChnlPool->writerStats [chnl->id];
+		if (stats->leases > 0) {
+			RING_IO_1Print64 ("GPP-->DSP:Channel leases %llu \n",
+					stats->leases);
+			RING_IO_1Print64 ("GPP-->DSP:Channel lease hit rate %llu %% \n",
+					(stats->hits * 100u) / stats->leases);
+			RING_IO_1Print64 ("GPP-->DSP:Channel setup avg %llu us \n",
+					stats->setupSum / stats->leases);
+			RING_IO_1Print64 ("GPP-->DSP:Channel setup max %llu us \n",
+					stats->setupMax);
+		}
+
+		stats = &RING_IO_ChnlPool->readerStats [chnl->id];
+		if (stats->leases > 0) {
+			RING_IO_1Print64 ("GPP<--DSP:Channel leases %llu \n",
+					stats->leases);
+			RING_IO_1Print64 ("GPP<--DSP:Channel lease hit rate %llu %% \n",
+					(stats->hits * 100u) / stats->leases);
+			RING_IO_1Print64 ("GPP<--DSP:Channel setup avg %llu us \n",
+					stats->setupSum / stats->leases);
+			RING_IO_1Print64 ("GPP<--DSP:Channel setup max %llu us \n",
+					stats->setupMax);
+		}
+	}
+}
+
+/** ============================================================================
+ *  @func   RING_IO_ChnlGetTuneStats
+ *
+ *  @desc   Gets the counters of the channel sampled by the ring size tuner.
+ *
+ *  @modif  None
+ *  ============================================================================
+ */
+NORMAL_API
+RING_IO_ChnlTuneStats *
+RING_IO_ChnlGetTuneStats (IN RING_IO_ChnlObj * chnl)
+{
+	RING_IO_ChnlTuneStats * stats = NULL;
+
+	if (RING_IO_ChnlPool != NULL) {
+		stats = &RING_IO_ChnlPool->tuneStats [chnl->id];
+	}
+
+	return (stats);
+}
+
+/** ============================================================================
+ *  @func   RING_IO_ChnlPublish
+ *
+ *  @desc   Publishes the settings of the channel to the clients.
+ *
+ *  @modif  RING_IO_ChnlPool
+ *  ============================================================================
+ */
+NORMAL_API
+Void
+RING_IO_ChnlPublish (IN RING_IO_ChnlObj * chnl)
+{
+	RING_IO_ChnlSettings * settings;
+
+	if (RING_IO_ChnlPool != NULL) {
+		settings = &RING_IO_ChnlPool->settings [chnl->id];
+		settings->writerBufSize = chnl->writerBufSize;
+		settings->readerBufSize = chnl->readerBufSize;
+		settings->readerNewSize = chnl->readerNewSize;
+		settings->writerAcqSize = chnl->writerAcqSize;
+		settings->writerWatermark = chnl->writerWatermark;
+		settings->writerNotifyType = chnl->writerNotifyType;
+		settings->readerPrefetch = chnl->readerPrefetch;
+		settings->readerStage = chnl->readerStage;
+		settings->writerFillAhead = chnl->writerFillAhead;
+		RING_IO_MemBarrier ();
+		settings->published = TRUE;
+	}
+}
+
+/** ============================================================================
+ *  @func   RING_IO_ChnlResize
+ *
+ *  @desc   Changes the sizes of the RingIOs of the channel.
+ *
+ *  @modif  writerBufSize, readerBufSize, readerNewSize, writerAcqSize of the
+ *          channel, RING_IO_ChnlPool.
+ *  ============================================================================
+ */
+NORMAL_API
+DSP_STATUS
+RING_IO_ChnlResize (IN RING_IO_ChnlObj * chnl,
+		IN Uint8 processorId,
+		IN Uint32 writerBufSize,
+		IN Uint32 readerBufSize,
+		IN Uint32 attrBufSize)
+{
+	DSP_STATUS status = DSP_SOK;
+	DSP_STATUS tmpStatus = DSP_SOK;
+	Uint32 sizes [RING_IO_RESIZE_SIZE];
+	RingIO_Attrs ringIoAttrs;
+
+	sizes [RING_IO_RESIZE_WRITER] = DSPLINK_ALIGN (writerBufSize,
+			DSPLINK_BUF_ALIGN);
+	sizes [RING_IO_RESIZE_READER] = DSPLINK_ALIGN (readerBufSize,
+			DSPLINK_BUF_ALIGN);
+	sizes [RING_IO_RESIZE_ATTR] = DSPLINK_ALIGN (attrBufSize,
+			DSPLINK_BUF_ALIGN);
+	if (   (writerBufSize == 0)
+		|| (readerBufSize == 0)
+		|| (attrBufSize == 0)
+		|| (sizes [RING_IO_RESIZE_WRITER] > RING_IO_RESIZE_MAX_SIZE)
+		|| (sizes [RING_IO_RESIZE_READER] > RING_IO_RESIZE_MAX_SIZE)
+		|| (sizes [RING_IO_RESIZE_ATTR] > RING_IO_RESIZE_MAX_SIZE)) {
+		status = DSP_EINVALIDARG;
+		RING_IO_0Print ("ERROR! Invalid RingIO sizes\n");
+	}
+
+	/* Both RingIOs are needed to exchange the new sizes with the DSP */
+	if (DSP_SUCCEEDED (status)) {
+		status = RING_IO_ChnlPoolDrain (chnl);
+	}
+	if (DSP_SUCCEEDED (status)) {
+		status = RING_IO_ChnlOpenWriter (chnl);
+	}
+	if (DSP_SUCCEEDED (status)) {
+		status = RING_IO_ChnlOpenReader (chnl);
+	}
+
+	if (DSP_SUCCEEDED (status)) {
+		do {
+			status = RingIO_setvAttribute (chnl->writerHandle,
+					0,
+					(Uint16) RINGIO_DATA_RESIZE,
+					0,
+					sizes,
+					sizeof (sizes));
+			if (DSP_FAILED (status)) {
+				RING_IO_Sleep(10);
+			}
+		}while (status != RINGIO_SUCCESS);
+
+		status = RING_IO_NotifyPost (chnl, (Uint16) NOTIFY_DATA_RESIZE);
+		if (DSP_SUCCEEDED (status)) {
+			status = RING_IO_ChnlResizeAck (chnl);
+		}
+		if (DSP_FAILED (status)) {
+			RING_IO_1Print ("Resize not acknowledged by the DSP. "
+					"Status = [0x%x]\n",
+					status);
+		}
+	}
+
+	/* The DSP has closed the writer RingIO and waits for the reader */
+	tmpStatus = RING_IO_ChnlCloseReader (chnl);
+	if (DSP_SUCCEEDED (status) && DSP_FAILED (tmpStatus)) {
+		status = tmpStatus;
+	}
+	tmpStatus = RING_IO_ChnlCloseWriter (chnl);
+	if (DSP_SUCCEEDED (status) && DSP_FAILED (tmpStatus)) {
+		status = tmpStatus;
+	}
+
+	if (DSP_SUCCEEDED (status)) {
+		do {
+#if defined (DSPLINK_LEGACY_SUPPORT)
+			status = RingIO_delete (chnl->writerName);
+#else
+			status = RingIO_delete (processorId, chnl->writerName);
+#endif /* if defined (DSPLINK_LEGACY_SUPPORT) */
+			if (DSP_FAILED (status)) {
+				RING_IO_Sleep(10);
+			}
+		}while (DSP_FAILED (status));
+
+		ringIoAttrs.transportType = RINGIO_TRANSPORT_GPP_DSP;
+		ringIoAttrs.ctrlPoolId = POOL_makePoolId (processorId,
+				RING_IO_RESIZE_POOL_ID);
+		ringIoAttrs.dataPoolId = ringIoAttrs.ctrlPoolId;
+		ringIoAttrs.attrPoolId = ringIoAttrs.ctrlPoolId;
+		ringIoAttrs.lockPoolId = ringIoAttrs.ctrlPoolId;
+		ringIoAttrs.dataBufSize = sizes [RING_IO_RESIZE_WRITER];
+		ringIoAttrs.footBufSize = 0;
+		ringIoAttrs.attrBufSize = sizes [RING_IO_RESIZE_ATTR];
+#if defined (DSPLINK_LEGACY_SUPPORT)
+		status = RingIO_create (chnl->writerName, &ringIoAttrs);
+#else
+		status = RingIO_create (processorId, chnl->writerName, &ringIoAttrs);
+#endif /* if defined (DSPLINK_LEGACY_SUPPORT) */
+		if (DSP_FAILED (status)) {
+			RING_IO_1Print ("RingIO_create () failed. Status = [0x%x]\n",
+					status);
+		}
+	}
+
+	if (DSP_SUCCEEDED (status)) {
+		chnl->writerBufSize = sizes [RING_IO_RESIZE_WRITER];
+		chnl->readerBufSize = sizes [RING_IO_RESIZE_READER];
+		chnl->readerNewSize = sizes [RING_IO_RESIZE_READER];
+		chnl->readerRemain = chnl->readerBufSize;
+		if (chnl->writerAcqSize > chnl->writerBufSize) {
+			chnl->writerAcqSize = chnl->writerBufSize;
+		}
+		RING_IO_ChnlPublish (chnl);
+	}
+
+	return (status);
+}
+
+/** ============================================================================
+ *  @func   RING_IO_ChnlConfigure
+ *
+ *  @desc   Applies a configuration to the channel.
+ *
+ *  @modif  writerBufSize, readerBufSize, writerAcqSize, writerWatermark,
+ *          writerNotifyType, readerPrefetch, readerStage of the channel,
+ *          RING_IO_ChnlPool.
+ *  ============================================================================
+ */
+NORMAL_API
+DSP_STATUS
+RING_IO_ChnlConfigure (IN RING_IO_ChnlObj * chnl,
+		IN Uint8 processorId,
+		IN Uint32 attrBufSize,
+		IN RING_IO_Config * config)
+{
+	DSP_STATUS status = DSP_SOK;
+
+	if (   (config->ringSize != 0)
+		&& (   (config->ringSize != chnl->writerBufSize)
+			|| (config->ringSize != chnl->readerBufSize))) {
+		status = RING_IO_ChnlResize (chnl,
+				processorId,
+				config->ringSize,
+				config->ringSize,
+				attrBufSize);
+	}
+
+	if (DSP_SUCCEEDED (status)) {
+		if (config->acqSize != 0) {
+			chnl->writerAcqSize = config->acqSize;
+		}
+		if (chnl->writerAcqSize > chnl->writerBufSize) {
+			chnl->writerAcqSize = chnl->writerBufSize;
+		}
+		if (config->watermark != 0) {
+			chnl->writerWatermark = config->watermark;
+		}
+		if (chnl->writerWatermark > chnl->writerBufSize) {
+			chnl->writerWatermark = chnl->writerBufSize;
+		}
+		chnl->writerNotifyType = (config->notifyAlways != 0) ?
+				RINGIO_NOTIFICATION_ALWAYS : RINGIO_NOTIFICATION_ONCE;
+		chnl->readerPrefetch = config->prefetch;
+		chnl->readerStage = (config->stage != 0) ? TRUE : FALSE;
+		chnl->writerFillAhead = (config->fillAhead != 0) ? TRUE : FALSE;
+		if (   (chnl->readerStage == TRUE)
+			&& (chnl->readerPrefetch > RING_IO_CHNL_STAGE_SIZE)) {
+			chnl->readerPrefetch = RING_IO_CHNL_STAGE_SIZE;
+		}
+		RING_IO_ChnlPublish (chnl);
+	}
+
+	return (status);
+}
+
+/** ============================================================================
+ *  @func   RING_IO_ChnlPoolFlush
+ *
+ *  @desc   Closes the RingIOs of the channel kept open by the channel pool.
+ *
+ *  @modif  RING_IO_ChnlEntries
+ *  ============================================================================
+ */
+NORMAL_API
+DSP_STATUS
+RING_IO_ChnlPoolFlush (IN RING_IO_ChnlObj * chnl)
+{
+	return (RING_IO_ChnlPoolDrain (chnl));
+}
+
+/** ============================================================================
+ *  @func   RING_IO_ChnlCalibrate
+ *
+ *  @desc   Times the copy and fill kernels on the writer RingIO.
+ *
+ *  @modif  None
+ *  ============================================================================
+ */
+NORMAL_API
+DSP_STATUS
+RING_IO_ChnlCalibrate (IN RING_IO_ChnlObj * chnl)
+{
+	DSP_STATUS status = DSP_SOK;
+	DSP_STATUS tmpStatus = DSP_SOK;
+	RingIO_BufPtr bufPtr = NULL;
+	Uint32 acqSize;
+
+	status = RING_IO_ChnlOpenWriter (chnl);
+	if (DSP_SUCCEEDED (status)) {
+		acqSize = chnl->writerBufSize;
+		tmpStatus = RingIO_acquire (chnl->writerHandle, &bufPtr, &acqSize);
+		if ((tmpStatus == RINGIO_SUCCESS) && (acqSize != 0)) {
+			/* The content is cancelled, the DSP never sees it */
+			RING_IO_CopySelect (bufPtr, acqSize);
+			tmpStatus = RingIO_cancel (chnl->writerHandle);
+			if (DSP_FAILED (tmpStatus)) {
+				status = tmpStatus;
+				RING_IO_1Print ("RingIO_cancel () Writer failed. "
+						"Status = [0x%x]\n",
+						status);
+			}
+		}
+		else {
+			/* Not fatal, the default kernels stay selected */
+			RING_IO_CopySelect (NULL, 0);
+		}
+	}
+
+	tmpStatus = RING_IO_ChnlCloseWriter (chnl);
+	if (DSP_SUCCEEDED (status) && DSP_FAILED (tmpStatus)) {
+		status = tmpStatus;
+	}
+
+	return (status);
+}
+
+/** ============================================================================
+ *  @func   RING_IO_ChnlShutdown
+ *
+ *  @desc   Sends the NOTIFY_DSP_END notification on the channel.
+ *
+ *  @modif  None
+ *  ============================================================================
+ */
+NORMAL_API
+DSP_STATUS
+RING_IO_ChnlShutdown (IN RING_IO_ChnlObj * chnl)
+{
+	return (RING_IO_ChnlShutdownAll (chnl, 1u));
+}
+
+/** ============================================================================
+ *  @func   RING_IO_ChnlShutdownAll
+ *
+ *  @desc   Ends the DSP side of several channels, with a single doorbell
+ *          if the DSP decodes them. The RingIOs kept open by the channel pool
+ *          are closed first.
+ *
+ *  @modif  None
+ *  ============================================================================
+ */
+NORMAL_API
+DSP_STATUS
+RING_IO_ChnlShutdownAll (IN RING_IO_ChnlObj * chnls, IN Uint32 numChnls)
+{
+	DSP_STATUS status = DSP_SOK;
+	DSP_STATUS tmpStatus = DSP_SOK;
+	Bool opened [RING_IO_NUM_CHNLS];
+	Bool allOpen = TRUE;
+	Uint32 i;
+
+	/* The DSP must have consumed the pooled writers before it ends */
+	for (i = 0; i < numChnls; i++) {
+		tmpStatus = RING_IO_ChnlPoolDrain (&chnls [i]);
+		if (DSP_SUCCEEDED (status) && DSP_FAILED (tmpStatus)) {
+			status = tmpStatus;
+		}
+	}
+
+	for (i = 0; i < numChnls; i++) {
+		opened [i] = FALSE;
+		if (chnls [i].writerHandle == NULL) {
+			tmpStatus = RING_IO_ChnlOpenWriter (&chnls [i]);
+			opened [i] = DSP_SUCCEEDED (tmpStatus) ? TRUE : FALSE;
+			if (DSP_FAILED (tmpStatus)) {
+				allOpen = FALSE;
+				if (DSP_SUCCEEDED (status)) {
+					status = tmpStatus;
+				}
+			}
+		}
+	}
+
+	/* The notifications are sent while the writers are still open */
+	if (allOpen == TRUE) {
+		tmpStatus = RING_IO_NotifyPostAll (chnls,
+				numChnls,
+				(Uint16) NOTIFY_DSP_END);
+		if (DSP_SUCCEEDED (status) && DSP_FAILED (tmpStatus)) {
+			status = tmpStatus;
+		}
+	}
+	else {
+		/* The channels that can still be ended get their own notification */
+		for (i = 0; i < numChnls; i++) {
+			if (chnls [i].writerHandle != NULL) {
+				tmpStatus = RING_IO_NotifyPost (&chnls [i],
+						(Uint16) NOTIFY_DSP_END);
+				if (DSP_SUCCEEDED (status) && DSP_FAILED (tmpStatus)) {
+					status = tmpStatus;
+				}
+			}
+		}
+	}
+
+	for (i = 0; i < numChnls; i++) {
+		if (opened [i] == TRUE) {
+			tmpStatus = RING_IO_ChnlCloseWriter (&chnls [i]);
+			if (DSP_SUCCEEDED (status) && DSP_FAILED (tmpStatus)) {
+				status = tmpStatus;
+			}
+		}
+	}
+
+	return (status);
+}
+
+
+/** ----------------------------------------------------------------------------
+ *  @func   RING_IO_ChnlWriterNotify
+ *
+ *  @desc   Notification callback for the RingIO opened by the GPP in writer
+ *          mode.
+ *
+ *  @modif  None
+ *  ----------------------------------------------------------------------------
+ */
+STATIC
+NORMAL_API
+Void
+RING_IO_ChnlWriterNotify (IN RingIO_Handle handle,
+		IN RingIO_NotifyParam param,
+		IN RingIO_NotifyMsg msg)
+{
+	DSP_STATUS status = DSP_SOK;
+	RING_IO_ChnlObj * chnl = (RING_IO_ChnlObj *) param;
+	RING_IO_ChnlTuneStats * tune = RING_IO_ChnlGetTuneStats (chnl);
+
+	if (tune != NULL) {
+		RING_IO_AtomicAdd64 (&tune->notifies, 1u);
+	}
+
+	/* Post the semaphore. */
+	status = RING_IO_PostSem (chnl->semWriter);
+	if (DSP_FAILED (status)) {
+		RING_IO_1Print ("RING_IO_PostSem () failed. Status = [0x%x]\n",
+				status);
+	}
+}
+
+/** ----------------------------------------------------------------------------
+ *  @func   RING_IO_ChnlReaderNotify
+ *
+ *  @desc   Notification callback for the RingIO opened by the GPP in reader
+ *          mode. Adds the event to the mask of the channel and wakes the
+ *          reader thread only if the mask was empty.
+ *
+ *  @modif  readerEvents of the channel.
+ *  ----------------------------------------------------------------------------
+ */
+STATIC
+NORMAL_API
+Void
+RING_IO_ChnlReaderNotify (IN RingIO_Handle handle,
+		IN RingIO_NotifyParam param,
+		IN RingIO_NotifyMsg msg)
+{
+	DSP_STATUS status = DSP_SOK;
+	RING_IO_ChnlObj * chnl = (RING_IO_ChnlObj *) param;
+	RING_IO_ChnlTuneStats * tune = RING_IO_ChnlGetTuneStats (chnl);
+	Uint32 event = RING_IO_EVENT_DATA;
+
+	if (tune != NULL) {
+		RING_IO_AtomicAdd64 (&tune->notifies, 1u);
+	}
+
+	/* Urgent control messages do not concern the data transfer */
+	if (RING_IO_NotifyUrgentRecv (chnl, (Uint16) msg) == FALSE) {
+		switch(msg) {
+			case NOTIFY_DATA_START:
+			event = RING_IO_EVENT_START;
+			break;
+
+			case NOTIFY_DATA_END:
+			event = RING_IO_EVENT_END;
+			break;
+
+			default:
+			/*
+			 * In inline mode, read the data here if the reader thread
+			 * waits for it, saving its wakeup.
+			 */
+			if (   (chnl->inlineFxn != NULL)
+				&& (RING_IO_AtomicCas (&chnl->readerOwner, 0u, 1u) == TRUE)) {
+				if (RING_IO_ChnlReadInline (chnl) == FALSE) {
+					event = 0;
+				}
+				RING_IO_AtomicCas (&chnl->readerOwner, 1u, 0u);
+			}
+			break;
+		}
+
+		/* A non empty mask means that a wakeup is already on its way */
+		if (   (event != 0)
+			&& (RING_IO_AtomicOr (&chnl->readerEvents, event) == 0)) {
+			/* Post the semaphore. */
+			status = RING_IO_PostSem (chnl->semReader);
+			if (DSP_FAILED (status)) {
+				RING_IO_1Print ("RING_IO_PostSem () failed. "
+						"Status = [0x%x]\n",
+						status);
+			}
+		}
+	}
+}
+
+/** ----------------------------------------------------------------------------
+ *  @func   RING_IO_ChnlReaderWait
+ *
+ *  @desc   Waits for a reader notification and takes the pending events.
+ *
+ *  @modif  readerEvents, readerPending of the channel.
+ *  ----------------------------------------------------------------------------
+ */
+STATIC
+NORMAL_API
+DSP_STATUS
+RING_IO_ChnlReaderWait (IN RING_IO_ChnlObj * chnl, IN Uint32 timeout)
+{
+	DSP_STATUS status = DSP_SOK;
+
+	if (timeout == 0) {
+		status = RING_IO_WaitSem (chnl->semReader);
+	}
+	else {
+		status = RING_IO_TimedWaitSem (chnl->semReader, timeout);
+	}
+
+	/*
+	 * Each post comes with a non empty mask: emptying it lets the next
+	 * notification post again.
+	 */
+	if (DSP_SUCCEEDED (status)) {
+		chnl->readerPending |= RING_IO_AtomicXchg (&chnl->readerEvents, 0u);
+	}
+
+	return (status);
+}
+
+/** ----------------------------------------------------------------------------
+ *  @func   RING_IO_ChnlWriteRecord
+ *
+ *  @desc   Places the variable attribute describing a record.
+ *
+ *  @modif  None
+ *  ----------------------------------------------------------------------------
+ */
+STATIC
+NORMAL_API
+DSP_STATUS
+RING_IO_ChnlWriteRecord (IN RING_IO_ChnlObj * chnl,
+		IN Uint32 size,
+		IN RING_IO_Uint64 offset)
+{
+	DSP_STATUS status = DSP_SOK;
+	Uint32 attrs [RING_IO_VATTR_SIZE];
+
+	/*
+	 * Tell the DSP the size of this record, its offset in the
+	 * transfer and its sequence number. The attribute is placed
+	 * at the start of the acquired buffer.
+	 */
+	attrs [RING_IO_VATTR_LEN] = size;
+	attrs [RING_IO_VATTR_OFFSET_LO] = (Uint32) offset;
+	attrs [RING_IO_VATTR_OFFSET_HI] = (Uint32) (offset >> 32);
+	attrs [RING_IO_VATTR_SEQ_LO] = (Uint32) chnl->writerSeq;
+	attrs [RING_IO_VATTR_SEQ_HI] = (Uint32) (chnl->writerSeq >> 32);
+	do {
+		status = RingIO_setvAttribute (chnl->writerHandle,
+				0, /* at the beginning */
+				0, /* No type */
+				0,
+				attrs,
+				chnl->writerAttrSize);
+		if (DSP_FAILED (status)) {
+			/* Attribute buffer is full, let the DSP drain it */
+			RING_IO_Sleep(10);
+		}
+	}while (DSP_FAILED (status));
+
+	return (status);
+}
+
+/** ----------------------------------------------------------------------------
+ *  @func   RING_IO_ChnlWriteDone
+ *
+ *  @desc   Accounts for a record written to the writer RingIO.
+ *
+ *  @modif  writerSeq of the channel.
+ *  ----------------------------------------------------------------------------
+ */
+STATIC
+NORMAL_API
+Void
+RING_IO_ChnlWriteDone (IN RING_IO_ChnlObj * chnl, IN Uint32 size)
+{
+	RING_IO_ChnlTuneStats * tune = RING_IO_ChnlGetTuneStats (chnl);
+
+	chnl->writerSeq++;
+	if (tune != NULL) {
+		tune->bytes += size;
+		if ((chnl->writerSeq % RING_IO_CHNL_OCC_PERIOD) == 0) {
+			tune->occupancySum += RingIO_getValidSize (chnl->writerHandle);
+			tune->occupancySamples++;
+		}
+	}
+}
+
+/** ----------------------------------------------------------------------------
+ *  @func   RING_IO_ChnlCommit
+ *
+ *  @desc   Copies a record from a staging buffer to the writer RingIO.
+ *
+ *  @modif  writerSeq of the channel.
+ *  ----------------------------------------------------------------------------
+ */
+STATIC
+NORMAL_API
+DSP_STATUS
+RING_IO_ChnlCommit (IN RING_IO_ChnlObj * chnl,
+		IN RingIO_BufPtr data,
+		IN Uint32 size,
+		IN RING_IO_Uint64 offset)
+{
+	DSP_STATUS status = DSP_SOK;
+	DSP_STATUS relStatus = DSP_SOK;
+	RingIO_BufPtr bufPtr = NULL;
+	Uint32 acqSize;
+	Uint32 done = 0;
+
+	while (DSP_SUCCEEDED (status) && (done < size)) {
+		acqSize = size - done;
+		status = RingIO_acquire (chnl->writerHandle,
+				&bufPtr,
+				&acqSize);
+
+		if ((DSP_SUCCEEDED (status)) && (acqSize > 0)) {
+			/* The attribute precedes the first piece of the record only */
+			if (done == 0) {
+				status = RING_IO_ChnlWriteRecord (chnl, size, offset);
+			}
+			RING_IO_Copy (bufPtr, data + done, acqSize);
+
+			relStatus = RingIO_release (chnl->writerHandle, acqSize);
+			if (DSP_FAILED (relStatus)) {
+				status = relStatus;
+				RING_IO_1Print ("RingIO_release () in Writer task "
+						"failed. relStatus = [0x%x]\n",
+						relStatus);
+			}
+			else {
+				done += acqSize;
+			}
+		}
+		else {
+			status = RING_IO_ChnlWriterWait (chnl);
+		}
+	}
+
+	if (DSP_SUCCEEDED (status)) {
+		RING_IO_ChnlWriteDone (chnl, size);
+	}
+
+	return (status);
+}
+
+/** ----------------------------------------------------------------------------
+ *  @func   RING_IO_ChnlFillThread
+ *
+ *  @desc   Fills the staging buffers of the writer in turn.
+ *
+ *  @modif  filled, status of the staging buffers.
+ *  ----------------------------------------------------------------------------
+ */
+STATIC
+NORMAL_API
+Void *
+RING_IO_ChnlFillThread (IN Void * ptr)
+{
+	RING_IO_ChnlFillObj * fill = (RING_IO_ChnlFillObj *) ptr;
+	DSP_STATUS status = DSP_SOK;
+	Uint32 slot = 0;
+	Bool endOfData = FALSE;
+
+	while (endOfData == FALSE) {
+		status = RING_IO_WaitSem (fill->semFree);
+		if (RING_IO_AtomicLoad (&fill->stop) != 0) {
+			/* The writer gave up and no longer takes the buffers */
+			break;
+		}
+
+		fill->filled [slot] = 0;
+		if (DSP_SUCCEEDED (status)) {
+			status = (*fill->fillFxn) (fill->arg,
+					fill->bufs [slot],
+					fill->size,
+					&fill->filled [slot]);
+		}
+		fill->status [slot] = status;
+		if (DSP_FAILED (status) || (fill->filled [slot] == 0)) {
+			endOfData = TRUE;
+		}
+
+		/* The semaphore publishes the buffer to the writer */
+		status = RING_IO_PostSem (fill->semFilled);
+		if (DSP_FAILED (status)) {
+			RING_IO_1Print ("RING_IO_PostSem () failed. Status = [0x%x]\n",
+					status);
+			endOfData = TRUE;
+		}
+		slot = (slot + 1u) % RING_IO_CHNL_FILL_BUFS;
+	}
+
+	return (NULL);
+}
+
+/** ----------------------------------------------------------------------------
+ *  @func   RING_IO_ChnlWriteAhead
+ *
+ *  @desc   Writes data to the DSP in fill-ahead mode.
+ *
+ *  @modif  writerSeq of the channel.
+ *  ----------------------------------------------------------------------------
+ */
+STATIC
+NORMAL_API
+DSP_STATUS
+RING_IO_ChnlWriteAhead (IN  RING_IO_ChnlObj * chnl,
+		IN  RING_IO_ChnlFillFxn fillFxn,
+		IN  Pvoid arg,
+		OUT RING_IO_Uint64 * bytesWritten)
+{
+	DSP_STATUS status = DSP_SOK;
+	RING_IO_ChnlFillObj fill;
+	Pvoid thread = NULL;
+	Pvoid addr = NULL;
+	Uint32 slot = 0;
+	Uint32 i;
+	Bool endOfData = FALSE;
+
+	memset (&fill, 0, sizeof (RING_IO_ChnlFillObj));
+	fill.fillFxn = fillFxn;
+	fill.arg = arg;
+	fill.size = chnl->writerAcqSize;
+
+	status = RING_IO_ShmAlloc (RING_IO_CHNL_FILL_BUFS * fill.size, &addr);
+	if (DSP_SUCCEEDED (status)) {
+		for (i = 0; i < RING_IO_CHNL_FILL_BUFS; i++) {
+			fill.bufs [i] = (RingIO_BufPtr) addr + (i * fill.size);
+		}
+		status = RING_IO_CreateSem (&fill.semFree);
+	}
+	if (DSP_SUCCEEDED (status)) {
+		status = RING_IO_CreateSem (&fill.semFilled);
+	}
+	for (i = 0; DSP_SUCCEEDED (status) && (i < RING_IO_CHNL_FILL_BUFS); i++) {
+		status = RING_IO_PostSem (fill.semFree);
+	}
+	if (DSP_SUCCEEDED (status)) {
+		status = RING_IO_CreateThread (&thread,
+				(Pvoid) &RING_IO_ChnlFillThread,
+				&fill);
+	}
+	if (DSP_FAILED (status)) {
+		RING_IO_1Print ("Fill-ahead setup failed. Status = [0x%x]\n",
+				status);
+	}
+
+	while (DSP_SUCCEEDED (status) && (endOfData == FALSE)) {
+		status = RING_IO_WaitSem (fill.semFilled);
+		if (DSP_FAILED (status)) {
+			RING_IO_1Print ("RING_IO_WaitSem () Fill SEM failed "
+					"Status = [0x%x]\n",
+					status);
+		}
+		else if (   DSP_FAILED (fill.status [slot])
+				 || (fill.filled [slot] == 0)) {
+			status = fill.status [slot];
+			endOfData = TRUE;
+		}
+		else {
+			/* Only the copy to the RingIO is left to this thread */
+			status = RING_IO_ChnlCommit (chnl,
+					fill.bufs [slot],
+					fill.filled [slot],
+					*bytesWritten);
+			if (DSP_SUCCEEDED (status)) {
+				*bytesWritten += fill.filled [slot];
+				status = RING_IO_PostSem (fill.semFree);
+			}
+			slot = (slot + 1u) % RING_IO_CHNL_FILL_BUFS;
+		}
+	}
+
+	if (thread != NULL) {
+		/* Lets the thread out if it waits for a buffer */
+		RING_IO_AtomicOr (&fill.stop, 1u);
+		RING_IO_PostSem (fill.semFree);
+		RING_IO_JoinThread (thread);
+	}
+	if (fill.semFilled != NULL) {
+		RING_IO_DeleteSem (fill.semFilled);
+	}
+	if (fill.semFree != NULL) {
+		RING_IO_DeleteSem (fill.semFree);
+	}
+	if (addr != NULL) {
+		RING_IO_ShmFree (addr, RING_IO_CHNL_FILL_BUFS * fill.size);
+	}
+
+	return (status);
+}
+
+/** ----------------------------------------------------------------------------
+ *  @func   RING_IO_ChnlSeqCheck
+ *
+ *  @desc   Accounts for the sequence number of a received record. A number
+ *          above the expected one marks the numbers in between as missing.
+ *          A number below it is a duplicate if it was already received, and
+ *          a late record otherwise, which is no longer missing.
+ *
+ *  @modif  readerSeq, readerSeqMask, seqStats of the channel.
+ *  ----------------------------------------------------------------------------
+ */
+STATIC
+NORMAL_API
+Void
+RING_IO_ChnlSeqCheck (IN RING_IO_ChnlObj * chnl, IN RING_IO_Uint64 seq)
+{
+	RING_IO_ChnlSeqStats * stats = &chnl->seqStats;
+	RING_IO_Uint64 distance;
+
+	stats->records++;
+
+	if (seq >= chnl->readerSeq) {
+		/* In sequence, or after a gap */
+		distance = seq - chnl->readerSeq;
+		stats->missing += distance;
+		if (distance >= (RING_IO_SEQ_WINDOW - 1u)) {
+			chnl->readerSeqMask = 1u;
+		}
+		else {
+			chnl->readerSeqMask =
+					(chnl->readerSeqMask << (distance + 1u)) | 1u;
+		}
+		chnl->readerSeq = seq + 1u;
+	}
+	else {
+		distance = chnl->readerSeq - 1u - seq;
+		if (distance >= RING_IO_SEQ_WINDOW) {
+			/* Too old to be told from a duplicate, count it as late */
+			stats->reordered++;
+		}
+		else if ((chnl->readerSeqMask & (1ull << distance)) != 0) {
+			stats->duplicates++;
+		}
+		else {
+			chnl->readerSeqMask |= (1ull << distance);
+			stats->reordered++;
+			stats->missing--;
+		}
+	}
+}
+
+/** ----------------------------------------------------------------------------
+ *  @func   RING_IO_ChnlReadDone
+ *
+ *  @desc   Accounts for data read and released from the reader RingIO.
+ *
+ *  @modif  readerRemain, readerBytes of the channel.
+ *  ----------------------------------------------------------------------------
+ */
+STATIC
+NORMAL_API
+Void
+RING_IO_ChnlReadDone (IN RING_IO_ChnlObj * chnl, IN Uint32 size)
+{
+	chnl->readerBytes += size;
+	chnl->readerRemain -= size;
+	if (chnl->readerRemain == 0) {
+		/* Acquire the full buffer until the next record is announced */
+		chnl->readerRemain = chnl->readerBufSize;
+	}
+}
+
+/** ----------------------------------------------------------------------------
+ *  @func   RING_IO_ChnlDrain
+ *
+ *  @desc   Hands an acquired reader buffer to the drain function.
+ *
+ *  @modif  readerStageBuf of the channel.
+ *  ----------------------------------------------------------------------------
+ */
+STATIC
+NORMAL_API
+DSP_STATUS
+RING_IO_ChnlDrain (IN RING_IO_ChnlObj * chnl,
+		IN RING_IO_ChnlDrainFxn drainFxn,
+		IN Pvoid arg,
+		IN RingIO_BufPtr buffer,
+		IN Uint32 size)
+{
+	DSP_STATUS status = DSP_SOK;
+	Uint8 * data = (Uint8 *) buffer;
+	Uint32 piece = chnl->readerPrefetch;
+	Uint32 len;
+
+	if ((piece == 0) && (chnl->readerStage == FALSE)) {
+		return ((*drainFxn) (arg, buffer, size));
+	}
+
+	if (piece == 0) {
+		piece = RING_IO_CHNL_STAGE_SIZE;
+	}
+
+	while ((size > 0) && DSP_SUCCEEDED (status)) {
+		len = (size < piece) ? size : piece;
+		if ((chnl->readerPrefetch != 0) && (size > len)) {
+			/* Load the next piece while this one is drained */
+			RING_IO_Prefetch (data + len,
+					((size - len) < piece) ? (size - len) : piece);
+		}
+
+		if (chnl->readerStage == TRUE) {
+			RING_IO_CopyOut (chnl->readerStageBuf, data, len);
+			status = (*drainFxn) (arg, chnl->readerStageBuf, len);
+		}
+		else {
+			status = (*drainFxn) (arg, data, len);
+		}
+		data += len;
+		size -= len;
+	}
+
+	return (status);
+}
+
+/** ----------------------------------------------------------------------------
+ *  @func   RING_IO_ChnlReadAttr
+ *
+ *  @desc   Reads the attribute pending on the reader RingIO.
+ *
+ *  @modif  readerRemain, readerDone of the channel.
+ *  ----------------------------------------------------------------------------
+ */
+STATIC
+NORMAL_API
+Void
+RING_IO_ChnlReadAttr (IN RING_IO_ChnlObj * chnl)
+{
+	DSP_STATUS attrStatus = DSP_SOK;
+	Uint32 attrs [RING_IO_VATTR_SIZE];
+	Uint32 vAttrSize = 0;
+	Uint32 param;
+	Uint16 type;
+
+	attrStatus = RingIO_getAttribute (chnl->readerHandle,
+			&type,
+			&param);
+	if ((attrStatus == RINGIO_SUCCESS)
+			|| (attrStatus == RINGIO_SPENDINGATTRIBUTE)) {
+		if (type == RINGIO_DATA_END) {
+			/* End of data transfer from DSP */
+			chnl->readerDone = TRUE;
+		}
+		else {
+			RING_IO_1Print ("RingIO_getAttribute () Reader "
+					"error,Unknown attribute "
+					" received Status = [0x%x]\n",
+					attrStatus);
+		}
+	}
+	else if (attrStatus == RINGIO_EVARIABLEATTRIBUTE) {
+		vAttrSize = sizeof(attrs);
+		attrStatus = RingIO_getvAttribute (chnl->readerHandle,
+				&type,
+				&param,
+				attrs,
+				&vAttrSize);
+		if ((attrStatus == RINGIO_SUCCESS)
+				|| (attrStatus == RINGIO_SPENDINGATTRIBUTE)) {
+			/* Acquire exactly the record announced by the DSP */
+			chnl->readerRemain = attrs[RING_IO_VATTR_LEN];
+			if (chnl->readerRemain == 0) {
+				chnl->readerRemain = chnl->readerBufSize;
+			}
+			if (vAttrSize == sizeof (attrs)) {
+				RING_IO_ChnlSeqCheck (chnl,
+						  attrs [RING_IO_VATTR_SEQ_LO]
+						| (  (RING_IO_Uint64)
+							 attrs [RING_IO_VATTR_SEQ_HI]
+						   << 32));
+			}
+		}
+		else if (attrStatus != RINGIO_EFAILURE) {
+			RING_IO_1Print ("Error:RingIO_getvAttribute "
+					"Status = [0x%x]\n",
+					attrStatus);
+		}
+	}
+	else {
+		RING_IO_1Print ("RingIO_getAttribute () Reader error "
+				"Status = [0x%x]\n",
+				attrStatus);
+	}
+}
+
+/** ----------------------------------------------------------------------------
+ *  @func   RING_IO_ChnlReadInline
+ *
+ *  @desc   Reads the reader RingIO in the reader notification.
+ *
+ *  @modif  inlineHead, inlineStats of the channel.
+ *  ----------------------------------------------------------------------------
+ */
+STATIC
+NORMAL_API
+Bool
+RING_IO_ChnlReadInline (IN RING_IO_ChnlObj * chnl)
+{
+	DSP_STATUS status = DSP_SOK;
+	RingIO_BufPtr bufPtr = NULL;
+	Bool wakeup = FALSE;
+	Bool handoff = FALSE;
+	Uint32 acqSize;
+	Uint32 slot;
+
+	while ((handoff == FALSE) && (chnl->readerDone == FALSE)) {
+		acqSize = chnl->readerRemain;
+		if (acqSize > RING_IO_CHNL_INLINE_MAX) {
+			acqSize = RING_IO_CHNL_INLINE_MAX;
+		}
+
+		if (   (chnl->readerRemain > RING_IO_CHNL_INLINE_MAX)
+			&& (RingIO_getValidSize (chnl->readerHandle)
+				> RING_IO_CHNL_INLINE_MAX)) {
+			/* Bulk data is better read by the thread in large pieces */
+			handoff = TRUE;
+			break;
+		}
+
+		status = RingIO_acquire (chnl->readerHandle, &bufPtr, &acqSize);
+
+		if ((status == RINGIO_SUCCESS) || (acqSize > 0)) {
+			if (   (chnl->inlineTail == chnl->inlineHead)
+				&& ((*chnl->inlineFxn) (chnl->inlineArg, bufPtr, acqSize)
+					== DSP_SOK)) {
+				chnl->inlineStats.records++;
+				chnl->inlineStats.bytes += acqSize;
+			}
+			else if (  (chnl->inlineHead - chnl->inlineTail)
+					 < RING_IO_CHNL_INLINE_SLOTS) {
+				/* Queued data goes first, and slow work is queued too */
+				slot = chnl->inlineHead % RING_IO_CHNL_INLINE_SLOTS;
+				memcpy (chnl->inlineData [slot], bufPtr, acqSize);
+				chnl->inlineLens [slot] = acqSize;
+				RING_IO_MemBarrier ();
+				chnl->inlineHead++;
+				chnl->inlineStats.queued++;
+				wakeup = TRUE;
+			}
+			else {
+				/* The queue is full, leave the data to the thread */
+				handoff = TRUE;
+			}
+
+			if (handoff == FALSE) {
+				RingIO_release (chnl->readerHandle, acqSize);
+				RING_IO_ChnlReadDone (chnl, acqSize);
+			}
+			else {
+				RingIO_cancel (chnl->readerHandle);
+			}
+		}
+		else if (status == RINGIO_SPENDINGATTRIBUTE) {
+			RING_IO_ChnlReadAttr (chnl);
+		}
+		else {
+			/* Nothing more to read, the notification is armed again */
+			break;
+		}
+	}
+
+	if (handoff == TRUE) {
+		chnl->inlineStats.handoffs++;
+	}
+
+	return ((wakeup == TRUE) || (handoff == TRUE) || (chnl->readerDone == TRUE));
+}
+
+
+/** ----------------------------------------------------------------------------
+ *  @func   RING_IO_ChnlWriterNotifier
+ *
+ *  @desc   Registers the notification of the writer RingIO of the channel.
+ *
+ *  @modif  None
+ *  ----------------------------------------------------------------------------
+ */
+STATIC
+NORMAL_API
+DSP_STATUS
+RING_IO_ChnlWriterNotifier (IN RING_IO_ChnlObj * chnl)
+{
+	DSP_STATUS status = DSP_SOK;
+
+	do {
+		/*
+		 * Get notified once the DSP has freed room for a full
+		 * acquire, or more.
+		 */
+		status = RingIO_setNotifier (chnl->writerHandle,
+				chnl->writerNotifyType,
+				RING_IO_ChnlWatermark (chnl),
+				&RING_IO_ChnlWriterNotify,
+				(RingIO_NotifyParam) chnl);
+		if (DSP_FAILED (status)) {
+			RING_IO_Sleep(10);
+		}
+	}while (DSP_FAILED (status));
+
+	return (status);
+}
+
+/** ----------------------------------------------------------------------------
+ *  @func   RING_IO_ChnlReaderNotifier
+ *
+ *  @desc   Registers the notification of the reader RingIO of the channel.
+ *
+ *  @modif  None
+ *  ----------------------------------------------------------------------------
+ */
+STATIC
+NORMAL_API
+DSP_STATUS
+RING_IO_ChnlReaderNotifier (IN RING_IO_ChnlObj * chnl)
+{
+	DSP_STATUS status = DSP_SOK;
+
+	do {
+		/*
+		 * Set water mark to zero. and try to acquire the full buffer
+		 * and  read what ever is available.
+		 */
+		status = RingIO_setNotifier (chnl->readerHandle,
+				RINGIO_NOTIFICATION_ONCE,
+				0,
+				&RING_IO_ChnlReaderNotify,
+				(RingIO_NotifyParam) chnl);
+		if (DSP_FAILED (status)) {
+			RING_IO_Sleep(10);
+		}
+	}while (DSP_FAILED (status));
+
+	return (status);
+}
+
+/** ----------------------------------------------------------------------------
+ *  @func   RING_IO_ChnlWatermark
+ *
+ *  @desc   Gets the watermark of the writer notification of the channel.
+ *
+ *  @modif  None
+ *  ----------------------------------------------------------------------------
+ */
+STATIC
+NORMAL_API
+Uint32
+RING_IO_ChnlWatermark (IN RING_IO_ChnlObj * chnl)
+{
+	return ((chnl->writerWatermark != 0) ? chnl->writerWatermark
+			: chnl->writerAcqSize);
+}
+
+/** ----------------------------------------------------------------------------
+ *  @func   RING_IO_ChnlPoolCount
+ *
+ *  @desc   Accounts for a lease from the channel pool. Each side of a
+ *          channel is leased by one client at a time.
+ *
+ *  @modif  stats
+ *  ----------------------------------------------------------------------------
+ */
+STATIC
+NORMAL_API
+Void
+RING_IO_ChnlPoolCount (IN RING_IO_ChnlPoolStats * stats,
+		IN Bool hit,
+		IN RING_IO_Uint64 start)
+{
+	RING_IO_Uint64 setup = RING_IO_GetTimeUsec () - start;
+
+	stats->leases++;
+	if (hit == TRUE) {
+		stats->hits++;
+	}
+	stats->setupSum += setup;
+	if (setup > stats->setupMax) {
+		stats->setupMax = setup;
+	}
+}
+
+/** ----------------------------------------------------------------------------
+ *  @func   RING_IO_ChnlAdopt
+ *
+ *  @desc   Takes the published settings of one side of the channel. Each
+ *          side only takes its own, as thread clients share the channel
+ *          object.
+ *
+ *  @modif  Settings of that side of the channel.
+ *  ----------------------------------------------------------------------------
+ */
+STATIC
+NORMAL_API
+Void
+RING_IO_ChnlAdopt (IN RING_IO_ChnlObj * chnl, IN Bool writer)
+{
+	RING_IO_ChnlSettings * settings;
+
+	if (   (RING_IO_ChnlPool == NULL)
+		|| (RING_IO_ChnlPool->settings [chnl->id].published == FALSE)) {
+		return;
+	}
+
+	settings = &RING_IO_ChnlPool->settings [chnl->id];
+	RING_IO_MemBarrier ();
+	if (writer == TRUE) {
+		chnl->writerBufSize = settings->writerBufSize;
+		chnl->writerAcqSize = settings->writerAcqSize;
+		chnl->writerWatermark = settings->writerWatermark;
+		chnl->writerNotifyType = settings->writerNotifyType;
+		chnl->writerFillAhead = settings->writerFillAhead;
+	}
+	else {
+		chnl->readerBufSize = settings->readerBufSize;
+		chnl->readerNewSize = settings->readerNewSize;
+		chnl->readerPrefetch = settings->readerPrefetch;
+		chnl->readerStage = settings->readerStage;
+	}
+}
+
+/** ----------------------------------------------------------------------------
+ *  @func   RING_IO_ChnlPoolDrain
+ *
+ *  @desc   Closes the RingIOs of the channel kept open by the channel pool,
+ *          the writer once the DSP has consumed it.
+ *
+ *  @modif  RING_IO_ChnlEntries
+ *  ----------------------------------------------------------------------------
+ */
+STATIC
+NORMAL_API
+DSP_STATUS
+RING_IO_ChnlPoolDrain (IN RING_IO_ChnlObj * chnl)
+{
+	DSP_STATUS status = DSP_SOK;
+	DSP_STATUS tmpStatus = DSP_SOK;
+	RING_IO_ChnlPoolEntry * entry = &RING_IO_ChnlEntries [chnl->id];
+
+	if ((entry->writerHandle != NULL) && (chnl->writerHandle == NULL)) {
+		chnl->writerHandle = entry->writerHandle;
+		chnl->semWriter = entry->semWriter;
+		entry->writerHandle = NULL;
+		entry->semWriter = NULL;
+		status = RING_IO_ChnlCloseWriter (chnl);
+	}
+
+	if ((entry->readerHandle != NULL) && (chnl->readerHandle == NULL)) {
+		chnl->readerHandle = entry->readerHandle;
+		chnl->semReader = entry->semReader;
+		entry->readerHandle = NULL;
+		entry->semReader = NULL;
+		tmpStatus = RING_IO_ChnlCloseReader (chnl);
+		if (DSP_SUCCEEDED (status) && DSP_FAILED (tmpStatus)) {
+			status = tmpStatus;
+		}
+	}
+
+	return (status);
+}
+
+/** ----------------------------------------------------------------------------
+ *  @func   RING_IO_ChnlResizeAck
+ *
+ *  @desc   Waits for the DSP to return the RINGIO_DATA_RESIZE attribute. Data
+ *          and attributes of an earlier transfer left in the reader RingIO
+ *          are discarded.
+ *
+ *  @modif  None
+ *  ----------------------------------------------------------------------------
+ */
+STATIC
+NORMAL_API
+DSP_STATUS
+RING_IO_ChnlResizeAck (IN RING_IO_ChnlObj * chnl)
+{
+	DSP_STATUS status = DSP_SOK;
+	RING_IO_Uint64 deadline = RING_IO_GetTimeUsec () + RING_IO_RESIZE_TIMEOUT;
+	RING_IO_Uint64 now;
+	Uint32 vAttr [RING_IO_VATTR_SIZE];
+	Uint32 vAttrSize;
+	Uint32 bytesFlushed;
+	Uint32 param;
+	Uint16 type;
+	Bool acked = FALSE;
+
+	while ((acked == FALSE) && DSP_SUCCEEDED (status)) {
+		status = RingIO_getAttribute (chnl->readerHandle, &type, &param);
+		if (   (status == RINGIO_SUCCESS)
+			|| (status == RINGIO_SPENDINGATTRIBUTE)) {
+			acked = (type == (Uint16) RINGIO_DATA_RESIZE) ? TRUE : FALSE;
+			status = DSP_SOK;
+		}
+		else if (status == RINGIO_EVARIABLEATTRIBUTE) {
+			vAttrSize = sizeof (vAttr);
+			RingIO_getvAttribute (chnl->readerHandle,
+					&type,
+					&param,
+					vAttr,
+					&vAttrSize);
+			status = DSP_SOK;
+		}
+		else if (status == RINGIO_EPENDINGDATA) {
+			/* Drops the data up to the next attribute */
+			status = RingIO_flush (chnl->readerHandle,
+					FALSE,
+					&type,
+					&param,
+					&bytesFlushed);
+		}
+		else {
+			now = RING_IO_GetTimeUsec ();
+			if (now >= deadline) {
+				status = DSP_ETIMEOUT;
+			}
+			else {
+				status = RING_IO_ChnlReaderWait (chnl,
+						(Uint32) (deadline - now));
+				if (status == DSP_ETIMEOUT) {
+					/* Checks the RingIO a last time */
+					status = DSP_SOK;
+				}
+			}
+		}
+	}
+
+	return (status);
+}
+
+#if defined (__cplusplus)
+}
+#endif /* defined (__cplusplus) */
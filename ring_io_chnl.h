@@ -0,0 +1,1272 @@
+/** ============================================================================
+ *  @file   ring_io_chnl.h
+ *
+ *  @path   $(DSPLINK)/gpp/src/samples/ring_io/
+ *
+ *  @desc   Defines the channel abstraction of the ring_io application.
+ *          A channel is the pair of RingIOs used for one GPP<->DSP data path:
+ *          the RingIO created by the GPP and written by it, and the RingIO
+ *          created by the DSP and read by the GPP.
+ *
+ *  @ver    1.65.00.02
+ *  ============================================================================
+ *  Copyright (C) 2002-2009, Texas Instruments Incorporated -
+ *  http://www.ti.com/
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions
+ *  are met:
+ *  
+ *  *  Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *  
+ *  *  Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer in the
+ *     documentation and/or other materials provided with the distribution.
+ *  
+ *  *  Neither the name of Texas Instruments Incorporated nor the names of
+ *     its contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *  
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ *  THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ *  PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+ *  CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ *  EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ *  PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ *  OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ *  WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ *  OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ *  EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *  ============================================================================
+ */
+
+
+#if !defined (RING_IO_CHNL_H)
+#define RING_IO_CHNL_H
+
+
+/*  ----------------------------------- DSP/BIOS Link                 */
+#include <dsplink.h>
+
+/*  ----------------------------------- DSP/BIOS LINK API             */
+#include <ringio.h>
+
+/*  ----------------------------------- Application Header            */
+#include <ring_io.h>
+#include <ring_io_os.h>
+
+
+#if defined (__cplusplus)
+extern "C" {
+#endif /* defined (__cplusplus) */
+
+
+/** ============================================================================
+ *  @const  RING_IO_NUM_CHNLS
+ *
+ *  @desc   Number of channels exchanged with the DSP executable.
+ *  ============================================================================
+ */
+#define RING_IO_NUM_CHNLS       2u
+
+/** ============================================================================
+ *  @const  RING_IO_SEQ_WINDOW
+ *
+ *  @desc   Number of sequence numbers below the highest one received that
+ *          are remembered to tell duplicate records from late ones.
+ *  ============================================================================
+ */
+#define RING_IO_SEQ_WINDOW      64u
+
+/** ============================================================================
+ *  @const  RING_IO_CHNL_INLINE_MAX
+ *
+ *  @desc   Largest piece of data handled in the reader notification in
+ *          inline mode. Larger ones are left to the reader thread.
+ *  ============================================================================
+ */
+#define RING_IO_CHNL_INLINE_MAX     256u
+
+/** ============================================================================
+ *  @const  RING_IO_CHNL_INLINE_SLOTS
+ *
+ *  @desc   Number of pieces of data the reader notification can queue for
+ *          the reader thread in inline mode. A power of two.
+ *  ============================================================================
+ */
+#define RING_IO_CHNL_INLINE_SLOTS   8u
+
+/** ============================================================================
+ *  @const  RING_IO_CHNL_STAGE_SIZE
+ *
+ *  @desc   Size of the staging buffer of the reader, and of the pieces an
+ *          acquired reader buffer is drained in when staged without a
+ *          prefetch distance.
+ *  ============================================================================
+ */
+#define RING_IO_CHNL_STAGE_SIZE     4096u
+
+/** ============================================================================
+ *  @const  RING_IO_CHNL_FILL_BUFS
+ *
+ *  @desc   Number of staging buffers of the writer in fill-ahead mode: one
+ *          is filled while the other is copied to the writer RingIO.
+ *  ============================================================================
+ */
+#define RING_IO_CHNL_FILL_BUFS      2u
+
+/** ============================================================================
+ *  @const  RING_IO_CHNL_OCC_PERIOD
+ *
+ *  @desc   Number of records written between two samples of the occupancy
+ *          of the writer RingIO.
+ *  ============================================================================
+ */
+#define RING_IO_CHNL_OCC_PERIOD     16u
+
+/** ============================================================================
+ *  @const  RING_IO_RESIZE_POOL_ID
+ *
+ *  @desc   ID of the pool the RingIOs of a resized channel are allocated
+ *          from, on both sides. Its buffers are not matched exactly, so
+ *          that any size up to RING_IO_RESIZE_MAX_SIZE fits.
+ *  ============================================================================
+ */
+#define RING_IO_RESIZE_POOL_ID      2u
+
+/** ============================================================================
+ *  @const  RING_IO_RESIZE_MAX_SIZE
+ *
+ *  @desc   Largest data or attribute buffer size of a resized RingIO.
+ *  ============================================================================
+ */
+#define RING_IO_RESIZE_MAX_SIZE     16384u
+
+/** ============================================================================
+ *  @const  RING_IO_RESIZE_TIMEOUT
+ *
+ *  @desc   Time in microseconds the DSP is given to acknowledge a resize.
+ *  ============================================================================
+ */
+#define RING_IO_RESIZE_TIMEOUT      2000000u
+
+
+/** ============================================================================
+ *  @name   RING_IO_ChnlFillFxn
+ *
+ *  @desc   Signature of the function used by RING_IO_ChnlWrite () to produce
+ *          data directly into an acquired writer buffer. In fill-ahead mode,
+ *          it is called from a thread of its own and fills a staging buffer
+ *          instead.
+ *
+ *  @arg    arg
+ *              Argument passed to RING_IO_ChnlWrite ().
+ *  @arg    buffer
+ *              Acquired RingIO buffer or staging buffer to be filled.
+ *  @arg    size
+ *              Size of the buffer.
+ *  @arg    filled
+ *              Location to receive the number of bytes produced. Zero
+ *              indicates end of data.
+ *  ============================================================================
+ */
+typedef DSP_STATUS (*RING_IO_ChnlFillFxn) (IN  Pvoid         arg,
+                                           IN  RingIO_BufPtr buffer,
+                                           IN  Uint32        size,
+                                           OUT Uint32 *      filled) ;
+
+/** ============================================================================
+ *  @name   RING_IO_ChnlDrainFxn
+ *
+ *  @desc   Signature of the function used by RING_IO_ChnlRead () to consume
+ *          data directly from an acquired reader buffer.
+ *
+ *  @arg    arg
+ *              Argument passed to RING_IO_ChnlRead ().
+ *  @arg    buffer
+ *              Acquired RingIO buffer holding the received data.
+ *  @arg    size
+ *              Number of valid bytes in the buffer.
+ *  ============================================================================
+ */
+typedef DSP_STATUS (*RING_IO_ChnlDrainFxn) (IN Pvoid         arg,
+                                            IN RingIO_BufPtr buffer,
+                                            IN Uint32        size) ;
+
+/** ============================================================================
+ *  @name   RING_IO_ChnlInlineFxn
+ *
+ *  @desc   Signature of the handler called in the reader notification in
+ *          inline mode. It must not block.
+ *
+ *  @arg    arg
+ *              Argument passed to RING_IO_ChnlSetInline ().
+ *  @arg    buffer
+ *              Acquired RingIO buffer holding the received data.
+ *  @arg    size
+ *              Number of valid bytes in the buffer.
+ *
+ *  @ret    DSP_SOK
+ *              The data was consumed.
+ *          Any failure
+ *              The data would take too long to consume. It is queued to the
+ *              reader thread, which consumes it with its drain function.
+ *  ============================================================================
+ */
+typedef DSP_STATUS (*RING_IO_ChnlInlineFxn) (IN Pvoid         arg,
+                                             IN RingIO_BufPtr buffer,
+                                             IN Uint32        size) ;
+
+/** ============================================================================
+ *  @name   RING_IO_ChnlInlineStats
+ *
+ *  @desc   Work done by the reader notification in inline mode.
+ *
+ *  @field  records
+ *              Number of pieces of data consumed by the inline handler.
+ *  @field  bytes
+ *              Number of bytes consumed by the inline handler.
+ *  @field  queued
+ *              Number of pieces of data queued to the reader thread.
+ *  @field  handoffs
+ *              Number of times data was left in the RingIO for the reader
+ *              thread, as too large or with the queue full.
+ *  ============================================================================
+ */
+typedef struct RING_IO_ChnlInlineStats_tag {
+    RING_IO_Uint64   records ;
+    RING_IO_Uint64   bytes ;
+    RING_IO_Uint64   queued ;
+    RING_IO_Uint64   handoffs ;
+} RING_IO_ChnlInlineStats ;
+
+/** ============================================================================
+ *  @name   RING_IO_ChnlSeqStats
+ *
+ *  @desc   Sequence number checks of the records received in a transfer.
+ *
+ *  @field  records
+ *              Number of records received with a sequence number.
+ *  @field  missing
+ *              Number of sequence numbers skipped and not received since.
+ *  @field  duplicates
+ *              Number of records received twice.
+ *  @field  reordered
+ *              Number of records received after a higher sequence number.
+ *  ============================================================================
+ */
+typedef struct RING_IO_ChnlSeqStats_tag {
+    RING_IO_Uint64   records ;
+    RING_IO_Uint64   missing ;
+    RING_IO_Uint64   duplicates ;
+    RING_IO_Uint64   reordered ;
+} RING_IO_ChnlSeqStats ;
+
+/** ============================================================================
+ *  @name   RING_IO_ChnlPoolStats
+ *
+ *  @desc   Leases of one side of a channel from the channel pool.
+ *
+ *  @field  leases
+ *              Number of leases.
+ *  @field  hits
+ *              Number of leases served by a RingIO already open.
+ *  @field  setupSum
+ *              Sum of the setup times of the leases in microseconds.
+ *  @field  setupMax
+ *              Largest of these times.
+ *  ============================================================================
+ */
+typedef struct RING_IO_ChnlPoolStats_tag {
+    RING_IO_Uint64   leases ;
+    RING_IO_Uint64   hits ;
+    RING_IO_Uint64   setupSum ;
+    RING_IO_Uint64   setupMax ;
+} RING_IO_ChnlPoolStats ;
+
+/** ============================================================================
+ *  @name   RING_IO_ChnlTuneStats
+ *
+ *  @desc   Counters of a channel sampled by the ring size tuner. They only
+ *          grow, the tuner works on their differences.
+ *
+ *  @field  bytes
+ *              Number of bytes written.
+ *  @field  writerWaits
+ *              Number of times the writer waited for room.
+ *  @field  writerWaitTime
+ *              Time in microseconds the writer waited for room.
+ *  @field  occupancySum
+ *              Sum of the samples of the number of bytes in the writer
+ *              RingIO.
+ *  @field  occupancySamples
+ *              Number of these samples.
+ *  @field  readerWaits
+ *              Number of times the reader waited for data, on the cache
+ *              line of the reader.
+ *  @field  readerWaitTime
+ *              Time in microseconds the reader waited for data.
+ *  @field  notifies
+ *              Number of notifications received on both RingIOs, on the
+ *              cache line of the notifications.
+ *  ============================================================================
+ */
+typedef struct RING_IO_ChnlTuneStats_tag {
+    volatile RING_IO_Uint64  bytes ;
+    volatile RING_IO_Uint64  writerWaits ;
+    volatile RING_IO_Uint64  writerWaitTime ;
+    volatile RING_IO_Uint64  occupancySum ;
+    volatile RING_IO_Uint64  occupancySamples ;
+    volatile RING_IO_Uint64  readerWaits RING_IO_CACHE_ALIGN ;
+    volatile RING_IO_Uint64  readerWaitTime ;
+    volatile RING_IO_Uint64  notifies RING_IO_CACHE_ALIGN ;
+} RING_IO_ChnlTuneStats ;
+
+/** ============================================================================
+ *  @name   RING_IO_ChnlObj
+ *
+ *  @desc   Structure holding the state of one channel. The fields are
+ *          grouped by who writes them while data flows, each group
+ *          starting on its own cache line so that the writer client, the
+ *          reader client and the reader notification do not invalidate
+ *          each other's lines: first the fields set up before a transfer,
+ *          then those of the writer, of the reader, of the notification,
+ *          and the buffers.
+ *
+ *  @field  id
+ *              Index of the channel.
+ *  @field  writerName
+ *              Name of the RingIO written by the GPP.
+ *  @field  readerName
+ *              Name of the RingIO read by the GPP.
+ *  @field  writerBufSize
+ *              Size of the data buffer of the writer RingIO.
+ *  @field  readerBufSize
+ *              Size of the data buffer of the reader RingIO.
+ *  @field  readerNewSize
+ *              Size the reader RingIO must have when next opened, 0 if any.
+ *              Set by a resize until the DSP has recreated the RingIO.
+ *  @field  writerAcqSize
+ *              Size of each acquire on the writer RingIO. It is also used as
+ *              the watermark of the writer notification if writerWatermark
+ *              is 0.
+ *  @field  writerWatermark
+ *              Watermark of the writer notification, 0 for the acquire
+ *              size.
+ *  @field  writerNotifyType
+ *              Type of the writer notification.
+ *  @field  xferMode
+ *              Parameter of the RINGIO_DATA_START attribute, RING_IO_XFER_*.
+ *  @field  writerHandle
+ *              Handle to the RingIO opened in writer mode.
+ *  @field  readerHandle
+ *              Handle to the RingIO opened in reader mode.
+ *  @field  semWriter
+ *              Semaphore posted by the writer notification.
+ *  @field  semReader
+ *              Semaphore posted by the reader notification.
+ *  @field  inlineFxn
+ *              Handler of the inline mode, NULL if the mode is off.
+ *  @field  inlineArg
+ *              Argument of the handler.
+ *  @field  readerPrefetch
+ *              Size of the pieces an acquired reader buffer is drained in,
+ *              each prefetched while the previous one is drained. 0 not to
+ *              prefetch.
+ *  @field  readerStage
+ *              Set if the pieces are copied to readerStageBuf before being
+ *              drained.
+ *  @field  writerFillAhead
+ *              Set if the fill function runs in a thread of its own, one
+ *              record ahead of the writer.
+ *  @field  writerSeq
+ *              Sequence number of the next record written.
+ *  @field  writerAttrSize
+ *              Size in bytes of the variable attribute of the records of the
+ *              transfer being written, see RING_IO_XFER_VATTR_EXT.
+ *  @field  readerSeq
+ *              Sequence number following the highest one received.
+ *  @field  readerSeqMask
+ *              Bit n is set if sequence number readerSeq - 1 - n has been
+ *              received, for the last RING_IO_SEQ_WINDOW sequence numbers.
+ *  @field  seqStats
+ *              Sequence number checks of the last transfer read.
+ *  @field  readerRemain
+ *              Number of bytes left in the record being read.
+ *  @field  readerBytes
+ *              Number of bytes read in the transfer.
+ *  @field  readerDone
+ *              Set when the RINGIO_DATA_END attribute has been read.
+ *  @field  inlineTail
+ *              Number of pieces of data consumed by the reader thread.
+ *  @field  readerPending
+ *              RING_IO_EVENT_* taken by the reader thread and not yet acted
+ *              on.
+ *  @field  readerEvents
+ *              RING_IO_EVENT_* notified by the DSP and not yet taken by the
+ *              reader thread.
+ *  @field  readerOwner
+ *              Non zero while the reader RingIO is being read. Owned by the
+ *              reader thread except while it waits in inline mode.
+ *  @field  inlineHead
+ *              Number of pieces of data queued by the reader notification.
+ *  @field  inlineLens
+ *              Sizes of the queued pieces of data.
+ *  @field  inlineStats
+ *              Work done in inline mode.
+ *  @field  inlineData
+ *              Queued pieces of data.
+ *  @field  readerStageBuf
+ *              Staging buffer of the reader.
+ *  ============================================================================
+ */
+typedef struct RING_IO_ChnlObj_tag {
+    Uint32           id ;
+    Char8 *          writerName ;
+    Char8 *          readerName ;
+    Uint32           writerBufSize ;
+    Uint32           readerBufSize ;
+    Uint32           readerNewSize ;
+    Uint32           writerAcqSize ;
+    Uint32           writerWatermark ;
+    RingIO_NotifyType writerNotifyType ;
+    Uint32           xferMode ;
+    RingIO_Handle    writerHandle ;
+    RingIO_Handle    readerHandle ;
+    Pvoid            semWriter ;
+    Pvoid            semReader ;
+    RING_IO_ChnlInlineFxn inlineFxn ;
+    Pvoid            inlineArg ;
+    Uint32           readerPrefetch ;
+    Uint32           readerStage ;
+    Uint32           writerFillAhead ;
+    RING_IO_Uint64   writerSeq RING_IO_CACHE_ALIGN ;
+    Uint32           writerAttrSize ;
+    RING_IO_Uint64   readerSeq RING_IO_CACHE_ALIGN ;
+    RING_IO_Uint64   readerSeqMask ;
+    RING_IO_ChnlSeqStats seqStats ;
+    Uint32           readerRemain ;
+    RING_IO_Uint64   readerBytes ;
+    volatile Uint32  readerDone ;
+    volatile Uint32  inlineTail ;
+    Uint32           readerPending ;
+    volatile Uint32  readerEvents RING_IO_CACHE_ALIGN ;
+    volatile Uint32  readerOwner ;
+    volatile Uint32  inlineHead ;
+    Uint32           inlineLens [RING_IO_CHNL_INLINE_SLOTS] ;
+    RING_IO_ChnlInlineStats inlineStats ;
+    Uint8            inlineData [RING_IO_CHNL_INLINE_SLOTS]
+                                [RING_IO_CHNL_INLINE_MAX] RING_IO_CACHE_ALIGN ;
+    Uint8            readerStageBuf [RING_IO_CHNL_STAGE_SIZE]
+                                    RING_IO_CACHE_ALIGN ;
+} RING_IO_ChnlObj ;
+
+
+/** ============================================================================
+ *  @func   RING_IO_ChnlInit
+ *
+ *  @desc   Initializes a channel object. No RingIO is opened.
+ *
+ *  @arg    chnl
+ *              Channel object to be initialized.
+ *  @arg    id
+ *              Index of the channel.
+ *  @arg    writerName
+ *              Name of the RingIO written by the GPP.
+ *  @arg    readerName
+ *              Name of the RingIO read by the GPP.
+ *  @arg    writerBufSize
+ *              Size of the data buffer of the writer RingIO.
+ *  @arg    readerBufSize
+ *              Size of the data buffer of the reader RingIO.
+ *
+ *  @ret    None
+ *
+ *  @enter  None
+ *
+ *  @leave  None
+ *
+ *  @see    RING_IO_ChnlOpenWriter, RING_IO_ChnlOpenReader
+ *  ============================================================================
+ */
+NORMAL_API
+Void
+RING_IO_ChnlInit (IN RING_IO_ChnlObj * chnl,
+                  IN Uint32            id,
+                  IN Char8 *           writerName,
+                  IN Char8 *           readerName,
+                  IN Uint32            writerBufSize,
+                  IN Uint32            readerBufSize) ;
+
+/** ============================================================================
+ *  @func   RING_IO_ChnlOpenWriter
+ *
+ *  @desc   Opens the writer RingIO of the channel and registers its
+ *          notification.
+ *
+ *  @arg    chnl
+ *              Channel object.
+ *
+ *  @ret    DSP_SOK
+ *              Operation successfully completed.
+ *          RINGIO_EFAILURE
+ *              The RingIO could not be opened.
+ *          DSP_EFAIL
+ *              General failure.
+ *
+ *  @enter  The channel has been initialized with RING_IO_ChnlInit ().
+ *
+ *  @leave  None
+ *
+ *  @see    RING_IO_ChnlCloseWriter
+ *  ============================================================================
+ */
+NORMAL_API
+DSP_STATUS
+RING_IO_ChnlOpenWriter (IN RING_IO_ChnlObj * chnl) ;
+
+/** ============================================================================
+ *  @func   RING_IO_ChnlCloseWriter
+ *
+ *  @desc   Waits for the DSP to consume the writer RingIO and closes it.
+ *
+ *  @arg    chnl
+ *              Channel object.
+ *
+ *  @ret    DSP_SOK
+ *              Operation successfully completed.
+ *          DSP_EFAIL
+ *              General failure.
+ *
+ *  @enter  None
+ *
+ *  @leave  None
+ *
+ *  @see    RING_IO_ChnlOpenWriter
+ *  ============================================================================
+ */
+NORMAL_API
+DSP_STATUS
+RING_IO_ChnlCloseWriter (IN RING_IO_ChnlObj * chnl) ;
+
+/** ============================================================================
+ *  @func   RING_IO_ChnlOpenReader
+ *
+ *  @desc   Opens the reader RingIO of the channel, once created by the DSP,
+ *          and registers its notification.
+ *
+ *  @arg    chnl
+ *              Channel object.
+ *
+ *  @ret    DSP_SOK
+ *              Operation successfully completed.
+ *          DSP_EFAIL
+ *              General failure.
+ *
+ *  @enter  The channel has been initialized with RING_IO_ChnlInit ().
+ *
+ *  @leave  None
+ *
+ *  @see    RING_IO_ChnlCloseReader
+ *  ============================================================================
+ */
+NORMAL_API
+DSP_STATUS
+RING_IO_ChnlOpenReader (IN RING_IO_ChnlObj * chnl) ;
+
+/** ============================================================================
+ *  @func   RING_IO_ChnlCloseReader
+ *
+ *  @desc   Closes the reader RingIO of the channel.
+ *
+ *  @arg    chnl
+ *              Channel object.
+ *
+ *  @ret    DSP_SOK
+ *              Operation successfully completed.
+ *          DSP_EFAIL
+ *              General failure.
+ *
+ *  @enter  None
+ *
+ *  @leave  None
+ *
+ *  @see    RING_IO_ChnlOpenReader
+ *  ============================================================================
+ */
+NORMAL_API
+DSP_STATUS
+RING_IO_ChnlCloseReader (IN RING_IO_ChnlObj * chnl) ;
+
+/** ============================================================================
+ *  @func   RING_IO_ChnlWriteStart
+ *
+ *  @desc   Inserts the RINGIO_DATA_START attribute, with xferMode as its
+ *          parameter, and notifies the DSP. RING_IO_XFER_VATTR_EXT is added
+ *          to the parameter, and the records of the transfer carry the
+ *          extended variable attribute, if the DSP announced it.
+ *
+ *  @arg    chnl
+ *              Channel object with the writer opened.
+ *
+ *  @ret    DSP_SOK
+ *              Operation successfully completed.
+ *          DSP_EFAIL
+ *              General failure.
+ *
+ *  @enter  None
+ *
+ *  @leave  None
+ *
+ *  @see    RING_IO_ChnlWrite, RING_IO_ChnlWriteEnd
+ *  ============================================================================
+ */
+NORMAL_API
+DSP_STATUS
+RING_IO_ChnlWriteStart (IN RING_IO_ChnlObj * chnl) ;
+
+/** ============================================================================
+ *  @func   RING_IO_ChnlWrite
+ *
+ *  @desc   Writes data to the DSP until the fill function signals end of data.
+ *          Every acquired buffer is handed to the fill function, which
+ *          produces the data in place, and is preceded by a variable
+ *          attribute holding the number of bytes filled. In fill-ahead
+ *          mode, the fill function produces each record in a staging buffer
+ *          from a thread of its own while the previous record is copied to
+ *          the RingIO, so that the RingIO is fed while the data is produced.
+ *
+ *  @arg    chnl
+ *              Channel object with the writer opened.
+ *  @arg    fillFxn
+ *              Function producing the data.
+ *  @arg    arg
+ *              Argument for the fill function.
+ *  @arg    bytesWritten
+ *              Location to receive the number of bytes written. May be NULL.
+ *
+ *  @ret    DSP_SOK
+ *              Operation successfully completed.
+ *          DSP_EMEMORY
+ *              Out of memory for the staging buffers.
+ *          DSP_EFAIL
+ *              General failure.
+ *
+ *  @enter  RING_IO_ChnlWriteStart () has been called.
+ *
+ *  @leave  None
+ *
+ *  @see    RING_IO_ChnlWriteEnd
+ *  ============================================================================
+ */
+NORMAL_API
+DSP_STATUS
+RING_IO_ChnlWrite (IN  RING_IO_ChnlObj *   chnl,
+                   IN  RING_IO_ChnlFillFxn fillFxn,
+                   IN  Pvoid               arg,
+                   OUT RING_IO_Uint64 *    bytesWritten) ;
+
+/** ============================================================================
+ *  @func   RING_IO_ChnlWriteEnd
+ *
+ *  @desc   Inserts the RINGIO_DATA_END attribute and notifies the DSP.
+ *
+ *  @arg    chnl
+ *              Channel object with the writer opened.
+ *
+ *  @ret    DSP_SOK
+ *              Operation successfully completed.
+ *          DSP_EFAIL
+ *              General failure.
+ *
+ *  @enter  None
+ *
+ *  @leave  None
+ *
+ *  @see    RING_IO_ChnlWriteStart
+ *  ============================================================================
+ */
+NORMAL_API
+DSP_STATUS
+RING_IO_ChnlWriteEnd (IN RING_IO_ChnlObj * chnl) ;
+
+/** ============================================================================
+ *  @func   RING_IO_ChnlWriterWait
+ *
+ *  @desc   Waits for the writer notification, posted when the DSP has freed
+ *          room in the writer RingIO, accounting for the wait in the
+ *          statistics of the tuner.
+ *
+ *  @arg    chnl
+ *              Channel object with the writer opened.
+ *
+ *  @ret    DSP_SOK
+ *              Operation successfully completed.
+ *          DSP_EFAIL
+ *              General failure.
+ *
+ *  @enter  An acquire on the writer RingIO failed, which arms the writer
+ *          notification.
+ *
+ *  @leave  None
+ *
+ *  @see    RING_IO_ChnlGetTuneStats
+ *  ============================================================================
+ */
+NORMAL_API
+DSP_STATUS
+RING_IO_ChnlWriterWait (IN RING_IO_ChnlObj * chnl) ;
+
+/** ============================================================================
+ *  @func   RING_IO_ChnlRead
+ *
+ *  @desc   Reads one data transfer from the DSP, from the RINGIO_DATA_START
+ *          to the RINGIO_DATA_END attribute. Every acquired buffer is handed
+ *          to the drain function before it is released.
+ *          The sequence numbers returned by the DSP are checked on the fly
+ *          into the seqStats of the channel.
+ *          In inline mode, the data the reader notification queued is
+ *          handed to the drain function in order with the rest.
+ *
+ *  @arg    chnl
+ *              Channel object with the reader opened.
+ *  @arg    drainFxn
+ *              Function consuming the data. May be NULL to discard it.
+ *  @arg    arg
+ *              Argument for the drain function.
+ *  @arg    bytesRead
+ *              Location to receive the number of bytes read. May be NULL.
+ *
+ *  @ret    DSP_SOK
+ *              Operation successfully completed.
+ *          DSP_EFAIL
+ *              General failure, or the drain function failed.
+ *
+ *  @enter  None
+ *
+ *  @leave  None
+ *
+ *  @see    RING_IO_ChnlSetInline
+ *  ============================================================================
+ */
+NORMAL_API
+DSP_STATUS
+RING_IO_ChnlRead (IN  RING_IO_ChnlObj *    chnl,
+                  IN  RING_IO_ChnlDrainFxn drainFxn,
+                  IN  Pvoid                arg,
+                  OUT RING_IO_Uint64 *     bytesRead) ;
+
+/** ============================================================================
+ *  @func   RING_IO_ChnlSetInline
+ *
+ *  @desc   Turns the inline mode of the reader on or off.
+ *          In inline mode, while the reader thread waits for data in
+ *          RING_IO_ChnlRead (), the reader notification reads the RingIO
+ *          itself and hands pieces of data of up to RING_IO_CHNL_INLINE_MAX
+ *          bytes to the handler, without waking the thread. Larger pieces
+ *          are left to the thread. Pieces the handler refuses are copied to
+ *          a lock-free queue drained by the thread.
+ *
+ *  @arg    chnl
+ *              Channel object.
+ *  @arg    inlineFxn
+ *              Handler of the inline mode, NULL to turn it off.
+ *  @arg    arg
+ *              Argument for the handler.
+ *
+ *  @ret    None
+ *
+ *  @enter  No transfer is being read on the channel.
+ *
+ *  @leave  None
+ *
+ *  @see    RING_IO_ChnlRead, RING_IO_ChnlInlineReport
+ *  ============================================================================
+ */
+NORMAL_API
+Void
+RING_IO_ChnlSetInline (IN RING_IO_ChnlObj *      chnl,
+                       IN RING_IO_ChnlInlineFxn inlineFxn,
+                       IN Pvoid                 arg) ;
+
+/** ============================================================================
+ *  @func   RING_IO_ChnlInlineReport
+ *
+ *  @desc   Prints the work done by the reader notification in inline mode.
+ *
+ *  @arg    chnl
+ *              Channel object.
+ *
+ *  @ret    None
+ *
+ *  @enter  None
+ *
+ *  @leave  None
+ *
+ *  @see    RING_IO_ChnlSetInline
+ *  ============================================================================
+ */
+NORMAL_API
+Void
+RING_IO_ChnlInlineReport (IN RING_IO_ChnlObj * chnl) ;
+
+/** ============================================================================
+ *  @func   RING_IO_ChnlSeqReport
+ *
+ *  @desc   Prints the sequence number checks of the last transfer read.
+ *
+ *  @arg    chnl
+ *              Channel object.
+ *
+ *  @ret    DSP_SOK
+ *              No record was missing, duplicated or reordered.
+ *          DSP_EFAIL
+ *              The transfer was not received in sequence.
+ *
+ *  @enter  None
+ *
+ *  @leave  None
+ *
+ *  @see    RING_IO_ChnlRead
+ *  ============================================================================
+ */
+NORMAL_API
+DSP_STATUS
+RING_IO_ChnlSeqReport (IN RING_IO_ChnlObj * chnl) ;
+
+/** ============================================================================
+ *  @func   RING_IO_ChnlPoolInit
+ *
+ *  @desc   Initializes the channel pool, which keeps the RingIOs of the
+ *          channels open between the sessions that lease them. Its
+ *          statistics are shared with the clients created afterwards.
+ *
+ *  @arg    None
+ *
+ *  @ret    DSP_SOK
+ *              Operation successfully completed.
+ *          DSP_EMEMORY
+ *              Out of memory.
+ *
+ *  @enter  None
+ *
+ *  @leave  None
+ *
+ *  @see    RING_IO_ChnlPoolExit
+ *  ============================================================================
+ */
+NORMAL_API
+DSP_STATUS
+RING_IO_ChnlPoolInit (Void) ;
+
+/** ============================================================================
+ *  @func   RING_IO_ChnlPoolExit
+ *
+ *  @desc   Closes the RingIOs still held by the channel pool and frees it.
+ *
+ *  @arg    chnls
+ *              Array of channel objects.
+ *  @arg    numChnls
+ *              Number of channel objects.
+ *
+ *  @ret    None
+ *
+ *  @enter  No channel is leased.
+ *
+ *  @leave  None
+ *
+ *  @see    RING_IO_ChnlPoolInit
+ *  ============================================================================
+ */
+NORMAL_API
+Void
+RING_IO_ChnlPoolExit (IN RING_IO_ChnlObj * chnls, IN Uint32 numChnls) ;
+
+/** ============================================================================
+ *  @func   RING_IO_ChnlLeaseWriter
+ *
+ *  @desc   Leases the writer RingIO of the channel from the channel pool.
+ *          The RingIO left open by the last session is reused, its
+ *          notification being registered again only if the channel object
+ *          or its acquire size changed. Otherwise the RingIO is opened.
+ *          The writer settings last published are taken first.
+ *
+ *  @arg    chnl
+ *              Channel object.
+ *
+ *  @ret    DSP_SOK
+ *              Operation successfully completed.
+ *          DSP_EFAIL
+ *              General failure.
+ *
+ *  @enter  writerAcqSize of the channel has been published, or set if the
+ *          channel was never published.
+ *
+ *  @leave  None
+ *
+ *  @see    RING_IO_ChnlReturnWriter, RING_IO_ChnlOpenWriter,
+ *          RING_IO_ChnlPublish
+ *  ============================================================================
+ */
+NORMAL_API
+DSP_STATUS
+RING_IO_ChnlLeaseWriter (IN RING_IO_ChnlObj * chnl) ;
+
+/** ============================================================================
+ *  @func   RING_IO_ChnlReturnWriter
+ *
+ *  @desc   Returns the writer RingIO of the channel to the channel pool,
+ *          which keeps it open. The data left in it is still read by the
+ *          DSP. Multiprocess builds close it, as a RingIO handle is only
+ *          valid in the process that opened it.
+ *
+ *  @arg    chnl
+ *              Channel object.
+ *
+ *  @ret    DSP_SOK
+ *              Operation successfully completed.
+ *          DSP_EFAIL
+ *              General failure.
+ *
+ *  @enter  The writer RingIO was leased.
+ *
+ *  @leave  None
+ *
+ *  @see    RING_IO_ChnlLeaseWriter
+ *  ============================================================================
+ */
+NORMAL_API
+DSP_STATUS
+RING_IO_ChnlReturnWriter (IN RING_IO_ChnlObj * chnl) ;
+
+/** ============================================================================
+ *  @func   RING_IO_ChnlLeaseReader
+ *
+ *  @desc   Leases the reader RingIO of the channel from the channel pool,
+ *          reusing the RingIO left open by the last session if any. The
+ *          reader settings last published are taken first.
+ *
+ *  @arg    chnl
+ *              Channel object.
+ *
+ *  @ret    DSP_SOK
+ *              Operation successfully completed.
+ *          DSP_EFAIL
+ *              General failure.
+ *
+ *  @enter  None
+ *
+ *  @leave  None
+ *
+ *  @see    RING_IO_ChnlReturnReader, RING_IO_ChnlOpenReader,
+ *          RING_IO_ChnlPublish
+ *  ============================================================================
+ */
+NORMAL_API
+DSP_STATUS
+RING_IO_ChnlLeaseReader (IN RING_IO_ChnlObj * chnl) ;
+
+/** ============================================================================
+ *  @func   RING_IO_ChnlReturnReader
+ *
+ *  @desc   Returns the reader RingIO of the channel to the channel pool.
+ *          The RingIO is flushed of whatever the session left unread and
+ *          kept open. Multiprocess builds close it.
+ *
+ *  @arg    chnl
+ *              Channel object.
+ *
+ *  @ret    DSP_SOK
+ *              Operation successfully completed.
+ *          DSP_EFAIL
+ *              General failure.
+ *
+ *  @enter  The reader RingIO was leased.
+ *
+ *  @leave  None
+ *
+ *  @see    RING_IO_ChnlLeaseReader
+ *  ============================================================================
+ */
+NORMAL_API
+DSP_STATUS
+RING_IO_ChnlReturnReader (IN RING_IO_ChnlObj * chnl) ;
+
+/** ============================================================================
+ *  @func   RING_IO_ChnlPoolReport
+ *
+ *  @desc   Prints the setup time and the hit rate of the leases of the
+ *          channel.
+ *
+ *  @arg    chnl
+ *              Channel object.
+ *
+ *  @ret    None
+ *
+ *  @enter  None
+ *
+ *  @leave  None
+ *
+ *  @see    RING_IO_ChnlLeaseWriter, RING_IO_ChnlLeaseReader
+ *  ============================================================================
+ */
+NORMAL_API
+Void
+RING_IO_ChnlPoolReport (IN RING_IO_ChnlObj * chnl) ;
+
+/** ============================================================================
+ *  @func   RING_IO_ChnlGetTuneStats
+ *
+ *  @desc   Gets the counters of the channel sampled by the ring size tuner,
+ *          which are shared between the clients.
+ *
+ *  @arg    chnl
+ *              Channel object.
+ *
+ *  @ret    The counters, NULL if the channel pool is not initialized.
+ *
+ *  @enter  None
+ *
+ *  @leave  None
+ *
+ *  @see    RING_IO_ChnlPoolInit
+ *  ============================================================================
+ */
+NORMAL_API
+RING_IO_ChnlTuneStats *
+RING_IO_ChnlGetTuneStats (IN RING_IO_ChnlObj * chnl) ;
+
+/** ============================================================================
+ *  @func   RING_IO_ChnlPublish
+ *
+ *  @desc   Publishes the sizes, acquire size, notification and read settings
+ *          of the channel in the channel pool. Each lease of a side of the
+ *          channel takes the settings of that side last published, so that
+ *          a client process, which has its own copy of the channel object,
+ *          sees the changes made after it was forked.
+ *          RING_IO_ChnlResize () and RING_IO_ChnlConfigure () publish the
+ *          settings they change.
+ *
+ *  @arg    chnl
+ *              Channel object.
+ *
+ *  @ret    None
+ *
+ *  @enter  No client holds the RingIOs of the channel.
+ *
+ *  @leave  None
+ *
+ *  @see    RING_IO_ChnlLeaseWriter, RING_IO_ChnlLeaseReader
+ *  ============================================================================
+ */
+NORMAL_API
+Void
+RING_IO_ChnlPublish (IN RING_IO_ChnlObj * chnl) ;
+
+/** ============================================================================
+ *  @func   RING_IO_ChnlResize
+ *
+ *  @desc   Changes the sizes of the RingIOs of the channel without reloading
+ *          the DSP. The RingIOs held by the channel pool are closed once the
+ *          DSP has consumed them, the new sizes are sent to the DSP in a
+ *          RINGIO_DATA_RESIZE attribute and, once it acknowledges them, the
+ *          writer RingIO is deleted and created again from the pool
+ *          RING_IO_RESIZE_POOL_ID. The DSP recreates the reader RingIO,
+ *          which the next RING_IO_ChnlOpenReader () waits for. The acquire
+ *          size is reduced to the new writer size if larger.
+ *
+ *  @arg    chnl
+ *              Channel object.
+ *  @arg    processorId
+ *              ID of the DSP processor.
+ *  @arg    writerBufSize
+ *              New data buffer size of the writer RingIO.
+ *  @arg    readerBufSize
+ *              New data buffer size of the reader RingIO.
+ *  @arg    attrBufSize
+ *              New attribute buffer size of both RingIOs.
+ *
+ *  @ret    DSP_SOK
+ *              Operation successfully completed.
+ *          DSP_EINVALIDARG
+ *              A size is zero or above RING_IO_RESIZE_MAX_SIZE.
+ *          DSP_ETIMEOUT
+ *              The DSP did not acknowledge the new sizes, which are not
+ *              applied.
+ *          DSP_EFAIL
+ *              General failure.
+ *
+ *  @enter  No data transfer is in progress on the channel and no client
+ *          holds its RingIOs.
+ *
+ *  @leave  None
+ *
+ *  @see    RING_IO_ChnlLeaseWriter, RING_IO_ChnlLeaseReader
+ *  ============================================================================
+ */
+NORMAL_API
+DSP_STATUS
+RING_IO_ChnlResize (IN RING_IO_ChnlObj * chnl,
+                    IN Uint8             processorId,
+                    IN Uint32            writerBufSize,
+                    IN Uint32            readerBufSize,
+                    IN Uint32            attrBufSize) ;
+
+/** ============================================================================
+ *  @func   RING_IO_ChnlConfigure
+ *
+ *  @desc   Applies a configuration to the channel, resizing its RingIOs if
+ *          the configuration asks for another size. The prefetch distance
+ *          is capped at RING_IO_CHNL_STAGE_SIZE when the reads are staged.
+ *
+ *  @arg    chnl
+ *              Channel object.
+ *  @arg    processorId
+ *              ID of the DSP processor.
+ *  @arg    attrBufSize
+ *              Attribute buffer size of the RingIOs, kept if they are
+ *              resized.
+ *  @arg    config
+ *              Configuration. Fields left to zero are not changed, except
+ *              notifyAlways, prefetch, stage and fillAhead.
+ *
+ *  @ret    DSP_SOK
+ *              Operation successfully completed.
+ *          DSP_EINVALIDARG
+ *              The ring size is above RING_IO_RESIZE_MAX_SIZE.
+ *          DSP_ETIMEOUT
+ *              The DSP did not acknowledge the new ring size.
+ *          DSP_EFAIL
+ *              General failure.
+ *
+ *  @enter  No data transfer is in progress on the channel and no client
+ *          holds its RingIOs.
+ *
+ *  @leave  None
+ *
+ *  @see    RING_IO_ChnlResize
+ *  ============================================================================
+ */
+NORMAL_API
+DSP_STATUS
+RING_IO_ChnlConfigure (IN RING_IO_ChnlObj * chnl,
+                       IN Uint8             processorId,
+                       IN Uint32            attrBufSize,
+                       IN RING_IO_Config *  config) ;
+
+/** ============================================================================
+ *  @func   RING_IO_ChnlPoolFlush
+ *
+ *  @desc   Closes the RingIOs of the channel kept open by the channel pool,
+ *          so that the next lease opens them again, with semaphores of the
+ *          current synchronization policy.
+ *
+ *  @arg    chnl
+ *              Channel object.
+ *
+ *  @ret    DSP_SOK
+ *              Operation successfully completed.
+ *          DSP_EFAIL
+ *              General failure.
+ *
+ *  @enter  No client holds the RingIOs of the channel.
+ *
+ *  @leave  None
+ *
+ *  @see    RING_IO_ChnlReturnWriter, RING_IO_ChnlReturnReader
+ *  ============================================================================
+ */
+NORMAL_API
+DSP_STATUS
+RING_IO_ChnlPoolFlush (IN RING_IO_ChnlObj * chnl) ;
+
+/** ============================================================================
+ *  @func   RING_IO_ChnlCalibrate
+ *
+ *  @desc   Selects the copy and fill kernels by timing them on the data
+ *          buffer of the writer RingIO of the channel. The buffer is acquired
+ *          and cancelled, so nothing reaches the DSP.
+ *
+ *  @arg    chnl
+ *              Channel object.
+ *
+ *  @ret    DSP_SOK
+ *              Operation successfully completed.
+ *          DSP_EFAIL
+ *              General failure.
+ *
+ *  @enter  The RingIOs of the channel are created and no client holds them.
+ *
+ *  @leave  None
+ *
+ *  @see    RING_IO_CopySelect
+ *  ============================================================================
+ */
+NORMAL_API
+DSP_STATUS
+RING_IO_ChnlCalibrate (IN RING_IO_ChnlObj * chnl) ;
+
+/** ============================================================================
+ *  @func   RING_IO_ChnlShutdown
+ *
+ *  @desc   Sends the NOTIFY_DSP_END notification on the channel, which ends
+ *          the DSP side of the channel. The writer is opened for the duration
+ *          of the call if it is not already open. The RingIOs of the channel
+ *          held by the channel pool are closed.
+ *
+ *  @arg    chnl
+ *              Channel object.
+ *
+ *  @ret    DSP_SOK
+ *              Operation successfully completed.
+ *          DSP_EFAIL
+ *              General failure.
+ *
+ *  @enter  No data transfer is in progress on the channel.
+ *
+ *  @leave  None
+ *
+ *  @see    RING_IO_ChnlShutdownAll
+ *  ============================================================================
+ */
+NORMAL_API
+DSP_STATUS
+RING_IO_ChnlShutdown (IN RING_IO_ChnlObj * chnl) ;
+
+/** ============================================================================
+ *  @func   RING_IO_ChnlShutdownAll
+ *
+ *  @desc   Ends the DSP side of several channels, with a single doorbell for
+ *          all of them if the DSP announced RING_IO_XFER_DOORBELL, else with
+ *          a NOTIFY_DSP_END notification per channel.
+ *
+ *  @arg    chnls
+ *              Array of channel objects.
+ *  @arg    numChnls
+ *              Number of channel objects.
+ *
+ *  @ret    DSP_SOK
+ *              Operation successfully completed.
+ *          DSP_EFAIL
+ *              General failure.
+ *
+ *  @enter  No data transfer is in progress on the channels.
+ *
+ *  @leave  None
+ *
+ *  @see    RING_IO_ChnlShutdown
+ *  ============================================================================
+ */
+NORMAL_API
+DSP_STATUS
+RING_IO_ChnlShutdownAll (IN RING_IO_ChnlObj * chnls, IN Uint32 numChnls) ;
+
+
+#if defined (__cplusplus)
+}
+#endif /* defined (__cplusplus) */
+
+
+#endif /* !defined (RING_IO_CHNL_H) */
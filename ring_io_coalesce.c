@@ -0,0 +1,432 @@
+/** ============================================================================
+ *  @file   ring_io_coalesce.c
+ *
+ *  @path   $(DSPLINK)/gpp/src/samples/ring_io/
+ *
+ *  @desc   Implementation of the coalescer of the ring_io application.
+ *
+ *  @ver    1.65.00.02
+ *  ============================================================================
+ *  Copyright (C) 2002-2009, Texas Instruments Incorporated -
+ *  http://www.ti.com/
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions
+ *  are met:
+ *  
+ *  *  Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *  
+ *  *  Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer in the
+ *     documentation and/or other materials provided with the distribution.
+ *  
+ *  *  Neither the name of Texas Instruments Incorporated nor the names of
+ *     its contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *  
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ *  THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ *  PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+ *  CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ *  EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ *  PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ *  OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ *  WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ *  OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ *  EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *  ============================================================================
+ */
+
+/*  ------------------------ DSP/BIOS Link ----------------------------------*/
+#include <dsplink.h>
+
+/*  ------------------------DSP/BIOS LINK API -------------------------------*/
+#include <ringio.h>
+#include <string.h>
+
+/*  ------------------------ Application Header------------------------------*/
+#include <ring_io.h>
+#include <ring_io_os.h>
+#include <ring_io_chnl.h>
+#include <ring_io_coalesce.h>
+
+
+#if defined (__cplusplus)
+extern "C" {
+#endif /* defined (__cplusplus) */
+
+
+/** ============================================================================
+ *  @macro  RING_IO_COALESCE_TABLE_SIZE
+ *
+ *  @desc   Size of the record table of a batch of n records.
+ *  ============================================================================
+ */
+#define RING_IO_COALESCE_TABLE_SIZE(n)  (((n) + 1u) * sizeof (Uint32))
+
+
+/** ----------------------------------------------------------------------------
+ *  @func   RING_IO_CoalesceSend
+ *
+ *  @desc   Writes one batch to the channel: acquires room for the record
+ *          table and the records, copies them and releases the batch with
+ *          its variable attribute.
+ *
+ *  @arg    coalesce
+ *              Coalescer.
+ *  @arg    lens
+ *              Sizes of the records.
+ *  @arg    numRecords
+ *              Number of records.
+ *  @arg    data
+ *              Records, one after the other.
+ *  @arg    size
+ *              Total size of the records.
+ *
+ *  @modif  offset, stats of the coalescer.
+ *  ----------------------------------------------------------------------------
+ */
+STATIC
+NORMAL_API
+DSP_STATUS
+RING_IO_CoalesceSend (IN RING_IO_CoalesceObj * coalesce,
+		IN Uint32 * lens,
+		IN Uint32 numRecords,
+		IN Uint8 * data,
+		IN Uint32 size);
+
+/** ----------------------------------------------------------------------------
+ *  @func   RING_IO_CoalesceSendPending
+ *
+ *  @desc   Sends the pending records, if any, as one batch.
+ *
+ *  @arg    coalesce
+ *              Coalescer.
+ *  @arg    counter
+ *              Statistic counting the reason of the send.
+ *
+ *  @modif  numRecords, used, stats of the coalescer.
+ *  ----------------------------------------------------------------------------
+ */
+STATIC
+NORMAL_API
+DSP_STATUS
+RING_IO_CoalesceSendPending (IN RING_IO_CoalesceObj * coalesce,
+		IN RING_IO_Uint64 * counter);
+
+
+/** ============================================================================
+ *  @func   RING_IO_CoalesceInit
+ *
+ *  @desc   Initializes a coalescer for a channel.
+ *
+ *  @modif  None
+ *  ============================================================================
+ */
+NORMAL_API
+Void
+RING_IO_CoalesceInit (IN RING_IO_CoalesceObj * coalesce,
+		IN RING_IO_ChnlObj * chnl,
+		IN Uint32 threshold,
+		IN Uint32 deadline)
+{
+	memset (coalesce, 0, sizeof (RING_IO_CoalesceObj));
+	coalesce->chnl = chnl;
+	coalesce->capacity = chnl->writerAcqSize;
+	if (coalesce->capacity > RING_IO_COALESCE_MAX_SIZE) {
+		coalesce->capacity = RING_IO_COALESCE_MAX_SIZE;
+	}
+	coalesce->threshold = threshold;
+	if (coalesce->threshold > coalesce->capacity) {
+		coalesce->threshold = coalesce->capacity;
+	}
+	coalesce->deadline = deadline;
+}
+
+/** ============================================================================
+ *  @func   RING_IO_CoalesceWrite
+ *
+ *  @desc   Adds a record to the pending batch.
+ *
+ *  @modif  None
+ *  ============================================================================
+ */
+NORMAL_API
+DSP_STATUS
+RING_IO_CoalesceWrite (IN RING_IO_CoalesceObj * coalesce,
+		IN Pvoid buffer,
+		IN Uint32 size)
+{
+	DSP_STATUS status = DSP_SOK;
+	Uint8 * record = (Uint8 *) buffer;
+	Uint32 room;
+	Uint32 copySize;
+
+	while (DSP_SUCCEEDED (status) && (size > 0)) {
+		room = 0;
+		if (coalesce->numRecords < RING_IO_COALESCE_MAX_RECORDS) {
+			room = coalesce->capacity - coalesce->used
+					- RING_IO_COALESCE_TABLE_SIZE (coalesce->numRecords);
+			if (room > sizeof (Uint32)) {
+				room -= sizeof (Uint32);
+			}
+			else {
+				room = 0;
+			}
+		}
+
+		if (room == 0) {
+			status = RING_IO_CoalesceSendPending (coalesce,
+					&coalesce->stats.sizeFlushes);
+		}
+		else if (   (coalesce->numRecords == 0)
+				 && (RING_IO_COALESCE_TABLE_SIZE (1u) + size
+						>= coalesce->threshold)) {
+			/* Nothing to coalesce with, send the record as it is */
+			copySize = (size < room) ? size : room;
+			status = RING_IO_CoalesceSend (coalesce,
+					&copySize,
+					1u,
+					record,
+					copySize);
+			coalesce->stats.sizeFlushes++;
+			record += copySize;
+			size -= copySize;
+		}
+		else {
+			copySize = (size < room) ? size : room;
+			if (coalesce->numRecords == 0) {
+				coalesce->firstTime = RING_IO_GetTimeUsec ();
+			}
+			memcpy (coalesce->data + coalesce->used, record, copySize);
+			coalesce->lens [coalesce->numRecords++] = copySize;
+			coalesce->used += copySize;
+			record += copySize;
+			size -= copySize;
+
+			if (  RING_IO_COALESCE_TABLE_SIZE (coalesce->numRecords)
+				+ coalesce->used >= coalesce->threshold) {
+				status = RING_IO_CoalesceSendPending (coalesce,
+						&coalesce->stats.sizeFlushes);
+			}
+		}
+	}
+
+	return (status);
+}
+
+/** ============================================================================
+ *  @func   RING_IO_CoalesceFlush
+ *
+ *  @desc   Sends the pending batch now.
+ *
+ *  @modif  None
+ *  ============================================================================
+ */
+NORMAL_API
+DSP_STATUS
+RING_IO_CoalesceFlush (IN RING_IO_CoalesceObj * coalesce)
+{
+	return (RING_IO_CoalesceSendPending (coalesce,
+			&coalesce->stats.explicitFlushes));
+}
+
+/** ============================================================================
+ *  @func   RING_IO_CoalescePoll
+ *
+ *  @desc   Sends the pending batch if its deadline has expired.
+ *
+ *  @modif  None
+ *  ============================================================================
+ */
+NORMAL_API
+DSP_STATUS
+RING_IO_CoalescePoll (IN  RING_IO_CoalesceObj * coalesce,
+		OUT Int32 * timeout)
+{
+	DSP_STATUS status = DSP_SOK;
+	RING_IO_Uint64 age;
+
+	*timeout = -1;
+	if (coalesce->numRecords > 0) {
+		age = RING_IO_GetTimeUsec () - coalesce->firstTime;
+		if (age >= coalesce->deadline) {
+			status = RING_IO_CoalesceSendPending (coalesce,
+					&coalesce->stats.deadlineFlushes);
+		}
+		else {
+			*timeout = (Int32) (coalesce->deadline - age);
+		}
+	}
+
+	return (status);
+}
+
+/** ============================================================================
+ *  @func   RING_IO_CoalesceReport
+ *
+ *  @desc   Prints the statistics of a coalescer.
+ *
+ *  @modif  None
+ *  ============================================================================
+ */
+NORMAL_API
+Void
+RING_IO_CoalesceReport (IN RING_IO_CoalesceObj * coalesce)
+{
+	RING_IO_CoalesceStats * stats = &coalesce->stats;
+
+	RING_IO_1Print64 ("GPP-->DSP:Records coalesced %llu \n", stats->records);
+	RING_IO_1Print64 ("GPP-->DSP:Batches sent %llu \n", stats->batches);
+	RING_IO_1Print64 ("GPP-->DSP:  on size %llu \n", stats->sizeFlushes);
+	RING_IO_1Print64 ("GPP-->DSP:  on deadline %llu \n",
+			stats->deadlineFlushes);
+	RING_IO_1Print64 ("GPP-->DSP:  on flush %llu \n", stats->explicitFlushes);
+	if (stats->batches > 0) {
+		RING_IO_1Print64 ("GPP-->DSP:Records per batch (x100) %llu \n",
+				(stats->records * 100u) / stats->batches);
+	}
+}
+
+/** ----------------------------------------------------------------------------
+ *  @func   RING_IO_CoalesceSend
+ *
+ *  @desc   Writes one batch to the channel.
+ *
+ *  @modif  offset, stats of the coalescer.
+ *  ----------------------------------------------------------------------------
+ */
+STATIC
+NORMAL_API
+DSP_STATUS
+RING_IO_CoalesceSend (IN RING_IO_CoalesceObj * coalesce,
+		IN Uint32 * lens,
+		IN Uint32 numRecords,
+		IN Uint8 * data,
+		IN Uint32 size)
+{
+	DSP_STATUS status = DSP_SOK;
+	DSP_STATUS relStatus = DSP_SOK;
+	RING_IO_ChnlObj * chnl = coalesce->chnl;
+	Uint32 tableSize = RING_IO_COALESCE_TABLE_SIZE (numRecords);
+	Uint32 batchSize = tableSize + size;
+	Uint32 table [1u + RING_IO_COALESCE_MAX_RECORDS];
+	Uint32 attrs [RING_IO_VATTR_SIZE];
+	RingIO_BufPtr bufPtr = NULL;
+	Uint8 * piece;
+	Uint32 acqSize;
+	Uint32 tableLen;
+	Uint32 done = 0;
+
+	table [0] = numRecords;
+	memcpy (&table [1], lens, numRecords * sizeof (Uint32));
+
+	attrs [RING_IO_VATTR_LEN] = batchSize;
+	attrs [RING_IO_VATTR_OFFSET_LO] = (Uint32) coalesce->offset;
+	attrs [RING_IO_VATTR_OFFSET_HI] = (Uint32) (coalesce->offset >> 32);
+	attrs [RING_IO_VATTR_SEQ_LO] = (Uint32) chnl->writerSeq;
+	attrs [RING_IO_VATTR_SEQ_HI] = (Uint32) (chnl->writerSeq >> 32);
+
+	/*
+	 * At the end of the buffer only part of the batch is acquired, the
+	 * rest follows in the next acquire as for RING_IO_ChnlWrite ().
+	 */
+	while (DSP_SUCCEEDED (status) && (done < batchSize)) {
+		acqSize = batchSize - done;
+		status = RingIO_acquire (chnl->writerHandle, &bufPtr, &acqSize);
+
+		if (DSP_SUCCEEDED (status) && (acqSize > 0)) {
+			/* The attribute precedes the first piece of the batch only */
+			while (done == 0) {
+				status = RingIO_setvAttribute (chnl->writerHandle,
+						0, /* at the beginning */
+						0, /* No type */
+						0,
+						attrs,
+						chnl->writerAttrSize);
+				if (DSP_SUCCEEDED (status)) {
+					break;
+				}
+				/* Attribute buffer is full, let the DSP drain it */
+				RING_IO_Sleep(10);
+			}
+
+			/* The batch need not be word aligned in the RingIO buffer */
+			piece = (Uint8 *) bufPtr;
+			tableLen = 0;
+			if (done < tableSize) {
+				tableLen = tableSize - done;
+				if (tableLen > acqSize) {
+					tableLen = acqSize;
+				}
+				memcpy (piece, (Uint8 *) table + done, tableLen);
+			}
+			if (acqSize > tableLen) {
+				RING_IO_Copy (piece + tableLen,
+						data + (done + tableLen - tableSize),
+						acqSize - tableLen);
+			}
+
+			relStatus = RingIO_release (chnl->writerHandle, acqSize);
+			if (DSP_FAILED (relStatus)) {
+				status = relStatus;
+				RING_IO_1Print ("RingIO_release () in Writer task "
+						"failed. relStatus = [0x%x]\n",
+						relStatus);
+			}
+			else {
+				done += acqSize;
+			}
+		}
+		else {
+			status = RING_IO_ChnlWriterWait (chnl);
+		}
+	}
+
+	if (DSP_SUCCEEDED (status)) {
+		coalesce->offset += batchSize;
+		chnl->writerSeq++;
+		coalesce->stats.records += numRecords;
+		coalesce->stats.bytes += size;
+		coalesce->stats.batches++;
+	}
+
+	return (status);
+}
+
+/** ----------------------------------------------------------------------------
+ *  @func   RING_IO_CoalesceSendPending
+ *
+ *  @desc   Sends the pending records, if any, as one batch.
+ *
+ *  @modif  numRecords, used, stats of the coalescer.
+ *  ----------------------------------------------------------------------------
+ */
+STATIC
+NORMAL_API
+DSP_STATUS
+RING_IO_CoalesceSendPending (IN RING_IO_CoalesceObj * coalesce,
+		IN RING_IO_Uint64 * counter)
+{
+	DSP_STATUS status = DSP_SOK;
+
+	if (coalesce->numRecords > 0) {
+		status = RING_IO_CoalesceSend (coalesce,
+				coalesce->lens,
+				coalesce->numRecords,
+				coalesce->data,
+				coalesce->used);
+		coalesce->numRecords = 0;
+		coalesce->used = 0;
+		(*counter)++;
+	}
+
+	return (status);
+}
+
+
+#if defined (__cplusplus)
+}
+#endif /* defined (__cplusplus) */
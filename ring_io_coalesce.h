@@ -0,0 +1,309 @@
+/** ============================================================================
+ *  @file   ring_io_coalesce.h
+ *
+ *  @path   $(DSPLINK)/gpp/src/samples/ring_io/
+ *
+ *  @desc   Defines the coalescer of the ring_io application, which gathers
+ *          small records written to a channel into RING_IO_XFER_BATCH
+ *          records, so that a single acquire, variable attribute and release
+ *          is paid for many of them.
+ *          A batch is sent once it reaches a size threshold, once its oldest
+ *          record is older than a deadline, or on an explicit flush.
+ *
+ *  @ver    1.65.00.02
+ *  ============================================================================
+ *  Copyright (C) 2002-2009, Texas Instruments Incorporated -
+ *  http://www.ti.com/
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions
+ *  are met:
+ *  
+ *  *  Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *  
+ *  *  Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer in the
+ *     documentation and/or other materials provided with the distribution.
+ *  
+ *  *  Neither the name of Texas Instruments Incorporated nor the names of
+ *     its contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *  
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ *  THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ *  PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+ *  CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ *  EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ *  PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ *  OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ *  WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ *  OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ *  EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *  ============================================================================
+ */
+
+
+#if !defined (RING_IO_COALESCE_H)
+#define RING_IO_COALESCE_H
+
+
+/*  ----------------------------------- DSP/BIOS Link                 */
+#include <dsplink.h>
+
+/*  ----------------------------------- Application Header            */
+#include <ring_io.h>
+#include <ring_io_chnl.h>
+
+
+#if defined (__cplusplus)
+extern "C" {
+#endif /* defined (__cplusplus) */
+
+
+/** ============================================================================
+ *  @const  RING_IO_COALESCE_MAX_SIZE
+ *
+ *  @desc   Maximum size of a batch, including its record table.
+ *  ============================================================================
+ */
+#define RING_IO_COALESCE_MAX_SIZE       4096u
+
+/** ============================================================================
+ *  @const  RING_IO_COALESCE_MAX_RECORDS
+ *
+ *  @desc   Maximum number of records in a batch.
+ *  ============================================================================
+ */
+#define RING_IO_COALESCE_MAX_RECORDS    32u
+
+/** ============================================================================
+ *  @const  RING_IO_COALESCE_DEADLINE
+ *
+ *  @desc   Default time in microseconds a record may wait for others.
+ *  ============================================================================
+ */
+#define RING_IO_COALESCE_DEADLINE       200u
+
+
+/** ============================================================================
+ *  @name   RING_IO_CoalesceStats
+ *
+ *  @desc   Statistics of a coalescer.
+ *
+ *  @field  records
+ *              Number of records sent. A record larger than a batch counts
+ *              once per batch it is split into.
+ *  @field  bytes
+ *              Number of bytes of records sent.
+ *  @field  batches
+ *              Number of batches sent.
+ *  @field  sizeFlushes
+ *              Number of batches sent on reaching the size threshold.
+ *  @field  deadlineFlushes
+ *              Number of batches sent on expiry of the deadline.
+ *  @field  explicitFlushes
+ *              Number of batches sent by RING_IO_CoalesceFlush ().
+ *  ============================================================================
+ */
+typedef struct RING_IO_CoalesceStats_tag {
+    RING_IO_Uint64   records ;
+    RING_IO_Uint64   bytes ;
+    RING_IO_Uint64   batches ;
+    RING_IO_Uint64   sizeFlushes ;
+    RING_IO_Uint64   deadlineFlushes ;
+    RING_IO_Uint64   explicitFlushes ;
+} RING_IO_CoalesceStats ;
+
+/** ============================================================================
+ *  @name   RING_IO_CoalesceObj
+ *
+ *  @desc   State of a coalescer.
+ *
+ *  @field  chnl
+ *              Channel the batches are written to.
+ *  @field  capacity
+ *              Maximum size of a batch.
+ *  @field  threshold
+ *              Size of a batch at which it is sent.
+ *  @field  deadline
+ *              Time in microseconds a record may wait for others.
+ *  @field  firstTime
+ *              Time stamp in microseconds of the oldest pending record.
+ *  @field  offset
+ *              Number of bytes written to the channel in the transfer.
+ *  @field  numRecords
+ *              Number of pending records.
+ *  @field  used
+ *              Number of bytes of pending records.
+ *  @field  lens
+ *              Sizes of the pending records.
+ *  @field  data
+ *              Pending records.
+ *  @field  stats
+ *              Statistics.
+ *  ============================================================================
+ */
+typedef struct RING_IO_CoalesceObj_tag {
+    RING_IO_ChnlObj *      chnl ;
+    Uint32                 capacity ;
+    Uint32                 threshold ;
+    Uint32                 deadline ;
+    RING_IO_Uint64         firstTime ;
+    RING_IO_Uint64         offset ;
+    Uint32                 numRecords ;
+    Uint32                 used ;
+    Uint32                 lens [RING_IO_COALESCE_MAX_RECORDS] ;
+    Uint8                  data [RING_IO_COALESCE_MAX_SIZE] ;
+    RING_IO_CoalesceStats  stats ;
+} RING_IO_CoalesceObj ;
+
+
+/** ============================================================================
+ *  @func   RING_IO_CoalesceInit
+ *
+ *  @desc   Initializes a coalescer for a channel.
+ *
+ *  @arg    coalesce
+ *              Coalescer to be initialized.
+ *  @arg    chnl
+ *              Channel with the writer opened. A batch never exceeds its
+ *              writerAcqSize.
+ *  @arg    threshold
+ *              Size of a batch at which it is sent. Bounded by the maximum
+ *              size of a batch.
+ *  @arg    deadline
+ *              Time in microseconds a record may wait for others.
+ *
+ *  @ret    None
+ *
+ *  @enter  The xferMode of the channel is RING_IO_XFER_BATCH.
+ *
+ *  @leave  None
+ *
+ *  @see    RING_IO_CoalesceWrite
+ *  ============================================================================
+ */
+NORMAL_API
+Void
+RING_IO_CoalesceInit (IN RING_IO_CoalesceObj * coalesce,
+                      IN RING_IO_ChnlObj *     chnl,
+                      IN Uint32                threshold,
+                      IN Uint32                deadline) ;
+
+/** ============================================================================
+ *  @func   RING_IO_CoalesceWrite
+ *
+ *  @desc   Adds a record to the pending batch. The batch is sent when it
+ *          reaches the threshold or is full. A record of at least the
+ *          threshold with no record pending is sent without being copied
+ *          into the coalescer.
+ *
+ *  @arg    coalesce
+ *              Coalescer.
+ *  @arg    buffer
+ *              Record to be written.
+ *  @arg    size
+ *              Size of the record.
+ *
+ *  @ret    DSP_SOK
+ *              Operation successfully completed.
+ *          DSP_EFAIL
+ *              General failure.
+ *
+ *  @enter  RING_IO_ChnlWriteStart () was called on the channel.
+ *
+ *  @leave  None
+ *
+ *  @see    RING_IO_CoalesceFlush, RING_IO_CoalescePoll
+ *  ============================================================================
+ */
+NORMAL_API
+DSP_STATUS
+RING_IO_CoalesceWrite (IN RING_IO_CoalesceObj * coalesce,
+                       IN Pvoid                 buffer,
+                       IN Uint32                size) ;
+
+/** ============================================================================
+ *  @func   RING_IO_CoalesceFlush
+ *
+ *  @desc   Sends the pending batch now, for records that must not wait.
+ *
+ *  @arg    coalesce
+ *              Coalescer.
+ *
+ *  @ret    DSP_SOK
+ *              Operation successfully completed.
+ *          DSP_EFAIL
+ *              General failure.
+ *
+ *  @enter  None
+ *
+ *  @leave  No record is pending.
+ *
+ *  @see    RING_IO_CoalesceWrite
+ *  ============================================================================
+ */
+NORMAL_API
+DSP_STATUS
+RING_IO_CoalesceFlush (IN RING_IO_CoalesceObj * coalesce) ;
+
+/** ============================================================================
+ *  @func   RING_IO_CoalescePoll
+ *
+ *  @desc   Sends the pending batch if its deadline has expired. To be called
+ *          by the writer when it waits for records.
+ *
+ *  @arg    coalesce
+ *              Coalescer.
+ *  @arg    timeout
+ *              Location to receive the time in microseconds until the
+ *              deadline of the pending batch, or -1 if no record is pending.
+ *
+ *  @ret    DSP_SOK
+ *              Operation successfully completed.
+ *          DSP_EFAIL
+ *              General failure.
+ *
+ *  @enter  None
+ *
+ *  @leave  None
+ *
+ *  @see    RING_IO_CoalesceWrite
+ *  ============================================================================
+ */
+NORMAL_API
+DSP_STATUS
+RING_IO_CoalescePoll (IN  RING_IO_CoalesceObj * coalesce,
+                      OUT Int32 *               timeout) ;
+
+/** ============================================================================
+ *  @func   RING_IO_CoalesceReport
+ *
+ *  @desc   Prints the statistics of a coalescer, including the number of
+ *          records per batch.
+ *
+ *  @arg    coalesce
+ *              Coalescer.
+ *
+ *  @ret    None
+ *
+ *  @enter  None
+ *
+ *  @leave  None
+ *
+ *  @see    None
+ *  ============================================================================
+ */
+NORMAL_API
+Void
+RING_IO_CoalesceReport (IN RING_IO_CoalesceObj * coalesce) ;
+
+
+#if defined (__cplusplus)
+}
+#endif /* defined (__cplusplus) */
+
+
+#endif /* !defined (RING_IO_COALESCE_H) */
@@ -0,0 +1,434 @@
+/** ============================================================================
+ *  @file   ring_io_notify.c
+ *
+ *  @path   $(DSPLINK)/gpp/src/samples/ring_io/
+ *
+ *  @desc   Implementation of the notification layer of the ring_io
+ *          application.
+ *
+ *  @ver    1.65.00.02
+ *  ============================================================================
+ *  Copyright (C) 2002-2009, Texas Instruments Incorporated -
+ *  http://www.ti.com/
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions
+ *  are met:
+ *  
+ *  *  Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *  
+ *  *  Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer in the
+ *     documentation and/or other materials provided with the distribution.
+ *  
+ *  *  Neither the name of Texas Instruments Incorporated nor the names of
+ *     its contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *  
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ *  THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ *  PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+ *  CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ *  EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ *  PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ *  OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ *  WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ *  OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ *  EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *  ============================================================================
+ */
+
+/*  ------------------------ DSP/BIOS Link ----------------------------------*/
+#include <dsplink.h>
+
+/*  ------------------------DSP/BIOS LINK API -------------------------------*/
+#include <ringio.h>
+#include <string.h>
+
+/*  ------------------------ Application Header------------------------------*/
+#include <ring_io.h>
+#include <ring_io_os.h>
+#include <ring_io_chnl.h>
+#include <ring_io_notify.h>
+
+
+#if defined (__cplusplus)
+extern "C" {
+#endif /* defined (__cplusplus) */
+
+
+/** ============================================================================
+ *  @name   RING_IO_NotifyObj
+ *
+ *  @desc   State of the notification layer.
+ *
+ *  @field  semPong
+ *              Semaphore posted when the answer to the ping in progress is
+ *              received.
+ *  @field  pingChnl
+ *              Channel of the ping in progress.
+ *  @field  pingToken
+ *              Parameter of the ping in progress, RING_IO_NOTIFY_NO_PING set
+ *              when none is.
+ *  @field  stats
+ *              Statistics, updated with atomic operations.
+ *  ============================================================================
+ */
+typedef struct RING_IO_NotifyObj_tag {
+	Pvoid                semPong;
+	RING_IO_ChnlObj *    pingChnl;
+	volatile Uint32      pingToken;
+	RING_IO_NotifyStats  stats;
+} RING_IO_NotifyObj;
+
+/** ============================================================================
+ *  @name   RING_IO_Notify
+ *
+ *  @desc   The notification layer.
+ *  ============================================================================
+ */
+STATIC RING_IO_NotifyObj RING_IO_Notify;
+
+
+/** ----------------------------------------------------------------------------
+ *  @func   RING_IO_NotifySend
+ *
+ *  @desc   Sends a notification message, retrying until the RingIO takes
+ *          it, and accounts for it in the statistics.
+ *
+ *  @arg    handle
+ *              Writer RingIO the message is sent on.
+ *  @arg    msg
+ *              Notification message.
+ *
+ *  @modif  stats of the layer.
+ *  ----------------------------------------------------------------------------
+ */
+STATIC
+NORMAL_API
+DSP_STATUS
+RING_IO_NotifySend (IN RingIO_Handle handle, IN RingIO_NotifyMsg msg);
+
+
+/** ============================================================================
+ *  @func   RING_IO_NotifyInit
+ *
+ *  @desc   Initializes the notification layer.
+ *
+ *  @modif  None
+ *  ============================================================================
+ */
+NORMAL_API
+DSP_STATUS
+RING_IO_NotifyInit (Void)
+{
+	DSP_STATUS status = DSP_SOK;
+	RING_IO_NotifyObj * notify = &RING_IO_Notify;
+
+	memset (notify, 0, sizeof (RING_IO_NotifyObj));
+	notify->pingToken = RING_IO_NOTIFY_NO_PING;
+	status = RING_IO_CreateSem (&notify->semPong);
+	if (DSP_FAILED (status)) {
+		RING_IO_1Print ("RING_IO_CreateSem () failed. Status = [0x%x]\n",
+				status);
+		notify->semPong = NULL;
+	}
+
+	return (status);
+}
+
+/** ============================================================================
+ *  @func   RING_IO_NotifyExit
+ *
+ *  @desc   Finalizes the notification layer.
+ *
+ *  @modif  None
+ *  ============================================================================
+ */
+NORMAL_API
+Void
+RING_IO_NotifyExit (Void)
+{
+	RING_IO_NotifyObj * notify = &RING_IO_Notify;
+
+	if (notify->semPong != NULL) {
+		RING_IO_DeleteSem (notify->semPong);
+		notify->semPong = NULL;
+	}
+}
+
+/** ============================================================================
+ *  @func   RING_IO_NotifyPost
+ *
+ *  @desc   Sends a notification for a channel.
+ *
+ *  @modif  None
+ *  ============================================================================
+ */
+NORMAL_API
+DSP_STATUS
+RING_IO_NotifyPost (IN RING_IO_ChnlObj * chnl,
+		IN Uint16 msg)
+{
+	RING_IO_AtomicAdd64 (&RING_IO_Notify.stats.posted, 1u);
+
+	return (RING_IO_NotifySend (chnl->writerHandle, (RingIO_NotifyMsg) msg));
+}
+
+/** ============================================================================
+ *  @func   RING_IO_NotifyPostAll
+ *
+ *  @desc   Sends the same notification for several channels.
+ *
+ *  @modif  None
+ *  ============================================================================
+ */
+NORMAL_API
+DSP_STATUS
+RING_IO_NotifyPostAll (IN RING_IO_ChnlObj * chnls,
+		IN Uint32 numChnls,
+		IN Uint16 msg)
+{
+	DSP_STATUS status = DSP_SOK;
+	DSP_STATUS tmpStatus = DSP_SOK;
+	RING_IO_NotifyStats * stats = &RING_IO_Notify.stats;
+	Uint32 doorbell = 0;
+	Uint32 i;
+
+	/* Only a DSP that announced it decodes a doorbell */
+	if (   (numChnls > 1)
+		&& ((  RING_IO_AtomicLoad (&RING_IO_CtrlGet ()->dspCaps)
+			 & RING_IO_XFER_DOORBELL) != 0)) {
+		doorbell = RING_IO_NOTIFY_DOORBELL;
+		for (i = 0; i < numChnls; i++) {
+			if (chnls [i].id >= RING_IO_NOTIFY_MAX_CHNLS) {
+				doorbell = 0;
+				break;
+			}
+			doorbell |= (Uint32) msg << (chnls [i].id * 4u);
+		}
+	}
+
+	if (doorbell != 0) {
+		RING_IO_AtomicAdd64 (&stats->posted, numChnls);
+		RING_IO_AtomicAdd64 (&stats->doorbells, 1u);
+		status = RING_IO_NotifySend (chnls [numChnls - 1].writerHandle,
+				(RingIO_NotifyMsg) doorbell);
+	}
+	else {
+		for (i = 0; i < numChnls; i++) {
+			tmpStatus = RING_IO_NotifyPost (&chnls [i], msg);
+			if (DSP_SUCCEEDED (status) && DSP_FAILED (tmpStatus)) {
+				status = tmpStatus;
+			}
+		}
+	}
+
+	return (status);
+}
+
+/** ============================================================================
+ *  @func   RING_IO_NotifyUrgent
+ *
+ *  @desc   Sends an urgent control message on a channel at once.
+ *
+ *  @modif  None
+ *  ============================================================================
+ */
+NORMAL_API
+DSP_STATUS
+RING_IO_NotifyUrgent (IN RING_IO_ChnlObj * chnl,
+		IN Uint32 op,
+		IN Uint32 param)
+{
+	DSP_STATUS status = DSP_SOK;
+
+	do {
+		status = RingIO_sendNotify (chnl->writerHandle,
+				(RingIO_NotifyMsg) RING_IO_NOTIFY_URGENT_MSG (op, param));
+		if (DSP_FAILED (status)) {
+			RING_IO_Sleep(10);
+		}
+	}while (status != RINGIO_SUCCESS);
+	RING_IO_AtomicAdd64 (&RING_IO_Notify.stats.urgent, 1u);
+
+	return (status);
+}
+
+/** ============================================================================
+ *  @func   RING_IO_NotifyUrgentRecv
+ *
+ *  @desc   Handles an urgent control message received from the DSP.
+ *
+ *  @modif  None
+ *  ============================================================================
+ */
+NORMAL_API
+Bool
+RING_IO_NotifyUrgentRecv (IN RING_IO_ChnlObj * chnl, IN Uint16 msg)
+{
+	Bool urgent = FALSE;
+	RING_IO_NotifyObj * notify = &RING_IO_Notify;
+
+	if (RING_IO_NOTIFY_IS_URGENT (msg)) {
+		urgent = TRUE;
+		/*
+		 * The token of a ping that timed out has RING_IO_NOTIFY_NO_PING set,
+		 * so no answer matches it until the next ping.
+		 */
+		if (   (RING_IO_NOTIFY_URGENT_OP (msg) == RING_IO_URGENT_PONG)
+			&& (RING_IO_NOTIFY_URGENT_PARAM (msg) == notify->pingToken)
+			&& (chnl == notify->pingChnl)
+			&& (notify->semPong != NULL)) {
+			RING_IO_PostSem (notify->semPong);
+		}
+	}
+
+	return (urgent);
+}
+
+/** ============================================================================
+ *  @func   RING_IO_NotifyPing
+ *
+ *  @desc   Measures the round trip time of an urgent control message.
+ *
+ *  @modif  None
+ *  ============================================================================
+ */
+NORMAL_API
+DSP_STATUS
+RING_IO_NotifyPing (IN RING_IO_ChnlObj * chnl, OUT RING_IO_Uint64 * rtt)
+{
+	DSP_STATUS status = DSP_SOK;
+	RING_IO_NotifyObj * notify = &RING_IO_Notify;
+	RING_IO_NotifyStats * stats = &notify->stats;
+	RING_IO_Uint64 start;
+
+	if (notify->semPong == NULL) {
+		status = DSP_EFAIL;
+	}
+	else {
+		/* Drops an answer that raced with the timeout of the last ping */
+		do {
+			status = RING_IO_TimedWaitSem (notify->semPong, 0u);
+		}while (DSP_SUCCEEDED (status));
+
+		notify->pingChnl = chnl;
+		notify->pingToken = (notify->pingToken + 1u) & 0xFFu;
+		start = RING_IO_GetTimeUsec ();
+		status = RING_IO_NotifyUrgent (chnl,
+				RING_IO_URGENT_PING,
+				notify->pingToken);
+	}
+
+	if (DSP_SUCCEEDED (status)) {
+		status = RING_IO_TimedWaitSem (notify->semPong,
+				RING_IO_NOTIFY_PING_TIMEOUT);
+		if (DSP_SUCCEEDED (status)) {
+			*rtt = RING_IO_GetTimeUsec () - start;
+			if ((stats->pings == 0) || (*rtt < stats->rttMin)) {
+				stats->rttMin = *rtt;
+			}
+			if (*rtt > stats->rttMax) {
+				stats->rttMax = *rtt;
+			}
+			stats->rttSum += *rtt;
+			stats->pings++;
+		}
+		else if (status == DSP_ETIMEOUT) {
+			stats->pingTimeouts++;
+		}
+		notify->pingToken |= RING_IO_NOTIFY_NO_PING;
+	}
+
+	return (status);
+}
+
+/** ============================================================================
+ *  @func   RING_IO_NotifyReport
+ *
+ *  @desc   Prints the statistics of the notification layer.
+ *
+ *  @modif  None
+ *  ============================================================================
+ */
+NORMAL_API
+Void
+RING_IO_NotifyReport (IN RING_IO_Uint64 bytes)
+{
+	RING_IO_NotifyStats * stats = &RING_IO_Notify.stats;
+
+	RING_IO_1Print64 ("GPP-->DSP:Notifications posted %llu \n",
+			stats->posted);
+	RING_IO_1Print64 ("GPP-->DSP:Notifications sent %llu \n", stats->sent);
+	RING_IO_1Print64 ("GPP-->DSP:Doorbells sent %llu \n", stats->doorbells);
+	if (bytes > 0) {
+		RING_IO_1Print64 ("GPP-->DSP:Notifications per MB (x100) %llu \n",
+				(stats->sent * 100u * 1048576u) / bytes);
+	}
+	if (stats->sent > 0) {
+		RING_IO_1Print64 ("GPP-->DSP:Notification delay avg %llu us\n",
+				stats->latencySum / stats->sent);
+		RING_IO_1Print64 ("GPP-->DSP:Notification delay max %llu us\n",
+				stats->latencyMax);
+	}
+	if (stats->urgent > 0) {
+		RING_IO_1Print64 ("GPP-->DSP:Urgent messages sent %llu \n",
+				stats->urgent);
+	}
+	if (stats->pings > 0) {
+		RING_IO_1Print64 ("GPP<->DSP:Urgent round trip min %llu us\n",
+				stats->rttMin);
+		RING_IO_1Print64 ("GPP<->DSP:Urgent round trip avg %llu us\n",
+				stats->rttSum / stats->pings);
+		RING_IO_1Print64 ("GPP<->DSP:Urgent round trip max %llu us\n",
+				stats->rttMax);
+	}
+	if (stats->pingTimeouts > 0) {
+		RING_IO_1Print64 ("GPP<->DSP:Urgent pings unanswered %llu \n",
+				stats->pingTimeouts);
+	}
+}
+
+/** ----------------------------------------------------------------------------
+ *  @func   RING_IO_NotifySend
+ *
+ *  @desc   Sends a notification message and accounts for it.
+ *
+ *  @modif  stats of the layer.
+ *  ----------------------------------------------------------------------------
+ */
+STATIC
+NORMAL_API
+DSP_STATUS
+RING_IO_NotifySend (IN RingIO_Handle handle, IN RingIO_NotifyMsg msg)
+{
+	DSP_STATUS status = DSP_SOK;
+	RING_IO_NotifyStats * stats = &RING_IO_Notify.stats;
+	RING_IO_Uint64 start = RING_IO_GetTimeUsec ();
+	RING_IO_Uint64 latency;
+
+	do {
+		status = RingIO_sendNotify (handle, msg);
+		if (DSP_FAILED (status)) {
+			RING_IO_Sleep(10);
+		}
+	}while (status != RINGIO_SUCCESS);
+
+	latency = RING_IO_GetTimeUsec () - start;
+	RING_IO_AtomicAdd64 (&stats->latencySum, latency);
+	/* Racing senders may lose a maximum, it is only reported */
+	if (latency > stats->latencyMax) {
+		stats->latencyMax = latency;
+	}
+	RING_IO_AtomicAdd64 (&stats->sent, 1u);
+
+	return (status);
+}
+
+
+#if defined (__cplusplus)
+}
+#endif /* defined (__cplusplus) */
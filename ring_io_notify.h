@@ -0,0 +1,464 @@
+/** ============================================================================
+ *  @file   ring_io_notify.h
+ *
+ *  @path   $(DSPLINK)/gpp/src/samples/ring_io/
+ *
+ *  @desc   Defines the notification layer of the ring_io application, through
+ *          which all notifications are sent to the DSP.
+ *          Every notification posted is sent at once: the DSP may block on
+ *          any of them, whatever the data left in the ring when it is
+ *          posted. The layer counts them for the notifications per megabyte
+ *          and the delay reported.
+ *          The same notification for several channels is sent as a single
+ *          doorbell if the DSP announced RING_IO_XFER_DOORBELL. Its message
+ *          holds the message of every channel: RING_IO_NOTIFY_DOORBELL is
+ *          set and bits 4n to 4n+3 hold the message for channel n, zero if
+ *          none. It is sent on the writer RingIO of the last channel. Other
+ *          DSPs get one notification per channel.
+ *          Urgent control messages bypass the data ring: the whole message,
+ *          RING_IO_NOTIFY_URGENT with a six bit opcode and an eight bit
+ *          parameter, travels in the notification payload, so it does not
+ *          wait behind the data queued in the ring.
+ *
+ *  @ver    1.65.00.02
+ *  ============================================================================
+ *  Copyright (C) 2002-2009, Texas Instruments Incorporated -
+ *  http://www.ti.com/
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions
+ *  are met:
+ *  
+ *  *  Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *  
+ *  *  Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer in the
+ *     documentation and/or other materials provided with the distribution.
+ *  
+ *  *  Neither the name of Texas Instruments Incorporated nor the names of
+ *     its contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *  
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ *  THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ *  PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+ *  CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ *  EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ *  PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ *  OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ *  WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ *  OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ *  EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *  ============================================================================
+ */
+
+
+#if !defined (RING_IO_NOTIFY_H)
+#define RING_IO_NOTIFY_H
+
+
+/*  ----------------------------------- DSP/BIOS Link                 */
+#include <dsplink.h>
+
+/*  ----------------------------------- Application Header            */
+#include <ring_io.h>
+#include <ring_io_chnl.h>
+
+
+#if defined (__cplusplus)
+extern "C" {
+#endif /* defined (__cplusplus) */
+
+
+/** ============================================================================
+ *  @const  RING_IO_NOTIFY_DOORBELL
+ *
+ *  @desc   Flag of a notification message carrying the messages of several
+ *          channels.
+ *  ============================================================================
+ */
+#define RING_IO_NOTIFY_DOORBELL     0x8000u
+
+/** ============================================================================
+ *  @const  RING_IO_NOTIFY_MAX_CHNLS
+ *
+ *  @desc   Number of channels a doorbell can carry.
+ *  ============================================================================
+ */
+#define RING_IO_NOTIFY_MAX_CHNLS    3u
+
+/** ============================================================================
+ *  @macro  RING_IO_NOTIFY_MSG
+ *
+ *  @desc   Message for channel chnlId in a doorbell.
+ *  ============================================================================
+ */
+#define RING_IO_NOTIFY_MSG(doorbell, chnlId)                                   \
+                        (((doorbell) >> ((chnlId) * 4u)) & 0xFu)
+
+/** ============================================================================
+ *  @const  RING_IO_NOTIFY_URGENT
+ *
+ *  @desc   Flag of a notification message carrying an urgent control message.
+ *          It is never set in a doorbell.
+ *  ============================================================================
+ */
+#define RING_IO_NOTIFY_URGENT       0x4000u
+
+/** ============================================================================
+ *  @macro  RING_IO_NOTIFY_IS_URGENT
+ *
+ *  @desc   TRUE if a notification message is an urgent control message.
+ *  ============================================================================
+ */
+#define RING_IO_NOTIFY_IS_URGENT(msg)                                          \
+        (((msg) & (RING_IO_NOTIFY_DOORBELL | RING_IO_NOTIFY_URGENT))           \
+                                                    == RING_IO_NOTIFY_URGENT)
+
+/** ============================================================================
+ *  @macro  RING_IO_NOTIFY_URGENT_MSG
+ *
+ *  @desc   Notification message of an urgent opcode and its parameter.
+ *  ============================================================================
+ */
+#define RING_IO_NOTIFY_URGENT_MSG(op, param)                                   \
+        ((Uint16) (RING_IO_NOTIFY_URGENT | (((op) & 0x3Fu) << 8u)              \
+                                         | ((param) & 0xFFu)))
+
+/** ============================================================================
+ *  @macro  RING_IO_NOTIFY_URGENT_OP
+ *
+ *  @desc   Opcode of an urgent control message.
+ *  ============================================================================
+ */
+#define RING_IO_NOTIFY_URGENT_OP(msg)       (((msg) >> 8u) & 0x3Fu)
+
+/** ============================================================================
+ *  @macro  RING_IO_NOTIFY_URGENT_PARAM
+ *
+ *  @desc   Parameter of an urgent control message.
+ *  ============================================================================
+ */
+#define RING_IO_NOTIFY_URGENT_PARAM(msg)    ((msg) & 0xFFu)
+
+/** ============================================================================
+ *  @const  RING_IO_URGENT_PING
+ *
+ *  @desc   Urgent opcode asking the peer to answer RING_IO_URGENT_PONG with
+ *          the same parameter.
+ *  ============================================================================
+ */
+#define RING_IO_URGENT_PING         1u
+
+/** ============================================================================
+ *  @const  RING_IO_URGENT_PONG
+ *
+ *  @desc   Urgent opcode answering RING_IO_URGENT_PING.
+ *  ============================================================================
+ */
+#define RING_IO_URGENT_PONG         2u
+
+/** ============================================================================
+ *  @const  RING_IO_URGENT_STOP
+ *
+ *  @desc   Urgent opcode asking the peer to drop the data queued on the
+ *          channel and end the transfer.
+ *  ============================================================================
+ */
+#define RING_IO_URGENT_STOP         3u
+
+/** ============================================================================
+ *  @const  RING_IO_URGENT_PARAM
+ *
+ *  @desc   Urgent opcode carrying a new value of the processing parameter of
+ *          the peer.
+ *  ============================================================================
+ */
+#define RING_IO_URGENT_PARAM        4u
+
+/** ============================================================================
+ *  @const  RING_IO_NOTIFY_PING_TIMEOUT
+ *
+ *  @desc   Time in microseconds a ping waits for its answer.
+ *  ============================================================================
+ */
+#define RING_IO_NOTIFY_PING_TIMEOUT 100000u
+
+/** ============================================================================
+ *  @const  RING_IO_NOTIFY_NO_PING
+ *
+ *  @desc   Flag of the ping token when no ping is in progress. It is outside
+ *          the eight bit parameter of an answer, which never matches it.
+ *  ============================================================================
+ */
+#define RING_IO_NOTIFY_NO_PING      0x100u
+
+
+/** ============================================================================
+ *  @name   RING_IO_NotifyStats
+ *
+ *  @desc   Statistics of the notification layer.
+ *
+ *  @field  posted
+ *              Number of notifications posted.
+ *  @field  sent
+ *              Number of notifications sent, doorbells included.
+ *  @field  doorbells
+ *              Number of doorbells sent.
+ *  @field  latencySum
+ *              Sum over the notifications sent of the time in microseconds
+ *              between the post and the RingIO taking the message.
+ *  @field  latencyMax
+ *              Largest of these times.
+ *  @field  urgent
+ *              Number of urgent control messages sent.
+ *  @field  pings
+ *              Number of pings answered.
+ *  @field  pingTimeouts
+ *              Number of pings not answered in time.
+ *  @field  rttSum
+ *              Sum of the round trip times in microseconds of the pings
+ *              answered.
+ *  @field  rttMin
+ *              Smallest of these times.
+ *  @field  rttMax
+ *              Largest of these times.
+ *  ============================================================================
+ */
+typedef struct RING_IO_NotifyStats_tag {
+    RING_IO_Uint64   posted ;
+    RING_IO_Uint64   sent ;
+    RING_IO_Uint64   doorbells ;
+    RING_IO_Uint64   latencySum ;
+    RING_IO_Uint64   latencyMax ;
+    RING_IO_Uint64   urgent ;
+    RING_IO_Uint64   pings ;
+    RING_IO_Uint64   pingTimeouts ;
+    RING_IO_Uint64   rttSum ;
+    RING_IO_Uint64   rttMin ;
+    RING_IO_Uint64   rttMax ;
+} RING_IO_NotifyStats ;
+
+
+/** ============================================================================
+ *  @func   RING_IO_NotifyInit
+ *
+ *  @desc   Initializes the notification layer.
+ *
+ *  @arg    None
+ *
+ *  @ret    DSP_SOK
+ *              Operation successfully completed.
+ *          DSP_EFAIL
+ *              General failure.
+ *
+ *  @enter  The OS layer is initialized.
+ *
+ *  @leave  None
+ *
+ *  @see    RING_IO_NotifyExit
+ *  ============================================================================
+ */
+NORMAL_API
+DSP_STATUS
+RING_IO_NotifyInit (Void) ;
+
+/** ============================================================================
+ *  @func   RING_IO_NotifyExit
+ *
+ *  @desc   Finalizes the notification layer.
+ *
+ *  @arg    None
+ *
+ *  @ret    None
+ *
+ *  @enter  None
+ *
+ *  @leave  None
+ *
+ *  @see    RING_IO_NotifyInit
+ *  ============================================================================
+ */
+NORMAL_API
+Void
+RING_IO_NotifyExit (Void) ;
+
+/** ============================================================================
+ *  @func   RING_IO_NotifyPost
+ *
+ *  @desc   Sends a notification for a channel.
+ *
+ *  @arg    chnl
+ *              Channel with the writer opened.
+ *  @arg    msg
+ *              Notification message, one of NOTIFY_*.
+ *
+ *  @ret    DSP_SOK
+ *              Operation successfully completed.
+ *          DSP_EFAIL
+ *              General failure.
+ *
+ *  @enter  None
+ *
+ *  @leave  None
+ *
+ *  @see    RING_IO_NotifyPostAll
+ *  ============================================================================
+ */
+NORMAL_API
+DSP_STATUS
+RING_IO_NotifyPost (IN RING_IO_ChnlObj * chnl,
+                    IN Uint16            msg) ;
+
+/** ============================================================================
+ *  @func   RING_IO_NotifyPostAll
+ *
+ *  @desc   Sends the same notification for several channels, as a single
+ *          doorbell if the DSP announced RING_IO_XFER_DOORBELL and the
+ *          channels fit in one, else one notification per channel.
+ *
+ *  @arg    chnls
+ *              Array of channels with the writer opened.
+ *  @arg    numChnls
+ *              Number of channels.
+ *  @arg    msg
+ *              Notification message, one of NOTIFY_*.
+ *
+ *  @ret    DSP_SOK
+ *              Operation successfully completed.
+ *          DSP_EFAIL
+ *              General failure.
+ *
+ *  @enter  None
+ *
+ *  @leave  None
+ *
+ *  @see    RING_IO_NotifyPost
+ *  ============================================================================
+ */
+NORMAL_API
+DSP_STATUS
+RING_IO_NotifyPostAll (IN RING_IO_ChnlObj * chnls,
+                       IN Uint32            numChnls,
+                       IN Uint16            msg) ;
+
+/** ============================================================================
+ *  @func   RING_IO_NotifyUrgent
+ *
+ *  @desc   Sends an urgent control message on a channel at once.
+ *
+ *  @arg    chnl
+ *              Channel with the writer opened.
+ *  @arg    op
+ *              Opcode, one of RING_IO_URGENT_*.
+ *  @arg    param
+ *              Parameter of the opcode, eight bits.
+ *
+ *  @ret    DSP_SOK
+ *              Operation successfully completed.
+ *          DSP_EFAIL
+ *              General failure.
+ *
+ *  @enter  None
+ *
+ *  @leave  None
+ *
+ *  @see    RING_IO_NotifyPing
+ *  ============================================================================
+ */
+NORMAL_API
+DSP_STATUS
+RING_IO_NotifyUrgent (IN RING_IO_ChnlObj * chnl,
+                      IN Uint32            op,
+                      IN Uint32            param) ;
+
+/** ============================================================================
+ *  @func   RING_IO_NotifyUrgentRecv
+ *
+ *  @desc   Handles an urgent control message received from the DSP. To be
+ *          called by the reader notification of a channel. An answer to a
+ *          ping ends it only if it is received on the channel of the ping,
+ *          with its token, before the ping timed out.
+ *
+ *  @arg    chnl
+ *              Channel the message was received on.
+ *  @arg    msg
+ *              Notification message received.
+ *
+ *  @ret    TRUE
+ *              The message was an urgent control message and was consumed.
+ *          FALSE
+ *              The message is not an urgent control message.
+ *
+ *  @enter  None
+ *
+ *  @leave  None
+ *
+ *  @see    RING_IO_NotifyPing
+ *  ============================================================================
+ */
+NORMAL_API
+Bool
+RING_IO_NotifyUrgentRecv (IN RING_IO_ChnlObj * chnl, IN Uint16 msg) ;
+
+/** ============================================================================
+ *  @func   RING_IO_NotifyPing
+ *
+ *  @desc   Measures the round trip time of an urgent control message to the
+ *          DSP and back.
+ *
+ *  @arg    chnl
+ *              Channel with the writer and the reader opened.
+ *  @arg    rtt
+ *              Location to receive the round trip time in microseconds.
+ *
+ *  @ret    DSP_SOK
+ *              Operation successfully completed.
+ *          DSP_ETIMEOUT
+ *              No answer within RING_IO_NOTIFY_PING_TIMEOUT.
+ *          DSP_EFAIL
+ *              General failure.
+ *
+ *  @enter  No other ping is in progress.
+ *
+ *  @leave  None
+ *
+ *  @see    RING_IO_NotifyUrgent
+ *  ============================================================================
+ */
+NORMAL_API
+DSP_STATUS
+RING_IO_NotifyPing (IN  RING_IO_ChnlObj * chnl,
+                    OUT RING_IO_Uint64 *  rtt) ;
+
+/** ============================================================================
+ *  @func   RING_IO_NotifyReport
+ *
+ *  @desc   Prints the statistics of the notification layer.
+ *
+ *  @arg    bytes
+ *              Number of bytes transferred, for the notifications per
+ *              megabyte.
+ *
+ *  @ret    None
+ *
+ *  @enter  None
+ *
+ *  @leave  None
+ *
+ *  @see    None
+ *  ============================================================================
+ */
+NORMAL_API
+Void
+RING_IO_NotifyReport (IN RING_IO_Uint64 bytes) ;
+
+
+#if defined (__cplusplus)
+}
+#endif /* defined (__cplusplus) */
+
+
+#endif /* !defined (RING_IO_NOTIFY_H) */
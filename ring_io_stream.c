@@ -0,0 +1,1018 @@
+/** ============================================================================
+ *  @file   ring_io_stream.c
+ *
+ *  @path   $(DSPLINK)/gpp/src/samples/ring_io/
+ *
+ *  @desc   Implementation of the streaming and filter modes of the ring_io
+ *          application.
+ *          In streaming mode the input file is mapped and copied straight
+ *          into acquired writer buffers. The reader side hands every acquired
+ *          buffer to the OS specific asynchronous file writer, which keeps
+ *          several aligned writes in flight, and releases it immediately.
+ *          In filter mode the standard input is read directly into acquired
+ *          writer buffers and the received data is sent to the standard
+ *          output.
+ *          In bulk mode the payload is placed in POOL buffers and only their
+ *          descriptors go through the RingIO. The state of each buffer is
+ *          kept in its header in the pool, so that the writer and the reader
+ *          clients can recycle buffers also when they are processes.
+ *
+ *  @ver    1.65.00.02
+ *  ============================================================================
+ *  Copyright (C) 2002-2009, Texas Instruments Incorporated -
+ *  http://www.ti.com/
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions
+ *  are met:
+ *  
+ *  *  Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *  
+ *  *  Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer in the
+ *     documentation and/or other materials provided with the distribution.
+ *  
+ *  *  Neither the name of Texas Instruments Incorporated nor the names of
+ *     its contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *  
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ *  THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ *  PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+ *  CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ *  EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ *  PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ *  OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ *  WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ *  OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ *  EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *  ============================================================================
+ */
+
+/*  ------------------------ DSP/BIOS Link ----------------------------------*/
+#include <dsplink.h>
+
+/*  ------------------------DSP/BIOS LINK API -------------------------------*/
+#include <pool.h>
+#include <ringio.h>
+#include <string.h>
+#include <stdint.h>
+
+/*  ------------------------ Application Header------------------------------*/
+#include <ring_io.h>
+#include <ring_io_os.h>
+#include <ring_io_chnl.h>
+#include <ring_io_notify.h>
+#include <ring_io_stream.h>
+
+#if defined (__cplusplus)
+extern "C" {
+#endif /* defined (__cplusplus) */
+
+
+/** ============================================================================
+ *  @const  RING_IO_BULK_FREE, RING_IO_BULK_BUSY
+ *
+ *  @desc   States of a bulk buffer, as stored in its header.
+ *  ============================================================================
+ */
+#define RING_IO_BULK_FREE   0u
+#define RING_IO_BULK_BUSY   1u
+
+/** ============================================================================
+ *  @const  RING_IO_BULK_FREE_TIMEOUT
+ *
+ *  @desc   Time in microseconds the DSP is given to return a bulk buffer,
+ *          whether the writer waits for a free one or for all of them once
+ *          the transfer is over. A buffer not returned at the end by then is
+ *          reported and leaked, since the DSP may still write it.
+ *  ============================================================================
+ */
+#define RING_IO_BULK_FREE_TIMEOUT   2000000u
+
+/** ============================================================================
+ *  @name   RING_IO_BulkLedger
+ *
+ *  @desc   Bulk buffers handed to the DSP, shared by the writer and the
+ *          reader clients whether they are threads or processes. A
+ *          descriptor the reader cannot translate is matched here, so that
+ *          the writer can take its buffer back.
+ *
+ *  @field  dspAddrs
+ *              DSP address of the payload of each bulk buffer sent, 0 if
+ *              none was sent. Written by the writer.
+ *  @field  lost
+ *              Set by the reader for a buffer the descriptor of which could
+ *              not be translated.
+ *  @field  unknown
+ *              Number of descriptors matching no buffer sent.
+ *  @field  semFree
+ *              Posted by the reader each time it gives a buffer back.
+ *  ============================================================================
+ */
+typedef struct RING_IO_BulkLedger_tag {
+	volatile Uint32  dspAddrs [RING_IO_BULK_NUM_BUFS];
+	volatile Uint32  lost [RING_IO_BULK_NUM_BUFS];
+	volatile Uint32  unknown;
+	Pvoid            semFree;
+} RING_IO_BulkLedger;
+
+/** ============================================================================
+ *  @name   RING_IO_StreamObj
+ *
+ *  @desc   State of a stream.
+ *
+ *  @field  chnl
+ *              Channel used for the stream.
+ *  @field  mode
+ *              RING_IO_MODE_STREAM, RING_IO_MODE_FILTER or RING_IO_MODE_BULK.
+ *  @field  inFile
+ *              Path of the input file.
+ *  @field  outFile
+ *              Path of the output file.
+ *  @field  inAddr
+ *              Mapping of the input file.
+ *  @field  inSize
+ *              Size of the input file.
+ *  @field  inOffset
+ *              Number of bytes of the input file already sent.
+ *  @field  outHandle
+ *              Handle of the output file.
+ *  @field  poolId
+ *              Pool of the bulk buffers.
+ *  @field  bulkBufs
+ *              Bulk buffers, including their header. Writer side only.
+ *  @field  bulkLedger
+ *              Bulk buffers handed to the DSP, in shared memory.
+ *  @field  rcvDesc
+ *              Descriptor being received. Reader side only.
+ *  @field  rcvDescFill
+ *              Number of bytes of rcvDesc received so far.
+ *  @field  rcvDescs
+ *              Number of descriptors received.
+ *  @field  rcvBytes
+ *              Number of payload bytes received.
+ *  ============================================================================
+ */
+typedef struct RING_IO_StreamObj_tag {
+	RING_IO_ChnlObj *  chnl;
+	RING_IO_Mode       mode;
+	Char8 *            inFile;
+	Char8 *            outFile;
+	Uint8 *            inAddr;
+	RING_IO_Uint64     inSize;
+	RING_IO_Uint64     inOffset;
+	Pvoid              outHandle;
+	PoolId             poolId;
+	Uint8 *            bulkBufs [RING_IO_BULK_NUM_BUFS];
+	RING_IO_BulkLedger * bulkLedger;
+	RING_IO_BulkDesc   rcvDesc;
+	Uint32             rcvDescFill;
+	RING_IO_Uint64     rcvDescs;
+	RING_IO_Uint64     rcvBytes;
+} RING_IO_StreamObj;
+
+/** ============================================================================
+ *  @name   RING_IO_Stream
+ *
+ *  @desc   The stream being run.
+ *  ============================================================================
+ */
+STATIC RING_IO_StreamObj RING_IO_Stream;
+
+/** ============================================================================
+ *  @name   streamWriterInfo, streamReaderInfo
+ *
+ *  @desc   Writer and reader client information structures.
+ *  ============================================================================
+ */
+STATIC RING_IO_ClientInfo streamWriterInfo;
+STATIC RING_IO_ClientInfo streamReaderInfo;
+
+
+/** ----------------------------------------------------------------------------
+ *  @func   RING_IO_StreamFill
+ *
+ *  @desc   Fill function of the stream: copies the next part of the mapped
+ *          input file into the acquired buffer.
+ *
+ *  @modif  inOffset of the stream.
+ *  ----------------------------------------------------------------------------
+ */
+STATIC
+NORMAL_API
+DSP_STATUS
+RING_IO_StreamFill (IN  Pvoid arg,
+		IN  RingIO_BufPtr buffer,
+		IN  Uint32 size,
+		OUT Uint32 * filled)
+{
+	RING_IO_StreamObj * stream = (RING_IO_StreamObj *) arg;
+	RING_IO_Uint64 remain = stream->inSize - stream->inOffset;
+
+	if (size > remain) {
+		size = (Uint32) remain;
+	}
+
+	if (size > 0) {
+		RING_IO_Copy (buffer, stream->inAddr + stream->inOffset, size);
+		stream->inOffset += size;
+	}
+	*filled = size;
+
+	return (DSP_SOK);
+}
+
+/** ----------------------------------------------------------------------------
+ *  @func   RING_IO_FilterFill
+ *
+ *  @desc   Fill function of the filter: reads the standard input directly
+ *          into the acquired buffer.
+ *
+ *  @modif  None
+ *  ----------------------------------------------------------------------------
+ */
+STATIC
+NORMAL_API
+DSP_STATUS
+RING_IO_FilterFill (IN  Pvoid arg,
+		IN  RingIO_BufPtr buffer,
+		IN  Uint32 size,
+		OUT Uint32 * filled)
+{
+	(Void) arg;
+
+	return (RING_IO_StdinRead (buffer, size, filled));
+}
+
+/** ----------------------------------------------------------------------------
+ *  @func   RING_IO_FilterDrain
+ *
+ *  @desc   Drain function of the filter: sends the received data to the
+ *          standard output.
+ *
+ *  @modif  None
+ *  ----------------------------------------------------------------------------
+ */
+STATIC
+NORMAL_API
+DSP_STATUS
+RING_IO_FilterDrain (IN Pvoid arg,
+		IN RingIO_BufPtr buffer,
+		IN Uint32 size)
+{
+	RING_IO_StreamObj * stream = (RING_IO_StreamObj *) arg;
+
+	return (RING_IO_StdoutWrite (stream->outHandle, buffer, size));
+}
+
+/** ----------------------------------------------------------------------------
+ *  @func   RING_IO_StreamDrain
+ *
+ *  @desc   Drain function of the stream: queues the received data on the
+ *          output file.
+ *
+ *  @modif  None
+ *  ----------------------------------------------------------------------------
+ */
+STATIC
+NORMAL_API
+DSP_STATUS
+RING_IO_StreamDrain (IN Pvoid arg,
+		IN RingIO_BufPtr buffer,
+		IN Uint32 size)
+{
+	RING_IO_StreamObj * stream = (RING_IO_StreamObj *) arg;
+
+	return (RING_IO_AsyncFileWrite (stream->outHandle, buffer, size));
+}
+
+/** ----------------------------------------------------------------------------
+ *  @func   RING_IO_BulkReclaim
+ *
+ *  @desc   Checks whether a bulk buffer is free, taking back a buffer the
+ *          reader reported lost.
+ *
+ *  @ret    TRUE if the buffer is free.
+ *
+ *  @modif  Header of the buffer.
+ *  ----------------------------------------------------------------------------
+ */
+STATIC
+NORMAL_API
+Bool
+RING_IO_BulkReclaim (IN RING_IO_StreamObj * stream, IN Uint32 index)
+{
+	volatile Uint32 * state = (volatile Uint32 *) stream->bulkBufs [index];
+
+	if (RING_IO_AtomicXchg (&stream->bulkLedger->lost [index], 0u) != 0) {
+		/* Its descriptor came back unusable, the DSP is done with it */
+		*state = RING_IO_BULK_FREE;
+		POOL_writeback (stream->poolId,
+				stream->bulkBufs [index],
+				RING_IO_BULK_HDR_SIZE);
+	}
+	else {
+		POOL_invalidate (stream->poolId,
+				stream->bulkBufs [index],
+				RING_IO_BULK_HDR_SIZE);
+	}
+
+	return ((*state == RING_IO_BULK_FREE) ? TRUE : FALSE);
+}
+
+/** ----------------------------------------------------------------------------
+ *  @func   RING_IO_BulkFill
+ *
+ *  @desc   Fill function of the bulk mode: copies the next part of the
+ *          mapped input file into a free bulk buffer and places its
+ *          descriptor in the acquired buffer. Waits for the DSP to return a
+ *          buffer if none is free, at most RING_IO_BULK_FREE_TIMEOUT.
+ *
+ *  @modif  inOffset of the stream.
+ *  ----------------------------------------------------------------------------
+ */
+STATIC
+NORMAL_API
+DSP_STATUS
+RING_IO_BulkFill (IN  Pvoid arg,
+		IN  RingIO_BufPtr buffer,
+		IN  Uint32 size,
+		OUT Uint32 * filled)
+{
+	DSP_STATUS status = DSP_SOK;
+	RING_IO_StreamObj * stream = (RING_IO_StreamObj *) arg;
+	volatile Uint32 * state = NULL;
+	Uint8 * payload = NULL;
+	Pvoid dspAddr = NULL;
+	RING_IO_BulkDesc desc;
+	RING_IO_Uint64 deadline;
+	RING_IO_Uint64 now;
+	Uint32 copySize;
+	Uint32 slot = 0;
+	Uint32 i;
+
+	*filled = 0;
+	copySize = RING_IO_BULK_BUF_SIZE;
+	if ((stream->inSize - stream->inOffset) < copySize) {
+		copySize = (Uint32) (stream->inSize - stream->inOffset);
+	}
+
+	if ((copySize > 0) && (size < sizeof (RING_IO_BulkDesc))) {
+		status = DSP_ESIZE;
+	}
+
+	deadline = RING_IO_GetTimeUsec () + RING_IO_BULK_FREE_TIMEOUT;
+	while ((copySize > 0) && DSP_SUCCEEDED (status) && (payload == NULL)) {
+		for (i = 0; (i < RING_IO_BULK_NUM_BUFS) && (payload == NULL); i++) {
+			state = (volatile Uint32 *) stream->bulkBufs [i];
+			if (RING_IO_BulkReclaim (stream, i) == TRUE) {
+				payload = stream->bulkBufs [i] + RING_IO_BULK_HDR_SIZE;
+				slot = i;
+			}
+		}
+		if (payload == NULL) {
+			/* All buffers are with the DSP, wait for the reader to get one */
+			now = RING_IO_GetTimeUsec ();
+			if (now >= deadline) {
+				status = DSP_ETIMEOUT;
+				RING_IO_0Print ("No bulk buffer returned by the DSP\n");
+			}
+			else {
+				RING_IO_TimedWaitSem (stream->bulkLedger->semFree,
+						(Uint32) (deadline - now));
+			}
+		}
+	}
+
+	if ((copySize > 0) && DSP_SUCCEEDED (status)) {
+		RING_IO_Copy (payload, stream->inAddr + stream->inOffset, copySize);
+		status = POOL_translateAddr (stream->poolId,
+				&dspAddr,
+				AddrType_Dsp,
+				payload,
+				AddrType_Usr);
+		if (DSP_SUCCEEDED (status)) {
+			/* Busy only once there is a descriptor to give it back */
+			*state = RING_IO_BULK_BUSY;
+			POOL_writeback (stream->poolId,
+					payload - RING_IO_BULK_HDR_SIZE,
+					RING_IO_BULK_HDR_SIZE + copySize);
+
+			desc.poolId = stream->poolId;
+			/* DSP addresses are 32 bits, whatever the size of a GPP pointer */
+			desc.dspAddr = (Uint32) (uintptr_t) dspAddr;
+			desc.size = copySize;
+			stream->bulkLedger->dspAddrs [slot] = desc.dspAddr;
+			memcpy (buffer, &desc, sizeof (RING_IO_BulkDesc));
+			*filled = sizeof (RING_IO_BulkDesc);
+			stream->inOffset += copySize;
+		}
+		else {
+			RING_IO_1Print ("POOL_translateAddr () failed. Status = [0x%x]\n",
+					status);
+		}
+	}
+
+	return (status);
+}
+
+/** ----------------------------------------------------------------------------
+ *  @func   RING_IO_BulkDrain
+ *
+ *  @desc   Drain function of the bulk mode: collects the returned
+ *          descriptors, writes their payload to the output file and gives
+ *          the buffers back to the writer.
+ *
+ *  @modif  rcvDesc of the stream.
+ *  ----------------------------------------------------------------------------
+ */
+STATIC
+NORMAL_API
+DSP_STATUS
+RING_IO_BulkDrain (IN Pvoid arg,
+		IN RingIO_BufPtr buffer,
+		IN Uint32 size)
+{
+	DSP_STATUS status = DSP_SOK;
+	DSP_STATUS tmpStatus = DSP_SOK;
+	RING_IO_StreamObj * stream = (RING_IO_StreamObj *) arg;
+	Uint8 * data = (Uint8 *) buffer;
+	Uint8 * payload = NULL;
+	Uint32 copySize;
+	Uint32 i;
+
+	while (size > 0) {
+		/* A descriptor may be split over two acquires */
+		copySize = sizeof (RING_IO_BulkDesc) - stream->rcvDescFill;
+		if (copySize > size) {
+			copySize = size;
+		}
+		memcpy ((Uint8 *) &stream->rcvDesc + stream->rcvDescFill,
+				data,
+				copySize);
+		stream->rcvDescFill += copySize;
+		data += copySize;
+		size -= copySize;
+
+		if (stream->rcvDescFill < sizeof (RING_IO_BulkDesc)) {
+			break;
+		}
+		stream->rcvDescFill = 0;
+
+		tmpStatus = POOL_translateAddr ((PoolId) stream->rcvDesc.poolId,
+				(Pvoid *) &payload,
+				AddrType_Usr,
+				(Pvoid) (uintptr_t) stream->rcvDesc.dspAddr,
+				AddrType_Dsp);
+		if (DSP_FAILED (tmpStatus)) {
+			RING_IO_1Print ("POOL_translateAddr () failed. Status = [0x%x]\n",
+					tmpStatus);
+			status = tmpStatus;
+
+			/* Let the writer take the buffer back */
+			for (i = 0; i < RING_IO_BULK_NUM_BUFS; i++) {
+				if (stream->bulkLedger->dspAddrs [i]
+						== stream->rcvDesc.dspAddr) {
+					RING_IO_AtomicOr (&stream->bulkLedger->lost [i], 1u);
+					break;
+				}
+			}
+			if (i == RING_IO_BULK_NUM_BUFS) {
+				RING_IO_1Print ("Descriptor of DSP address 0x%x matches no "
+						"bulk buffer\n",
+						stream->rcvDesc.dspAddr);
+				stream->bulkLedger->unknown++;
+			}
+			RING_IO_PostSem (stream->bulkLedger->semFree);
+			continue;
+		}
+
+		POOL_invalidate ((PoolId) stream->rcvDesc.poolId,
+				payload,
+				stream->rcvDesc.size);
+		if ((stream->outHandle != NULL) && DSP_SUCCEEDED (status)) {
+			status = RING_IO_AsyncFileWrite (stream->outHandle,
+					payload,
+					stream->rcvDesc.size);
+		}
+		stream->rcvDescs++;
+		stream->rcvBytes += stream->rcvDesc.size;
+
+		/* The payload has been copied out, give the buffer back */
+		*((volatile Uint32 *) (payload - RING_IO_BULK_HDR_SIZE)) =
+				RING_IO_BULK_FREE;
+		POOL_writeback ((PoolId) stream->rcvDesc.poolId,
+				payload - RING_IO_BULK_HDR_SIZE,
+				RING_IO_BULK_HDR_SIZE);
+		RING_IO_PostSem (stream->bulkLedger->semFree);
+	}
+
+	return (status);
+}
+
+/** ----------------------------------------------------------------------------
+ *  @func   RING_IO_BulkAlloc
+ *
+ *  @desc   Allocates the bulk buffers and marks them free.
+ *
+ *  @modif  bulkBufs of the stream.
+ *  ----------------------------------------------------------------------------
+ */
+STATIC
+NORMAL_API
+DSP_STATUS
+RING_IO_BulkAlloc (IN RING_IO_StreamObj * stream)
+{
+	DSP_STATUS status = DSP_SOK;
+	Pvoid bufPtr = NULL;
+	Uint32 i;
+
+	for (i = 0; (i < RING_IO_BULK_NUM_BUFS) && DSP_SUCCEEDED (status); i++) {
+		status = POOL_alloc (stream->poolId,
+				&bufPtr,
+				RING_IO_BULK_HDR_SIZE + RING_IO_BULK_BUF_SIZE);
+		if (DSP_SUCCEEDED (status)) {
+			stream->bulkBufs [i] = (Uint8 *) bufPtr;
+			*((volatile Uint32 *) bufPtr) = RING_IO_BULK_FREE;
+			POOL_writeback (stream->poolId, bufPtr, RING_IO_BULK_HDR_SIZE);
+		}
+		else {
+			RING_IO_1Print ("POOL_alloc () failed. Status = [0x%x]\n",
+					status);
+		}
+	}
+
+	return (status);
+}
+
+/** ----------------------------------------------------------------------------
+ *  @func   RING_IO_BulkFree
+ *
+ *  @desc   Waits for the DSP to return all the bulk buffers and frees them.
+ *          Buffers not returned within RING_IO_BULK_FREE_TIMEOUT are
+ *          reported and leaked.
+ *
+ *  @modif  bulkBufs of the stream.
+ *  ----------------------------------------------------------------------------
+ */
+STATIC
+NORMAL_API
+Void
+RING_IO_BulkFree (IN RING_IO_StreamObj * stream)
+{
+	RING_IO_Uint64 deadline;
+	RING_IO_Uint64 now;
+	Bool isFree;
+	Uint32 i;
+
+	deadline = RING_IO_GetTimeUsec () + RING_IO_BULK_FREE_TIMEOUT;
+	for (i = 0; i < RING_IO_BULK_NUM_BUFS; i++) {
+		if (stream->bulkBufs [i] == NULL) {
+			continue;
+		}
+
+		isFree = RING_IO_BulkReclaim (stream, i);
+		now = RING_IO_GetTimeUsec ();
+		while ((isFree == FALSE) && (now < deadline)) {
+			RING_IO_TimedWaitSem (stream->bulkLedger->semFree,
+					(Uint32) (deadline - now));
+			isFree = RING_IO_BulkReclaim (stream, i);
+			now = RING_IO_GetTimeUsec ();
+		}
+
+		if (isFree == TRUE) {
+			POOL_free (stream->poolId,
+					stream->bulkBufs [i],
+					RING_IO_BULK_HDR_SIZE + RING_IO_BULK_BUF_SIZE);
+		}
+		else {
+			RING_IO_1Print ("Bulk buffer of DSP address 0x%x not returned, "
+					"leaked\n",
+					stream->bulkLedger->dspAddrs [i]);
+		}
+		stream->bulkBufs [i] = NULL;
+	}
+
+	if (stream->bulkLedger->unknown != 0) {
+		RING_IO_1Print ("Bulk descriptors matching no buffer %u\n",
+				stream->bulkLedger->unknown);
+	}
+}
+
+/** ============================================================================
+ *  @func   RING_IO_StreamWriterClient
+ *
+ *  @desc   Writer client of the stream. An input file that cannot be mapped
+ *          or bulk buffers that cannot be allocated result in an empty
+ *          transfer, so that the DSP and the reader client still see a
+ *          complete transfer.
+ *
+ *  @modif  None
+ *  ============================================================================
+ */
+NORMAL_API
+Void *
+RING_IO_StreamWriterClient (IN Void * ptr)
+{
+	DSP_STATUS status = DSP_SOK;
+	DSP_STATUS tmpStatus = DSP_SOK;
+	RING_IO_StreamObj * stream = (RING_IO_StreamObj *) ptr;
+	Pvoid inAddr = NULL;
+	RING_IO_Uint64 bytesTransfered = 0;
+	RING_IO_Uint64 rtt = 0;
+	RING_IO_ChnlFillFxn fillFxn = &RING_IO_StreamFill;
+	Uint32 i;
+
+	RING_IO_0Print ("Entered RING_IO_StreamWriterClient ()\n");
+
+	if (stream->mode == RING_IO_MODE_FILTER) {
+		fillFxn = &RING_IO_FilterFill;
+	}
+	else {
+		tmpStatus = RING_IO_MapFile (stream->inFile,
+				&inAddr,
+				&stream->inSize);
+		if (DSP_FAILED (tmpStatus)) {
+			RING_IO_1Print ("RING_IO_MapFile () failed. Status = [0x%x]\n",
+					tmpStatus);
+			stream->inSize = 0;
+		}
+	}
+	stream->inAddr = (Uint8 *) inAddr;
+	stream->inOffset = 0;
+
+	if (stream->mode == RING_IO_MODE_BULK) {
+		fillFxn = &RING_IO_BulkFill;
+		tmpStatus = RING_IO_BulkAlloc (stream);
+		if (DSP_FAILED (tmpStatus)) {
+			stream->inSize = 0;
+		}
+	}
+
+	status = RING_IO_ChnlOpenWriter (stream->chnl);
+
+	if (DSP_SUCCEEDED (status)) {
+		status = RING_IO_ChnlWriteStart (stream->chnl);
+	}
+
+	if (DSP_SUCCEEDED (status)) {
+		status = RING_IO_ChnlWrite (stream->chnl,
+				fillFxn,
+				stream,
+				&bytesTransfered);
+		if (DSP_FAILED (status)) {
+			RING_IO_1Print ("RING_IO_ChnlWrite () failed. Status = [0x%x]\n",
+					status);
+		}
+
+		/*
+		 * The ring is now as full as it gets. Urgent messages do not go
+		 * through it, so their round trip must not depend on its backlog.
+		 * A DSP not answering pings is not an error.
+		 */
+		tmpStatus = DSP_SOK;
+		for (i = 0;
+				(i < RING_IO_STREAM_NUM_PINGS) && DSP_SUCCEEDED (tmpStatus);
+				i++) {
+			tmpStatus = RING_IO_NotifyPing (stream->chnl, &rtt);
+		}
+
+		/* Always terminate the transfer so that the reader completes */
+		tmpStatus = RING_IO_ChnlWriteEnd (stream->chnl);
+		if (DSP_SUCCEEDED (status) && DSP_FAILED (tmpStatus)) {
+			status = tmpStatus;
+		}
+	}
+
+	RING_IO_1Print64 ("GPP-->DSP:Total Bytes Transmitted  %llu \n",
+			bytesTransfered);
+	RING_IO_NotifyReport (bytesTransfered);
+	if (stream->mode == RING_IO_MODE_BULK) {
+		RING_IO_1Print64 ("GPP-->DSP:Payload Bytes Transmitted  %llu \n",
+				stream->inOffset);
+		RING_IO_BulkFree (stream);
+	}
+
+	tmpStatus = RING_IO_ChnlCloseWriter (stream->chnl);
+	if (DSP_SUCCEEDED (status) && DSP_FAILED (tmpStatus)) {
+		status = tmpStatus;
+	}
+
+	if (inAddr != NULL) {
+		RING_IO_UnmapFile (inAddr, stream->inSize);
+	}
+
+	RING_IO_0Print ("Leaving RING_IO_StreamWriterClient ()\n");
+
+	/* Exit */
+	RING_IO_Exit_client (&streamWriterInfo);
+
+	return (NULL);
+}
+
+/** ============================================================================
+ *  @func   RING_IO_StreamReaderClient
+ *
+ *  @desc   Reader client of the stream. If the output file cannot be created
+ *          the data is still drained from the DSP and discarded.
+ *
+ *  @modif  None
+ *  ============================================================================
+ */
+NORMAL_API
+Void *
+RING_IO_StreamReaderClient (IN Void * ptr)
+{
+	DSP_STATUS status = DSP_SOK;
+	DSP_STATUS tmpStatus = DSP_SOK;
+	RING_IO_StreamObj * stream = (RING_IO_StreamObj *) ptr;
+	RING_IO_Uint64 totalRcvbytes = 0;
+	RING_IO_Uint64 startTime;
+	RING_IO_Uint64 elapsed;
+	RING_IO_ChnlDrainFxn drainFxn = &RING_IO_StreamDrain;
+
+	RING_IO_0Print ("Entered RING_IO_StreamReaderClient ()\n");
+
+	if (stream->mode == RING_IO_MODE_FILTER) {
+		drainFxn = &RING_IO_FilterDrain;
+		status = RING_IO_StdoutOpen (stream->chnl->readerBufSize,
+				&stream->outHandle);
+	}
+	else {
+		if (stream->mode == RING_IO_MODE_BULK) {
+			drainFxn = &RING_IO_BulkDrain;
+		}
+		status = RING_IO_AsyncFileOpen (stream->outFile,
+				RING_IO_STREAM_SLOT_SIZE,
+				RING_IO_STREAM_NUM_SLOTS,
+				&stream->outHandle);
+	}
+	if (DSP_FAILED (status)) {
+		RING_IO_1Print ("Opening the output failed. Status = [0x%x]\n",
+				status);
+	}
+
+	tmpStatus = RING_IO_ChnlOpenReader (stream->chnl);
+	if (DSP_SUCCEEDED (tmpStatus)) {
+		startTime = RING_IO_GetTimeMsec ();
+		/* Bulk buffers must be given back even without an output */
+		tmpStatus = RING_IO_ChnlRead (stream->chnl,
+				(   (stream->outHandle != NULL)
+				 || (stream->mode == RING_IO_MODE_BULK)) ? drainFxn : NULL,
+				stream,
+				&totalRcvbytes);
+		elapsed = RING_IO_GetTimeMsec () - startTime;
+
+		if (stream->mode == RING_IO_MODE_BULK) {
+			RING_IO_1Print64 ("GPP<--DSP:Descriptors Received %llu \n",
+					stream->rcvDescs);
+			totalRcvbytes = stream->rcvBytes;
+		}
+
+		RING_IO_1Print64 ("GPP<--DSP:Bytes Received %llu \n", totalRcvbytes);
+		RING_IO_1Print64 ("GPP<--DSP:Elapsed time %llu ms\n", elapsed);
+		if (elapsed > 0) {
+			RING_IO_1Print64 ("GPP<--DSP:Throughput %llu KB/s\n",
+					totalRcvbytes / elapsed);
+		}
+		if (   DSP_FAILED (RING_IO_ChnlSeqReport (stream->chnl))
+			&& DSP_SUCCEEDED (status)) {
+			status = DSP_EFAIL;
+		}
+	}
+	if (DSP_SUCCEEDED (status) && DSP_FAILED (tmpStatus)) {
+		status = tmpStatus;
+		RING_IO_1Print ("RING_IO_ChnlRead () failed. Status = [0x%x]\n",
+				status);
+	}
+
+	tmpStatus = RING_IO_ChnlCloseReader (stream->chnl);
+	if (DSP_SUCCEEDED (status) && DSP_FAILED (tmpStatus)) {
+		status = tmpStatus;
+	}
+
+	if ((stream->outHandle != NULL) && (stream->mode == RING_IO_MODE_FILTER)) {
+		RING_IO_StdoutClose (stream->outHandle);
+		stream->outHandle = NULL;
+	}
+	else if (stream->outHandle != NULL) {
+		tmpStatus = RING_IO_AsyncFileClose (stream->outHandle);
+		stream->outHandle = NULL;
+		if (DSP_FAILED (tmpStatus)) {
+			RING_IO_1Print ("RING_IO_AsyncFileClose () failed. "
+					"Status = [0x%x]\n",
+					tmpStatus);
+		}
+	}
+
+	RING_IO_0Print ("Leaving RING_IO_StreamReaderClient ()\n");
+
+	/* Exit */
+	RING_IO_Exit_client (&streamReaderInfo);
+
+	return (NULL);
+}
+
+/** ----------------------------------------------------------------------------
+ *  @func   RING_IO_StreamStart
+ *
+ *  @desc   Runs the writer and reader clients of a prepared stream and shuts
+ *          down all the channels when they are done.
+ *
+ *  @modif  writerAcqSize of the channel used.
+ *  ----------------------------------------------------------------------------
+ */
+STATIC
+NORMAL_API
+DSP_STATUS
+RING_IO_StreamStart (IN RING_IO_StreamObj * stream,
+		IN RING_IO_ChnlObj * chnls,
+		IN Uint8 processorId)
+{
+	DSP_STATUS status = DSP_SOK;
+	DSP_STATUS tmpStatus = DSP_SOK;
+
+	/*
+	 * Acquire half of the writer RingIO at a time, so that the GPP fills
+	 * one half while the DSP consumes the other. In bulk mode every record
+	 * is a single descriptor.
+	 */
+	stream->chnl->writerAcqSize = DSPLINK_ALIGN (
+			stream->chnl->writerBufSize / 2u,
+			DSPLINK_BUF_ALIGN);
+	if (stream->chnl->writerAcqSize > stream->chnl->writerBufSize) {
+		stream->chnl->writerAcqSize = stream->chnl->writerBufSize;
+	}
+	if (stream->mode == RING_IO_MODE_BULK) {
+		stream->chnl->writerAcqSize = sizeof (RING_IO_BulkDesc);
+		stream->chnl->xferMode = RING_IO_XFER_BULK;
+	}
+
+	streamReaderInfo.processorId = processorId;
+	status = RING_IO_Create_client (&streamReaderInfo,
+			(Pvoid) RING_IO_StreamReaderClient,
+			stream);
+	if (DSP_SUCCEEDED (status)) {
+		streamWriterInfo.processorId = processorId;
+		status = RING_IO_Create_client (&streamWriterInfo,
+				(Pvoid) RING_IO_StreamWriterClient,
+				stream);
+		if (DSP_SUCCEEDED (status)) {
+			RING_IO_Join_client (&streamWriterInfo);
+		}
+		else {
+			RING_IO_0Print ("ERROR! Failed to create stream writer client\n");
+		}
+		RING_IO_Join_client (&streamReaderInfo);
+	}
+	else {
+		RING_IO_0Print ("ERROR! Failed to create stream reader client\n");
+	}
+
+	stream->chnl->xferMode = RING_IO_XFER_DATA;
+
+	/* End the DSP side of every channel, used or not */
+	tmpStatus = RING_IO_ChnlShutdownAll (chnls, RING_IO_NUM_CHNLS);
+	if (DSP_SUCCEEDED (status) && DSP_FAILED (tmpStatus)) {
+		status = tmpStatus;
+	}
+
+	return (status);
+}
+
+/** ============================================================================
+ *  @func   RING_IO_StreamRun
+ *
+ *  @desc   Streams a file through one channel of the DSP.
+ *
+ *  @modif  None
+ *  ============================================================================
+ */
+NORMAL_API
+DSP_STATUS
+RING_IO_StreamRun (IN RING_IO_ChnlObj * chnls,
+		IN Uint32 chnlId,
+		IN Uint8 processorId,
+		IN Char8 * inFile,
+		IN Char8 * outFile)
+{
+	RING_IO_StreamObj * stream = &RING_IO_Stream;
+
+	stream->chnl = &chnls [chnlId];
+	stream->mode = RING_IO_MODE_STREAM;
+	stream->inFile = inFile;
+	stream->outFile = outFile;
+	stream->inAddr = NULL;
+	stream->inSize = 0;
+	stream->inOffset = 0;
+	stream->outHandle = NULL;
+
+	return (RING_IO_StreamStart (stream, chnls, processorId));
+}
+
+/** ============================================================================
+ *  @func   RING_IO_FilterRun
+ *
+ *  @desc   Streams the standard input through one channel of the DSP to the
+ *          standard output.
+ *
+ *  @modif  None
+ *  ============================================================================
+ */
+NORMAL_API
+DSP_STATUS
+RING_IO_FilterRun (IN RING_IO_ChnlObj * chnls,
+		IN Uint32 chnlId,
+		IN Uint8 processorId)
+{
+	RING_IO_StreamObj * stream = &RING_IO_Stream;
+
+	stream->chnl = &chnls [chnlId];
+	stream->mode = RING_IO_MODE_FILTER;
+	stream->inFile = NULL;
+	stream->outFile = NULL;
+	stream->inAddr = NULL;
+	stream->inSize = 0;
+	stream->inOffset = 0;
+	stream->outHandle = NULL;
+
+	return (RING_IO_StreamStart (stream, chnls, processorId));
+}
+
+/** ============================================================================
+ *  @func   RING_IO_BulkRun
+ *
+ *  @desc   Streams a file through one channel of the DSP, passing POOL
+ *          buffer descriptors.
+ *
+ *  @modif  None
+ *  ============================================================================
+ */
+NORMAL_API
+DSP_STATUS
+RING_IO_BulkRun (IN RING_IO_ChnlObj * chnls,
+		IN Uint32 chnlId,
+		IN Uint8 processorId,
+		IN Char8 * inFile,
+		IN Char8 * outFile)
+{
+	DSP_STATUS status = DSP_SOK;
+	DSP_STATUS tmpStatus = DSP_SOK;
+	RING_IO_StreamObj * stream = &RING_IO_Stream;
+	Pvoid addr = NULL;
+	Uint32 i;
+
+	memset (stream, 0, sizeof (RING_IO_StreamObj));
+	stream->chnl = &chnls [chnlId];
+	stream->mode = RING_IO_MODE_BULK;
+	stream->inFile = inFile;
+	stream->outFile = outFile;
+	stream->poolId = POOL_makePoolId (processorId, RING_IO_BULK_POOL_ID);
+	for (i = 0; i < RING_IO_BULK_NUM_BUFS; i++) {
+		stream->bulkBufs [i] = NULL;
+	}
+
+	/* Mapped before the clients are created, so that both see it */
+	status = RING_IO_ShmAlloc (sizeof (RING_IO_BulkLedger), &addr);
+	if (DSP_FAILED (status)) {
+		RING_IO_1Print ("RING_IO_ShmAlloc () failed. Status = [0x%x]\n",
+				status);
+	}
+	else {
+		stream->bulkLedger = (RING_IO_BulkLedger *) addr;
+		status = RING_IO_CreateShmSem (&stream->bulkLedger->semFree);
+		if (DSP_FAILED (status)) {
+			RING_IO_1Print ("RING_IO_CreateShmSem () failed. "
+					"Status = [0x%x]\n",
+					status);
+		}
+	}
+
+	if (DSP_FAILED (status)) {
+		/* The DSP side of the channels still has to be ended */
+		RING_IO_ChnlShutdownAll (chnls, RING_IO_NUM_CHNLS);
+	}
+	else {
+		status = RING_IO_StreamStart (stream, chnls, processorId);
+	}
+
+	if (stream->bulkLedger != NULL) {
+		if (stream->bulkLedger->semFree != NULL) {
+			tmpStatus = RING_IO_DeleteShmSem (stream->bulkLedger->semFree);
+			if (DSP_SUCCEEDED (status) && DSP_FAILED (tmpStatus)) {
+				status = tmpStatus;
+			}
+		}
+		RING_IO_ShmFree (stream->bulkLedger, sizeof (RING_IO_BulkLedger));
+		stream->bulkLedger = NULL;
+	}
+
+	return (status);
+}
+
+#if defined (__cplusplus)
+}
+#endif /* defined (__cplusplus) */
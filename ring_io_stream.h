@@ -0,0 +1,259 @@
+/** ============================================================================
+ *  @file   ring_io_stream.h
+ *
+ *  @path   $(DSPLINK)/gpp/src/samples/ring_io/
+ *
+ *  @desc   Defines the streaming modes of the ring_io application, which
+ *          push the contents of an input file or of the standard input
+ *          through the DSP and store the processed data in an output file or
+ *          send it to the standard output. Large payloads can be passed as
+ *          POOL buffer descriptors.
+ *
+ *  @ver    1.65.00.02
+ *  ============================================================================
+ *  Copyright (C) 2002-2009, Texas Instruments Incorporated -
+ *  http://www.ti.com/
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions
+ *  are met:
+ *  
+ *  *  Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *  
+ *  *  Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer in the
+ *     documentation and/or other materials provided with the distribution.
+ *  
+ *  *  Neither the name of Texas Instruments Incorporated nor the names of
+ *     its contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *  
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ *  THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ *  PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+ *  CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ *  EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ *  PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ *  OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ *  WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ *  OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ *  EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *  ============================================================================
+ */
+
+
+#if !defined (RING_IO_STREAM_H)
+#define RING_IO_STREAM_H
+
+
+/*  ----------------------------------- DSP/BIOS Link                 */
+#include <dsplink.h>
+
+/*  ----------------------------------- Application Header            */
+#include <ring_io_chnl.h>
+
+
+#if defined (__cplusplus)
+extern "C" {
+#endif /* defined (__cplusplus) */
+
+
+/** ============================================================================
+ *  @const  RING_IO_STREAM_SLOT_SIZE
+ *
+ *  @desc   Size of each staging buffer used to write the output file.
+ *  ============================================================================
+ */
+#define RING_IO_STREAM_SLOT_SIZE    65536u
+
+/** ============================================================================
+ *  @const  RING_IO_STREAM_NUM_SLOTS
+ *
+ *  @desc   Number of staging buffers used to write the output file, i.e. the
+ *          maximum number of writes in flight.
+ *  ============================================================================
+ */
+#define RING_IO_STREAM_NUM_SLOTS    4u
+
+/** ============================================================================
+ *  @const  RING_IO_BULK_POOL_ID
+ *
+ *  @desc   ID of the pool holding the payload buffers of RING_IO_BulkRun ().
+ *          Opened by RING_IO_Create () before the DSP executable is loaded,
+ *          so that the DSP can address it from its start.
+ *  ============================================================================
+ */
+#define RING_IO_BULK_POOL_ID        1u
+
+/** ============================================================================
+ *  @const  RING_IO_BULK_NUM_BUFS
+ *
+ *  @desc   Number of payload buffers of RING_IO_BulkRun (), i.e. the maximum
+ *          number of descriptors in flight.
+ *  ============================================================================
+ */
+#define RING_IO_BULK_NUM_BUFS       4u
+
+/** ============================================================================
+ *  @const  RING_IO_BULK_BUF_SIZE
+ *
+ *  @desc   Payload size of each buffer of RING_IO_BulkRun ().
+ *  ============================================================================
+ */
+#define RING_IO_BULK_BUF_SIZE       1048576u
+
+/** ============================================================================
+ *  @const  RING_IO_BULK_HDR_SIZE
+ *
+ *  @desc   Size of the header preceding each payload, holding the state of
+ *          the buffer. A full cache line so that it is written back
+ *          independently of the payload.
+ *  ============================================================================
+ */
+#define RING_IO_BULK_HDR_SIZE       DSPLINK_BUF_ALIGN
+
+/** ============================================================================
+ *  @const  RING_IO_STREAM_NUM_PINGS
+ *
+ *  @desc   Number of urgent pings sent once the data is written, while the
+ *          DSP still drains it, to measure the control latency under load.
+ *  ============================================================================
+ */
+#define RING_IO_STREAM_NUM_PINGS    4u
+
+
+/** ============================================================================
+ *  @func   RING_IO_StreamRun
+ *
+ *  @desc   Streams a file through one channel of the DSP.
+ *          A writer client maps the input file and copies it into buffers
+ *          acquired from the writer RingIO, while a reader client drains the
+ *          reader RingIO into the output file. Both run concurrently so that
+ *          the transfer is paced by the DSP only. The other channels are
+ *          shut down.
+ *
+ *  @arg    chnls
+ *              Array of RING_IO_NUM_CHNLS initialized channel objects.
+ *  @arg    chnlId
+ *              Index of the channel used for the stream.
+ *  @arg    processorId
+ *              ID of the DSP processor.
+ *  @arg    inFile
+ *              Path of the input file.
+ *  @arg    outFile
+ *              Path of the output file.
+ *
+ *  @ret    DSP_SOK
+ *              Operation successfully completed.
+ *          DSP_EFAIL
+ *              General failure.
+ *
+ *  @enter  The DSP executable has been started by RING_IO_Create ().
+ *
+ *  @leave  None
+ *
+ *  @see    None
+ *  ============================================================================
+ */
+NORMAL_API
+DSP_STATUS
+RING_IO_StreamRun (IN RING_IO_ChnlObj * chnls,
+                   IN Uint32            chnlId,
+                   IN Uint8             processorId,
+                   IN Char8 *           inFile,
+                   IN Char8 *           outFile) ;
+
+/** ============================================================================
+ *  @func   RING_IO_FilterRun
+ *
+ *  @desc   Streams the standard input through one channel of the DSP to the
+ *          standard output, e.g. in a shell pipeline.
+ *          The standard input is read in blocks directly into buffers
+ *          acquired from the writer RingIO. The received data is written to
+ *          the standard output, with vmsplice () when it is a pipe. The other
+ *          channels are shut down.
+ *
+ *  @arg    chnls
+ *              Array of RING_IO_NUM_CHNLS initialized channel objects.
+ *  @arg    chnlId
+ *              Index of the channel used for the stream.
+ *  @arg    processorId
+ *              ID of the DSP processor.
+ *
+ *  @ret    DSP_SOK
+ *              Operation successfully completed.
+ *          DSP_EFAIL
+ *              General failure.
+ *
+ *  @enter  The DSP executable has been started by RING_IO_Create ().
+ *          Messages are printed to the standard error, see
+ *          RING_IO_PrintToStderr ().
+ *
+ *  @leave  None
+ *
+ *  @see    RING_IO_StreamRun
+ *  ============================================================================
+ */
+NORMAL_API
+DSP_STATUS
+RING_IO_FilterRun (IN RING_IO_ChnlObj * chnls,
+                   IN Uint32            chnlId,
+                   IN Uint8             processorId) ;
+
+
+/** ============================================================================
+ *  @func   RING_IO_BulkRun
+ *
+ *  @desc   Streams a file through one channel of the DSP without copying the
+ *          payload through the RingIO.
+ *          The payload is placed in buffers of the dedicated pool
+ *          RING_IO_BULK_POOL_ID, and only a RING_IO_BulkDesc per buffer is
+ *          written to the
+ *          writer RingIO. A buffer is written to the output file and reused
+ *          when the DSP returns its descriptor on the reader RingIO. The
+ *          other channels are shut down.
+ *
+ *  @arg    chnls
+ *              Array of RING_IO_NUM_CHNLS initialized channel objects.
+ *  @arg    chnlId
+ *              Index of the channel used for the descriptors.
+ *  @arg    processorId
+ *              ID of the DSP processor.
+ *  @arg    inFile
+ *              Path of the input file.
+ *  @arg    outFile
+ *              Path of the output file.
+ *
+ *  @ret    DSP_SOK
+ *              Operation successfully completed.
+ *          DSP_EMEMORY
+ *              Out of memory.
+ *          DSP_ETIMEOUT
+ *              The DSP did not return a bulk buffer in time.
+ *          DSP_EFAIL
+ *              General failure.
+ *
+ *  @enter  The DSP executable has been started by RING_IO_Create ().
+ *
+ *  @leave  None
+ *
+ *  @see    RING_IO_StreamRun
+ *  ============================================================================
+ */
+NORMAL_API
+DSP_STATUS
+RING_IO_BulkRun (IN RING_IO_ChnlObj * chnls,
+                 IN Uint32            chnlId,
+                 IN Uint8             processorId,
+                 IN Char8 *           inFile,
+                 IN Char8 *           outFile) ;
+
+
+#if defined (__cplusplus)
+}
+#endif /* defined (__cplusplus) */
+
+
+#endif /* !defined (RING_IO_STREAM_H) */
@@ -0,0 +1,613 @@
+/** ============================================================================
+ *  @file   ring_io_tune.c
+ *
+ *  @path   $(DSPLINK)/gpp/src/samples/ring_io/
+ *
+ *  @desc   Implementation of the ring size tuner of the ring_io application.
+ *          The tuner is a client of its own which wakes up every
+ *          RING_IO_TUNE_TICK microseconds to check whether it must stop, and
+ *          samples the counters of the channels every RING_IO_TUNE_PERIOD
+ *          microseconds. Its decisions live in shared memory with the sizes
+ *          they were taken for, as the channel objects of a
+ *          RING_IO_MULTIPROCESS client are copies. They are applied by the
+ *          main client, between transfers, since resizing closes the
+ *          RingIOs.
+ *
+ *  @ver    1.65.00.02
+ *  ============================================================================
+ *  Copyright (C) 2002-2009, Texas Instruments Incorporated -
+ *  http://www.ti.com/
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions
+ *  are met:
+ *  
+ *  *  Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *  
+ *  *  Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer in the
+ *     documentation and/or other materials provided with the distribution.
+ *  
+ *  *  Neither the name of Texas Instruments Incorporated nor the names of
+ *     its contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *  
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ *  THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ *  PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+ *  CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ *  EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ *  PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ *  OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ *  WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ *  OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ *  EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *  ============================================================================
+ */
+
+/*  ------------------------ DSP/BIOS Link ----------------------------------*/
+#include <dsplink.h>
+
+/*  ------------------------DSP/BIOS LINK API -------------------------------*/
+#include <ringio.h>
+#include <string.h>
+
+/*  ------------------------ Application Header------------------------------*/
+#include <ring_io.h>
+#include <ring_io_os.h>
+#include <ring_io_chnl.h>
+#include <ring_io_tune.h>
+
+
+#if defined (__cplusplus)
+extern "C" {
+#endif /* defined (__cplusplus) */
+
+
+/** ============================================================================
+ *  @const  RING_IO_TUNE_TICK
+ *
+ *  @desc   Interval in microseconds at which the tuner checks whether it must
+ *          stop.
+ *  ============================================================================
+ */
+#define RING_IO_TUNE_TICK           10000u
+
+/** ============================================================================
+ *  @const  RING_IO_TUNE_SETTLE
+ *
+ *  @desc   Number of periods with data transfer after the decisions of a
+ *          channel are applied before its throughput is measured again. The
+ *          first one includes the resize itself.
+ *  ============================================================================
+ */
+#define RING_IO_TUNE_SETTLE         2u
+
+/** ============================================================================
+ *  @name   RING_IO_TuneEntry
+ *
+ *  @desc   State of the tuner for a channel.
+ *
+ *  @field  last
+ *              Counters of the channel at the end of the last period.
+ *  @field  writerSize
+ *              Size of the writer RingIO.
+ *  @field  readerSize
+ *              Size of the reader RingIO.
+ *  @field  acqSize
+ *              Watermark of the writer RingIO, i.e. its acquire size.
+ *  @field  newWriterSize
+ *              Size of the writer RingIO last chosen.
+ *  @field  newReaderSize
+ *              Size of the reader RingIO last chosen.
+ *  @field  newAcqSize
+ *              Watermark last chosen.
+ *  @field  pending
+ *              Set by the tuner when the choice is to be applied, cleared by
+ *              RING_IO_TuneApply () once it is.
+ *  @field  settle
+ *              Number of periods left before the throughput is measured
+ *              after the choice was applied.
+ *  @field  rateBefore
+ *              Throughput in bytes per second of the period the choice was
+ *              made in.
+ *  ============================================================================
+ */
+typedef struct RING_IO_TuneEntry_tag {
+	RING_IO_ChnlTuneStats  last;
+	Uint32                 writerSize;
+	Uint32                 readerSize;
+	Uint32                 acqSize;
+	Uint32                 newWriterSize;
+	Uint32                 newReaderSize;
+	Uint32                 newAcqSize;
+	volatile Uint32        pending;
+	volatile Uint32        settle;
+	RING_IO_Uint64         rateBefore;
+} RING_IO_TuneEntry;
+
+/** ============================================================================
+ *  @name   RING_IO_TuneObj
+ *
+ *  @desc   State of the tuner, shared by the tuner client and the main
+ *          client.
+ *
+ *  @field  stop
+ *              Set to stop the tuner client.
+ *  @field  mode
+ *              Whether the choices are only logged or also applied.
+ *  @field  processorId
+ *              ID of the DSP processor.
+ *  @field  attrBufSize
+ *              Size of the attribute buffer of the RingIOs.
+ *  @field  chnls
+ *              Channels of the application.
+ *  @field  numChnls
+ *              Number of channels.
+ *  @field  entries
+ *              State of the tuner for each channel.
+ *  ============================================================================
+ */
+typedef struct RING_IO_TuneObj_tag {
+	volatile Uint32        stop;
+	RING_IO_TuneMode       mode;
+	Uint8                  processorId;
+	Uint32                 attrBufSize;
+	RING_IO_ChnlObj *      chnls;
+	Uint32                 numChnls;
+	RING_IO_TuneEntry      entries [RING_IO_NUM_CHNLS];
+} RING_IO_TuneObj;
+
+/** ============================================================================
+ *  @name   RING_IO_Tune
+ *
+ *  @desc   The tuner, in shared memory. NULL if it is not started.
+ *  ============================================================================
+ */
+STATIC RING_IO_TuneObj * RING_IO_Tune = NULL;
+
+/** ============================================================================
+ *  @name   tuneClientInfo
+ *
+ *  @desc   Tuner client information structure.
+ *  ============================================================================
+ */
+STATIC RING_IO_ClientInfo tuneClientInfo;
+
+
+/** ----------------------------------------------------------------------------
+ *  @func   RING_IO_TuneSnapshot
+ *
+ *  @desc   Copies the counters of a channel.
+ *
+ *  @modif  None
+ *  ----------------------------------------------------------------------------
+ */
+STATIC
+NORMAL_API
+Void
+RING_IO_TuneSnapshot (IN  RING_IO_ChnlTuneStats * stats,
+		OUT RING_IO_ChnlTuneStats * copy)
+{
+	copy->bytes = stats->bytes;
+	copy->writerWaits = stats->writerWaits;
+	copy->writerWaitTime = stats->writerWaitTime;
+	copy->readerWaits = stats->readerWaits;
+	copy->readerWaitTime = stats->readerWaitTime;
+	copy->notifies = stats->notifies;
+	copy->occupancySum = stats->occupancySum;
+	copy->occupancySamples = stats->occupancySamples;
+}
+
+/** ----------------------------------------------------------------------------
+ *  @func   RING_IO_TuneBudget
+ *
+ *  @desc   Gets the sum of the sizes of the RingIOs of the channels other
+ *          than the one given, counting the choices not applied yet.
+ *
+ *  @modif  None
+ *  ----------------------------------------------------------------------------
+ */
+STATIC
+NORMAL_API
+Uint32
+RING_IO_TuneBudget (IN RING_IO_TuneObj * tune, IN Uint32 chnlId)
+{
+	RING_IO_TuneEntry * entry;
+	Uint32 total = 0;
+	Uint32 i;
+
+	for (i = 0; i < tune->numChnls; i++) {
+		entry = &tune->entries [i];
+		if (i == chnlId) {
+			continue;
+		}
+		if (entry->pending == TRUE) {
+			total += entry->newWriterSize + entry->newReaderSize;
+		}
+		else {
+			total += entry->writerSize + entry->readerSize;
+		}
+	}
+
+	return (total);
+}
+
+/** ----------------------------------------------------------------------------
+ *  @func   RING_IO_TuneLog
+ *
+ *  @desc   Logs the measurements of a period and the choice made from them.
+ *
+ *  @modif  None
+ *  ----------------------------------------------------------------------------
+ */
+STATIC
+NORMAL_API
+Void
+RING_IO_TuneLog (IN RING_IO_TuneObj *   tune,
+		IN Uint32              chnlId,
+		IN RING_IO_Uint64      rate,
+		IN RING_IO_Uint64      writerPct,
+		IN RING_IO_Uint64      readerPct,
+		IN RING_IO_Uint64      occPct,
+		IN RING_IO_Uint64      notifyRate)
+{
+	RING_IO_TuneEntry * entry = &tune->entries [chnlId];
+
+	RING_IO_1Print ("RING_IO_Tune: channel %d\n", chnlId);
+	RING_IO_1Print64 ("RING_IO_Tune:   throughput %llu bytes/s\n", rate);
+	RING_IO_1Print64 ("RING_IO_Tune:   writer blocked %llu %%\n", writerPct);
+	RING_IO_1Print64 ("RING_IO_Tune:   reader empty %llu %%\n", readerPct);
+	RING_IO_1Print64 ("RING_IO_Tune:   occupancy %llu %%\n", occPct);
+	RING_IO_1Print64 ("RING_IO_Tune:   notifications %llu /s\n", notifyRate);
+	RING_IO_1Print ("RING_IO_Tune:   writer RingIO %d", entry->writerSize);
+	RING_IO_1Print (" -> %d\n", entry->newWriterSize);
+	RING_IO_1Print ("RING_IO_Tune:   reader RingIO %d", entry->readerSize);
+	RING_IO_1Print (" -> %d\n", entry->newReaderSize);
+	RING_IO_1Print ("RING_IO_Tune:   watermark %d", entry->acqSize);
+	RING_IO_1Print (" -> %d\n", entry->newAcqSize);
+	if (tune->mode == RING_IO_TUNE_APPLY) {
+		RING_IO_0Print ("RING_IO_Tune:   applied after this transfer\n");
+	}
+	else {
+		RING_IO_0Print ("RING_IO_Tune:   recommended\n");
+	}
+}
+
+/** ----------------------------------------------------------------------------
+ *  @func   RING_IO_TuneSample
+ *
+ *  @desc   Samples the counters of a channel at the end of a period and
+ *          chooses new RingIO sizes and watermark from them:
+ *          - A writer often blocked on a mostly full RingIO needs deeper
+ *            RingIOs to ride out the bursts of the DSP.
+ *          - A reader often waiting while the writer RingIO is mostly empty
+ *            is limited by the source, its RingIO gives memory back.
+ *          - Frequent notifications call for a higher watermark.
+ *          The choice must fit in RING_IO_TUNE_BUDGET with the other
+ *          channels.
+ *
+ *  @modif  Entry of the channel.
+ *  ----------------------------------------------------------------------------
+ */
+STATIC
+NORMAL_API
+Void
+RING_IO_TuneSample (IN RING_IO_TuneObj * tune,
+		IN Uint32 chnlId,
+		IN RING_IO_Uint64 elapsed)
+{
+	RING_IO_TuneEntry * entry = &tune->entries [chnlId];
+	RING_IO_ChnlTuneStats * stats;
+	RING_IO_ChnlTuneStats cur;
+	RING_IO_Uint64 rate;
+	RING_IO_Uint64 writerPct;
+	RING_IO_Uint64 readerPct;
+	RING_IO_Uint64 occPct = 0;
+	RING_IO_Uint64 notifyRate;
+	RING_IO_Uint64 occSamples;
+	Uint32 writerSize = entry->writerSize;
+	Uint32 readerSize = entry->readerSize;
+	Uint32 acqSize = entry->acqSize;
+
+	stats = RING_IO_ChnlGetTuneStats (&tune->chnls [chnlId]);
+	if (stats == NULL) {
+		return;
+	}
+	RING_IO_TuneSnapshot (stats, &cur);
+	rate = ((cur.bytes - entry->last.bytes) * 1000000u) / elapsed;
+	writerPct = ((cur.writerWaitTime - entry->last.writerWaitTime) * 100u)
+			/ elapsed;
+	readerPct = ((cur.readerWaitTime - entry->last.readerWaitTime) * 100u)
+			/ elapsed;
+	notifyRate = ((cur.notifies - entry->last.notifies) * 1000000u)
+			/ elapsed;
+	occSamples = cur.occupancySamples - entry->last.occupancySamples;
+	if ((occSamples > 0) && (entry->writerSize > 0)) {
+		occPct = (  ((cur.occupancySum - entry->last.occupancySum) * 100u)
+				  / occSamples)
+				/ entry->writerSize;
+	}
+	entry->last = cur;
+
+	/* Idle periods and choices not applied yet tell nothing */
+	if ((rate == 0) || (entry->pending == TRUE)) {
+		return;
+	}
+
+	if (entry->settle > 0) {
+		entry->settle--;
+		if (entry->settle == 0) {
+			RING_IO_1Print ("RING_IO_Tune: channel %d\n", chnlId);
+			RING_IO_1Print64 ("RING_IO_Tune:   throughput before %llu "
+					"bytes/s\n",
+					entry->rateBefore);
+			RING_IO_1Print64 ("RING_IO_Tune:   throughput after %llu "
+					"bytes/s\n",
+					rate);
+		}
+		return;
+	}
+
+	if (   (writerPct >= RING_IO_TUNE_STALL_PCT)
+		&& (occPct >= RING_IO_TUNE_FULL_PCT)) {
+		writerSize *= 2u;
+		readerSize *= 2u;
+	}
+	else if (   (readerPct >= RING_IO_TUNE_STALL_PCT)
+			 && (occPct <= RING_IO_TUNE_EMPTY_PCT)) {
+		readerSize /= 2u;
+	}
+	if (writerSize > RING_IO_RESIZE_MAX_SIZE) {
+		writerSize = RING_IO_RESIZE_MAX_SIZE;
+	}
+	if (readerSize > RING_IO_RESIZE_MAX_SIZE) {
+		readerSize = RING_IO_RESIZE_MAX_SIZE;
+	}
+	if (readerSize < RING_IO_TUNE_MIN_SIZE) {
+		readerSize = entry->readerSize;
+	}
+	if (  RING_IO_TuneBudget (tune, chnlId) + writerSize + readerSize
+		> RING_IO_TUNE_BUDGET) {
+		writerSize = entry->writerSize;
+		readerSize = entry->readerSize;
+	}
+
+	if (notifyRate >= RING_IO_TUNE_NOTIFY_RATE) {
+		acqSize *= 2u;
+	}
+	if (acqSize > writerSize) {
+		acqSize = writerSize;
+	}
+
+	if (   (writerSize == entry->writerSize)
+		&& (readerSize == entry->readerSize)
+		&& (acqSize == entry->acqSize)) {
+		return;
+	}
+	/* A recommendation is logged once */
+	if (   (tune->mode != RING_IO_TUNE_APPLY)
+		&& (writerSize == entry->newWriterSize)
+		&& (readerSize == entry->newReaderSize)
+		&& (acqSize == entry->newAcqSize)) {
+		return;
+	}
+
+	entry->newWriterSize = writerSize;
+	entry->newReaderSize = readerSize;
+	entry->newAcqSize = acqSize;
+	RING_IO_TuneLog (tune,
+			chnlId,
+			rate,
+			writerPct,
+			readerPct,
+			occPct,
+			notifyRate);
+
+	if (tune->mode == RING_IO_TUNE_APPLY) {
+		entry->rateBefore = rate;
+		entry->pending = TRUE;
+	}
+}
+
+/** ============================================================================
+ *  @func   RING_IO_TuneClient
+ *
+ *  @desc   Tuner client: samples the channels every period until it is
+ *          stopped.
+ *
+ *  @modif  None
+ *  ============================================================================
+ */
+NORMAL_API
+Void *
+RING_IO_TuneClient (IN Void * ptr)
+{
+	RING_IO_TuneObj * tune = RING_IO_Tune;
+	RING_IO_ChnlTuneStats * stats;
+	RING_IO_Uint64 start;
+	RING_IO_Uint64 now;
+	Uint32 i;
+
+	(Void) ptr;
+
+	for (i = 0; i < tune->numChnls; i++) {
+		stats = RING_IO_ChnlGetTuneStats (&tune->chnls [i]);
+		if (stats != NULL) {
+			RING_IO_TuneSnapshot (stats, &tune->entries [i].last);
+		}
+	}
+
+	start = RING_IO_GetTimeUsec ();
+	while (tune->stop == FALSE) {
+		RING_IO_Sleep (RING_IO_TUNE_TICK);
+		now = RING_IO_GetTimeUsec ();
+		if ((now - start) >= RING_IO_TUNE_PERIOD) {
+			for (i = 0; i < tune->numChnls; i++) {
+				RING_IO_TuneSample (tune, i, now - start);
+			}
+			start = now;
+		}
+	}
+
+	/* Exit */
+	RING_IO_Exit_client (&tuneClientInfo);
+
+	return (NULL);
+}
+
+/** ============================================================================
+ *  @func   RING_IO_TuneStart
+ *
+ *  @desc   Starts the tuner client on the channels.
+ *
+ *  @modif  RING_IO_Tune
+ *  ============================================================================
+ */
+NORMAL_API
+DSP_STATUS
+RING_IO_TuneStart (IN RING_IO_ChnlObj * chnls,
+		IN Uint32 numChnls,
+		IN Uint8 processorId,
+		IN Uint32 attrBufSize,
+		IN RING_IO_TuneMode mode)
+{
+	DSP_STATUS status = DSP_SOK;
+	RING_IO_TuneEntry * entry;
+	Pvoid addr = NULL;
+	Uint32 i;
+
+	if ((mode == RING_IO_TUNE_OFF) || (RING_IO_Tune != NULL)) {
+		return (DSP_SOK);
+	}
+
+	status = RING_IO_ShmAlloc (sizeof (RING_IO_TuneObj), &addr);
+	if (DSP_SUCCEEDED (status)) {
+		RING_IO_Tune = (RING_IO_TuneObj *) addr;
+		memset (RING_IO_Tune, 0, sizeof (RING_IO_TuneObj));
+		RING_IO_Tune->stop = FALSE;
+		RING_IO_Tune->mode = mode;
+		RING_IO_Tune->processorId = processorId;
+		RING_IO_Tune->attrBufSize = attrBufSize;
+		RING_IO_Tune->chnls = chnls;
+		RING_IO_Tune->numChnls = (numChnls < RING_IO_NUM_CHNLS) ? numChnls
+				: RING_IO_NUM_CHNLS;
+		for (i = 0; i < RING_IO_Tune->numChnls; i++) {
+			entry = &RING_IO_Tune->entries [i];
+			entry->writerSize = chnls [i].writerBufSize;
+			entry->readerSize = chnls [i].readerBufSize;
+			entry->acqSize = chnls [i].writerAcqSize;
+			entry->newWriterSize = entry->writerSize;
+			entry->newReaderSize = entry->readerSize;
+			entry->newAcqSize = entry->acqSize;
+			entry->pending = FALSE;
+		}
+
+		tuneClientInfo.processorId = processorId;
+		status = RING_IO_Create_client (&tuneClientInfo,
+				(Pvoid) RING_IO_TuneClient,
+				NULL);
+		if (DSP_FAILED (status)) {
+			RING_IO_0Print ("ERROR! Failed to create tuner client\n");
+			RING_IO_ShmFree (addr, sizeof (RING_IO_TuneObj));
+			RING_IO_Tune = NULL;
+		}
+	}
+
+	return (status);
+}
+
+/** ============================================================================
+ *  @func   RING_IO_TuneApply
+ *
+ *  @desc   Resizes the RingIOs of the channels and sets their watermark as
+ *          chosen by the tuner.
+ *
+ *  @modif  Channels with a choice pending.
+ *  ============================================================================
+ */
+NORMAL_API
+DSP_STATUS
+RING_IO_TuneApply (Void)
+{
+	DSP_STATUS status = DSP_SOK;
+	RING_IO_TuneObj * tune = RING_IO_Tune;
+	RING_IO_TuneEntry * entry;
+	RING_IO_ChnlObj * chnl;
+	Uint32 i;
+
+	if ((tune == NULL) || (tune->mode != RING_IO_TUNE_APPLY)) {
+		return (DSP_SOK);
+	}
+
+	for (i = 0; (i < tune->numChnls) && DSP_SUCCEEDED (status); i++) {
+		entry = &tune->entries [i];
+		chnl = &tune->chnls [i];
+		if (entry->pending == FALSE) {
+			continue;
+		}
+
+		if (   (entry->newWriterSize != chnl->writerBufSize)
+			|| (entry->newReaderSize != chnl->readerBufSize)) {
+			status = RING_IO_ChnlResize (chnl,
+					tune->processorId,
+					entry->newWriterSize,
+					entry->newReaderSize,
+					tune->attrBufSize);
+		}
+		if (DSP_SUCCEEDED (status)) {
+			chnl->writerAcqSize = entry->newAcqSize;
+			if (chnl->writerAcqSize > chnl->writerBufSize) {
+				chnl->writerAcqSize = chnl->writerBufSize;
+			}
+			RING_IO_ChnlPublish (chnl);
+			RING_IO_1Print ("RING_IO_Tune: channel %d tuned\n", i);
+			entry->settle = RING_IO_TUNE_SETTLE;
+		}
+		else {
+			RING_IO_1Print ("RING_IO_Tune: channel %d not tuned\n", i);
+			RING_IO_1Print ("RING_IO_ChnlResize () failed. "
+					"Status = [0x%x]\n",
+					status);
+		}
+
+		/* The tuner goes on from the sizes actually in place */
+		entry->writerSize = chnl->writerBufSize;
+		entry->readerSize = chnl->readerBufSize;
+		entry->acqSize = chnl->writerAcqSize;
+		entry->newWriterSize = entry->writerSize;
+		entry->newReaderSize = entry->readerSize;
+		entry->newAcqSize = entry->acqSize;
+		entry->pending = FALSE;
+	}
+
+	return (status);
+}
+
+/** ============================================================================
+ *  @func   RING_IO_TuneStop
+ *
+ *  @desc   Stops the tuner client.
+ *
+ *  @modif  RING_IO_Tune
+ *  ============================================================================
+ */
+NORMAL_API
+Void
+RING_IO_TuneStop (Void)
+{
+	if (RING_IO_Tune != NULL) {
+		RING_IO_Tune->stop = TRUE;
+		RING_IO_Join_client (&tuneClientInfo);
+
+		RING_IO_ShmFree (RING_IO_Tune, sizeof (RING_IO_TuneObj));
+		RING_IO_Tune = NULL;
+	}
+}
+
+
+#if defined (__cplusplus)
+}
+#endif /* defined (__cplusplus) */
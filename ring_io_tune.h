@@ -0,0 +1,213 @@
+/** ============================================================================
+ *  @file   ring_io_tune.h
+ *
+ *  @path   $(DSPLINK)/gpp/src/samples/ring_io/
+ *
+ *  @desc   Defines the ring size tuner of the ring_io application. A
+ *          background client samples the counters of every channel once per
+ *          period: throughput, occupancy of the writer RingIO, time the
+ *          writer waited for room, time the reader waited for data and rate
+ *          of notifications. From them it derives new RingIO sizes and a new
+ *          watermark, within a budget of shared memory, and logs each
+ *          decision. In RING_IO_TUNE_APPLY mode the decisions are applied
+ *          between transfers, and the throughput measured before and after
+ *          them is logged.
+ *
+ *  @ver    1.65.00.02
+ *  ============================================================================
+ *  Copyright (C) 2002-2009, Texas Instruments Incorporated -
+ *  http://www.ti.com/
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions
+ *  are met:
+ *  
+ *  *  Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *  
+ *  *  Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer in the
+ *     documentation and/or other materials provided with the distribution.
+ *  
+ *  *  Neither the name of Texas Instruments Incorporated nor the names of
+ *     its contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *  
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ *  THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ *  PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+ *  CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ *  EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ *  PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ *  OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ *  WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ *  OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ *  EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *  ============================================================================
+ */
+
+
+#if !defined (RING_IO_TUNE_H)
+#define RING_IO_TUNE_H
+
+
+/*  ----------------------------------- DSP/BIOS Link                 */
+#include <dsplink.h>
+
+/*  ----------------------------------- Application Header            */
+#include <ring_io.h>
+#include <ring_io_chnl.h>
+
+
+#if defined (__cplusplus)
+extern "C" {
+#endif /* defined (__cplusplus) */
+
+
+/** ============================================================================
+ *  @const  RING_IO_TUNE_PERIOD
+ *
+ *  @desc   Sampling period of the tuner in microseconds.
+ *  ============================================================================
+ */
+#define RING_IO_TUNE_PERIOD         1000000u
+
+/** ============================================================================
+ *  @const  RING_IO_TUNE_BUDGET
+ *
+ *  @desc   Largest sum of the data buffer sizes of the RingIOs of all the
+ *          channels the tuner may choose.
+ *  ============================================================================
+ */
+#define RING_IO_TUNE_BUDGET         32768u
+
+/** ============================================================================
+ *  @const  RING_IO_TUNE_MIN_SIZE
+ *
+ *  @desc   Smallest data buffer size the tuner may choose.
+ *  ============================================================================
+ */
+#define RING_IO_TUNE_MIN_SIZE       512u
+
+/** ============================================================================
+ *  @const  RING_IO_TUNE_STALL_PCT
+ *
+ *  @desc   Share of a period, in percent, a side of a channel must spend
+ *          waiting for the tuner to act on it.
+ *  ============================================================================
+ */
+#define RING_IO_TUNE_STALL_PCT      20u
+
+/** ============================================================================
+ *  @const  RING_IO_TUNE_FULL_PCT, RING_IO_TUNE_EMPTY_PCT
+ *
+ *  @desc   Average occupancy of the writer RingIO, in percent, above which
+ *          it is considered full and below which it is considered empty.
+ *  ============================================================================
+ */
+#define RING_IO_TUNE_FULL_PCT       75u
+#define RING_IO_TUNE_EMPTY_PCT      25u
+
+/** ============================================================================
+ *  @const  RING_IO_TUNE_NOTIFY_RATE
+ *
+ *  @desc   Number of notifications per second above which the watermark is
+ *          raised.
+ *  ============================================================================
+ */
+#define RING_IO_TUNE_NOTIFY_RATE    2000u
+
+
+/** ============================================================================
+ *  @func   RING_IO_TuneStart
+ *
+ *  @desc   Starts the tuner client on the channels.
+ *
+ *  @arg    chnls
+ *              Channels of the application.
+ *  @arg    numChnls
+ *              Number of channels.
+ *  @arg    processorId
+ *              ID of the DSP processor.
+ *  @arg    attrBufSize
+ *              Size of the attribute buffer of the RingIOs, kept when they
+ *              are resized.
+ *  @arg    mode
+ *              RING_IO_TUNE_RECOMMEND or RING_IO_TUNE_APPLY. Nothing is
+ *              started for RING_IO_TUNE_OFF.
+ *
+ *  @ret    DSP_SOK
+ *              Operation successfully completed.
+ *          DSP_EMEMORY
+ *              Out of memory.
+ *          DSP_EFAIL
+ *              General failure.
+ *
+ *  @enter  RING_IO_ChnlPoolInit () succeeded.
+ *
+ *  @leave  None
+ *
+ *  @see    RING_IO_TuneStop, RING_IO_TuneApply
+ *  ============================================================================
+ */
+NORMAL_API
+DSP_STATUS
+RING_IO_TuneStart (IN RING_IO_ChnlObj * chnls,
+                   IN Uint32            numChnls,
+                   IN Uint8             processorId,
+                   IN Uint32            attrBufSize,
+                   IN RING_IO_TuneMode  mode) ;
+
+/** ============================================================================
+ *  @func   RING_IO_TuneApply
+ *
+ *  @desc   Applies the decisions of the tuner not applied yet, in
+ *          RING_IO_TUNE_APPLY mode. Does nothing otherwise.
+ *
+ *  @arg    None
+ *
+ *  @ret    DSP_SOK
+ *              Operation successfully completed.
+ *          DSP_EFAIL
+ *              General failure.
+ *
+ *  @enter  No data transfer is in progress and no client holds the RingIOs
+ *          of the channels.
+ *
+ *  @leave  None
+ *
+ *  @see    RING_IO_ChnlResize
+ *  ============================================================================
+ */
+NORMAL_API
+DSP_STATUS
+RING_IO_TuneApply (Void) ;
+
+/** ============================================================================
+ *  @func   RING_IO_TuneStop
+ *
+ *  @desc   Stops the tuner client, if started.
+ *
+ *  @arg    None
+ *
+ *  @ret    None
+ *
+ *  @enter  None
+ *
+ *  @leave  None
+ *
+ *  @see    RING_IO_TuneStart
+ *  ============================================================================
+ */
+NORMAL_API
+Void
+RING_IO_TuneStop (Void) ;
+
+
+#if defined (__cplusplus)
+}
+#endif /* defined (__cplusplus) */
+
+
+#endif /* !defined (RING_IO_TUNE_H) */